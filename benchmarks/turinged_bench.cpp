@@ -0,0 +1,1019 @@
+// Microbenchmarks for the polynomial, scheme and homomorphic primitives.
+//
+// Every benchmark is run for each combination of the swept ring sizes, moduli,
+// GLWE dimensions (only where k matters) and thread counts. With T threads, T
+// copies of the operation run concurrently on independent outputs, so ns/op is
+// the per-thread latency and ops/s the aggregate throughput. bytes/op counts the
+// operand and result coefficients the call reads and writes (8 bytes each, keys
+// included); the allocation columns come from the coefficient pool counters.
+//
+// Key switching, automorphism and packing benchmarks need the NTT key switching
+// path to cover the gadget at that (n, q); packing runs at q - 1, since it needs
+// an odd modulus. The rns.* and ckks.* benchmarks build a chain of three primes
+// of q_bits bits each and are skipped where no such chain exists.
+//
+// The gate.* and lut.* suites run once per thread count at fixed bootstrapping
+// parameters instead of the sweep: operations::default_gate_parameters(), and
+// the same with N = 2048 and t = 8 for the lookup tables. They also report
+// gates (or table outputs) per second per core: aggregate throughput divided by
+// the thread count. The batched gate variant runs a single evaluate_gates call
+// over a pool of that many threads rather than one copy per thread.
+//
+//   turinged_bench [--n 256,1024] [--q-bits 32,50] [--k 1,2] [--threads 1,4]
+//                  [--t 16] [--beta-bits 8] [--levels 3] [--min-time 0.1]
+//                  [--filter rlwe.] [--json results.json | --json -] [--list]
+
+#include "turinged/turinged.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace turinged;
+
+namespace {
+
+struct Options {
+    std::vector<std::size_t> n = {256, 512, 1024, 2048, 4096, 8192, 16384};
+    std::vector<std::size_t> q_bits = {32, 50};
+    std::vector<std::size_t> k = {1, 2};
+    std::vector<std::size_t> threads;
+    int64 t = 16;
+    std::size_t beta_bits = 8;
+    int levels = 3;
+    double min_time = 0.1;
+    std::string filter;
+    std::string json;
+    bool list = false;
+};
+
+// Keeps the compiler from discarding a result that is never read
+template <typename T>
+void keep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Gate bootstrapping keys and encrypted bits at the default gate parameters
+struct GateFixture {
+    keys::GateBootstrappingParameters params;
+    keys::LWESecretKey lwe_sk;
+    keys::GateBootstrappingKey key;
+    keys::GateBootstrappingKeyView view;
+    schemes::LWECiphertext a;
+    schemes::LWECiphertext b;
+    schemes::LWECiphertext select;
+    std::vector<schemes::LWECiphertext> batch_a;
+    std::vector<schemes::LWECiphertext> batch_b;
+};
+
+// Bootstrapping keys and an input for the lookup-table benchmarks
+struct LutFixture {
+    keys::GateBootstrappingParameters params;
+    Parameters lwe_params;
+    Parameters glwe_params;
+    keys::LWESecretKey lwe_sk;
+    keys::GateBootstrappingKey key;
+    schemes::LWECiphertext ct;
+    std::vector<std::vector<int64>> tables;
+
+    LutFixture() : lwe_params(0, 0, 0, 0), glwe_params(0, 0, 0, 0) {}
+};
+
+// Keys and inputs shared (read-only) by every thread running a configuration
+struct Fixture {
+    Parameters params;
+    std::size_t k;
+    int levels;
+    int64 beta;
+
+    Polynomial a;
+    Polynomial b;
+    Polynomial message;             // mod t
+    std::vector<int64> lwe_a;
+    std::vector<int64> lwe_b;
+
+    keys::LWESecretKey lwe_sk;
+    schemes::LWECiphertext lwe_ct1;
+    schemes::LWECiphertext lwe_ct2;
+
+    keys::RLWESecretKey rlwe_sk;
+    keys::RLWEPublicKey rlwe_pk;
+    keys::RLWERelinKey relin_key;
+    schemes::RLWECiphertext rlwe_ct1;
+    schemes::RLWECiphertext rlwe_ct2;
+    operations::RLWETensorCiphertext tensor;
+
+    keys::GLWESecretKey glwe_sk;
+    keys::GLWEPublicKey glwe_pk;
+    schemes::GLWECiphertext glwe_ct1;
+    schemes::GLWECiphertext glwe_ct2;
+    schemes::GLevCiphertext glev_ct;
+    schemes::GGSWCiphertext ggsw_ct;
+
+    operations::PreparedPlaintext prepared;
+    bool exact_products;            // prepared plaintext products fit the NTT range
+    bool exact_tensor;
+
+    // Key switching, automorphisms and packing, where the NTT key switching
+    // path covers the gadget
+    bool key_switching;
+    int64 q_switched;                       // modulus switching target, about sqrt(q)
+    keys::RLWEKeySwitchKey rlwe_ksk;        // from a second ring key
+    keys::RLWEGaloisKeys galois_keys;       // rotations by 1..4 steps
+    keys::LWEKeySwitchKey lwe_ksk;          // n -> n / 2, only for n <= LWE_KEY_SWITCH_MAX_N
+    Parameters pack_params;                 // q - 1: packing needs an odd modulus
+    keys::RLWEGaloisKeys pack_keys;
+    std::vector<schemes::LWECiphertext> pack_inputs;
+    keys::GLWEKeySwitchKey glwe_ksk;
+    keys::GLWEGaloisKeys glwe_galois_keys;
+
+    // RNS BFV and CKKS over RNS_PRIMES primes of q_bits each, where such a chain exists
+    bool rns_ready;
+    rns::RNSParameters rns_params;
+    keys::RNSRelinKey rns_relin;
+    schemes::RNSRLWECiphertext rns_ct1;
+    schemes::RNSRLWECiphertext rns_ct2;
+    rns::RNSParameters ckks_params;
+    keys::RNSRelinKey ckks_relin;
+    encoding::CKKSEncoder ckks_encoder;
+    std::vector<double> ckks_values;
+    double ckks_scale;
+    schemes::CKKSCiphertext ckks_ct1;
+    schemes::CKKSCiphertext ckks_ct2;
+
+    std::shared_ptr<GateFixture> gates;     // only in the gate fixture
+    std::shared_ptr<LutFixture> luts;       // only in the lookup-table fixture
+    mutable std::size_t pool_threads;       // thread count of the row, for pooled benchmarks
+
+    Fixture(const Parameters& params, std::size_t k, int levels, int64 beta)
+        : params(params), k(k), levels(levels), beta(beta), exact_products(false), exact_tensor(false),
+          key_switching(false), q_switched(0), pack_params(params), rns_ready(false), ckks_scale(0),
+          pool_threads(1) {}
+};
+
+using Op = std::function<void()>;
+
+// A benchmark builds one Op per thread, so each thread owns its outputs
+struct Benchmark {
+    std::string name;
+    bool uses_k;
+    std::function<bool(const Fixture&)> supported;
+    std::function<std::size_t(const Fixture&)> words;
+    std::function<Op(const Fixture&)> make;
+    std::string suite;          // "gate" or "lut" at fixed parameters, empty for the sweep
+    std::size_t outputs;        // gates or table outputs per call in a suite
+    bool pooled;                // one copy spreading its work over pool_threads threads
+};
+
+struct Measurement {
+    std::size_t iterations;
+    double ns_per_op;
+    double ops_per_sec;
+    double pool_allocations_per_op;
+    double global_allocations_per_op;
+};
+
+std::vector<std::size_t> parse_list(const std::string& flag, const std::string& text) {
+    std::vector<std::size_t> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::size_t used = 0;
+        unsigned long long value = 0;
+        try {
+            value = std::stoull(item, &used);
+        } catch (const std::exception&) {
+            used = 0;
+        }
+        if (used == 0 || used != item.size() || value == 0) {
+            throw std::runtime_error("Bad value '" + item + "' for " + flag);
+        }
+        values.push_back(static_cast<std::size_t>(value));
+    }
+    if (values.empty()) {
+        throw std::runtime_error("Empty list for " + flag);
+    }
+    return values;
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--list") {
+            options.list = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + flag);
+        }
+        std::string value = argv[++i];
+
+        if (flag == "--n") options.n = parse_list(flag, value);
+        else if (flag == "--q-bits") options.q_bits = parse_list(flag, value);
+        else if (flag == "--k") options.k = parse_list(flag, value);
+        else if (flag == "--threads") options.threads = parse_list(flag, value);
+        else if (flag == "--t") options.t = static_cast<int64>(parse_list(flag, value)[0]);
+        else if (flag == "--beta-bits") options.beta_bits = parse_list(flag, value)[0];
+        else if (flag == "--levels") options.levels = static_cast<int>(parse_list(flag, value)[0]);
+        else if (flag == "--min-time") options.min_time = std::stod(value);
+        else if (flag == "--filter") options.filter = value;
+        else if (flag == "--json") options.json = value;
+        else throw std::runtime_error("Unknown option " + flag);
+    }
+
+    for (std::size_t bits : options.q_bits) {
+        if (bits < 8 || bits > 62) {
+            throw std::runtime_error("--q-bits must lie in 8..62");
+        }
+    }
+    if (options.beta_bits == 0 || options.beta_bits > 30) {
+        throw std::runtime_error("--beta-bits must lie in 1..30");
+    }
+    if (options.t < 2) {
+        throw std::runtime_error("--t must be at least 2");
+    }
+
+    // Default thread sweep: powers of two up to the hardware concurrency
+    if (options.threads.empty()) {
+        std::size_t hw = core::default_thread_count();
+        for (std::size_t threads = 1; threads < hw; threads *= 2) options.threads.push_back(threads);
+        options.threads.push_back(hw);
+    }
+    return options;
+}
+
+// The LWE key switching key holds n * levels * (n / 2 + 1) words
+constexpr std::size_t LWE_KEY_SWITCH_MAX_N = 2048;
+
+// LWE ciphertexts packed per call of the packing benchmark
+constexpr std::size_t PACK_COUNT = 16;
+
+// Primes in the RNS and CKKS modulus chains
+constexpr std::size_t RNS_PRIMES = 3;
+
+Polynomial random_polynomial(std::size_t n, int64 q, uint64 seed) {
+    Polynomial p(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        p[i] = static_cast<int64>(core::derive_seed(seed, i) % static_cast<uint64>(q));
+    }
+    return p;
+}
+
+std::unique_ptr<Fixture> make_fixture(const Parameters& params, std::size_t k, bool ring, const Options& options) {
+    int64 beta = static_cast<int64>(1) << options.beta_bits;
+    auto f = std::unique_ptr<Fixture>(new Fixture(params, k, options.levels, beta));
+    std::size_t n = params.n;
+
+    f->a = random_polynomial(n, params.q, 1);
+    f->b = random_polynomial(n, params.q, 2);
+    f->message = random_polynomial(n, params.t, 3);
+    f->lwe_a.assign(f->a.begin(), f->a.end());
+    f->lwe_b.assign(f->b.begin(), f->b.end());
+
+    if (ring) {
+        f->lwe_sk = keys::generate_lwe_secret_key(n);
+        f->lwe_ct1 = schemes::encrypt_lwe(1, f->lwe_sk, params);
+        f->lwe_ct2 = schemes::encrypt_lwe(2, f->lwe_sk, params);
+
+        f->rlwe_sk = keys::generate_rlwe_secret_key(n);
+        f->rlwe_pk = keys::generate_rlwe_public_key(f->rlwe_sk, params);
+        f->rlwe_ct1 = schemes::encrypt_rlwe(f->message, f->rlwe_sk, params);
+        f->rlwe_ct2 = schemes::encrypt_rlwe(f->message, f->rlwe_sk, params);
+
+        f->exact_tensor = polynomial::ntt_supported(n, params.q, 2);
+        if (f->exact_tensor) {
+            f->relin_key = keys::generate_rlwe_relin_key(f->rlwe_sk, params, beta);
+            f->tensor = operations::tensor_rlwe(f->rlwe_ct1, f->rlwe_ct2, params);
+        }
+    }
+
+    int q_bits = static_cast<int>(std::log2(static_cast<double>(params.q)));
+    f->q_switched = static_cast<int64>(1) << (q_bits + 1) / 2;
+    int gadget_levels = core::gadget_levels(params.q, beta);
+    f->key_switching = polynomial::ntt_supported(n, params.q, static_cast<std::size_t>(gadget_levels) * std::max<std::size_t>(k, 1));
+    if (ring && f->key_switching) {
+        keys::RLWESecretKey other = keys::generate_rlwe_secret_key(n);
+        f->rlwe_ksk = keys::generate_rlwe_key_switch_key(other.s, f->rlwe_sk, params, beta);
+        std::vector<uint64> rotations;
+        for (int steps = 1; steps <= 4; ++steps) rotations.push_back(operations::galois_element_for_rotation(steps, n));
+        f->galois_keys = keys::generate_rlwe_galois_keys(f->rlwe_sk, params, beta, rotations);
+
+        f->pack_params = Parameters(n, params.q - 1, params.t, params.noise_bound);
+        f->pack_keys = keys::generate_rlwe_galois_keys(f->rlwe_sk, f->pack_params, beta, operations::packing_galois_elements(n));
+        keys::LWESecretKey extracted = keys::extract_lwe_secret_key(f->rlwe_sk);
+        for (std::size_t i = 0; i < PACK_COUNT; ++i) {
+            f->pack_inputs.push_back(schemes::encrypt_lwe(static_cast<int64>(i) % params.t, extracted, f->pack_params));
+        }
+
+        if (n <= LWE_KEY_SWITCH_MAX_N) {
+            f->lwe_ksk = keys::generate_lwe_key_switch_key(f->lwe_sk, keys::generate_lwe_secret_key(n / 2), params, beta);
+        }
+    }
+
+    if (ring) {
+        // Chains exist only where RNS_PRIMES primes = 1 mod 2n of q_bits bits do
+        try {
+            f->rns_params = rns::create_rns_parameters(n, params.t, params.noise_bound, q_bits, RNS_PRIMES);
+            f->rns_relin = keys::generate_rns_relin_key(f->rlwe_sk, f->rns_params);
+            f->rns_ct1 = schemes::encrypt_rlwe_rns(f->message, f->rlwe_sk, f->rns_params);
+            f->rns_ct2 = schemes::encrypt_rlwe_rns(f->message, f->rlwe_sk, f->rns_params);
+
+            f->ckks_params = rns::create_ckks_parameters(n, params.noise_bound, q_bits, RNS_PRIMES);
+            f->ckks_relin = keys::generate_rns_relin_key(f->rlwe_sk, f->ckks_params);
+            f->ckks_encoder = encoding::create_ckks_encoder(n);
+            f->ckks_scale = std::ldexp(1.0, q_bits);
+            for (std::size_t i = 0; i < n / 2; ++i) f->ckks_values.push_back(std::sin(static_cast<double>(i)));
+            encoding::CKKSPlaintext plain = encoding::encode_ckks(f->ckks_values, f->ckks_scale, f->ckks_encoder);
+            f->ckks_ct1 = schemes::encrypt_ckks(plain, f->rlwe_sk, f->ckks_params);
+            f->ckks_ct2 = schemes::encrypt_ckks(plain, f->rlwe_sk, f->ckks_params);
+            f->rns_ready = true;
+        } catch (const std::runtime_error&) {
+            f->rns_ready = false;
+        }
+    }
+
+    // Plaintext products throw when n * q * t outgrows the exact NTT range
+    f->prepared = operations::prepare_plaintext(f->message, params);
+    try {
+        schemes::RLWECiphertext probe = schemes::trivial_rlwe(f->message, params);
+        operations::multiply_plain_rlwe(probe, f->prepared, params);
+        f->exact_products = true;
+    } catch (const std::runtime_error&) {
+        f->exact_products = false;
+    }
+
+    if (k > 0) {
+        f->glwe_sk = keys::generate_glwe_secret_key(k, n);
+        f->glwe_pk = keys::generate_glwe_public_key(f->glwe_sk, params);
+        f->glwe_ct1 = schemes::encrypt_glwe(f->message, f->glwe_sk, params);
+        f->glwe_ct2 = schemes::encrypt_glwe(f->message, f->glwe_sk, params);
+        f->glev_ct = schemes::encrypt_glev(f->message, f->glwe_sk, params, options.levels, beta);
+        f->ggsw_ct = schemes::encrypt_ggsw(f->message, f->glwe_sk, params, options.levels, beta);
+
+        if (f->key_switching) {
+            keys::GLWESecretKey other = keys::generate_glwe_secret_key(k, n);
+            f->glwe_ksk = keys::generate_glwe_key_switch_key(other.s, f->glwe_sk, params, beta);
+            f->glwe_galois_keys = keys::generate_glwe_galois_keys(f->glwe_sk, params, beta,
+                                                                  {operations::galois_element_for_rotation(1, n)});
+        }
+    }
+    return f;
+}
+
+// Gates per call of the batched gate benchmark
+constexpr std::size_t GATE_BATCH = 16;
+
+std::unique_ptr<Fixture> make_gate_fixture() {
+    auto g = std::make_shared<GateFixture>();
+    g->params = operations::default_gate_parameters();
+    g->lwe_sk = keys::generate_lwe_secret_key(g->params.lwe_dimension);
+    keys::GLWESecretKey glwe_sk = keys::generate_glwe_secret_key(g->params.k, g->params.n);
+    g->key = keys::generate_gate_bootstrapping_key(g->lwe_sk, glwe_sk, g->params);
+    g->view = g->key.view();
+    g->a = operations::encrypt_bit(true, g->lwe_sk, g->params);
+    g->b = operations::encrypt_bit(false, g->lwe_sk, g->params);
+    g->select = operations::encrypt_bit(true, g->lwe_sk, g->params);
+    for (std::size_t i = 0; i < GATE_BATCH; ++i) {
+        g->batch_a.push_back(operations::encrypt_bit(i % 2 == 0, g->lwe_sk, g->params));
+        g->batch_b.push_back(operations::encrypt_bit(i % 3 == 0, g->lwe_sk, g->params));
+    }
+
+    auto f = std::unique_ptr<Fixture>(new Fixture(g->params.glwe_parameters(), g->params.k, g->params.bsk_l,
+                                                  g->params.bsk_beta));
+    f->gates = g;
+    return f;
+}
+
+// Default gate set with N = 2048, whose smaller blind rotation noise leaves
+// room for the growth of the table products; four tables of four messages
+std::unique_ptr<Fixture> make_lut_fixture() {
+    auto l = std::make_shared<LutFixture>();
+    l->params = operations::default_gate_parameters();
+    l->params.n = 2048;
+    l->params.glwe_noise_bound = params::noise_bound_for_stddev(
+        params::min_noise_stddev(l->params.k * l->params.n, l->params.q, 128));
+    l->lwe_params = l->params.lwe_parameters();
+    l->glwe_params = l->params.glwe_parameters();
+
+    l->lwe_sk = keys::generate_lwe_secret_key(l->params.lwe_dimension);
+    keys::GLWESecretKey glwe_sk = keys::generate_glwe_secret_key(l->params.k, l->params.n);
+    l->key = keys::generate_gate_bootstrapping_key(l->lwe_sk, glwe_sk, l->params);
+    l->ct = schemes::encrypt_lwe(2, l->lwe_sk, l->lwe_params);
+    l->tables = {{0, 1, 2, 3}, {0, 1, 0, 1}, {3, 2, 1, 0}, {0, 0, 1, 3}};
+
+    auto f = std::unique_ptr<Fixture>(new Fixture(l->glwe_params, l->params.k, l->params.bsk_l,
+                                                  l->params.bsk_beta));
+    f->luts = l;
+    return f;
+}
+
+void print_suite_parameters(std::ostream& out, const std::string& suite, const keys::GateBootstrappingParameters& gp) {
+    out << suite << " parameters: lwe n=" << gp.lwe_dimension << ", N=" << gp.n << ", k=" << gp.k
+        << ", q=2^" << static_cast<int>(std::log2(static_cast<double>(gp.q)))
+        << ", bsk beta=" << gp.bsk_beta << " levels=" << gp.bsk_l + 1
+        << ", ksk beta=" << gp.ksk_beta << std::endl;
+}
+
+bool always(const Fixture&) { return true; }
+
+std::vector<Benchmark> make_benchmarks() {
+    std::vector<Benchmark> list;
+    auto add = [&](const std::string& name, bool uses_k,
+                   std::function<std::size_t(const Fixture&)> words,
+                   std::function<Op(const Fixture&)> make,
+                   std::function<bool(const Fixture&)> supported = always) {
+        list.push_back({name, uses_k, supported, words, make, "", 0, false});
+    };
+    auto add_suite = [&](const std::string& suite, const std::string& name, std::size_t outputs, bool pooled,
+                         std::function<std::size_t(const Fixture&)> words,
+                         std::function<Op(const Fixture&)> make) {
+        list.push_back({name, true, always, words, make, suite, outputs, pooled});
+    };
+
+    auto exact_products = [](const Fixture& f) { return f.exact_products; };
+    auto exact_tensor = [](const Fixture& f) { return f.exact_tensor; };
+    auto key_switching = [](const Fixture& f) { return f.key_switching; };
+    auto rns_ready = [](const Fixture& f) { return f.rns_ready; };
+
+    // Words of an RLWE key switch: input, the 2 * levels key polynomials, output
+    auto switch_words = [](const Fixture& f) {
+        return (4 + 2 * static_cast<std::size_t>(f.rlwe_ksk.levels)) * f.params.n;
+    };
+    auto rns_words = [](const Fixture& f, const rns::RNSParameters& params) {
+        return RNS_PRIMES * f.params.n * (6 + 2 * (RNS_PRIMES + params.p_base.primes.size()));
+    };
+
+    // ---- Polynomial arithmetic ----
+    add("poly.negacyclic_multiply", false, [](const Fixture& f) { return 3 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(polynomial::negacyclic_multiply(f.a, f.b, f.params.q)); };
+    });
+    add("poly.negacyclic_multiply.into", false, [](const Fixture& f) { return 3 * f.params.n; }, [](const Fixture& f) -> Op {
+        auto out = std::make_shared<Polynomial>(f.params.n);
+        return [&f, out]() {
+            polynomial::negacyclic_multiply(polynomial::view(f.a, f.params.q), polynomial::view(f.b, f.params.q),
+                                            polynomial::view(*out, f.params.q));
+            keep(*out);
+        };
+    });
+    add("poly.add", false, [](const Fixture& f) { return 3 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(polynomial::add(f.a, f.b, f.params.q)); };
+    });
+    add("poly.add.into", false, [](const Fixture& f) { return 3 * f.params.n; }, [](const Fixture& f) -> Op {
+        auto out = std::make_shared<Polynomial>(f.params.n);
+        return [&f, out]() {
+            polynomial::add(polynomial::view(f.a, f.params.q), polynomial::view(f.b, f.params.q),
+                            polynomial::view(*out, f.params.q));
+            keep(*out);
+        };
+    });
+    add("poly.scalar_multiply", false, [](const Fixture& f) { return 2 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(polynomial::scalar_multiply(f.a, 12345, f.params.q)); };
+    });
+    add("poly.scalar_multiply.into", false, [](const Fixture& f) { return 2 * f.params.n; }, [](const Fixture& f) -> Op {
+        auto out = std::make_shared<Polynomial>(f.params.n);
+        return [&f, out]() {
+            polynomial::scalar_multiply(polynomial::view(f.a, f.params.q), 12345, polynomial::view(*out, f.params.q));
+            keep(*out);
+        };
+    });
+    add("math.dot_product_modq", false, [](const Fixture& f) { return 2 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(core::dot_product_modq(f.lwe_a, f.lwe_b, f.params.q)); };
+    });
+
+    // ---- LWE ----
+    add("lwe.encrypt_sk", false, [](const Fixture& f) { return 2 * f.params.n + 1; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::encrypt_lwe(3, f.lwe_sk, f.params)); };
+    });
+    add("lwe.decrypt", false, [](const Fixture& f) { return 2 * f.params.n + 1; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::decrypt_lwe(f.lwe_ct1, f.lwe_sk, f.params)); };
+    });
+
+    // ---- RLWE ----
+    add("rlwe.encrypt_sk", false, [](const Fixture& f) { return 4 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::encrypt_rlwe(f.message, f.rlwe_sk, f.params)); };
+    });
+    add("rlwe.encrypt_pk", false, [](const Fixture& f) { return 5 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::encrypt_rlwe(f.message, f.rlwe_pk, f.params)); };
+    });
+    add("rlwe.decrypt", false, [](const Fixture& f) { return 4 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::decrypt_rlwe(f.rlwe_ct1, f.rlwe_sk, f.params)); };
+    });
+
+    // ---- GLWE / GLev / GGSW ----
+    add("keys.generate_glwe_public_key", true, [](const Fixture& f) { return (2 * f.k + 1) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(keys::generate_glwe_public_key(f.glwe_sk, f.params)); };
+        });
+    add("glwe.encrypt_sk", true, [](const Fixture& f) { return (2 * f.k + 2) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::encrypt_glwe(f.message, f.glwe_sk, f.params)); };
+    });
+    add("glwe.encrypt_pk", true, [](const Fixture& f) { return (2 * f.k + 3) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::encrypt_glwe(f.message, f.glwe_pk, f.params)); };
+    });
+    add("glwe.decrypt", true, [](const Fixture& f) { return (2 * f.k + 2) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::decrypt_glwe(f.glwe_ct1, f.glwe_sk, f.params)); };
+    });
+    add("glev.encrypt_sk", true,
+        [](const Fixture& f) { return (f.k + 1 + (f.levels + 1) * (f.k + 1)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(schemes::encrypt_glev(f.message, f.glwe_sk, f.params, f.levels, f.beta)); };
+        });
+    add("glev.encrypt_pk", true,
+        [](const Fixture& f) { return (f.k + 2 + (f.levels + 1) * (f.k + 1)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(schemes::encrypt_glev(f.message, f.glwe_pk, f.params, f.levels, f.beta)); };
+        });
+    add("glev.decrypt_level", true, [](const Fixture& f) { return (2 * f.k + 2) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::decrypt_glev_level(f.glev_ct, f.glwe_sk, f.params, 0, f.beta)); };
+    });
+    add("ggsw.encrypt_sk", true,
+        [](const Fixture& f) { return (f.k + 1 + (f.k + 1) * (f.levels + 1) * (f.k + 1)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(schemes::encrypt_ggsw(f.message, f.glwe_sk, f.params, f.levels, f.beta)); };
+        });
+    add("ggsw.encrypt_pk", true,
+        [](const Fixture& f) { return (2 * f.k + 2 + (f.k + 1) * (f.levels + 1) * (f.k + 1)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() {
+                keep(schemes::encrypt_ggsw(f.message, f.glwe_pk, f.glwe_sk, f.params, f.levels, f.beta));
+            };
+        });
+    add("ggsw.decrypt", true, [](const Fixture& f) { return (2 * f.k + 2) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(schemes::decrypt_ggsw(f.ggsw_ct, f.glwe_sk, f.params, 0, f.beta)); };
+    });
+
+    // ---- LWE homomorphic ----
+    add("lwe.add", false, [](const Fixture& f) { return 3 * (f.params.n + 1); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::add_lwe(f.lwe_ct1, f.lwe_ct2, f.params)); };
+    });
+    add("lwe.subtract", false, [](const Fixture& f) { return 3 * (f.params.n + 1); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::subtract_lwe(f.lwe_ct1, f.lwe_ct2, f.params)); };
+    });
+    add("lwe.scalar_multiply", false, [](const Fixture& f) { return 2 * (f.params.n + 1); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::scalar_multiply_lwe(f.lwe_ct1, 3, f.params)); };
+    });
+    add("lwe.add_plain", false, [](const Fixture& f) { return 2 * (f.params.n + 1); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::add_plain_lwe(f.lwe_ct1, 1, f.params)); };
+    });
+    add("lwe.sub_plain", false, [](const Fixture& f) { return 2 * (f.params.n + 1); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::sub_plain_lwe(f.lwe_ct1, 1, f.params)); };
+    });
+
+    // ---- RLWE homomorphic ----
+    add("rlwe.add", false, [](const Fixture& f) { return 6 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::add_rlwe(f.rlwe_ct1, f.rlwe_ct2, f.params)); };
+    });
+    add("rlwe.add.into", false, [](const Fixture& f) { return 6 * f.params.n; }, [](const Fixture& f) -> Op {
+        auto out = std::make_shared<schemes::RLWECiphertext>(f.params.n);
+        return [&f, out]() {
+            operations::add_rlwe(schemes::view(f.rlwe_ct1, f.params.q), schemes::view(f.rlwe_ct2, f.params.q),
+                                 f.params, schemes::view(*out, f.params.q));
+            keep(*out);
+        };
+    });
+    add("rlwe.subtract", false, [](const Fixture& f) { return 6 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::subtract_rlwe(f.rlwe_ct1, f.rlwe_ct2, f.params)); };
+    });
+    add("rlwe.scalar_multiply", false, [](const Fixture& f) { return 4 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::scalar_multiply_rlwe(f.rlwe_ct1, 3, f.params)); };
+    });
+    add("rlwe.add_plain", false, [](const Fixture& f) { return 5 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::add_plain_rlwe(f.rlwe_ct1, f.message, f.params)); };
+    });
+    add("rlwe.sub_plain", false, [](const Fixture& f) { return 5 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::sub_plain_rlwe(f.rlwe_ct1, f.message, f.params)); };
+    });
+    add("rlwe.multiply_plain", false, [](const Fixture& f) { return 5 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::multiply_plain_rlwe(f.rlwe_ct1, f.message, f.params)); };
+    }, exact_products);
+    add("rlwe.multiply_plain_prepared", false, [](const Fixture& f) { return 6 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::multiply_plain_rlwe(f.rlwe_ct1, f.prepared, f.params)); };
+    }, exact_products);
+    add("rlwe.multiply_plain_accumulate.8", false, [](const Fixture& f) { return (8 * 4 + 2) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            auto cts = std::make_shared<std::vector<schemes::RLWECiphertext>>(8, f.rlwe_ct1);
+            auto plains = std::make_shared<std::vector<operations::PreparedPlaintext>>(8, f.prepared);
+            return [&f, cts, plains]() { keep(operations::multiply_plain_accumulate_rlwe(*cts, *plains, f.params)); };
+        }, exact_products);
+    add("rlwe.tensor", false, [](const Fixture& f) { return 7 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::tensor_rlwe(f.rlwe_ct1, f.rlwe_ct2, f.params)); };
+    }, exact_tensor);
+    add("rlwe.relinearize", false,
+        [](const Fixture& f) { return (5 + 4 * static_cast<std::size_t>(f.relin_key.levels)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(operations::relinearize_rlwe(f.tensor, f.relin_key, f.params)); };
+        }, exact_tensor);
+    add("rlwe.multiply", false,
+        [](const Fixture& f) { return (6 + 4 * static_cast<std::size_t>(f.relin_key.levels)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(operations::multiply_rlwe(f.rlwe_ct1, f.rlwe_ct2, f.relin_key, f.params)); };
+        }, exact_tensor);
+
+    // ---- Key switching, modulus switching, automorphisms and packing ----
+    add("lwe.key_switch", false,
+        [](const Fixture& f) { return f.lwe_ksk.total_words() + f.lwe_ksk.n_in + f.lwe_ksk.n_out + 2; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(operations::key_switch_lwe(f.lwe_ct1, f.lwe_ksk, f.params)); };
+        }, [](const Fixture& f) { return f.lwe_ksk.n_in != 0; });
+    add("lwe.modulus_switch", false, [](const Fixture& f) { return 2 * (f.params.n + 1); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::modulus_switch_lwe(f.lwe_ct1, f.params, f.q_switched)); };
+    });
+    add("rlwe.modulus_switch", false, [](const Fixture& f) { return 4 * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::modulus_switch_rlwe(f.rlwe_ct1, f.params, f.q_switched)); };
+    });
+    add("rlwe.key_switch", false, switch_words, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::key_switch_rlwe(f.rlwe_ct1, f.rlwe_ksk, f.params)); };
+    }, key_switching);
+    add("rlwe.automorphism", false, switch_words, [](const Fixture& f) -> Op {
+        uint64 galois_elt = operations::galois_element_for_rotation(1, f.params.n);
+        return [&f, galois_elt]() { keep(operations::apply_galois_rlwe(f.rlwe_ct1, galois_elt, f.galois_keys, f.params)); };
+    }, key_switching);
+    add("rlwe.rotate_rows", false, switch_words, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::rotate_rows_rlwe(f.rlwe_ct1, 3, f.galois_keys, f.params)); };
+    }, key_switching);
+    // One gadget decomposition shared by four rotations
+    add("rlwe.rotate_rows.hoisted.4", false, [=](const Fixture& f) { return 4 * switch_words(f); }, [](const Fixture& f) -> Op {
+        auto steps = std::make_shared<std::vector<int>>(std::vector<int>{1, 2, 3, 4});
+        return [&f, steps]() { keep(operations::rotate_rows_hoisted(f.rlwe_ct1, *steps, f.galois_keys, f.params)); };
+    }, key_switching);
+    add("rlwe.pack_lwe.16", false,
+        [=](const Fixture& f) { return PACK_COUNT * (f.params.n + 1) + f.pack_keys.keys.size() * switch_words(f); },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(operations::pack_lwe_rlwe(f.pack_inputs, f.pack_keys, f.pack_params, 1)); };
+        }, key_switching);
+
+    // ---- RNS BFV and CKKS ----
+    // Words: operands, output and relinearisation key over the Q and P primes
+    add("rns.rlwe.multiply", false, [=](const Fixture& f) { return rns_words(f, f.rns_params); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::multiply_rlwe_rns(f.rns_ct1, f.rns_ct2, f.rns_relin, f.rns_params)); };
+    }, rns_ready);
+    add("rns.rlwe.mod_switch", false, [](const Fixture& f) { return 4 * RNS_PRIMES * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::mod_switch_to_level_rlwe_rns(f.rns_ct1, 0, f.rns_params)); };
+    }, rns_ready);
+    add("ckks.encode", false, [](const Fixture& f) { return f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(encoding::encode_ckks(f.ckks_values, f.ckks_scale, f.ckks_encoder)); };
+    }, rns_ready);
+    add("ckks.add", false, [](const Fixture& f) { return 6 * RNS_PRIMES * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::add_ckks(f.ckks_ct1, f.ckks_ct2, f.ckks_params)); };
+    }, rns_ready);
+    add("ckks.multiply", false, [=](const Fixture& f) { return rns_words(f, f.ckks_params); }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::multiply_ckks(f.ckks_ct1, f.ckks_ct2, f.ckks_relin, f.ckks_params)); };
+    }, rns_ready);
+    add("ckks.mod_drop", false, [](const Fixture& f) { return 4 * RNS_PRIMES * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::mod_drop_ckks(f.ckks_ct1, 0, f.ckks_params)); };
+    }, rns_ready);
+
+    // ---- GLWE homomorphic ----
+    add("glwe.add", true, [](const Fixture& f) { return 3 * (f.k + 1) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::add_glwe(f.glwe_ct1, f.glwe_ct2, f.params)); };
+    });
+    add("glwe.subtract", true, [](const Fixture& f) { return 3 * (f.k + 1) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::subtract_glwe(f.glwe_ct1, f.glwe_ct2, f.params)); };
+    });
+    add("glwe.scalar_multiply", true, [](const Fixture& f) { return 2 * (f.k + 1) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::scalar_multiply_glwe(f.glwe_ct1, 3, f.params)); };
+    });
+    add("glwe.add_plain", true, [](const Fixture& f) { return (2 * f.k + 3) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::add_plain_glwe(f.glwe_ct1, f.message, f.params)); };
+    });
+    add("glwe.sub_plain", true, [](const Fixture& f) { return (2 * f.k + 3) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::sub_plain_glwe(f.glwe_ct1, f.message, f.params)); };
+    });
+    add("glwe.multiply_plain", true, [](const Fixture& f) { return (2 * f.k + 3) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::multiply_plain_glwe(f.glwe_ct1, f.message, f.params)); };
+    }, exact_products);
+    add("glwe.multiply_plain_prepared", true, [](const Fixture& f) { return (2 * f.k + 4) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(operations::multiply_plain_glwe(f.glwe_ct1, f.prepared, f.params)); };
+        }, exact_products);
+    add("glwe.multiply_plain_accumulate.8", true, [](const Fixture& f) { return (8 * (f.k + 3) + f.k + 1) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            auto cts = std::make_shared<std::vector<schemes::GLWECiphertext>>(8, f.glwe_ct1);
+            auto plains = std::make_shared<std::vector<operations::PreparedPlaintext>>(8, f.prepared);
+            return [&f, cts, plains]() { keep(operations::multiply_plain_accumulate_glwe(*cts, *plains, f.params)); };
+        }, exact_products);
+    add("glwe.modulus_switch", true, [](const Fixture& f) { return 2 * (f.k + 1) * f.params.n; }, [](const Fixture& f) -> Op {
+        return [&f]() { keep(operations::modulus_switch_glwe(f.glwe_ct1, f.params, f.q_switched)); };
+    });
+    add("glwe.key_switch", true,
+        [](const Fixture& f) { return (2 * f.k + 2 + f.k * (f.k + 1) * static_cast<std::size_t>(f.glwe_ksk.levels)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            return [&f]() { keep(operations::key_switch_glwe(f.glwe_ct1, f.glwe_ksk, f.params)); };
+        }, key_switching);
+    add("glwe.automorphism", true,
+        [](const Fixture& f) { return (2 * f.k + 2 + f.k * (f.k + 1) * static_cast<std::size_t>(f.glwe_ksk.levels)) * f.params.n; },
+        [](const Fixture& f) -> Op {
+            uint64 galois_elt = operations::galois_element_for_rotation(1, f.params.n);
+            return [&f, galois_elt]() {
+                keep(operations::apply_galois_glwe(f.glwe_ct1, galois_elt, f.glwe_galois_keys, f.params));
+            };
+        }, key_switching);
+
+    // ---- Gate bootstrapping ----
+    // Words: the bootstrapping and key switching keys dominate
+    auto gate_words = [](const Fixture& f) {
+        return f.gates->key.bsk.total_words() + f.gates->key.ksk.total_words();
+    };
+    add_suite("gate", "gate.nand", 1, false, gate_words, [](const Fixture& f) -> Op {
+        const GateFixture& g = *f.gates;
+        return [&g]() { keep(operations::evaluate_gate(operations::Gate::NAND, g.a, g.b, g.view)); };
+    });
+    add_suite("gate", "gate.xor", 1, false, gate_words, [](const Fixture& f) -> Op {
+        const GateFixture& g = *f.gates;
+        return [&g]() { keep(operations::evaluate_gate(operations::Gate::XOR, g.a, g.b, g.view)); };
+    });
+    add_suite("gate", "gate.mux", 1, false, [=](const Fixture& f) { return 2 * gate_words(f); }, [](const Fixture& f) -> Op {
+        const GateFixture& g = *f.gates;
+        return [&g]() { keep(operations::gate_mux(g.select, g.a, g.b, g.view)); };
+    });
+    add_suite("gate", "gate.nand.batch", GATE_BATCH, true, [=](const Fixture& f) { return GATE_BATCH * gate_words(f); },
+        [](const Fixture& f) -> Op {
+            const GateFixture& g = *f.gates;
+            std::size_t threads = f.pool_threads;
+            return [&g, threads]() {
+                keep(operations::evaluate_gates(operations::Gate::NAND, g.batch_a, g.batch_b, g.view, threads));
+            };
+        });
+
+    // ---- Multi-value bootstrapping ----
+    auto lut_words = [](const Fixture& f) {
+        return f.luts->key.bsk.total_words() + f.luts->key.ksk.total_words();
+    };
+    add_suite("lut", "lut.bootstrap", 1, false, lut_words, [](const Fixture& f) -> Op {
+        const LutFixture& l = *f.luts;
+        auto table = std::make_shared<std::vector<std::vector<int64>>>(1, l.tables[0]);
+        return [&l, table]() {
+            keep(operations::multi_value_bootstrap_lwe(l.ct, *table, l.key.bsk.view(), l.key.ksk.view(),
+                                                       l.lwe_params, l.glwe_params));
+        };
+    });
+    add_suite("lut", "lut.multi_value.4", 4, false, lut_words, [](const Fixture& f) -> Op {
+        const LutFixture& l = *f.luts;
+        return [&l]() {
+            keep(operations::multi_value_bootstrap_lwe(l.ct, l.tables, l.key.bsk.view(), l.key.ksk.view(),
+                                                       l.lwe_params, l.glwe_params));
+        };
+    });
+
+    return list;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Smallest power-of-two iteration count whose single-threaded run takes at least min_time
+std::size_t calibrate(const Op& op, double min_time) {
+    op();
+    std::size_t iterations = 1;
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) op();
+        if (seconds_since(start) >= min_time || iterations >= (std::size_t(1) << 30)) return iterations;
+        iterations *= 2;
+    }
+}
+
+// Runs `iterations` calls on each of `threads` threads (a single one for pooled
+// benchmarks), released together after every thread has built its state and
+// made one warm-up call
+Measurement measure(const Benchmark& bench, const Fixture& fixture, std::size_t threads, std::size_t iterations) {
+    fixture.pool_threads = threads;
+    std::size_t copies = bench.pooled ? 1 : threads;
+    std::atomic<std::size_t> ready(0);
+    std::atomic<bool> go(false);
+    std::mutex stats_mutex;
+    uint64 pool_allocations = 0;
+    uint64 global_allocations = 0;
+    std::exception_ptr error;
+
+    std::vector<std::thread> workers;
+    for (std::size_t w = 0; w < copies; ++w) {
+        workers.emplace_back([&]() {
+            Op op;
+            try {
+                op = bench.make(fixture);
+                op();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                if (!error) error = std::current_exception();
+            }
+            core::reset_pool_stats();
+            ++ready;
+            while (!go.load()) std::this_thread::yield();
+            if (!op) return;
+
+            try {
+                for (std::size_t i = 0; i < iterations; ++i) op();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                if (!error) error = std::current_exception();
+            }
+            core::PoolStats stats = core::pool_stats();
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            pool_allocations += stats.allocations;
+            global_allocations += stats.global_allocations;
+        });
+    }
+
+    while (ready.load() < copies) std::this_thread::yield();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true);
+    for (std::thread& worker : workers) worker.join();
+    double elapsed = seconds_since(start);
+
+    if (error) std::rethrow_exception(error);
+
+    double total_ops = static_cast<double>(iterations) * static_cast<double>(copies);
+    Measurement m;
+    m.iterations = iterations;
+    m.ns_per_op = elapsed * 1e9 / static_cast<double>(iterations);
+    m.ops_per_sec = total_ops / elapsed;
+    m.pool_allocations_per_op = static_cast<double>(pool_allocations) / total_ops;
+    m.global_allocations_per_op = static_cast<double>(global_allocations) / total_ops;
+    return m;
+}
+
+std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+struct Row {
+    std::string name;
+    std::size_t n;
+    std::size_t q_bits;
+    int64 q;
+    std::size_t k;          // 0 when the benchmark does not depend on k
+    std::size_t threads;
+    std::size_t bytes_per_op;
+    std::string unit;       // "gates" or "luts" in the bootstrapping suites
+    std::size_t outputs;
+    Measurement m;
+
+    double outputs_per_sec_per_core() const {
+        return m.ops_per_sec * static_cast<double>(outputs) / static_cast<double>(threads);
+    }
+};
+
+void write_json(std::ostream& out, const Options& options, const std::vector<Row>& rows) {
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"library\": \"turinged\",\n";
+    out << "  \"version\": \"" << VERSION << "\",\n";
+    out << "  \"hardware_threads\": " << core::default_thread_count() << ",\n";
+    out << "  \"min_time_s\": " << options.min_time << ",\n";
+    out << "  \"t\": " << options.t << ",\n";
+    out << "  \"beta\": " << (static_cast<int64>(1) << options.beta_bits) << ",\n";
+    out << "  \"levels\": " << options.levels << ",\n";
+    out << "  \"results\": [";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const Row& r = rows[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << json_escape(r.name) << "\", \"n\": " << r.n
+            << ", \"q\": " << r.q << ", \"q_bits\": " << r.q_bits;
+        if (r.k > 0) out << ", \"k\": " << r.k;
+        out << ", \"threads\": " << r.threads
+            << ", \"iterations\": " << r.m.iterations
+            << ", \"ns_per_op\": " << r.m.ns_per_op
+            << ", \"ops_per_sec\": " << r.m.ops_per_sec
+            << ", \"bytes_per_op\": " << r.bytes_per_op;
+        if (r.outputs > 0) out << ", \"" << r.unit << "_per_sec_per_core\": " << r.outputs_per_sec_per_core();
+        out
+            << ", \"pool_allocations_per_op\": " << r.m.pool_allocations_per_op
+            << ", \"global_allocations_per_op\": " << r.m.global_allocations_per_op << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void print_row(std::ostream& out, const Row& r) {
+    std::ostringstream label;
+    label << r.name << " n=" << r.n << " q=2^" << r.q_bits;
+    if (r.k > 0) label << " k=" << r.k;
+    label << " threads=" << r.threads;
+
+    out << std::left << std::setw(66) << label.str() << std::right << std::fixed << std::setprecision(1)
+        << std::setw(14) << r.m.ns_per_op << " ns/op"
+        << std::setw(14) << r.m.ops_per_sec << " ops/s"
+        << std::setw(12) << r.bytes_per_op << " B/op"
+        << std::setprecision(2) << std::setw(8) << r.m.global_allocations_per_op << " mallocs/op";
+    if (r.outputs > 0) out << std::setprecision(1) << std::setw(10) << r.outputs_per_sec_per_core() << " " << r.unit << "/s/core";
+    out << std::endl;
+    out.unsetf(std::ios::fixed);
+}
+
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options = parse_options(argc, argv);
+        std::vector<Benchmark> benchmarks = make_benchmarks();
+
+        std::vector<const Benchmark*> selected;
+        bool any_k = false;
+        bool any_ring = false;
+        bool any_gate = false;
+        bool any_lut = false;
+        for (const Benchmark& bench : benchmarks) {
+            if (bench.name.find(options.filter) == std::string::npos) continue;
+            selected.push_back(&bench);
+            if (!bench.suite.empty()) {
+                any_gate = any_gate || bench.suite == "gate";
+                any_lut = any_lut || bench.suite == "lut";
+                continue;
+            }
+            any_k = any_k || bench.uses_k;
+            any_ring = any_ring || !bench.uses_k;
+        }
+
+        if (options.list) {
+            for (const Benchmark* bench : selected) std::cout << bench->name << std::endl;
+            return 0;
+        }
+
+        // The table goes to stderr when the JSON report takes stdout
+        std::ostream& log = options.json == "-" ? std::cerr : std::cout;
+        std::vector<Row> rows;
+
+        auto run = [&](const Benchmark& bench, const Fixture& fixture, std::size_t q_bits) {
+            std::size_t iterations = calibrate(bench.make(fixture), options.min_time);
+            for (std::size_t threads : options.threads) {
+                Row row;
+                row.name = bench.name;
+                row.n = fixture.params.n;
+                row.q_bits = q_bits;
+                row.q = fixture.params.q;
+                row.k = fixture.k;
+                row.threads = threads;
+                row.bytes_per_op = 8 * bench.words(fixture);
+                row.unit = bench.suite == "gate" ? "gates" : "luts";
+                row.outputs = bench.outputs;
+                row.m = measure(bench, fixture, threads, iterations);
+                print_row(log, row);
+                rows.push_back(row);
+            }
+        };
+
+        for (std::size_t n : options.n) {
+            for (std::size_t q_bits : options.q_bits) {
+                int64 q = static_cast<int64>(1) << q_bits;
+                Parameters params(n, q, options.t, 8);
+
+                // One fixture without a GLWE key for the k-independent benchmarks,
+                // then one per swept k
+                std::vector<std::size_t> ks;
+                if (any_ring) ks.push_back(0);
+                if (any_k) ks.insert(ks.end(), options.k.begin(), options.k.end());
+
+                for (std::size_t k : ks) {
+                    std::unique_ptr<Fixture> fixture = make_fixture(params, k, k == 0, options);
+
+                    for (const Benchmark* bench : selected) {
+                        if (!bench->suite.empty() || bench->uses_k != (k > 0) || !bench->supported(*fixture)) continue;
+                        run(*bench, *fixture, q_bits);
+                    }
+                }
+            }
+        }
+
+        // Bootstrapping suites, one fixture each
+        for (const std::string& suite : {std::string("gate"), std::string("lut")}) {
+            if ((suite == "gate" && !any_gate) || (suite == "lut" && !any_lut)) continue;
+            std::unique_ptr<Fixture> fixture = suite == "gate" ? make_gate_fixture() : make_lut_fixture();
+            const keys::GateBootstrappingParameters& gp = suite == "gate" ? fixture->gates->params : fixture->luts->params;
+            print_suite_parameters(log, suite, gp);
+
+            std::size_t q_bits = static_cast<std::size_t>(std::log2(static_cast<double>(gp.q)));
+            for (const Benchmark* bench : selected) {
+                if (bench->suite == suite) run(*bench, *fixture, q_bits);
+            }
+        }
+
+        if (options.json == "-") {
+            write_json(std::cout, options, rows);
+        } else if (!options.json.empty()) {
+            std::ofstream file(options.json);
+            if (!file) throw std::runtime_error("Cannot open " + options.json);
+            write_json(file, options, rows);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "turinged_bench: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
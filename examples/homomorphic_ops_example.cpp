@@ -1,3 +1,4 @@
+#include <cmath>
 #include <iostream>
 #include "turinged/turinged.hpp"
 
@@ -103,11 +104,53 @@ void test_rlwe_homomorphic_ops() {
     std::cout << "Scalar multiplication: " << (scalar_correct ? "PASS" : "FAIL") << std::endl;
 }
 
+void test_rlwe_multiplication() {
+    std::cout << "\n=== RLWE Multiplication ===" << std::endl;
+
+    // Fastest 128-bit parameters for one multiplication with t = 257
+    params::Requirements req;
+    req.t = 257;
+    req.depth = 1;
+    params::ParameterSet set = params::select_parameters(req);
+
+    Parameters params = set.params;
+    std::size_t n = params.n;
+    int64 t = params.t;
+    int64 beta = set.beta;
+    std::cout << "Selected: n=" << n << ", log2 q=" << std::log2(static_cast<double>(params.q))
+              << ", noise_bound=" << params.noise_bound << ", beta=" << beta
+              << ", ~" << static_cast<int>(set.security_bits) << "-bit security" << std::endl;
+
+    // Key generation
+    auto sk = keys::generate_rlwe_secret_key(n);
+    auto rlk = keys::generate_rlwe_relin_key(sk, params, beta);
+
+    // m1 is an arbitrary polynomial, m2 = 2 + X
+    Polynomial m1(n), m2(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        m1[i] = (3 * i + 1) % t;
+    }
+    m2[0] = 2;
+    m2[1] = 1;
+
+    auto ct1 = schemes::encrypt_rlwe(m1, sk, params);
+    auto ct2 = schemes::encrypt_rlwe(m2, sk, params);
+
+    // Homomorphic multiplication with relinearisation
+    auto ct_mul = operations::multiply_rlwe(ct1, ct2, rlk, params);
+    Polynomial result_mul = schemes::decrypt_rlwe(ct_mul, sk, params);
+
+    Polynomial expected = polynomial::negacyclic_multiply(m1, m2, t);
+    bool mul_correct = polynomial::is_equal(result_mul, expected);
+    std::cout << "Homomorphic multiplication: " << (mul_correct ? "PASS" : "FAIL") << std::endl;
+}
+
 int main() {
     std::cout << "Turinged Homomorphic Operations Example" << std::endl;
 
     test_lwe_homomorphic_ops();
     test_rlwe_homomorphic_ops();
+    test_rlwe_multiplication();
 
     return 0;
 }
\ No newline at end of file
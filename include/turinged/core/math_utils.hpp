@@ -11,5 +11,41 @@ int64 center_rep(int64 x, int64 q);
 
 int64 dot_product_modq(const std::vector<int64>& a, const std::vector<int64>& b, int64 q);
 
+int64 dot_product_modq(const int64* a, const int64* b, std::size_t n, int64 q);
+
+// Rescale x in [0, q) to round(x * q_new / q) mod q_new
+int64 switch_modulus(int64 x, int64 q, int64 q_new);
+
+// Batch modulus switch over a contiguous buffer; power-of-two moduli take a shift-only path
+void switch_modulus_inplace(int64* data, std::size_t count, int64 q, int64 q_new);
+
+bool is_power_of_two(uint64 x);
+
+// The low `bits` bits of x in reverse order
+std::size_t bit_reverse(std::size_t x, int bits);
+
+// Modular arithmetic for moduli below 2^63
+uint64 mul_mod(uint64 a, uint64 b, uint64 p);
+
+uint64 pow_mod(uint64 base, uint64 exp, uint64 p);
+
+// Deterministic Miller-Rabin for 64-bit inputs
+bool is_prime(uint64 n);
+
+// Inverse of a modulo m (gcd(a, m) must be 1)
+int64 inverse_mod(int64 a, int64 m);
+
+// Reduce a 128-bit value into [0, q)
+int64 mod_int128(int128 x, int64 q);
+
+// round(x * num / den) computed exactly without overflowing x * num
+int128 scale_round(int128 x, int64 num, int64 den);
+
+// Number of base-beta digits needed to represent values in [0, q)
+int gadget_levels(int64 q, int64 beta);
+
+// Independent 64-bit seed for sub-stream `index` of `seed` (SplitMix64 mixing)
+uint64 derive_seed(uint64 seed, uint64 index);
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "types.hpp"
+#include "trace.hpp"
+#include <array>
+#include <ostream>
+#include <string>
+
+namespace turinged {
+namespace core {
+
+// Opt-in instrumentation, compiled in with -DTURINGED_METRICS (CMake option
+// TURINGED_ENABLE_METRICS). Every schemes:: and operations:: entry point then
+// records its call count, latency histogram, pool bytes allocated and the
+// polynomial multiplies and NTTs it ran, under its qualified name; public-key
+// overloads are recorded as "<name>/pk". Counts are inclusive of nested calls,
+// except that a function delegating to an overload with the same name is
+// recorded once. Without the flag the macros below expand to nothing and the
+// snapshot is empty. TURINGED_OPERATION_SCOPE also emits a trace event when
+// tracing is compiled in (see trace.hpp).
+
+// Log-linear latency histogram in nanoseconds: values below 32 are exact, above
+// that each power of two is split into 16 buckets (at most 1/16 relative error)
+constexpr std::size_t HISTOGRAM_SUB_BUCKETS = 16;
+constexpr std::size_t HISTOGRAM_BUCKETS = 61 * HISTOGRAM_SUB_BUCKETS;
+
+struct LatencyHistogram {
+    std::array<uint64, HISTOGRAM_BUCKETS> counts;
+    uint64 count;
+    uint64 total_ns;
+    uint64 min_ns;
+    uint64 max_ns;
+
+    LatencyHistogram() : counts(), count(0), total_ns(0), min_ns(0), max_ns(0) {}
+
+    static std::size_t bucket(uint64 ns);
+    // Largest value that falls into bucket b
+    static uint64 bucket_upper(std::size_t b);
+
+    void record(uint64 ns);
+    void merge(const LatencyHistogram& other);
+    // Upper bound of the bucket holding the p-th percentile (p in [0, 100])
+    uint64 percentile(double p) const;
+};
+
+struct OperationMetrics {
+    std::string name;
+    uint64 calls;
+    LatencyHistogram latency;
+    uint64 pool_allocations;
+    uint64 pool_bytes;
+    uint64 poly_multiplies;         // NTT-domain or schoolbook products of one polynomial pair
+    uint64 ntt_forward;             // length-n transforms, one per prime
+    uint64 ntt_inverse;
+};
+
+struct MetricsSnapshot {
+    std::vector<OperationMetrics> operations;   // called at least once, by name
+};
+
+constexpr bool metrics_enabled() {
+#ifdef TURINGED_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+MetricsSnapshot metrics_snapshot();
+
+void reset_metrics();
+
+// One JSON object per operation, percentiles in nanoseconds
+void write_metrics_json(std::ostream& out, const MetricsSnapshot& snapshot);
+
+#ifdef TURINGED_METRICS
+
+// Per-thread event counts, bumped by the polynomial kernels
+struct ThreadMetricCounters {
+    uint64 poly_multiplies;
+    uint64 ntt_forward;
+    uint64 ntt_inverse;
+};
+
+extern thread_local ThreadMetricCounters thread_metric_counters;
+
+struct OperationSite;
+
+OperationSite* register_operation(const char* name);
+
+class OperationScope {
+public:
+    explicit OperationScope(OperationSite* site);
+    ~OperationScope();
+
+    OperationScope(const OperationScope&) = delete;
+    OperationScope& operator=(const OperationScope&) = delete;
+
+private:
+    OperationSite* site_;
+    OperationSite* parent_;
+    uint64 start_ns_;
+    uint64 allocations_;
+    uint64 bytes_;
+    ThreadMetricCounters counters_;
+};
+
+#define TURINGED_METRICS_SCOPE(name) \
+    static ::turinged::core::OperationSite* const turinged_metrics_site = ::turinged::core::register_operation(name); \
+    ::turinged::core::OperationScope turinged_metrics_scope(turinged_metrics_site)
+
+#define TURINGED_METRICS_COUNT(counter) (++::turinged::core::thread_metric_counters.counter)
+
+#else
+
+#define TURINGED_METRICS_SCOPE(name) ((void)0)
+#define TURINGED_METRICS_COUNT(counter) ((void)0)
+
+#endif
+
+// Placed first in every instrumented entry point
+#define TURINGED_OPERATION_SCOPE(name) \
+    TURINGED_METRICS_SCOPE(name); \
+    TURINGED_TRACE_SCOPE(name)
+
+}
+}
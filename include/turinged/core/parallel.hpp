@@ -0,0 +1,20 @@
+#pragma once
+
+#include "types.hpp"
+#include <functional>
+
+namespace turinged {
+namespace core {
+
+// Hardware concurrency, at least 1
+std::size_t default_thread_count();
+
+// Runs fn(i) for every i in [0, count) on up to num_threads threads
+// (0 = default_thread_count()). The first exception thrown is rethrown.
+// The calling thread takes part; the others come from a process-wide set of
+// workers that is started on first use and kept, so each worker's pool
+// allocator cache (pool_allocator.hpp) is reused from one call to the next.
+void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn, std::size_t num_threads = 0);
+
+}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace turinged {
+namespace core {
+
+// Per-thread pool for coefficient buffers. Requests are rounded up to a
+// power-of-two size class (64 B .. 64 MiB) and every block is 64-byte aligned.
+// Freed blocks go onto the freeing thread's list for their class and are
+// handed out again without touching the global allocator; larger requests,
+// and blocks freed once a thread caches POOL_CACHE_LIMIT bytes, go straight
+// to the global allocator. Blocks may be freed on any thread.
+constexpr std::size_t POOL_ALIGNMENT = 64;
+constexpr std::size_t POOL_MIN_CLASS_BITS = 6;
+constexpr std::size_t POOL_MAX_CLASS_BITS = 26;
+constexpr std::size_t POOL_CACHE_LIMIT = std::size_t(64) << 20;
+
+// Counters for the calling thread since it started (or the last reset)
+struct PoolStats {
+    std::uint64_t allocations;          // all pool_allocate calls
+    std::uint64_t bytes_allocated;      // bytes requested by those calls
+    std::uint64_t reused;               // served from the free lists
+    std::uint64_t global_allocations;   // calls into the global allocator
+    std::uint64_t global_frees;
+    std::size_t bytes_cached;           // held on the free lists right now
+};
+
+void* pool_allocate(std::size_t bytes);
+
+void pool_deallocate(void* p, std::size_t bytes);
+
+PoolStats pool_stats();
+
+void reset_pool_stats();
+
+// Returns the calling thread's cached blocks to the global allocator
+void release_pool();
+
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(pool_allocate(n * sizeof(T))); }
+    void deallocate(T* p, std::size_t n) noexcept { pool_deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
+
+template <typename T>
+using PooledVector = std::vector<T, PoolAllocator<T>>;
+
+}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "types.hpp"
+#include <ostream>
+#include <string>
+
+namespace turinged {
+namespace core {
+
+// Opt-in timeline tracing, compiled in with -DTURINGED_TRACE (CMake option
+// TURINGED_ENABLE_TRACING). Between start_tracing() and stop_tracing(), every
+// schemes:: / operations:: entry point, polynomial transform, GLev level, GGSW
+// row, parallel_for worker and streaming pipeline stage appends a complete
+// event to its thread's ring buffer; once a buffer is full the oldest events
+// are overwritten. write_chrome_trace() dumps all buffers as Chrome Trace Event
+// JSON for chrome://tracing or ui.perfetto.dev. Without the flag the macros
+// below expand to nothing and the dump holds no events.
+
+constexpr std::size_t TRACE_DEFAULT_CAPACITY = std::size_t(1) << 16;
+
+constexpr bool tracing_enabled() {
+#ifdef TURINGED_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Clears every buffer and starts recording, keeping the last
+// events_per_thread events of each thread
+void start_tracing(std::size_t events_per_thread = TRACE_DEFAULT_CAPACITY);
+
+void stop_tracing();
+
+bool tracing_active();
+
+// Label for the calling thread in the trace (default "thread <id>")
+void set_trace_thread_name(const std::string& name);
+
+// Call once tracing has stopped or the traced threads are idle
+void write_chrome_trace(std::ostream& out);
+
+#ifdef TURINGED_TRACE
+
+// Records [construction, destruction) as one event. name must be a string
+// literal (only the pointer is stored); arg_name/arg, if given, end up in the
+// event's args. A scope directly inside one of the same name (an overload
+// delegating to another) records nothing.
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* arg_name = nullptr, int64 arg = 0);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    const char* parent_;
+    const char* arg_name_;
+    int64 arg_;
+    uint64 start_ns_;
+};
+
+#define TURINGED_TRACE_CONCAT_INNER(a, b) a##b
+#define TURINGED_TRACE_CONCAT(a, b) TURINGED_TRACE_CONCAT_INNER(a, b)
+
+#define TURINGED_TRACE_SCOPE(name) \
+    ::turinged::core::TraceScope TURINGED_TRACE_CONCAT(turinged_trace_scope_, __LINE__)(name)
+
+#define TURINGED_TRACE_SCOPE_ARG(name, arg_name, arg) \
+    ::turinged::core::TraceScope TURINGED_TRACE_CONCAT(turinged_trace_scope_, __LINE__)( \
+        name, arg_name, static_cast<::turinged::int64>(arg))
+
+#else
+
+#define TURINGED_TRACE_SCOPE(name) ((void)0)
+#define TURINGED_TRACE_SCOPE_ARG(name, arg_name, arg) ((void)0)
+
+#endif
+
+}
+}
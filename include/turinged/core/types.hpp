@@ -1,5 +1,6 @@
 #pragma once
 
+#include "pool_allocator.hpp"
 #include <vector>
 #include <cstdint>
 
@@ -8,8 +9,10 @@ namespace turinged {
 using int64 = std::int64_t;
 using uint64 = std::uint64_t;
 using int128 = __int128;
+using uint128 = unsigned __int128;
 
-using Polynomial = std::vector<int64>;
+// Coefficient buffers come from the calling thread's pool (see pool_allocator.hpp)
+using Polynomial = core::PooledVector<int64>;
 
 struct Parameters {
     std::size_t n;          // polynomial degree
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/polynomial/ntt.hpp"
+
+namespace turinged {
+namespace encoding {
+
+// CRT slot encoder for a prime plaintext modulus t = 1 (mod 2n). The n slots are
+// the evaluations of the plaintext at the primitive 2n-th roots of unity mod t,
+// so ciphertext addition and multiplication act slot-wise.
+//
+// Slots form a 2 x (n/2) matrix: slot i of row 0 sits at root psi^(3^i) and
+// slot i of row 1 at psi^(-3^i). Galois element 3 rotates both rows, 2n - 1 swaps them.
+struct BatchEncoder {
+    std::size_t n;
+    int64 t;
+    std::shared_ptr<const polynomial::NTTTables> tables;
+    std::vector<std::size_t> slot_index;    // slot -> position in NTT output
+
+    BatchEncoder() : n(0), t(0) {}
+};
+
+BatchEncoder create_batch_encoder(const Parameters& params);
+
+// Missing trailing slots are zero; values are reduced mod t
+Polynomial encode_batch(const std::vector<int64>& slots, const BatchEncoder& encoder);
+
+std::vector<int64> decode_batch(const Polynomial& plain, const BatchEncoder& encoder);
+
+}
+}
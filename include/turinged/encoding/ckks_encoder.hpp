@@ -0,0 +1,42 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include <complex>
+
+namespace turinged {
+namespace encoding {
+
+// Canonical-embedding encoder for approximate (CKKS) arithmetic. The n/2 complex
+// slots are the evaluations of the plaintext at the primitive 2n-th roots
+// zeta^(5^j), j < n/2 (their conjugates are implied), so polynomial products
+// act slot-wise. Encoding multiplies by a scale and rounds to integers.
+struct CKKSEncoder {
+    std::size_t n;
+    std::vector<std::complex<double>> roots;    // zeta^j = exp(2*pi*i*j / 2n), j < 2n
+    std::vector<std::size_t> rot_group;         // 5^j mod 2n, j < n/2
+
+    CKKSEncoder() : n(0) {}
+
+    std::size_t slot_count() const { return n / 2; }
+};
+
+// Integer plaintext polynomial carrying its scale
+struct CKKSPlaintext {
+    Polynomial coeffs;
+    double scale;
+
+    CKKSPlaintext() : scale(1.0) {}
+};
+
+CKKSEncoder create_ckks_encoder(std::size_t n);
+
+// Missing trailing slots are zero; |value * scale| must stay below 2^62
+CKKSPlaintext encode_ckks(const std::vector<std::complex<double>>& values, double scale, const CKKSEncoder& encoder);
+
+CKKSPlaintext encode_ckks(const std::vector<double>& values, double scale, const CKKSEncoder& encoder);
+
+// Slots of a (centered, decrypted) coefficient vector at the given scale
+std::vector<std::complex<double>> decode_ckks(const std::vector<long double>& coeffs, double scale, const CKKSEncoder& encoder);
+
+}
+}
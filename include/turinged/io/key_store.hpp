@@ -0,0 +1,61 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/io/serialization.hpp"
+#include <memory>
+#include <string>
+
+namespace turinged {
+namespace io {
+
+// Key file laid out exactly like the in-memory key, for zero-copy loading.
+// A 4 KiB header page holds native-endian 64-bit words:
+//   magic "TRGDKMAP", version, object type, byte-order mark,
+//   n, q, t, noise_bound, layout fields (6 words), data offset, data words,
+//   CRC-32 of the data
+// followed at the page-aligned data offset by the key's words verbatim
+// (transform-domain when the key is). Files are only readable on machines
+// with the writer's byte order.
+constexpr uint64 MAPPED_KEY_MAGIC = 0x50414d4b44475254ULL;     // "TRGDKMAP"
+constexpr uint64 MAPPED_KEY_VERSION = 1;
+constexpr std::size_t MAPPED_KEY_HEADER_BYTES = 4096;
+
+void write_mapped_key(const std::string& path, const keys::BootstrappingKey& key, const Parameters& params);
+
+void write_mapped_key(const std::string& path, const keys::LWEKeySwitchKey& key, const Parameters& params);
+
+// Read-only shared mapping of a key file. Opening only validates the header
+// page, so start-up cost does not grow with the key; pages are faulted in on
+// first use and shared with every other process mapping the same file. Views
+// point into the mapping and must not outlive the store (or its copies, which
+// share the mapping).
+class KeyStore {
+public:
+    explicit KeyStore(const std::string& path);
+
+    ObjectType type() const { return type_; }
+    Parameters parameters() const { return params_; }
+    std::size_t size_bytes() const;
+
+    // Throw if the file holds a different key type
+    keys::BootstrappingKeyView bootstrapping_key() const;
+    keys::LWEKeySwitchKeyView lwe_key_switch_key() const;
+
+    // Checks the stored data checksum; touches every page, so opt-in
+    bool verify() const;
+
+private:
+    struct Mapping;
+
+    std::shared_ptr<const Mapping> mapping_;
+    ObjectType type_;
+    Parameters params_;
+    uint64 layout_[6];
+    uint64 data_offset_;
+    uint64 data_words_;
+    uint64 checksum_;
+};
+
+}
+}
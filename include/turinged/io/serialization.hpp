@@ -0,0 +1,214 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/schemes/lwe.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+#include "turinged/schemes/glev.hpp"
+#include "turinged/schemes/ggsw.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+namespace turinged {
+namespace io {
+
+// Binary object format, all fields little-endian and bit-packed back to back:
+//   magic "TRGD" (32) | version (16) | object type (16) |
+//   n (64) | q (64) | t (64) | noise_bound (64) | coeff_bits (8) |
+//   object body | zero padding to a byte | CRC-32 of everything before it (32)
+// Coefficients mod q take coeff_bits = ceil(log2 q) bits each. RNS objects
+// record q = 0 and pack residues at the width of their largest prime.
+// LWE objects carry their dimension as a length field of their own and are
+// not tied to the header's n, which holds the ring degree they came from
+// (sample extraction from a k-polynomial GLWE gives dimension k*n).
+constexpr uint32_t FORMAT_MAGIC = 0x44475254;      // "TRGD"
+constexpr uint16_t FORMAT_VERSION = 1;
+
+enum class ObjectType : uint16_t {
+    LWECiphertext = 1,
+    RLWECiphertext = 2,
+    GLWECiphertext = 3,
+    GLevCiphertext = 4,
+    GGSWCiphertext = 5,
+    LWESecretKey = 16,
+    RLWESecretKey = 17,
+    GLWESecretKey = 18,
+    LWEPublicKey = 19,
+    RLWEPublicKey = 20,
+    GLWEPublicKey = 21,
+    RLWEKeySwitchKey = 22,
+    GLWEKeySwitchKey = 23,
+    RLWEGaloisKeys = 24,
+    GLWEGaloisKeys = 25,
+    RNSKeySwitchKey = 26,
+    RNSRelinKey = 27,
+    LWEKeySwitchKey = 28,
+    BootstrappingKey = 29,
+    StreamChunk = 40
+};
+
+struct Header {
+    uint16_t version;
+    ObjectType type;
+    std::size_t n;
+    int64 q;
+    int64 t;
+    int64 noise_bound;
+    unsigned coeff_bits;
+
+    // Parameters the object was written with (not meaningful for RNS objects)
+    Parameters parameters() const { return Parameters(n, q, t, noise_bound); }
+};
+
+// Bits needed for values in [0, q)
+unsigned coefficient_bits(int64 q);
+
+// CRC-32 (IEEE) of `len` bytes, continuing from a previous crc (0 to start)
+uint32_t crc32_update(uint32_t crc, const unsigned char* data, std::size_t len);
+
+// a * b for sizes built from untrusted shape fields; throws the format error
+// when the product does not fit in a size_t
+std::size_t checked_product(std::size_t a, std::size_t b);
+
+// Streams one object: the constructor writes the header, finish() the padding
+// and checksum. Values go through a small staging buffer, never a full copy.
+class Writer {
+public:
+    Writer(std::ostream& out, ObjectType type, std::size_t n, int64 q, int64 t, int64 noise_bound, unsigned coeff_bits);
+    Writer(std::ostream& out, ObjectType type, const Parameters& params);
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    void write_bits(uint64 value, unsigned bits);
+    void write_u64(uint64 value) { write_bits(value, 64); }
+
+    // Coefficients reduced mod q, coeff_bits each
+    void write_coefficients(const int64* values, std::size_t count);
+    // Values already below 2^coeff_bits (RNS residues, raw NTT words)
+    void write_packed(const uint64* values, std::size_t count);
+
+    void finish();
+
+    // Bytes handed to the stream so far (all of them after finish())
+    std::size_t bytes_written() const { return bytes_; }
+
+private:
+    void flush();
+
+    std::ostream& out_;
+    int64 q_;
+    unsigned coeff_bits_;
+    uint128 acc_;
+    unsigned acc_bits_;
+    std::array<unsigned char, 4096> buffer_;
+    std::size_t buffer_len_;
+    std::size_t bytes_;
+    uint32_t crc_;
+    bool finished_;
+};
+
+// Reads one object written by Writer, consuming exactly its bytes so objects
+// can be concatenated on a stream. finish() verifies the checksum.
+class Reader {
+public:
+    // Throws if the magic, version or object type do not match
+    Reader(std::istream& in, ObjectType expected);
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    const Header& header() const { return header_; }
+
+    uint64 read_bits(unsigned bits);
+    uint64 read_u64() { return read_bits(64); }
+
+    // Length field of `count` items taking at least min_bits_each bits each.
+    // Throws the format error when they cannot fit in what is left of the
+    // stream, so a corrupt length fails before anything is sized from it.
+    // Streams that cannot report their size (pipes) are only checked as the
+    // items arrive.
+    std::size_t read_length(std::size_t min_bits_each);
+
+    // The same check for a count already read, or derived from several fields
+    std::size_t check_length(uint64 count, std::size_t min_bits_each) const;
+
+    void read_coefficients(int64* values, std::size_t count);
+    void read_packed(uint64* values, std::size_t count);
+
+    void finish();
+
+    std::size_t bytes_read() const { return bytes_; }
+
+private:
+    void fetch(std::size_t bytes);
+    void require(unsigned bits, std::size_t following_bits);
+
+    std::istream& in_;
+    std::size_t available_;     // stream bytes from the object start, SIZE_MAX if unknown
+    Header header_;
+    uint128 acc_;
+    unsigned acc_bits_;
+    std::array<unsigned char, 4096> buffer_;
+    std::size_t buffer_pos_;
+    std::size_t buffer_len_;
+    std::size_t bytes_;
+    uint32_t crc_;
+};
+
+// ========== Ciphertexts ==========
+
+void serialize(std::ostream& out, const schemes::LWECiphertext& ct, const Parameters& params);
+void serialize(std::ostream& out, const schemes::RLWECiphertext& ct, const Parameters& params);
+void serialize(std::ostream& out, const schemes::GLWECiphertext& ct, const Parameters& params);
+void serialize(std::ostream& out, const schemes::GLevCiphertext& ct, const Parameters& params);
+void serialize(std::ostream& out, const schemes::GGSWCiphertext& ct, const Parameters& params);
+
+// The optional header receives the parameters recorded with the object
+schemes::LWECiphertext deserialize_lwe_ciphertext(std::istream& in, Header* header = nullptr);
+schemes::RLWECiphertext deserialize_rlwe_ciphertext(std::istream& in, Header* header = nullptr);
+schemes::GLWECiphertext deserialize_glwe_ciphertext(std::istream& in, Header* header = nullptr);
+schemes::GLevCiphertext deserialize_glev_ciphertext(std::istream& in, Header* header = nullptr);
+schemes::GGSWCiphertext deserialize_ggsw_ciphertext(std::istream& in, Header* header = nullptr);
+
+// ========== Keys ==========
+
+void serialize(std::ostream& out, const keys::LWESecretKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::RLWESecretKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::GLWESecretKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::LWEPublicKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::RLWEPublicKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::GLWEPublicKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::RLWEKeySwitchKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::GLWEKeySwitchKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::RLWEGaloisKeys& keys, const Parameters& params);
+void serialize(std::ostream& out, const keys::GLWEGaloisKeys& keys, const Parameters& params);
+void serialize(std::ostream& out, const keys::LWEKeySwitchKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::BootstrappingKey& key, const Parameters& params);
+void serialize(std::ostream& out, const keys::RNSKeySwitchKey& key, const rns::RNSParameters& params);
+void serialize(std::ostream& out, const keys::RNSRelinKey& key, const rns::RNSParameters& params);
+
+// Opening fields of a BootstrappingKey body, for writers that stream the
+// coefficients (mod q, in layout order) themselves
+void write_bootstrapping_key_shape(Writer& w, const keys::BootstrappingKey& shape);
+
+keys::LWESecretKey deserialize_lwe_secret_key(std::istream& in, Header* header = nullptr);
+keys::RLWESecretKey deserialize_rlwe_secret_key(std::istream& in, Header* header = nullptr);
+keys::GLWESecretKey deserialize_glwe_secret_key(std::istream& in, Header* header = nullptr);
+keys::LWEPublicKey deserialize_lwe_public_key(std::istream& in, Header* header = nullptr);
+keys::RLWEPublicKey deserialize_rlwe_public_key(std::istream& in, Header* header = nullptr);
+keys::GLWEPublicKey deserialize_glwe_public_key(std::istream& in, Header* header = nullptr);
+keys::RLWEKeySwitchKey deserialize_rlwe_key_switch_key(std::istream& in, Header* header = nullptr);
+keys::GLWEKeySwitchKey deserialize_glwe_key_switch_key(std::istream& in, Header* header = nullptr);
+keys::RLWEGaloisKeys deserialize_rlwe_galois_keys(std::istream& in, Header* header = nullptr);
+keys::GLWEGaloisKeys deserialize_glwe_galois_keys(std::istream& in, Header* header = nullptr);
+keys::LWEKeySwitchKey deserialize_lwe_key_switch_key(std::istream& in, Header* header = nullptr);
+keys::BootstrappingKey deserialize_bootstrapping_key(std::istream& in, Header* header = nullptr);
+keys::RNSKeySwitchKey deserialize_rns_key_switch_key(std::istream& in, Header* header = nullptr);
+keys::RNSRelinKey deserialize_rns_relin_key(std::istream& in, Header* header = nullptr);
+
+}
+}
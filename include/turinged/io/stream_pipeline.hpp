@@ -0,0 +1,94 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include <functional>
+#include <iosfwd>
+
+namespace turinged {
+namespace io {
+
+// Streaming RLWE encryption of plaintext records (values in [0, t)), n records
+// per polynomial. The calling thread reads and packs records, a worker pool
+// encrypts batches of polynomials, and a writer thread serializes ciphertexts
+// in input order. All queues are bounded, and so is the number of batches
+// between reading and writing (results waiting on a slow predecessor count),
+// so memory stays flat however long the input is.
+//
+// Output: one StreamChunk object per polynomial (record count followed by the
+// RLWE ciphertext) and a final chunk with a record count of 0.
+
+struct StreamStats {
+    std::size_t records;
+    std::size_t ciphertexts;
+    std::size_t plaintext_bytes;        // records * floor(log2 t) / 8
+    std::size_t ciphertext_bytes;
+    double seconds;
+
+    StreamStats() : records(0), ciphertexts(0), plaintext_bytes(0), ciphertext_bytes(0), seconds(0) {}
+
+    double plaintext_mb_per_second() const { return seconds > 0 ? plaintext_bytes / seconds / 1e6 : 0.0; }
+    double ciphertext_mb_per_second() const { return seconds > 0 ? ciphertext_bytes / seconds / 1e6 : 0.0; }
+};
+
+using StreamProgressCallback = std::function<void(const StreamStats&)>;
+
+struct StreamOptions {
+    std::size_t num_threads;            // encryption workers, 0 = core::default_thread_count()
+    std::size_t batch_size;             // polynomials per task
+    std::size_t queue_depth;            // tasks in flight per queue, 0 = 2 per worker
+    StreamProgressCallback progress;    // called from the writer thread after each batch
+
+    StreamOptions() : num_threads(0), batch_size(8), queue_depth(0) {}
+};
+
+// Fills up to `max` records and returns how many it wrote; 0 ends the stream
+using RecordSource = std::function<std::size_t(int64* records, std::size_t max)>;
+
+// Receives decrypted records in order
+using RecordSink = std::function<void(const int64* records, std::size_t count)>;
+
+// Little-endian records of record_bytes bytes read from / written to a file
+// descriptor; every record must fit in a coefficient (2^(8 * record_bytes) <= t)
+RecordSource fd_record_source(int fd, std::size_t record_bytes);
+
+RecordSink fd_record_sink(int fd, std::size_t record_bytes);
+
+template <typename Iterator>
+RecordSource iterator_record_source(Iterator begin, Iterator end) {
+    return [begin, end](int64* records, std::size_t max) mutable {
+        std::size_t count = 0;
+        for (; count < max && begin != end; ++count, ++begin) {
+            records[count] = static_cast<int64>(*begin);
+        }
+        return count;
+    };
+}
+
+StreamStats encrypt_stream(
+    const RecordSource& source,
+    std::ostream& out,
+    const keys::RLWEPublicKey& pk,
+    const Parameters& params,
+    const StreamOptions& options = StreamOptions()
+);
+
+StreamStats encrypt_stream(
+    const RecordSource& source,
+    std::ostream& out,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params,
+    const StreamOptions& options = StreamOptions()
+);
+
+// Reads chunks until the end marker, decrypting across the worker pool
+StreamStats decrypt_stream(
+    std::istream& in,
+    const RecordSink& sink,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params,
+    const StreamOptions& options = StreamOptions()
+);
+
+}
+}
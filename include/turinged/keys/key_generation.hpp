@@ -0,0 +1,86 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include <functional>
+#include <iosfwd>
+
+namespace turinged {
+namespace keys {
+
+// Reported after every generated chunk, from the calling thread
+struct KeygenProgress {
+    std::size_t completed;      // GGSW samples (bootstrapping key) or key-switch rows done
+    std::size_t total;
+    double elapsed_seconds;
+    double items_per_second;
+};
+
+using KeygenProgressCallback = std::function<void(const KeygenProgress&)>;
+
+struct KeygenOptions {
+    std::size_t num_threads;            // 0 = core::default_thread_count()
+    std::size_t chunk_size;             // items per parallel batch, 0 = 4 per thread
+    bool transform;                     // store the bootstrapping key in NTT form
+    uint64 seed;                        // master mask seed, 0 = draw one from std::random_device
+    KeygenProgressCallback progress;
+
+    KeygenOptions() : num_threads(0), chunk_size(0), transform(true), seed(0) {}
+};
+
+// GGSW i encrypts lwe_sk.s[i] under glwe_sk with levels 0..l of base beta.
+// Every sample draws its mask and noise from its own generator, derived from
+// the master seed and a secret noise seed, so the result does not depend on
+// the thread count.
+BootstrappingKey generate_bootstrapping_key(
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    const KeygenOptions& options = KeygenOptions()
+);
+
+// Same key streamed to `out` in the io:: serialization format one chunk at a
+// time, so peak memory is a single chunk rather than the whole key. Load it
+// back with io::deserialize_bootstrapping_key.
+void write_bootstrapping_key(
+    std::ostream& out,
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    const KeygenOptions& options = KeygenOptions()
+);
+
+// Key switching key from from_sk to to_sk with a full base-beta gadget
+LWEKeySwitchKey generate_lwe_key_switch_key(
+    const LWESecretKey& from_sk,
+    const LWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta,
+    const KeygenOptions& options = KeygenOptions()
+);
+
+// Streamed counterpart, read back with io::deserialize_lwe_key_switch_key
+void write_lwe_key_switch_key(
+    std::ostream& out,
+    const LWESecretKey& from_sk,
+    const LWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta,
+    const KeygenOptions& options = KeygenOptions()
+);
+
+// Bootstrapping key of lwe_sk under glwe_sk and key switching key from
+// extract_lwe_secret_key(glwe_sk) back to lwe_sk, for operations/gates.hpp
+GateBootstrappingKey generate_gate_bootstrapping_key(
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const GateBootstrappingParameters& params,
+    const KeygenOptions& options = KeygenOptions()
+);
+
+}
+}
\ No newline at end of file
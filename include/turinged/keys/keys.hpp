@@ -1,6 +1,10 @@
 #pragma once
 
 #include "turinged/core/types.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/rns/rns.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+#include <map>
 
 namespace turinged {
 namespace keys {
@@ -12,11 +16,16 @@ struct LWESecretKey {
     explicit LWESecretKey(std::size_t k) : s(k) {}
 };
 
+// Matrix of `samples` LWE encryptions of zero: row i is (a[i*k .. i*k+k), b[i])
+// with b[i] = <a_i, s> + e_i. Encryption adds a random subset of the rows.
 struct LWEPublicKey {
-    std::vector<int64> a;
+    std::size_t k;
+    std::size_t samples;
+    std::vector<int64> a;       // row-major samples x k
+    std::vector<int64> b;       // samples
 
-    LWEPublicKey() = default;
-    explicit LWEPublicKey(std::size_t k) : a(k) {}
+    LWEPublicKey() : k(0), samples(0) {}
+    LWEPublicKey(std::size_t k, std::size_t samples) : k(k), samples(samples), a(k * samples), b(samples) {}
 };
 
 struct RLWESecretKey {
@@ -26,6 +35,15 @@ struct RLWESecretKey {
     explicit RLWESecretKey(std::size_t n) : s(n) {}
 };
 
+// RLWE encryption of zero: b = a*s + e
+struct RLWEPublicKey {
+    Polynomial a;
+    Polynomial b;
+
+    RLWEPublicKey() = default;
+    explicit RLWEPublicKey(std::size_t n) : a(n), b(n) {}
+};
+
 struct GLWESecretKey {
     std::vector<Polynomial> s;
 
@@ -41,6 +59,195 @@ struct GLWEPublicKey {
     GLWEPublicKey(std::size_t k, std::size_t n) : pk1(n), pk2(k, Polynomial(n)) {}
 };
 
+// RLWE key-switching key from a source secret s' to sk: for each gadget level j,
+// an RLWE sample (a_j, b_j) with b_j = a_j * s + e_j + beta^j * s'. Stored in NTT
+// form since the samples are only ever used as multiplicands.
+struct RLWEKeySwitchKey {
+    int64 beta;
+    int levels;
+    std::vector<polynomial::NTTPolynomial> a;
+    std::vector<polynomial::NTTPolynomial> b;
+
+    RLWEKeySwitchKey() : beta(0), levels(0) {}
+};
+
+// Relinearisation key: key switch from s^2 back to s
+using RLWERelinKey = RLWEKeySwitchKey;
+
+// GLWE key-switching key from source key polynomials s'_0..s'_{k'-1} to a GLWE
+// key. Row i * levels + j is a GLWE sample under the target key encrypting
+// beta^j * s'_i, i.e. body = sum_o mask[o] * s_o + e + beta^j * s'_i.
+struct GLWEKeySwitchKey {
+    int64 beta;
+    int levels;
+    std::vector<std::vector<polynomial::NTTPolynomial>> mask;
+    std::vector<polynomial::NTTPolynomial> body;
+
+    GLWEKeySwitchKey() : beta(0), levels(0) {}
+};
+
+// Galois keys: key switch from s(X^g) back to s, indexed by Galois element g
+struct RLWEGaloisKeys {
+    std::map<uint64, RLWEKeySwitchKey> keys;
+};
+
+struct GLWEGaloisKeys {
+    std::map<uint64, GLWEKeySwitchKey> keys;
+};
+
+// RNS key-switching key: sample i encrypts s' * e_i under the target key, where
+// e_i is the CRT idempotent of q_i (1 mod q_i, 0 mod every other prime), so the
+// gadget digits of x are simply its residues [x]_{q_i}. Stored in NTT form at
+// the top level; dropping trailing primes gives the key for any lower level,
+// since e_i restricted to Q_l is again the idempotent of q_i.
+struct RNSKeySwitchKey {
+    std::vector<std::vector<rns::RNSPolynomial>> mask;    // [i][target key polynomial]
+    std::vector<rns::RNSPolynomial> body;                 // [i]
+};
+
+// One key switching key per product s_i * s_j (i <= j) of the key polynomials,
+// in order (0,0), (0,1), ..., (0,k-1), (1,1), ...
+struct RNSRelinKey {
+    std::vector<RNSKeySwitchKey> keys;
+};
+
+// Layout of an LWE key-switching key from an n_in-coefficient key s' to an
+// n_out-coefficient key s. Entry (i, j) is an LWE sample under s encrypting
+// beta^j * s'_i, i.e. body = <mask, s> + e + beta^j * s'_i, stored contiguously
+// as n_out mask coefficients followed by the body.
+struct LWEKeySwitchKeyLayout {
+    std::size_t n_in;
+    std::size_t n_out;
+    int64 beta;
+    int levels;
+
+    LWEKeySwitchKeyLayout() : n_in(0), n_out(0), beta(0), levels(0) {}
+    LWEKeySwitchKeyLayout(std::size_t n_in, std::size_t n_out, int64 beta, int levels)
+        : n_in(n_in), n_out(n_out), beta(beta), levels(levels) {}
+
+    std::size_t entry_words() const { return n_out + 1; }
+    std::size_t entry_offset(std::size_t i, int j) const { return (i * levels + j) * entry_words(); }
+    std::size_t total_words() const { return n_in * levels * entry_words(); }
+};
+
+// Non-owning view of key switching key data, e.g. a memory-mapped key file
+struct LWEKeySwitchKeyView : LWEKeySwitchKeyLayout {
+    const int64* data;
+
+    LWEKeySwitchKeyView() : data(nullptr) {}
+    LWEKeySwitchKeyView(const LWEKeySwitchKeyLayout& layout, const int64* data)
+        : LWEKeySwitchKeyLayout(layout), data(data) {}
+
+    const int64* entry(std::size_t i, int j) const { return data + entry_offset(i, j); }
+};
+
+struct LWEKeySwitchKey : LWEKeySwitchKeyLayout {
+    std::vector<int64> data;
+
+    LWEKeySwitchKey() = default;
+    LWEKeySwitchKey(std::size_t n_in, std::size_t n_out, int64 beta, int levels)
+        : LWEKeySwitchKeyLayout(n_in, n_out, beta, levels), data(total_words()) {}
+
+    const int64* entry(std::size_t i, int j) const { return data.data() + entry_offset(i, j); }
+    int64* entry(std::size_t i, int j) { return data.data() + entry_offset(i, j); }
+
+    LWEKeySwitchKeyView view() const { return LWEKeySwitchKeyView(*this, data.data()); }
+};
+
+// Layout of a bootstrapping key: GGSW encryptions of the LWE secret
+// coefficients under the GLWE key, in one contiguous buffer. GGSW i is laid out
+// as [row r = 0..k][level j = 0..l][component c = 0..k][words], component c < k
+// being mask d_tilde[c] and c = k the body (rows and levels as in
+// schemes::GGSWCiphertext). A transformed key holds each polynomial as its
+// EXACT_PRIME_COUNT NTT residue vectors back to back, ready for the external
+// product; otherwise each polynomial is n coefficients in [0, q).
+struct BootstrappingKeyLayout {
+    std::size_t n_lwe;
+    std::size_t k;
+    std::size_t n;
+    int l;
+    int64 beta;
+    bool transformed;
+
+    BootstrappingKeyLayout() : n_lwe(0), k(0), n(0), l(0), beta(0), transformed(false) {}
+    BootstrappingKeyLayout(std::size_t n_lwe, std::size_t k, std::size_t n, int l, int64 beta, bool transformed)
+        : n_lwe(n_lwe), k(k), n(n), l(l), beta(beta), transformed(transformed) {}
+
+    std::size_t poly_words() const { return transformed ? polynomial::EXACT_PRIME_COUNT * n : n; }
+    std::size_t glwe_words() const { return (k + 1) * poly_words(); }
+    std::size_t ggsw_words() const { return (k + 1) * (l + 1) * glwe_words(); }
+    std::size_t total_words() const { return n_lwe * ggsw_words(); }
+
+    // Offset of the GLWE sample at (row, level) of GGSW i
+    std::size_t glwe_offset(std::size_t i, std::size_t row, int level) const {
+        return i * ggsw_words() + (row * (l + 1) + level) * glwe_words();
+    }
+};
+
+// Non-owning view of bootstrapping key data, e.g. a memory-mapped key file
+struct BootstrappingKeyView : BootstrappingKeyLayout {
+    const uint64* data;
+
+    BootstrappingKeyView() : data(nullptr) {}
+    BootstrappingKeyView(const BootstrappingKeyLayout& layout, const uint64* data)
+        : BootstrappingKeyLayout(layout), data(data) {}
+
+    const uint64* ggsw(std::size_t i) const { return data + i * ggsw_words(); }
+    const uint64* glwe(std::size_t i, std::size_t row, int level) const { return data + glwe_offset(i, row, level); }
+};
+
+struct BootstrappingKey : BootstrappingKeyLayout {
+    std::vector<uint64> data;
+
+    BootstrappingKey() = default;
+    BootstrappingKey(std::size_t n_lwe, std::size_t k, std::size_t n, int l, int64 beta, bool transformed)
+        : BootstrappingKeyLayout(n_lwe, k, n, l, beta, transformed), data(total_words()) {}
+
+    const uint64* ggsw(std::size_t i) const { return data.data() + i * ggsw_words(); }
+    uint64* ggsw(std::size_t i) { return data.data() + i * ggsw_words(); }
+    const uint64* glwe(std::size_t i, std::size_t row, int level) const { return data.data() + glwe_offset(i, row, level); }
+
+    BootstrappingKeyView view() const { return BootstrappingKeyView(*this, data.data()); }
+};
+
+// ========== Gate bootstrapping keys ==========
+
+// One modulus q for the gate ciphertexts (LWE of dimension lwe_dimension) and
+// the accumulator (GLWE with k polynomials of degree n); see operations/gates.hpp
+struct GateBootstrappingParameters {
+    std::size_t lwe_dimension;
+    std::size_t k;
+    std::size_t n;
+    int64 q;
+    int64 lwe_noise_bound;
+    int64 glwe_noise_bound;
+    int bsk_l;                  // bootstrapping key levels 0..bsk_l of base bsk_beta
+    int64 bsk_beta;
+    int64 ksk_beta;             // key switching back to the LWE key, full gadget
+
+    GateBootstrappingParameters()
+        : lwe_dimension(0), k(0), n(0), q(0), lwe_noise_bound(0), glwe_noise_bound(0),
+          bsk_l(0), bsk_beta(0), ksk_beta(0) {}
+
+    // Bits are encoded with t = 8 (true = Delta, false = -Delta)
+    Parameters lwe_parameters() const { return Parameters(0, q, 8, lwe_noise_bound); }
+    Parameters glwe_parameters() const { return Parameters(n, q, 8, glwe_noise_bound); }
+};
+
+struct GateBootstrappingKeyView {
+    GateBootstrappingParameters params;
+    BootstrappingKeyView bsk;
+    LWEKeySwitchKeyView ksk;
+};
+
+struct GateBootstrappingKey {
+    GateBootstrappingParameters params;
+    BootstrappingKey bsk;
+    LWEKeySwitchKey ksk;        // from the extracted GLWE key to the LWE key
+
+    GateBootstrappingKeyView view() const { return GateBootstrappingKeyView{params, bsk.view(), ksk.view()}; }
+};
+
 LWESecretKey generate_lwe_secret_key(std::size_t k);
 
 RLWESecretKey generate_rlwe_secret_key(std::size_t n);
@@ -49,5 +256,67 @@ GLWESecretKey generate_glwe_secret_key(std::size_t k, std::size_t n);
 
 GLWEPublicKey generate_glwe_public_key(const GLWESecretKey& sk, const Parameters& params);
 
+// Fresh encryptions sum up to `samples` noise terms, so samples * noise_bound must
+// stay well below Delta/2; the leftover hash lemma asks for samples > (k+1) log2 q
+LWEPublicKey generate_lwe_public_key(const LWESecretKey& sk, const Parameters& params, std::size_t samples);
+
+RLWEPublicKey generate_rlwe_public_key(const RLWESecretKey& sk, const Parameters& params);
+
+// LWE key made of the coefficients of the ring key (concatenated for GLWE);
+// sample extraction and LWE-to-ring packing work against this key
+LWESecretKey extract_lwe_secret_key(const RLWESecretKey& sk);
+
+LWESecretKey extract_lwe_secret_key(const GLWESecretKey& sk);
+
+RLWEKeySwitchKey generate_rlwe_key_switch_key(
+    const Polynomial& from_s,
+    const RLWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta
+);
+
+RLWERelinKey generate_rlwe_relin_key(
+    const RLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta
+);
+
+GLWEKeySwitchKey generate_glwe_key_switch_key(
+    const std::vector<Polynomial>& from_s,
+    const GLWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta
+);
+
+RLWEGaloisKeys generate_rlwe_galois_keys(
+    const RLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    const std::vector<uint64>& galois_elts
+);
+
+RNSKeySwitchKey generate_rns_key_switch_key(
+    const rns::RNSPolynomial& from_s,
+    const GLWESecretKey& to_sk,
+    const rns::RNSParameters& params
+);
+
+RNSRelinKey generate_rns_relin_key(
+    const GLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+RNSRelinKey generate_rns_relin_key(
+    const RLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+GLWEGaloisKeys generate_glwe_galois_keys(
+    const GLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    const std::vector<uint64>& galois_elts
+);
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/schemes/lwe.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+
+namespace turinged {
+namespace noise {
+
+// Decryption rounds the phase to the nearest multiple of Delta = q / t, so it
+// is correct while every error coefficient stays below Delta / 2.
+//
+// Two tools are provided. measure_noise_* computes the actual error of a
+// ciphertext from the secret key. Separately, LWE, RLWE and GLWE ciphertexts
+// carry noise_variance, an analytic estimate of the per-coefficient error
+// variance, and coherent_variance, its slowly varying part (see below):
+// encryption sets both and every owning operations:: call propagates them
+// with the model below. They are NaN when unknown (ciphertexts filled through
+// views, deserialized or built by hand), and NaN propagates.
+
+struct NoiseMeasurement {
+    int64 max_abs;          // largest |e_i| over the coefficients
+    double variance;        // mean of e_i^2
+    double budget_bits;     // log2((Delta / 2) / max_abs); <= 0 means decryption fails
+};
+
+// Error against the nearest codeword. Once the noise has passed Delta / 2 the
+// nearest codeword is the wrong message, so past that point only the overloads
+// taking the expected message measure the true error.
+NoiseMeasurement measure_noise_lwe(
+    const schemes::LWECiphertext& ct,
+    const keys::LWESecretKey& sk,
+    const Parameters& params
+);
+
+NoiseMeasurement measure_noise_lwe(
+    const schemes::LWECiphertext& ct,
+    int64 message,
+    const keys::LWESecretKey& sk,
+    const Parameters& params
+);
+
+NoiseMeasurement measure_noise_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params
+);
+
+NoiseMeasurement measure_noise_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& message,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params
+);
+
+NoiseMeasurement measure_noise_glwe(
+    const schemes::GLWECiphertext& ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params
+);
+
+NoiseMeasurement measure_noise_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params
+);
+
+// ========== Variance model ==========
+//
+// Central-limit estimates assuming uniform masks, uniform messages and binary
+// secrets (as produced by keys::), averaged over keys. The q mod t encoding
+// term is ignored except by tensor and plaintext products, where it dominates
+// unless q mod t is tiny, so elsewhere the model is tight when t divides q.
+//
+// Errors left by key switching and tensoring are not independent across
+// coefficients. Unsigned gadget digits have mean (beta - 1) / 2, so a key switch
+// leaves (beta - 1) / 2 * (1 + x + ... + x^(n-1)) * sum_j e_j: a slowly varying
+// polynomial fixed by the key, the same for every ciphertext switched with it.
+// The tensor multiplies each error by the other input's phase, whose a*s part
+// carries the same kind of component through the binary secret. Ciphertexts
+// carry this part of noise_variance separately as coherent_variance:
+// - sums add its standard deviations rather than its variances;
+// - a plaintext product scales it by the mean square of p * (1 + x + ... +
+//   x^(n-1)) instead of |p|^2, which is about n / 3 * mean(p)^2 / Var(p) times
+//   larger (centered plaintexts with even t have mean 1/2: ~9x at n = 2048,
+//   t = 16), and turns the incoherent part times the mean of p coherent too.
+// The coherent component spreads over few low frequencies, so its size varies
+// between keys and ciphertexts by up to an order of magnitude either side of
+// the estimate, and failure bounds need a margin on top of it.
+
+// Variance of one sample of the uniform noise on [-noise_bound, noise_bound]
+double fresh_variance(const Parameters& params);
+
+// Public-key encryptions: a random half of the LWE key's rows, or
+// e*u + e1 - <e2, s> for the ring schemes with k mask polynomials. Half of it
+// is coherent: rows shared between encryptions, and the mean of binary u and s.
+double lwe_public_key_variance(const Parameters& params, std::size_t samples);
+double glwe_public_key_variance(const Parameters& params, std::size_t k);
+double lwe_public_key_coherent_variance(const Parameters& params, std::size_t samples);
+double glwe_public_key_coherent_variance(const Parameters& params, std::size_t k);
+
+// Noise added by a gadget key switch of params.q over `levels` digits of base
+// beta whose input has `terms` coefficients multiplied into the key (n_in for
+// LWE, n for RLWE, k_in * n for GLWE), and its coherent part
+double key_switch_variance(const Parameters& params, int64 beta, int levels, std::size_t terms);
+double key_switch_coherent_variance(const Parameters& params, int64 beta, int levels, std::size_t terms);
+
+// Switching q -> q_new scales the noise and adds the rounding of the body and
+// of `key_terms` mask coefficients (the LWE dimension, or k * n)
+double modulus_switch_variance(double variance, int64 q, int64 q_new, std::size_t key_terms);
+double modulus_switch_coherent_variance(double coherent, int64 q, int64 q_new, std::size_t key_terms);
+
+// Blind rotation over n_lwe CMux steps against a bootstrapping key with levels
+// 0..l of base beta (signed digits) under params' noise; the test polynomial
+// is trivial, so this is also the variance of the extracted sample. Signed
+// digits leave no coherent part.
+double blind_rotation_variance(const Parameters& params, std::size_t k, std::size_t n_lwe, int l, int64 beta);
+
+// Sum or difference of two ciphertexts, assuming their coherent parts align
+double sum_variance(double variance1, double coherent1, double variance2, double coherent2);
+double sum_coherent_variance(double coherent1, double coherent2);
+
+// Product with a plaintext p given |p|^2, the mean square of p * (1 + x + ...
+// + x^(n-1)) and (sum_i p_i)^2 / n, all over centered coefficients
+double plain_product_variance(
+    double variance,
+    double coherent,
+    double norm_squared,
+    double ramp_norm_squared,
+    const Parameters& params
+);
+
+double plain_product_coherent_variance(
+    double variance,
+    double coherent,
+    double mean_norm_squared,
+    double ramp_norm_squared,
+    const Parameters& params
+);
+
+// BFV tensor with scale-and-round by t/q, before relinearisation
+double tensor_variance(double variance1, double coherent1, double variance2, double coherent2, const Parameters& params);
+double tensor_coherent_variance(double variance1, double coherent1, double variance2, double coherent2, const Parameters& params);
+
+// Gaussian tail: log2((Delta / 2) / (sigmas * sqrt(variance)))
+double noise_budget_bits(double variance, const Parameters& params, double sigmas = 6.0);
+
+// Probability that any of `coefficients` error coefficients reaches Delta / 2
+double failure_probability(double variance, const Parameters& params, std::size_t coefficients = 1);
+
+}
+}
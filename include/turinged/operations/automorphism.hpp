@@ -0,0 +1,101 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Galois element 3^steps mod 2n, rotating both batch rows left by `steps`
+// (negative steps rotate right)
+uint64 galois_element_for_rotation(int steps, std::size_t n);
+
+// Galois element 2n - 1, swapping the two batch rows
+uint64 galois_element_for_row_swap(std::size_t n);
+
+// Elements for rotations by 1, 2, 4, ..., n/4 plus the row swap: enough for
+// sum_slots_rlwe and for any rotate_rows_rlwe, which composes at most
+// log2(n/2) of them when the exact key is missing
+std::vector<uint64> power_of_two_galois_elements(std::size_t n);
+
+// Applies X -> X^g to an RLWE ciphertext and switches back to the original key
+schemes::RLWECiphertext apply_galois_rlwe(
+    const schemes::RLWECiphertext& ct,
+    uint64 galois_elt,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+);
+
+schemes::GLWECiphertext apply_galois_glwe(
+    const schemes::GLWECiphertext& ct,
+    uint64 galois_elt,
+    const keys::GLWEGaloisKeys& gk,
+    const Parameters& params
+);
+
+// Uses the key for galois_element_for_rotation(steps) when gk has it;
+// otherwise rotates by each power of two in steps mod n/2 in turn (one key
+// switch, and its noise, per set bit)
+schemes::RLWECiphertext rotate_rows_rlwe(
+    const schemes::RLWECiphertext& ct,
+    int steps,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+);
+
+schemes::RLWECiphertext swap_rows_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+);
+
+// Gadget decomposition of -a, already in the NTT domain. Automorphisms commute
+// with the decomposition, so one of these serves any number of rotations.
+// A trivial ciphertext hoists to no digits.
+struct HoistedRLWECiphertext {
+    Polynomial b;
+    int64 beta;
+    int levels;
+    std::vector<polynomial::NTTPolynomial> digits;
+    double noise_variance;
+    double coherent_variance;
+
+    bool is_trivial() const { return digits.empty(); }
+};
+
+HoistedRLWECiphertext hoist_rlwe(
+    const schemes::RLWECiphertext& ct,
+    int64 beta,
+    const Parameters& params
+);
+
+// Costs one permutation per digit plus the key inner product; no decomposition
+// or forward transforms
+schemes::RLWECiphertext apply_galois_hoisted(
+    const HoistedRLWECiphertext& hoisted,
+    uint64 galois_elt,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+);
+
+// Many rotations of the same ciphertext sharing one decomposition; steps
+// without an exact key fall back to rotate_rows_rlwe
+std::vector<schemes::RLWECiphertext> rotate_rows_hoisted(
+    const schemes::RLWECiphertext& ct,
+    const std::vector<int>& steps,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+);
+
+// Every slot ends up holding the sum of all n slots (needs power_of_two_galois_elements)
+schemes::RLWECiphertext sum_slots_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+);
+
+}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/schemes/lwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Programmable bootstrapping of LWE ciphertexts. lwe_params and glwe_params
+// share q; the LWE key is the one the bootstrapping key encrypts (n_lwe bits)
+// and glwe_params.n is the ring degree N of the accumulator. The bootstrapping
+// key may be in either layout, but a key not in NTT form is transformed on
+// every use. Decomposition is exact for power-of-two q and beta.
+
+// GLWE encryption of m * mu from GGSW i of the bootstrapping key (m = s_i)
+// and a GLWE encryption of mu; trivial inputs are accepted
+schemes::GLWECiphertext external_product(
+    const keys::BootstrappingKeyView& bsk,
+    std::size_t i,
+    const schemes::GLWECiphertext& ct,
+    const Parameters& params
+);
+
+// GLWE encryption of X^(-p) * test_polynomial, where p in [0, 2N) is the
+// phase of ct switched to modulus 2N. Coefficient 0 of the result is
+// test_polynomial[p] for p < N and -test_polynomial[p - N] otherwise.
+schemes::GLWECiphertext blind_rotate(
+    const schemes::LWECiphertext& ct,
+    const Polynomial& test_polynomial,
+    const keys::BootstrappingKeyView& bsk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+);
+
+// LWE encryption of coefficient `index` of the GLWE plaintext, under
+// keys::extract_lwe_secret_key of the GLWE key
+schemes::LWECiphertext sample_extract(
+    const schemes::GLWECiphertext& ct,
+    std::size_t index,
+    const Parameters& params
+);
+
+// Blind rotation and extraction of coefficient 0, left under the extracted key
+schemes::LWECiphertext bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const Polynomial& test_polynomial,
+    const keys::BootstrappingKeyView& bsk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+);
+
+// Same, key switched back to the LWE key with ksk (extracted key -> LWE key)
+schemes::LWECiphertext bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const Polynomial& test_polynomial,
+    const keys::BootstrappingKeyView& bsk,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+);
+
+// ========== Multi-value bootstrapping ==========
+//
+// Several lookup tables of one encrypted message for a single blind rotation
+// (Carpov, Izabachene, Mollimard). Messages m in [0, t/2) are encoded as
+// Delta * m with Delta = q / t (params.t even), keeping the top bit of the
+// phase clear. Since (1 + X + ... + X^(N-1)) * (1 - X) = 2 mod X^N + 1, the
+// test polynomial of table f factors into the common v0 = (Delta / 2) *
+// (1 + X + ... + X^(N-1)), which is blind rotated once, and the small
+// plaintext v_f = (1 - X) * F with F[i] = f(floor(i * (t/2) / N)). Each table
+// then costs one plaintext product and an extraction. The product multiplies
+// the blind rotation noise by the squared norm of v_f, which grows with the
+// jumps between neighbouring table entries.
+
+// v0 for glwe_params.t
+Polynomial multi_value_test_polynomial(const Parameters& glwe_params);
+
+// v_f for table[m] = f(m), m in [0, t/2); entries are taken mod t
+Polynomial lut_factor_polynomial(const std::vector<int64>& table, const Parameters& glwe_params);
+
+// Encryptions of Delta * table_j[m], one per table, left under the extracted key
+std::vector<schemes::LWECiphertext> multi_value_bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const std::vector<std::vector<int64>>& tables,
+    const keys::BootstrappingKeyView& bsk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+);
+
+// Same, each output key switched back to the LWE key with ksk
+std::vector<schemes::LWECiphertext> multi_value_bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const std::vector<std::vector<int64>>& tables,
+    const keys::BootstrappingKeyView& bsk,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+);
+
+}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+#include "turinged/schemes/ckks.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Drops trailing primes down to `level` without touching the message or scale
+schemes::CKKSCiphertext mod_drop_ckks(
+    const schemes::CKKSCiphertext& ct,
+    std::size_t level,
+    const rns::RNSParameters& params
+);
+
+// Divides by the last prime q_l and rounds: level l -> l-1, scale -> scale / q_l
+schemes::CKKSCiphertext rescale_ckks(
+    const schemes::CKKSCiphertext& ct,
+    const rns::RNSParameters& params
+);
+
+// Operands are brought to the lower of their levels; scales must match
+schemes::CKKSCiphertext add_ckks(
+    const schemes::CKKSCiphertext& ct1,
+    const schemes::CKKSCiphertext& ct2,
+    const rns::RNSParameters& params
+);
+
+schemes::CKKSCiphertext subtract_ckks(
+    const schemes::CKKSCiphertext& ct1,
+    const schemes::CKKSCiphertext& ct2,
+    const rns::RNSParameters& params
+);
+
+// Slot-wise product: tensor mod Q_l, relinearise, then rescale, so the result
+// sits at level l-1 with scale scale1 * scale2 / q_l
+schemes::CKKSCiphertext multiply_ckks(
+    const schemes::CKKSCiphertext& ct1,
+    const schemes::CKKSCiphertext& ct2,
+    const keys::RNSRelinKey& rlk,
+    const rns::RNSParameters& params
+);
+
+}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/schemes/lwe.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Boolean gates on LWE ciphertexts with a bootstrap after every gate. A bit is
+// encrypted as +q/8 (true) or -q/8 (false). A two-input gate adds a constant to
+// a small linear combination of its inputs so that the phase falls in (0, q/2)
+// exactly when the output is true, then blind rotates a test polynomial of
+// q/8 everywhere, extracts and key switches back to the LWE key. Every output
+// therefore carries the same bootstrapping noise, whatever the depth of the
+// circuit. NOT is a negation and needs no bootstrap; MUX takes two.
+
+enum class Gate { NAND, AND, OR, NOR, XOR, XNOR };
+
+// 128-bit set under the params/params.hpp security model: n = 750, N = 1024,
+// k = 1, q = 2^32, bootstrapping key base 2^7 with 3 levels, key switching
+// base 2^4. The estimated failure probability of a gate is below 2^-80.
+keys::GateBootstrappingParameters default_gate_parameters();
+
+schemes::LWECiphertext encrypt_bit(bool bit, const keys::LWESecretKey& sk, const keys::GateBootstrappingParameters& params);
+
+bool decrypt_bit(const schemes::LWECiphertext& ct, const keys::LWESecretKey& sk, const keys::GateBootstrappingParameters& params);
+
+// Noiseless constant
+schemes::LWECiphertext trivial_bit(bool bit, const keys::GateBootstrappingParameters& params);
+
+schemes::LWECiphertext evaluate_gate(
+    Gate gate,
+    const schemes::LWECiphertext& a,
+    const schemes::LWECiphertext& b,
+    const keys::GateBootstrappingKeyView& key
+);
+
+schemes::LWECiphertext gate_not(const schemes::LWECiphertext& a, const keys::GateBootstrappingParameters& params);
+
+// select ? a : b
+schemes::LWECiphertext gate_mux(
+    const schemes::LWECiphertext& select,
+    const schemes::LWECiphertext& a,
+    const schemes::LWECiphertext& b,
+    const keys::GateBootstrappingKeyView& key
+);
+
+// Independent gates out[i] = gate(a[i], b[i]) spread over num_threads threads
+// (0 = core::default_thread_count())
+std::vector<schemes::LWECiphertext> evaluate_gates(
+    Gate gate,
+    const std::vector<schemes::LWECiphertext>& a,
+    const std::vector<schemes::LWECiphertext>& b,
+    const keys::GateBootstrappingKeyView& key,
+    std::size_t num_threads = 0
+);
+
+std::vector<schemes::LWECiphertext> evaluate_mux_gates(
+    const std::vector<schemes::LWECiphertext>& select,
+    const std::vector<schemes::LWECiphertext>& a,
+    const std::vector<schemes::LWECiphertext>& b,
+    const keys::GateBootstrappingKeyView& key,
+    std::size_t num_threads = 0
+);
+
+}
+}
@@ -6,11 +6,33 @@
 #include "turinged/schemes/glwe.hpp"
 #include "turinged/schemes/glev.hpp"
 #include "turinged/schemes/ggsw.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include <limits>
 
 namespace turinged {
 namespace operations {
 
-// LWE Homomorphic Operations
+// Plaintext polynomial (coefficients mod t) lifted to centered integers and
+// transformed once, so every later product with a ciphertext component is a
+// pointwise multiply
+struct PreparedPlaintext {
+    polynomial::NTTPolynomial value;
+    int64 bound;            // largest centered coefficient magnitude
+    double norm_squared;        // sum of squared centered coefficients, scales the noise variance
+    double ramp_norm_squared;   // mean square of plain * (1 + x + ... + x^(n-1)), scales the coherent part
+    double mean_norm_squared;   // (sum of centered coefficients)^2 / n
+
+    PreparedPlaintext()
+        : bound(0),
+          norm_squared(std::numeric_limits<double>::quiet_NaN()),
+          ramp_norm_squared(std::numeric_limits<double>::quiet_NaN()),
+          mean_norm_squared(std::numeric_limits<double>::quiet_NaN()) {}
+};
+
+PreparedPlaintext prepare_plaintext(const Polynomial& plain, const Parameters& params);
+
+// LWE Homomorphic Operations. Trivial ciphertexts (empty mask) are accepted
+// by add, subtract, scalar and plaintext operations.
 schemes::LWECiphertext add_lwe(
     const schemes::LWECiphertext& ct1,
     const schemes::LWECiphertext& ct2,
@@ -29,6 +51,19 @@ schemes::LWECiphertext scalar_multiply_lwe(
     const Parameters& params
 );
 
+// Plaintext constants only shift the body by Delta*m; no noise is added
+schemes::LWECiphertext add_plain_lwe(
+    const schemes::LWECiphertext& ct,
+    int64 message,
+    const Parameters& params
+);
+
+schemes::LWECiphertext sub_plain_lwe(
+    const schemes::LWECiphertext& ct,
+    int64 message,
+    const Parameters& params
+);
+
 // RLWE Homomorphic Operations
 schemes::RLWECiphertext add_rlwe(
     const schemes::RLWECiphertext& ct1,
@@ -48,9 +83,67 @@ schemes::RLWECiphertext scalar_multiply_rlwe(
     const Parameters& params
 );
 
+schemes::RLWECiphertext add_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& message,
+    const Parameters& params
+);
+
+schemes::RLWECiphertext sub_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& message,
+    const Parameters& params
+);
+
+// Ciphertext-plaintext products; decrypt to plain * m mod (X^n + 1, t)
+schemes::RLWECiphertext multiply_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& plain,
+    const Parameters& params
+);
+
+schemes::RLWECiphertext multiply_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params
+);
+
+// sum_i plain_i * ct_i, accumulated in the NTT domain with one inverse
+// transform per component
+schemes::RLWECiphertext multiply_plain_accumulate_rlwe(
+    const std::vector<schemes::RLWECiphertext>& cts,
+    const std::vector<PreparedPlaintext>& plains,
+    const Parameters& params
+);
+
+// Degree-2 ciphertext produced by tensoring: phase = c0 + c1*s + c2*s^2
+struct RLWETensorCiphertext {
+    Polynomial c0;
+    Polynomial c1;
+    Polynomial c2;
+    double noise_variance = std::numeric_limits<double>::quiet_NaN();
+    double coherent_variance = std::numeric_limits<double>::quiet_NaN();
+};
+
+// BFV tensor product with exact scale-and-round by t/q (needs ntt_supported(n, q, 2))
+RLWETensorCiphertext tensor_rlwe(
+    const schemes::RLWECiphertext& ct1,
+    const schemes::RLWECiphertext& ct2,
+    const Parameters& params
+);
+
+schemes::RLWECiphertext relinearize_rlwe(
+    const RLWETensorCiphertext& ct,
+    const keys::RLWERelinKey& rlk,
+    const Parameters& params
+);
+
+// Tensor followed by relinearisation; decrypts to m1 * m2 mod (X^n + 1, t).
+// With a trivial operand this is a plaintext product and needs no relinearisation.
 schemes::RLWECiphertext multiply_rlwe(
     const schemes::RLWECiphertext& ct1,
     const schemes::RLWECiphertext& ct2,
+    const keys::RLWERelinKey& rlk,
     const Parameters& params
 );
 
@@ -73,14 +166,159 @@ schemes::GLWECiphertext scalar_multiply_glwe(
     const Parameters& params
 );
 
-// Key switching and decomposition functions (placeholders for future implementation)
-schemes::LWECiphertext key_switch_lwe_to_lwe(
-    const schemes::LWECiphertext& ct,
-    const keys::LWESecretKey& from_key,
-    const keys::LWESecretKey& to_key,
+schemes::GLWECiphertext add_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& message,
     const Parameters& params
 );
 
+schemes::GLWECiphertext sub_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& message,
+    const Parameters& params
+);
+
+schemes::GLWECiphertext multiply_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& plain,
+    const Parameters& params
+);
+
+schemes::GLWECiphertext multiply_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params
+);
+
+schemes::GLWECiphertext multiply_plain_accumulate_glwe(
+    const std::vector<schemes::GLWECiphertext>& cts,
+    const std::vector<PreparedPlaintext>& plains,
+    const Parameters& params
+);
+
+// View overloads of the linear operations, writing into caller buffers; out
+// may alias an input. A trivial input's missing mask counts as zero, and out
+// needs a mask whenever the result has one (a trivial-only result zeroes it).
+// Views carry no noise estimate.
+void add_lwe(
+    schemes::ConstLWECiphertextView ct1,
+    schemes::ConstLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+);
+
+void subtract_lwe(
+    schemes::ConstLWECiphertextView ct1,
+    schemes::ConstLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+);
+
+void scalar_multiply_lwe(
+    schemes::ConstLWECiphertextView ct,
+    int64 scalar,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+);
+
+void add_plain_lwe(
+    schemes::ConstLWECiphertextView ct,
+    int64 message,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+);
+
+void sub_plain_lwe(
+    schemes::ConstLWECiphertextView ct,
+    int64 message,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+);
+
+void add_rlwe(
+    schemes::ConstRLWECiphertextView ct1,
+    schemes::ConstRLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+);
+
+void subtract_rlwe(
+    schemes::ConstRLWECiphertextView ct1,
+    schemes::ConstRLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+);
+
+void scalar_multiply_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    int64 scalar,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+);
+
+void add_plain_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+);
+
+void sub_plain_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+);
+
+void multiply_plain_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+);
+
+void add_glwe(
+    schemes::ConstGLWECiphertextView ct1,
+    schemes::ConstGLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+);
+
+void subtract_glwe(
+    schemes::ConstGLWECiphertextView ct1,
+    schemes::ConstGLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+);
+
+void scalar_multiply_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    int64 scalar,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+);
+
+void add_plain_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+);
+
+void sub_plain_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+);
+
+void multiply_plain_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+);
+
 std::vector<int64> decompose(int64 value, int64 base, int levels);
 
 }
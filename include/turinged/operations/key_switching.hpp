@@ -0,0 +1,60 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/schemes/lwe.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Unsigned base-beta digits of every coefficient, least significant first:
+// a = sum_j digits[j] * beta^j (mod q)
+std::vector<Polynomial> gadget_decompose(const Polynomial& a, int64 beta, int levels);
+
+// RLWE encryption (under the key's target secret) of c * s', where s' is the
+// key's source secret: b - a*s = c*s' + small noise
+schemes::RLWECiphertext key_switch_component(
+    const Polynomial& c,
+    const keys::RLWEKeySwitchKey& ksk,
+    const Parameters& params
+);
+
+// Re-encrypts a ciphertext under s' as a ciphertext under s
+schemes::RLWECiphertext key_switch_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWEKeySwitchKey& ksk,
+    const Parameters& params
+);
+
+// Re-encrypts an LWE ciphertext under the key's source key under its target key
+schemes::LWECiphertext key_switch_lwe(
+    const schemes::LWECiphertext& ct,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& params
+);
+
+schemes::LWECiphertext key_switch_lwe(
+    const schemes::LWECiphertext& ct,
+    const keys::LWEKeySwitchKey& ksk,
+    const Parameters& params
+);
+
+// View overload; out has dimension n_out and must not overlap ct
+void key_switch_lwe(
+    schemes::ConstLWECiphertextView ct,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+);
+
+// Re-encrypts a GLWE ciphertext under s'_0..s'_{k'-1} under the key's target GLWE key
+schemes::GLWECiphertext key_switch_glwe(
+    const schemes::GLWECiphertext& ct,
+    const keys::GLWEKeySwitchKey& ksk,
+    const Parameters& params
+);
+
+}
+}
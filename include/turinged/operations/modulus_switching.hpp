@@ -0,0 +1,44 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/schemes/lwe.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Modulus switching q -> q_new: every coefficient becomes round(x * q_new / q).
+// The result decrypts under the same key with params.q replaced by q_new.
+schemes::LWECiphertext modulus_switch_lwe(
+    const schemes::LWECiphertext& ct,
+    const Parameters& params,
+    int64 q_new
+);
+
+schemes::RLWECiphertext modulus_switch_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Parameters& params,
+    int64 q_new
+);
+
+schemes::GLWECiphertext modulus_switch_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Parameters& params,
+    int64 q_new
+);
+
+// Batch LWE switch, e.g. to 2N before blind rotation. Ciphertexts are split
+// across num_threads threads (0 = hardware concurrency).
+std::vector<schemes::LWECiphertext> modulus_switch_lwe_batch(
+    const std::vector<schemes::LWECiphertext>& cts,
+    const Parameters& params,
+    int64 q_new,
+    std::size_t num_threads = 0
+);
+
+// Returns params with q replaced by q_new (n, t and noise_bound unchanged)
+Parameters switched_parameters(const Parameters& params, int64 q_new);
+
+}
+}
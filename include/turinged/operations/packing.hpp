@@ -0,0 +1,46 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/schemes/lwe.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Galois elements 2^j + 1 for j = 1..log2(n), used by the packing tree and trace
+std::vector<uint64> packing_galois_elements(std::size_t n);
+
+// RLWE ciphertext whose constant coefficient decrypts like the LWE ciphertext.
+// The LWE key must be extract_lwe_secret_key(sk) of the ring key.
+schemes::RLWECiphertext lwe_to_rlwe(
+    const schemes::LWECiphertext& ct,
+    const Parameters& params
+);
+
+schemes::GLWECiphertext lwe_to_glwe(
+    const schemes::LWECiphertext& ct,
+    const Parameters& params
+);
+
+// Packs up to n LWE ciphertexts into one RLWE ciphertext with the automorphism
+// tree: ciphertext j lands in coefficient j * (n / m), where m is cts.size()
+// rounded up to a power of two, and all other coefficients decrypt to zero.
+// Each tree level is processed in parallel. q must be odd (n is inverted mod q).
+schemes::RLWECiphertext pack_lwe_rlwe(
+    const std::vector<schemes::LWECiphertext>& cts,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params,
+    std::size_t num_threads = 0
+);
+
+schemes::GLWECiphertext pack_lwe_glwe(
+    const std::vector<schemes::LWECiphertext>& cts,
+    const keys::GLWEGaloisKeys& gk,
+    const Parameters& params,
+    std::size_t num_threads = 0
+);
+
+}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+#include "turinged/schemes/rns_rlwe.hpp"
+#include "turinged/schemes/rns_glwe.hpp"
+
+namespace turinged {
+namespace operations {
+
+// Modulus chain: drop_level divides by the last prime q_l and rounds, moving a
+// ciphertext from level l to l-1 without changing its plaintext
+schemes::RNSRLWECiphertext drop_level_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct,
+    const rns::RNSParameters& params
+);
+
+schemes::RNSRLWECiphertext mod_switch_to_level_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct,
+    std::size_t level,
+    const rns::RNSParameters& params
+);
+
+schemes::RNSGLWECiphertext drop_level_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct,
+    const rns::RNSParameters& params
+);
+
+schemes::RNSGLWECiphertext mod_switch_to_level_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct,
+    std::size_t level,
+    const rns::RNSParameters& params
+);
+
+// RNS RLWE Homomorphic Operations. Binary operations first bring both operands
+// down to the lower of their two levels.
+schemes::RNSRLWECiphertext add_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct1,
+    const schemes::RNSRLWECiphertext& ct2,
+    const rns::RNSParameters& params
+);
+
+schemes::RNSRLWECiphertext subtract_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct1,
+    const schemes::RNSRLWECiphertext& ct2,
+    const rns::RNSParameters& params
+);
+
+// BFV multiplication at level l >= 1: exact tensor in Q_l*P, HPS scale-and-round
+// by t/Q_l, relinearisation with the RNS digit decomposition, then a drop to
+// level l-1 so later operations run on one residue fewer
+schemes::RNSRLWECiphertext multiply_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct1,
+    const schemes::RNSRLWECiphertext& ct2,
+    const keys::RNSRelinKey& rlk,
+    const rns::RNSParameters& params
+);
+
+// RNS GLWE Homomorphic Operations
+schemes::RNSGLWECiphertext add_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct1,
+    const schemes::RNSGLWECiphertext& ct2,
+    const rns::RNSParameters& params
+);
+
+schemes::RNSGLWECiphertext subtract_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct1,
+    const schemes::RNSGLWECiphertext& ct2,
+    const rns::RNSParameters& params
+);
+
+schemes::RNSGLWECiphertext multiply_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct1,
+    const schemes::RNSGLWECiphertext& ct2,
+    const keys::RNSRelinKey& rlk,
+    const rns::RNSParameters& params
+);
+
+// GLWE encryption (under the key's target secret) of x * s', where s' is the
+// key's source secret; x is a coefficient-form polynomial over Q_l for any level l
+schemes::RNSGLWECiphertext key_switch_component_rns(
+    const rns::RNSPolynomial& x,
+    const keys::RNSKeySwitchKey& ksk,
+    const rns::RNSParameters& params
+);
+
+}
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace turinged {
+namespace params {
+
+// Parameter selection for the single-modulus RLWE/GLWE schemes. A candidate
+// (n, q, k, noise_bound, beta, levels) is accepted when the lattice model below
+// puts its security at or above the target and the noise model of noise.hpp
+// keeps the decryption failure probability of the circuit's critical path under
+// the target, with a margin for the spread of the noise between keys; among
+// accepted candidates the one whose operation mix is cheapest under a cost
+// model wins. q is searched over powers of two, where the noise
+// model is tight, and must leave room for the exact NTT products (tensor,
+// plaintext product) and the 64-bit key-switching accumulator.
+
+// ========== Security model ==========
+//
+// Fit to the homomorphicencryption.org standard tables (classical, ternary
+// secret, sigma = 3.19), which were produced with the lattice estimator: the
+// cost of the best attack grows as c(n) * n / log2(q / sigma), with c(n)
+// interpolated over the table in log2(n), taking the smallest c across its 128,
+// 192 and 256-bit columns and clamping outside n in [1024, 32768]. keys:: draws
+// binary secrets, which hybrid attacks exploit somewhat better than ternary
+// ones; the fit does not capture that, so leave a margin for production use.
+// Below the table's sigma small-noise attacks take over, so it is also the
+// floor on the noise of every selected set.
+
+constexpr double MIN_NOISE_STDDEV = 3.19;
+
+// Estimated bits of security of LWE with `dimension` (k * n for GLWE), modulus
+// q and error standard deviation sigma
+double estimated_security_bits(std::size_t dimension, int64 q, double sigma);
+
+// Smallest error standard deviation reaching security_bits, at least MIN_NOISE_STDDEV
+double min_noise_stddev(std::size_t dimension, int64 q, int security_bits);
+
+// Smallest noise_bound whose uniform noise on [-B, B] has at least that deviation
+int64 noise_bound_for_stddev(double sigma);
+
+// ========== Cost model ==========
+
+// Single-threaded seconds per call at one (n, k). In this library the cost of
+// an operation does not depend on q except through the gadget level count, so
+// key switching is split into a fixed part and a part per level.
+struct OperationCosts {
+    double encrypt;                 // secret key
+    double public_key_encrypt;
+    double decrypt;
+    double add;
+    double multiply_plain;          // prepared plaintext
+    double tensor;                  // infinity when k > 1 (no GLWE tensor product)
+    double key_switch_fixed;        // relinearisation or rotation, excluding the levels
+    double key_switch_per_level;
+};
+
+// Transform-count estimate with nominal per-butterfly and per-coefficient times
+OperationCosts model_operation_costs(std::size_t n, std::size_t k);
+
+// Times the library's own operations at q = 2^40, running each for at least
+// min_time seconds; key switching is fitted from rotations at 2 and 8 levels
+OperationCosts measure_operation_costs(std::size_t n, std::size_t k, double min_time = 0.02);
+
+// Called once per (n, k) that has an accepted candidate
+using CostFunction = std::function<OperationCosts(std::size_t n, std::size_t k)>;
+
+// ========== Selection ==========
+
+// Calls per evaluation of the workload
+struct OperationMix {
+    double encryptions = 0.0;
+    double decryptions = 0.0;
+    double additions = 0.0;
+    double plaintext_multiplies = 0.0;
+    double multiplies = 0.0;            // tensor + relinearisation
+    double rotations = 0.0;
+
+    bool empty() const {
+        return encryptions == 0.0 && decryptions == 0.0 && additions == 0.0 &&
+               plaintext_multiplies == 0.0 && multiplies == 0.0 && rotations == 0.0;
+    }
+};
+
+struct Requirements {
+    int security_bits = 128;
+    int64 t = 16;
+    double failure_probability = std::ldexp(1.0, -40);  // of one decrypted ciphertext
+    bool public_key = false;                            // inputs encrypted under a public key
+
+    // The noise model is a mean over keys and plaintexts, while the coherent
+    // key-switching error is fixed by the key: single keys land several times
+    // above it. The failure probability is taken at this multiple of the
+    // predicted variance.
+    double variance_margin = 16.0;
+
+    // Critical path of the circuit, for the noise: `depth` ciphertext products
+    // in sequence. Each level (the only level when depth is 0) is followed by
+    // plaintext_multiplies uniform plaintext products and `rotations` key
+    // switches, and then by a sum of fan_in such ciphertexts.
+    int depth = 0;
+    std::size_t fan_in = 1;
+    std::size_t plaintext_multiplies = 0;
+    std::size_t rotations = 0;
+
+    // Workload priced by the cost model; left empty it is derived from the
+    // critical path plus one encryption per input and one decryption
+    OperationMix mix;
+
+    std::size_t min_n = 256;
+    std::size_t max_n = 32768;
+    std::size_t max_k = 4;                              // only k = 1 when depth > 0
+};
+
+struct ParameterSet {
+    Parameters params;
+    std::size_t k;
+    int64 beta;                     // 0 when the circuit needs no key switching
+    int levels;
+    double security_bits;
+    double variance;                // predicted error variance at the end of the critical path
+    double failure_probability;     // at variance_margin times that variance
+    double cost;                    // seconds per evaluation of the mix
+
+    ParameterSet() : params(0, 0, 0, 0), k(0), beta(0), levels(0), security_bits(0.0),
+                     variance(0.0), failure_probability(0.0), cost(0.0) {}
+};
+
+OperationMix operation_mix(const Requirements& req);
+
+// Error variance after the critical path of req under (params, k, beta, levels),
+// without the margin; plaintexts are taken uniform mod t
+double path_variance(const Requirements& req, const Parameters& params, std::size_t k, int64 beta, int levels);
+
+// Cheapest accepted candidate of every (n, k), fastest first; empty if none
+std::vector<ParameterSet> feasible_parameters(const Requirements& req, const CostFunction& costs = model_operation_costs);
+
+// Fastest accepted candidate; throws if there is none
+ParameterSet select_parameters(const Requirements& req, const CostFunction& costs = model_operation_costs);
+
+}
+}
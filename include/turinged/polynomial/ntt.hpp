@@ -0,0 +1,86 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/polynomial/poly_view.hpp"
+#include <array>
+#include <memory>
+
+namespace turinged {
+namespace polynomial {
+
+// Twiddle factors for the length-n negacyclic NTT modulo a prime p = 1 (mod 2n).
+// Powers are stored in bit-reversed order together with their Shoup constants.
+struct NTTTables {
+    std::size_t n;
+    uint64 p;
+    std::vector<uint64> psi_rev;
+    std::vector<uint64> psi_rev_shoup;
+    std::vector<uint64> psi_inv_rev;
+    std::vector<uint64> psi_inv_rev_shoup;
+    uint64 n_inv;
+    uint64 n_inv_shoup;
+};
+
+// Tables are built once per (n, p) and shared between callers and threads
+std::shared_ptr<const NTTTables> get_ntt_tables(std::size_t n, uint64 p);
+
+// In-place transforms on values in [0, p). After ntt_forward, index i holds the
+// evaluation at psi^(2 * bitrev(i) + 1).
+void ntt_forward(uint64* a, const NTTTables& tables);
+
+void ntt_inverse(uint64* a, const NTTTables& tables);
+
+// Two NTT primes just below 2^62 (both = 1 mod 2^17, so n <= 65536). Their
+// product (~2^124) is large enough to hold exact integer products of
+// centered polynomials, which are then reduced modulo an arbitrary q.
+constexpr std::size_t EXACT_PRIME_COUNT = 2;
+constexpr std::array<uint64, EXACT_PRIME_COUNT> EXACT_PRIMES = {
+    4611686018425815041ULL,
+    4611686018423062529ULL
+};
+
+// Integer polynomial held as NTT-domain residues modulo EXACT_PRIMES
+struct NTTPolynomial {
+    std::array<core::PooledVector<uint64>, EXACT_PRIME_COUNT> residues;
+
+    NTTPolynomial() = default;
+    explicit NTTPolynomial(std::size_t n) {
+        for (auto& r : residues) r.assign(n, 0);
+    }
+
+    std::size_t size() const { return residues[0].size(); }
+};
+
+// True when n is a supported power of two and a sum of `terms` products of
+// centered mod-q polynomials stays within the exact range.
+bool ntt_supported(std::size_t n, int64 q, std::size_t terms = 1);
+
+// Centered lift of a mod-q polynomial, then forward NTT
+NTTPolynomial to_ntt(const Polynomial& a, int64 q);
+
+NTTPolynomial to_ntt(ConstPolynomialView a);
+
+NTTPolynomial ntt_multiply(const NTTPolynomial& a, const NTTPolynomial& b);
+
+// acc += a * b (pointwise)
+void ntt_multiply_accumulate(NTTPolynomial& acc, const NTTPolynomial& a, const NTTPolynomial& b);
+
+void ntt_add_inplace(NTTPolynomial& acc, const NTTPolynomial& a);
+
+void ntt_negate_inplace(NTTPolynomial& a);
+
+// Galois automorphism X -> X^galois_elt applied directly in the NTT domain,
+// where it is a permutation of the evaluation points
+NTTPolynomial ntt_automorphism(const NTTPolynomial& a, uint64 galois_elt);
+
+// Inverse NTT and CRT composition to exact signed coefficients
+core::PooledVector<int128> from_ntt_exact(const NTTPolynomial& a);
+
+// Inverse NTT, CRT composition and reduction into [0, q)
+Polynomial from_ntt(const NTTPolynomial& a, int64 q);
+
+// Same, written into out (reduced mod out.q)
+void from_ntt(const NTTPolynomial& a, PolynomialView out);
+
+}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include <type_traits>
+
+namespace turinged {
+namespace polynomial {
+
+// Non-owning polynomial: n coefficients mod q at data, e.g. inside a network
+// frame, a mapped file or an arena block. A view never allocates or frees and
+// must not outlive the buffer it points into. A null data pointer stands for
+// an absent component (the mask of a trivial ciphertext).
+template <typename T>
+struct BasicPolynomialView {
+    T* data;
+    std::size_t n;
+    int64 q;
+
+    BasicPolynomialView() : data(nullptr), n(0), q(0) {}
+    BasicPolynomialView(T* data, std::size_t n, int64 q) : data(data), n(n), q(q) {}
+
+    // Mutable views convert to read-only ones
+    template <typename U, typename = typename std::enable_if<
+        !std::is_same<U, T>::value && std::is_same<const U, T>::value>::type>
+    BasicPolynomialView(const BasicPolynomialView<U>& other) : data(other.data), n(other.n), q(other.q) {}
+
+    bool empty() const { return data == nullptr; }
+    T& operator[](std::size_t i) const { return data[i]; }
+    T* begin() const { return data; }
+    T* end() const { return data + n; }
+};
+
+using PolynomialView = BasicPolynomialView<int64>;
+using ConstPolynomialView = BasicPolynomialView<const int64>;
+
+// Views of an owned polynomial; an empty polynomial gives an empty view
+inline PolynomialView view(Polynomial& a, int64 q) {
+    return PolynomialView(a.empty() ? nullptr : a.data(), a.size(), q);
+}
+
+inline ConstPolynomialView view(const Polynomial& a, int64 q) {
+    return ConstPolynomialView(a.empty() ? nullptr : a.data(), a.size(), q);
+}
+
+}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "turinged/core/types.hpp"
+#include "turinged/polynomial/poly_view.hpp"
 #include <string>
 
 namespace turinged {
@@ -14,8 +15,31 @@ Polynomial scalar_multiply(const Polynomial& a, int64 scalar, int64 q);
 
 Polynomial negate(const Polynomial& a, int64 q);
 
+// Uses the NTT path (see ntt.hpp) for power-of-two n, schoolbook otherwise
 Polynomial negacyclic_multiply(const Polynomial& a, const Polynomial& b, int64 q);
 
+Polynomial negacyclic_multiply_schoolbook(const Polynomial& a, const Polynomial& b, int64 q);
+
+// View overloads write their result into `out`, which may alias an input.
+// Every view must have the same n and q.
+void add(ConstPolynomialView a, ConstPolynomialView b, PolynomialView out);
+
+void subtract(ConstPolynomialView a, ConstPolynomialView b, PolynomialView out);
+
+void scalar_multiply(ConstPolynomialView a, int64 scalar, PolynomialView out);
+
+void negate(ConstPolynomialView a, PolynomialView out);
+
+void negacyclic_multiply(ConstPolynomialView a, ConstPolynomialView b, PolynomialView out);
+
+// a * X^r in Z_q[X]/(X^n + 1), r taken mod 2n
+Polynomial multiply_monomial(const Polynomial& a, std::size_t r, int64 q);
+
+// Galois automorphism a(X) -> a(X^galois_elt) in Z_q[X]/(X^n + 1); galois_elt must be odd
+Polynomial automorphism(const Polynomial& a, uint64 galois_elt, int64 q);
+
+Polynomial switch_modulus(const Polynomial& a, int64 q, int64 q_new);
+
 std::vector<int64> center_representation(const Polynomial& a, int64 q);
 
 bool is_equal(const Polynomial& a, const Polynomial& b);
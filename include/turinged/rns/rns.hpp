@@ -0,0 +1,100 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include <memory>
+
+namespace turinged {
+namespace rns {
+
+// `count` distinct primes p < 2^bits with p = 1 (mod 2n), largest first,
+// skipping anything in `exclude`. bits must be at most 61.
+std::vector<uint64> generate_ntt_primes(int bits, std::size_t n, std::size_t count, const std::vector<uint64>& exclude = {});
+
+// A set of word-sized NTT primes q_0..q_{k-1} with Q = prod q_i
+struct RNSBase {
+    std::size_t n;
+    std::vector<uint64> primes;
+    std::vector<std::shared_ptr<const polynomial::NTTTables>> tables;
+    std::vector<uint64> q_hat_inv;          // (Q / q_i)^-1 mod q_i
+    std::vector<long double> inv_primes;    // 1 / q_i
+
+    RNSBase() : n(0) {}
+
+    std::size_t size() const { return primes.size(); }
+};
+
+RNSBase create_rns_base(std::size_t n, const std::vector<uint64>& primes);
+
+// Base made of the first `count` primes of `base`
+RNSBase prefix_base(const RNSBase& base, std::size_t count);
+
+// log2(Q), for sizing decisions
+long double log2_modulus(const RNSBase& base);
+
+// Polynomial in Z_Q[X]/(X^n + 1) as one residue vector per prime, either in
+// coefficient or NTT form
+struct RNSPolynomial {
+    std::vector<std::vector<uint64>> residues;
+    bool ntt_form;
+
+    RNSPolynomial() : ntt_form(false) {}
+    RNSPolynomial(std::size_t prime_count, std::size_t n)
+        : residues(prime_count, std::vector<uint64>(n, 0)), ntt_form(false) {}
+
+    std::size_t prime_count() const { return residues.size(); }
+    std::size_t degree() const { return residues.empty() ? 0 : residues[0].size(); }
+};
+
+// Residues of a polynomial with (small, signed) integer coefficients
+RNSPolynomial to_rns(const Polynomial& coeffs, const RNSBase& base);
+
+void to_ntt_inplace(RNSPolynomial& a, const RNSBase& base);
+
+void from_ntt_inplace(RNSPolynomial& a, const RNSBase& base);
+
+// Element-wise ops; both operands must share the same form
+RNSPolynomial add(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base);
+
+RNSPolynomial subtract(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base);
+
+RNSPolynomial negate(const RNSPolynomial& a, const RNSBase& base);
+
+RNSPolynomial scalar_multiply(const RNSPolynomial& a, int64 scalar, const RNSBase& base);
+
+// Pointwise product of NTT-form polynomials
+RNSPolynomial multiply_ntt(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base);
+
+// acc += a * b, all NTT form. Operands may carry extra trailing primes (such as
+// top-level keys used at a lower level); only the primes of `base` are touched.
+void multiply_accumulate_ntt(RNSPolynomial& acc, const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base);
+
+// Negacyclic product of coefficient-form polynomials, returned in coefficient form
+RNSPolynomial multiply(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base);
+
+// Keeps the residues of the first `count` primes
+RNSPolynomial drop_primes(const RNSPolynomial& a, std::size_t count);
+
+// Precomputed constants for exact conversion from base Q to base P
+struct BaseConverter {
+    RNSBase from;
+    RNSBase to;
+    std::vector<std::vector<uint64>> q_hat_mod_p;   // [i][j] (Q / q_i) mod p_j
+    std::vector<uint64> q_mod_p;                    // Q mod p_j
+};
+
+BaseConverter create_base_converter(const RNSBase& from, const RNSBase& to);
+
+// Fast base conversion of the centered representative of each coefficient
+// (coefficient form). The overflow count is recovered in floating point, which
+// is exact unless a coefficient lies within ~2^-50 Q of +-Q/2.
+RNSPolynomial convert_base(const RNSPolynomial& x, const BaseConverter& converter);
+
+// CRT composition: each coefficient in [0, Q) as little-endian 64-bit limbs
+std::vector<std::vector<uint64>> compose(const RNSPolynomial& x, const RNSBase& base);
+
+// Centered CRT composition as long double; exact up to 64 bits of precision
+std::vector<long double> compose_centered(const RNSPolynomial& x, const RNSBase& base);
+
+}
+}
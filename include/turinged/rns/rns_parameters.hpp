@@ -0,0 +1,83 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/rns/rns.hpp"
+
+namespace turinged {
+namespace rns {
+
+// Constants for one level of the modulus chain, Q_l = q_0 * ... * q_l.
+// The auxiliary base P is shared by all levels; everything from qp_base down to
+// scale_t_q_inv is only filled in for BFV parameters.
+struct RNSLevel {
+    RNSBase q_base;
+    std::vector<uint64> last_prime_inv;                 // q_l^-1 mod q_i for i < l
+
+    RNSBase qp_base;                    // q_base primes followed by the P primes
+
+    BaseConverter q_to_p;
+    BaseConverter p_to_q;
+
+    std::vector<uint64> delta_mod_q;    // floor(Q_l / t) mod q_i
+
+    // Scale-and-round round(t * x / Q_l) from base Q_l*P into base P:
+    // t*P/q_i = I_i + F_i with I_i integer and F_i in [0, 1)
+    std::vector<uint64> scale_y_factor;                 // (P * Q_l/q_i)^-1 mod q_i
+    std::vector<long double> scale_fraction;            // F_i
+    std::vector<std::vector<uint64>> scale_integer;     // [i][j] I_i mod p_j
+    std::vector<uint64> scale_t_q_inv;                  // t * Q_l^-1 mod p_j
+};
+
+// BFV parameters over a leveled RNS modulus chain. levels[l] works modulo the
+// first l+1 primes; fresh ciphertexts live at the top level. The auxiliary
+// base P is sized so that tensor products are exact in Q*P and
+// round(t * x / Q) fits in P at every level. Approximate (CKKS) parameters
+// have t = 0 and no auxiliary base.
+struct RNSParameters {
+    std::size_t n;
+    int64 t;
+    int64 noise_bound;
+
+    RNSBase p_base;
+    std::vector<RNSLevel> levels;
+
+    RNSParameters() : n(0), t(0), noise_bound(0) {}
+
+    std::size_t top_level() const { return levels.size() - 1; }
+    const RNSLevel& level(std::size_t l) const;
+    const RNSBase& q_base(std::size_t l) const { return level(l).q_base; }
+};
+
+// prime_count primes of prime_bits bits each (prime_bits <= 61, all primes > t),
+// giving levels 0 .. prime_count-1
+RNSParameters create_rns_parameters(
+    std::size_t n,
+    int64 t,
+    int64 noise_bound,
+    int prime_bits,
+    std::size_t prime_count
+);
+
+// CKKS chain of prime_count primes of prime_bits bits each. Rescaling divides
+// by a prime, so prime_bits should be close to log2 of the encoding scale.
+RNSParameters create_ckks_parameters(
+    std::size_t n,
+    int64 noise_bound,
+    int prime_bits,
+    std::size_t prime_count
+);
+
+// Level of a polynomial over Q_l, from its number of residues
+std::size_t level_of(const RNSPolynomial& a);
+
+// Delta_l * m over Q_l for a plaintext polynomial m with coefficients mod t
+RNSPolynomial scale_message(const Polynomial& message, const RNSParameters& params, std::size_t level);
+
+// round(t * x / Q_l) mod t for a coefficient-form phase x over Q_l
+Polynomial scale_to_plaintext(const RNSPolynomial& phase, const RNSParameters& params);
+
+// round(x / q_l): maps a coefficient-form polynomial over Q_l to Q_{l-1}
+RNSPolynomial rescale_by_last_prime(const RNSPolynomial& x, const RNSParameters& params);
+
+}
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/polynomial/poly_view.hpp"
+#include <type_traits>
+
+namespace turinged {
+namespace schemes {
+
+// Non-owning ciphertexts over caller buffers. As with the owning types, a null
+// mask marks a trivial ciphertext. The contiguous constructors take one block
+// laid out mask first, body last -- the layout of LWE key switching key entries
+// and of the GLWE samples inside a (non-transformed) bootstrapping key -- and
+// words() gives the block size. The Const variants are read-only; mutable views
+// convert to them implicitly.
+
+template <typename T, typename U>
+using EnableIfConstOf = typename std::enable_if<!std::is_same<U, T>::value && std::is_same<const U, T>::value>::type;
+
+template <typename T>
+struct BasicLWECiphertextView {
+    T* a;                   // dim mask coefficients, or nullptr
+    T* b;
+    std::size_t dim;
+    int64 q;
+
+    BasicLWECiphertextView() : a(nullptr), b(nullptr), dim(0), q(0) {}
+    BasicLWECiphertextView(T* a, T* b, std::size_t dim, int64 q) : a(a), b(b), dim(dim), q(q) {}
+    BasicLWECiphertextView(T* data, std::size_t dim, int64 q) : a(data), b(data + dim), dim(dim), q(q) {}
+
+    template <typename U, typename = EnableIfConstOf<T, U>>
+    BasicLWECiphertextView(const BasicLWECiphertextView<U>& other) : a(other.a), b(other.b), dim(other.dim), q(other.q) {}
+
+    static std::size_t words(std::size_t dim) { return dim + 1; }
+    bool is_trivial() const { return a == nullptr; }
+};
+
+template <typename T>
+struct BasicRLWECiphertextView {
+    polynomial::BasicPolynomialView<T> a;
+    polynomial::BasicPolynomialView<T> b;
+
+    BasicRLWECiphertextView() = default;
+    BasicRLWECiphertextView(polynomial::BasicPolynomialView<T> a, polynomial::BasicPolynomialView<T> b) : a(a), b(b) {}
+    BasicRLWECiphertextView(T* data, std::size_t n, int64 q) : a(data, n, q), b(data + n, n, q) {}
+
+    template <typename U, typename = EnableIfConstOf<T, U>>
+    BasicRLWECiphertextView(const BasicRLWECiphertextView<U>& other) : a(other.a), b(other.b) {}
+
+    static std::size_t words(std::size_t n) { return 2 * n; }
+    std::size_t n() const { return b.n; }
+    int64 q() const { return b.q; }
+    bool is_trivial() const { return a.empty(); }
+};
+
+template <typename T>
+struct BasicGLWECiphertextView {
+    T* mask;                // k polynomials back to back, or nullptr
+    T* body;
+    std::size_t k;
+    std::size_t n;
+    int64 q;
+
+    BasicGLWECiphertextView() : mask(nullptr), body(nullptr), k(0), n(0), q(0) {}
+    BasicGLWECiphertextView(T* mask, T* body, std::size_t k, std::size_t n, int64 q)
+        : mask(mask), body(body), k(k), n(n), q(q) {}
+    BasicGLWECiphertextView(T* data, std::size_t k, std::size_t n, int64 q)
+        : mask(data), body(data + k * n), k(k), n(n), q(q) {}
+
+    template <typename U, typename = EnableIfConstOf<T, U>>
+    BasicGLWECiphertextView(const BasicGLWECiphertextView<U>& other)
+        : mask(other.mask), body(other.body), k(other.k), n(other.n), q(other.q) {}
+
+    static std::size_t words(std::size_t k, std::size_t n) { return (k + 1) * n; }
+    bool is_trivial() const { return mask == nullptr; }
+
+    polynomial::BasicPolynomialView<T> d_tilde(std::size_t i) const { return {mask + i * n, n, q}; }
+    polynomial::BasicPolynomialView<T> b() const { return {body, n, q}; }
+};
+
+// l + 1 contiguous GLWE blocks, level j at offset j * GLWE words
+template <typename T>
+struct BasicGLevCiphertextView {
+    T* data;
+    std::size_t k;
+    std::size_t n;
+    int l;
+    int64 q;
+
+    BasicGLevCiphertextView() : data(nullptr), k(0), n(0), l(0), q(0) {}
+    BasicGLevCiphertextView(T* data, std::size_t k, std::size_t n, int l, int64 q)
+        : data(data), k(k), n(n), l(l), q(q) {}
+
+    template <typename U, typename = EnableIfConstOf<T, U>>
+    BasicGLevCiphertextView(const BasicGLevCiphertextView<U>& other)
+        : data(other.data), k(other.k), n(other.n), l(other.l), q(other.q) {}
+
+    static std::size_t words(std::size_t k, std::size_t n, int l) {
+        return (l + 1) * BasicGLWECiphertextView<T>::words(k, n);
+    }
+
+    BasicGLWECiphertextView<T> level(int j) const {
+        return BasicGLWECiphertextView<T>(data + j * BasicGLWECiphertextView<T>::words(k, n), k, n, q);
+    }
+};
+
+// k + 1 contiguous GLev rows (rows i < k encrypt -S_i * M, row k encrypts M);
+// the layout of one GGSW inside a non-transformed bootstrapping key
+template <typename T>
+struct BasicGGSWCiphertextView {
+    T* data;
+    std::size_t k;
+    std::size_t n;
+    int l;
+    int64 q;
+
+    BasicGGSWCiphertextView() : data(nullptr), k(0), n(0), l(0), q(0) {}
+    BasicGGSWCiphertextView(T* data, std::size_t k, std::size_t n, int l, int64 q)
+        : data(data), k(k), n(n), l(l), q(q) {}
+
+    template <typename U, typename = EnableIfConstOf<T, U>>
+    BasicGGSWCiphertextView(const BasicGGSWCiphertextView<U>& other)
+        : data(other.data), k(other.k), n(other.n), l(other.l), q(other.q) {}
+
+    static std::size_t words(std::size_t k, std::size_t n, int l) {
+        return (k + 1) * BasicGLevCiphertextView<T>::words(k, n, l);
+    }
+
+    BasicGLevCiphertextView<T> row(std::size_t i) const {
+        return BasicGLevCiphertextView<T>(data + i * BasicGLevCiphertextView<T>::words(k, n, l), k, n, l, q);
+    }
+};
+
+using LWECiphertextView = BasicLWECiphertextView<int64>;
+using ConstLWECiphertextView = BasicLWECiphertextView<const int64>;
+using RLWECiphertextView = BasicRLWECiphertextView<int64>;
+using ConstRLWECiphertextView = BasicRLWECiphertextView<const int64>;
+using GLWECiphertextView = BasicGLWECiphertextView<int64>;
+using ConstGLWECiphertextView = BasicGLWECiphertextView<const int64>;
+using GLevCiphertextView = BasicGLevCiphertextView<int64>;
+using ConstGLevCiphertextView = BasicGLevCiphertextView<const int64>;
+using GGSWCiphertextView = BasicGGSWCiphertextView<int64>;
+using ConstGGSWCiphertextView = BasicGGSWCiphertextView<const int64>;
+
+}
+}
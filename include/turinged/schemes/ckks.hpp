@@ -0,0 +1,40 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/encoding/ckks_encoder.hpp"
+#include "turinged/rns/rns.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+
+namespace turinged {
+namespace schemes {
+
+// Approximate RLWE ciphertext over level l of an RNS chain, coefficient form:
+// b - a*s = m + e (mod Q_l), where m encodes the slots multiplied by `scale`
+struct CKKSCiphertext {
+    rns::RNSPolynomial a;
+    rns::RNSPolynomial b;
+    double scale;
+
+    CKKSCiphertext() : scale(1.0) {}
+    CKKSCiphertext(std::size_t prime_count, std::size_t n) : a(prime_count, n), b(prime_count, n), scale(1.0) {}
+
+    std::size_t level() const { return rns::level_of(b); }
+};
+
+// Fresh ciphertexts are encrypted at the top level
+CKKSCiphertext encrypt_ckks(
+    const encoding::CKKSPlaintext& plain,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+// Centered coefficients of m + e; decode them with ct.scale
+std::vector<long double> decrypt_ckks(
+    const CKKSCiphertext& ct,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+}
+}
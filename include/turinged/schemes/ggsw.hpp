@@ -8,7 +8,7 @@ namespace turinged {
 namespace schemes {
 
 struct GGSWCiphertext {
-    std::vector<GLevCiphertext> glev_rows;
+    core::PooledVector<GLevCiphertext> glev_rows;
 
     GGSWCiphertext() = default;
     explicit GGSWCiphertext(std::size_t k) : glev_rows(k + 1) {}
@@ -23,6 +23,36 @@ GGSWCiphertext encrypt_ggsw(
     int64 beta
 );
 
+// GGSW ciphertext with seed-compressed rows; row i uses core::derive_seed(seed, i)
+// (and core::derive_seed(noise_seed, i) for its noise)
+struct SeededGGSWCiphertext {
+    core::PooledVector<SeededGLevCiphertext> glev_rows;
+
+    SeededGGSWCiphertext() = default;
+    explicit SeededGGSWCiphertext(std::size_t k) : glev_rows(k + 1) {}
+};
+
+SeededGGSWCiphertext encrypt_ggsw_seeded(
+    const Polynomial& message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed
+);
+
+GGSWCiphertext expand_seeded_ggsw(const SeededGGSWCiphertext& ct, const Parameters& params);
+
+// Secret-key encryption, several times cheaper than the public-key path
+GGSWCiphertext encrypt_ggsw(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta
+);
+
 Polynomial decrypt_ggsw(
     const GGSWCiphertext& ct,
     const keys::GLWESecretKey& sk,
@@ -31,5 +61,34 @@ Polynomial decrypt_ggsw(
     int64 beta
 );
 
+// View overloads; the shape comes from the view. Row i is encrypted as by
+// encrypt_glev_seeded with core::derive_seed(seed, i) / derive_seed(noise_seed, i).
+void encrypt_ggsw_seeded(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed,
+    GGSWCiphertextView out
+);
+
+void encrypt_ggsw(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    GGSWCiphertextView out
+);
+
+void decrypt_ggsw(
+    ConstGGSWCiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int level_idx,
+    int64 beta,
+    polynomial::PolynomialView out
+);
+
 }
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace turinged {
 namespace schemes {
 
 struct GLevCiphertext {
-    std::vector<GLWECiphertext> levels;
+    core::PooledVector<GLWECiphertext> levels;
 
     GLevCiphertext() = default;
     explicit GLevCiphertext(int l) : levels(l + 1) {}
@@ -22,6 +22,37 @@ GLevCiphertext encrypt_glev(
     int64 beta
 );
 
+// GLev ciphertext with every level's mask compressed to a seed.
+// Level j's mask is expanded from core::derive_seed(seed, j); its noise comes
+// from core::derive_seed(noise_seed, j) at encryption time.
+struct SeededGLevCiphertext {
+    uint64 seed;
+    core::PooledVector<Polynomial> bodies;
+
+    SeededGLevCiphertext() : seed(0) {}
+};
+
+SeededGLevCiphertext encrypt_glev_seeded(
+    const Polynomial& message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed
+);
+
+GLevCiphertext expand_seeded_glev(const SeededGLevCiphertext& ct, std::size_t k, const Parameters& params);
+
+// Secret-key encryption: no public-key products, one <mask, s> per level
+GLevCiphertext encrypt_glev(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta
+);
+
 Polynomial decrypt_glev_level(
     const GLevCiphertext& ct,
     const keys::GLWESecretKey& sk,
@@ -30,5 +61,35 @@ Polynomial decrypt_glev_level(
     int64 beta
 );
 
+// View overloads; the level count comes from the view. encrypt_glev_seeded
+// writes the expanded ciphertext, with the same per-level seeds as above.
+void encrypt_glev_seeded(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed,
+    GLevCiphertextView out
+);
+
+void encrypt_glev(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    GLevCiphertextView out
+);
+
+// out carries modulus t
+void decrypt_glev_level(
+    ConstGLevCiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int level_idx,
+    int64 beta,
+    polynomial::PolynomialView out
+);
+
 }
 }
\ No newline at end of file
@@ -2,16 +2,24 @@
 
 #include "turinged/core/types.hpp"
 #include "turinged/keys/keys.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/schemes/ciphertext_view.hpp"
+#include <limits>
 
 namespace turinged {
 namespace schemes {
 
+// An empty mask marks a trivial (noiseless) ciphertext whose phase is b itself
 struct GLWECiphertext {
     Polynomial b;
-    std::vector<Polynomial> d_tilde;
+    core::PooledVector<Polynomial> d_tilde;
+    double noise_variance = std::numeric_limits<double>::quiet_NaN();     // estimate, see noise/noise.hpp
+    double coherent_variance = std::numeric_limits<double>::quiet_NaN();  // its slowly varying part
 
     GLWECiphertext() = default;
     GLWECiphertext(std::size_t k, std::size_t n) : b(n), d_tilde(k, Polynomial(n)) {}
+
+    bool is_trivial() const { return d_tilde.empty(); }
 };
 
 GLWECiphertext encrypt_glwe(
@@ -20,11 +28,101 @@ GLWECiphertext encrypt_glwe(
     const Parameters& params
 );
 
+// Secret key with its polynomials transformed once. Secret-key encryptions
+// against it cost k forward transforms and one inverse for <mask, s>.
+struct PreparedGLWESecretKey {
+    std::size_t k;
+    bool use_ntt;                                   // false if the exact NTT range is too small
+    core::PooledVector<polynomial::NTTPolynomial> s_ntt;
+    core::PooledVector<Polynomial> s;               // coefficient form
+
+    PreparedGLWESecretKey() : k(0), use_ntt(false) {}
+};
+
+PreparedGLWESecretKey prepare_glwe_secret_key(const keys::GLWESecretKey& sk, const Parameters& params);
+
+// Uniform mask polynomials mod q generated deterministically from a seed
+core::PooledVector<Polynomial> glwe_mask_from_seed(uint64 seed, std::size_t k, const Parameters& params);
+
+// GLWE ciphertext with its mask compressed to the seed it was generated from
+struct SeededGLWECiphertext {
+    uint64 seed;
+    Polynomial b;
+
+    SeededGLWECiphertext() : seed(0) {}
+};
+
+// Secret-key encryption of an already scaled plaintext (mod q):
+// b = <mask(seed), s> + scaled + e, with e drawn from a generator seeded by
+// noise_seed. The mask seed is public; noise_seed must stay secret.
+SeededGLWECiphertext encrypt_glwe_seeded_scaled(
+    const Polynomial& scaled,
+    uint64 seed,
+    uint64 noise_seed,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params
+);
+
+SeededGLWECiphertext encrypt_glwe_seeded(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    uint64 seed
+);
+
+GLWECiphertext expand_seeded_glwe(const SeededGLWECiphertext& ct, std::size_t k, const Parameters& params);
+
+// Secret-key encryption with a fresh random mask
+GLWECiphertext encrypt_glwe(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params
+);
+
+// Trivial encryption b = Delta*m with no mask; costs O(n)
+GLWECiphertext trivial_glwe(const Polynomial& message, const Parameters& params);
+
 Polynomial decrypt_glwe(
     const GLWECiphertext& ct,
     const keys::GLWESecretKey& sk,
     const Parameters& params
 );
 
+// View overloads. Plaintext views carry modulus t, ciphertext views modulus q.
+
+// Expands the mask from `seed` straight into out and writes
+// b = <mask, s> + delta * message + e (noise from noise_seed)
+void encrypt_glwe_seeded_scaled(
+    polynomial::ConstPolynomialView message,
+    int64 delta,
+    uint64 seed,
+    uint64 noise_seed,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    GLWECiphertextView out
+);
+
+void encrypt_glwe(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    GLWECiphertextView out
+);
+
+// Phase b - <d_tilde, s> mod q; out may have any modulus, only its buffer is used
+void glwe_phase(
+    ConstGLWECiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    polynomial::PolynomialView out
+);
+
+void decrypt_glwe(
+    ConstGLWECiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    polynomial::PolynomialView out
+);
+
 }
 }
\ No newline at end of file
@@ -2,29 +2,85 @@
 
 #include "turinged/core/types.hpp"
 #include "turinged/keys/keys.hpp"
+#include "turinged/schemes/ciphertext_view.hpp"
+#include <limits>
 
 namespace turinged {
 namespace schemes {
 
+// An empty mask marks a trivial (noiseless) ciphertext whose phase is b itself
 struct LWECiphertext {
-    std::vector<int64> a;
+    Polynomial a;
     int64 b;
+    double noise_variance = std::numeric_limits<double>::quiet_NaN();     // estimate, see noise/noise.hpp
+    double coherent_variance = std::numeric_limits<double>::quiet_NaN();  // its slowly varying part
 
     LWECiphertext() = default;
     LWECiphertext(std::size_t k) : a(k), b(0) {}
+
+    bool is_trivial() const { return a.empty(); }
 };
 
+inline LWECiphertextView view(LWECiphertext& ct, int64 q) {
+    return LWECiphertextView(ct.a.empty() ? nullptr : ct.a.data(), &ct.b, ct.a.size(), q);
+}
+
+inline ConstLWECiphertextView view(const LWECiphertext& ct, int64 q) {
+    return ConstLWECiphertextView(ct.a.empty() ? nullptr : ct.a.data(), &ct.b, ct.a.size(), q);
+}
+
 LWECiphertext encrypt_lwe(
     int64 message,
     const keys::LWESecretKey& sk,
     const Parameters& params
 );
 
+// Public-key encryption: a random subset sum of the key's zero encryptions plus Delta*m
+LWECiphertext encrypt_lwe(
+    int64 message,
+    const keys::LWEPublicKey& pk,
+    const Parameters& params
+);
+
+// Many messages against one public key. Subset selections are drawn up front and
+// the sums run as a blocked binary matrix product over the key matrix, split
+// across num_threads threads (0 = hardware concurrency).
+std::vector<LWECiphertext> encrypt_lwe_batch(
+    const std::vector<int64>& messages,
+    const keys::LWEPublicKey& pk,
+    const Parameters& params,
+    std::size_t num_threads = 0
+);
+
+// Trivial encryption b = Delta*m with no mask; costs no sampling
+LWECiphertext trivial_lwe(int64 message, const Parameters& params);
+
 int64 decrypt_lwe(
     const LWECiphertext& ct,
     const keys::LWESecretKey& sk,
     const Parameters& params
 );
 
+// View overloads: encrypt into a caller buffer whose dim matches the key
+void encrypt_lwe(
+    int64 message,
+    const keys::LWESecretKey& sk,
+    const Parameters& params,
+    LWECiphertextView out
+);
+
+void encrypt_lwe(
+    int64 message,
+    const keys::LWEPublicKey& pk,
+    const Parameters& params,
+    LWECiphertextView out
+);
+
+int64 decrypt_lwe(
+    ConstLWECiphertextView ct,
+    const keys::LWESecretKey& sk,
+    const Parameters& params
+);
+
 }
 }
\ No newline at end of file
@@ -2,29 +2,86 @@
 
 #include "turinged/core/types.hpp"
 #include "turinged/keys/keys.hpp"
+#include "turinged/schemes/ciphertext_view.hpp"
+#include <limits>
 
 namespace turinged {
 namespace schemes {
 
+// An empty mask marks a trivial (noiseless) ciphertext whose phase is b itself
 struct RLWECiphertext {
     Polynomial a;
     Polynomial b;
+    double noise_variance = std::numeric_limits<double>::quiet_NaN();     // estimate, see noise/noise.hpp
+    double coherent_variance = std::numeric_limits<double>::quiet_NaN();  // its slowly varying part
 
     RLWECiphertext() = default;
     RLWECiphertext(std::size_t n) : a(n), b(n) {}
+
+    bool is_trivial() const { return a.empty(); }
 };
 
+inline RLWECiphertextView view(RLWECiphertext& ct, int64 q) {
+    return RLWECiphertextView(polynomial::view(ct.a, q), polynomial::view(ct.b, q));
+}
+
+inline ConstRLWECiphertextView view(const RLWECiphertext& ct, int64 q) {
+    return ConstRLWECiphertextView(polynomial::view(ct.a, q), polynomial::view(ct.b, q));
+}
+
 RLWECiphertext encrypt_rlwe(
     const Polynomial& message,
     const keys::RLWESecretKey& sk,
     const Parameters& params
 );
 
+// Public-key encryption with a binary u: (a*u + e2, b*u + e1 + Delta*m)
+RLWECiphertext encrypt_rlwe(
+    const Polynomial& message,
+    const keys::RLWEPublicKey& pk,
+    const Parameters& params
+);
+
+// Many messages against one public key; the key is transformed once and each
+// message costs one forward and two inverse transforms
+std::vector<RLWECiphertext> encrypt_rlwe_batch(
+    const std::vector<Polynomial>& messages,
+    const keys::RLWEPublicKey& pk,
+    const Parameters& params,
+    std::size_t num_threads = 0
+);
+
+// Trivial encryption b = Delta*m with no mask; costs O(n)
+RLWECiphertext trivial_rlwe(const Polynomial& message, const Parameters& params);
+
 Polynomial decrypt_rlwe(
     const RLWECiphertext& ct,
     const keys::RLWESecretKey& sk,
     const Parameters& params
 );
 
+// View overloads. Plaintext views carry modulus t, ciphertext views modulus q;
+// output views must have room for the full result.
+void encrypt_rlwe(
+    polynomial::ConstPolynomialView message,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params,
+    RLWECiphertextView out
+);
+
+void encrypt_rlwe(
+    polynomial::ConstPolynomialView message,
+    const keys::RLWEPublicKey& pk,
+    const Parameters& params,
+    RLWECiphertextView out
+);
+
+void decrypt_rlwe(
+    ConstRLWECiphertextView ct,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params,
+    polynomial::PolynomialView out
+);
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/rns/rns.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+
+namespace turinged {
+namespace schemes {
+
+// GLWE ciphertext over level l of the RNS modulus chain, coefficient form:
+// b - sum_i d_tilde[i] * s_i = Delta_l*m + e (mod Q_l)
+struct RNSGLWECiphertext {
+    rns::RNSPolynomial b;
+    std::vector<rns::RNSPolynomial> d_tilde;
+
+    RNSGLWECiphertext() = default;
+    RNSGLWECiphertext(std::size_t k, std::size_t prime_count, std::size_t n)
+        : b(prime_count, n), d_tilde(k, rns::RNSPolynomial(prime_count, n)) {}
+
+    std::size_t level() const { return rns::level_of(b); }
+};
+
+// Fresh ciphertexts are encrypted at the top level
+RNSGLWECiphertext encrypt_glwe_rns(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+Polynomial decrypt_glwe_rns(
+    const RNSGLWECiphertext& ct,
+    const keys::GLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "turinged/core/types.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/rns/rns.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+
+namespace turinged {
+namespace schemes {
+
+// RLWE ciphertext over level l of the RNS modulus chain, coefficient form:
+// b - a*s = Delta_l*m + e (mod Q_l). The level is the number of residues minus one.
+struct RNSRLWECiphertext {
+    rns::RNSPolynomial a;
+    rns::RNSPolynomial b;
+
+    RNSRLWECiphertext() = default;
+    RNSRLWECiphertext(std::size_t prime_count, std::size_t n) : a(prime_count, n), b(prime_count, n) {}
+
+    std::size_t level() const { return rns::level_of(b); }
+};
+
+// Fresh ciphertexts are encrypted at the top level
+RNSRLWECiphertext encrypt_rlwe_rns(
+    const Polynomial& message,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+Polynomial decrypt_rlwe_rns(
+    const RNSRLWECiphertext& ct,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+);
+
+}
+}
@@ -3,22 +3,61 @@
 // Core types and utilities
 #include "turinged/core/types.hpp"
 #include "turinged/core/math_utils.hpp"
+#include "turinged/core/pool_allocator.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/core/trace.hpp"
+#include "turinged/core/parallel.hpp"
+#include "turinged/core/bounded_queue.hpp"
 
 // Polynomial operations
 #include "turinged/polynomial/polynomial.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/polynomial/poly_view.hpp"
+
+// Residue number system
+#include "turinged/rns/rns.hpp"
+#include "turinged/rns/rns_parameters.hpp"
+
+// Plaintext encodings
+#include "turinged/encoding/batch_encoder.hpp"
+#include "turinged/encoding/ckks_encoder.hpp"
 
 // Key management
 #include "turinged/keys/keys.hpp"
+#include "turinged/keys/key_generation.hpp"
+
+// Serialization
+#include "turinged/io/serialization.hpp"
+#include "turinged/io/key_store.hpp"
+#include "turinged/io/stream_pipeline.hpp"
 
 // Cryptographic schemes
+#include "turinged/schemes/ciphertext_view.hpp"
 #include "turinged/schemes/lwe.hpp"
 #include "turinged/schemes/rlwe.hpp"
 #include "turinged/schemes/glwe.hpp"
 #include "turinged/schemes/glev.hpp"
 #include "turinged/schemes/ggsw.hpp"
+#include "turinged/schemes/rns_rlwe.hpp"
+#include "turinged/schemes/rns_glwe.hpp"
+#include "turinged/schemes/ckks.hpp"
 
 // Homomorphic operations
 #include "turinged/operations/homomorphic.hpp"
+#include "turinged/operations/modulus_switching.hpp"
+#include "turinged/operations/key_switching.hpp"
+#include "turinged/operations/automorphism.hpp"
+#include "turinged/operations/packing.hpp"
+#include "turinged/operations/rns_homomorphic.hpp"
+#include "turinged/operations/ckks_homomorphic.hpp"
+#include "turinged/operations/bootstrapping.hpp"
+#include "turinged/operations/gates.hpp"
+
+// Noise measurement and estimation
+#include "turinged/noise/noise.hpp"
+
+// Parameter selection
+#include "turinged/params/params.hpp"
 
 namespace turinged {
 
@@ -17,13 +17,9 @@ int64 center_rep(int64 x, int64 q) {
     return v;
 }
 
-int64 dot_product_modq(const std::vector<int64>& a, const std::vector<int64>& b, int64 q) {
-    if (a.size() != b.size()) {
-        throw std::runtime_error("Vector size mismatch in dot product");
-    }
-
+int64 dot_product_modq(const int64* a, const int64* b, std::size_t n, int64 q) {
     int128 acc = 0;
-    for (std::size_t i = 0; i < a.size(); ++i) {
+    for (std::size_t i = 0; i < n; ++i) {
         acc += static_cast<int128>(a[i]) * static_cast<int128>(b[i]);
     }
 
@@ -32,5 +28,162 @@ int64 dot_product_modq(const std::vector<int64>& a, const std::vector<int64>& b,
     return acc64;
 }
 
+int64 dot_product_modq(const std::vector<int64>& a, const std::vector<int64>& b, int64 q) {
+    if (a.size() != b.size()) {
+        throw std::runtime_error("Vector size mismatch in dot product");
+    }
+    return dot_product_modq(a.data(), b.data(), a.size(), q);
+}
+
+int64 switch_modulus(int64 x, int64 q, int64 q_new) {
+    int128 num = static_cast<int128>(modq(x, q)) * q_new;
+    int64 r = static_cast<int64>((2 * num + q) / (2 * static_cast<int128>(q)));
+    return r == q_new ? 0 : r;
+}
+
+bool is_power_of_two(uint64 x) {
+    return x != 0 && (x & (x - 1)) == 0;
+}
+
+std::size_t bit_reverse(std::size_t x, int bits) {
+    std::size_t r = 0;
+    for (int i = 0; i < bits; ++i) {
+        r = (r << 1) | (x & 1);
+        x >>= 1;
+    }
+    return r;
+}
+
+void switch_modulus_inplace(int64* data, std::size_t count, int64 q, int64 q_new) {
+    if (q <= 0 || q_new <= 0) {
+        throw std::runtime_error("Invalid modulus in modulus switching");
+    }
+
+    // Power-of-two to smaller power-of-two: rounding is a shift, no division needed
+    if (is_power_of_two(q) && is_power_of_two(q_new) && q_new <= q) {
+        int shift = 0;
+        while ((q_new << shift) < q) shift++;
+        if (shift == 0) return;
+
+        uint64 mask = static_cast<uint64>(q_new) - 1;
+        uint64 half = uint64(1) << (shift - 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint64 v = static_cast<uint64>(data[i]) & (static_cast<uint64>(q) - 1);
+            data[i] = static_cast<int64>(((v + half) >> shift) & mask);
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        data[i] = switch_modulus(data[i], q, q_new);
+    }
+}
+
+uint64 mul_mod(uint64 a, uint64 b, uint64 p) {
+    return static_cast<uint64>((static_cast<uint128>(a) * b) % p);
+}
+
+uint64 pow_mod(uint64 base, uint64 exp, uint64 p) {
+    uint64 result = 1 % p;
+    base %= p;
+    while (exp > 0) {
+        if (exp & 1) result = mul_mod(result, base, p);
+        base = mul_mod(base, base, p);
+        exp >>= 1;
+    }
+    return result;
+}
+
+bool is_prime(uint64 n) {
+    if (n < 2) return false;
+    for (uint64 p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        if (n % p == 0) return n == p;
+    }
+
+    uint64 d = n - 1;
+    int s = 0;
+    while ((d & 1) == 0) {
+        d >>= 1;
+        s++;
+    }
+
+    // These witnesses are sufficient for every n < 2^64
+    for (uint64 a : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        uint64 x = pow_mod(a, d, n);
+        if (x == 1 || x == n - 1) continue;
+
+        bool composite = true;
+        for (int r = 1; r < s; ++r) {
+            x = mul_mod(x, x, n);
+            if (x == n - 1) {
+                composite = false;
+                break;
+            }
+        }
+        if (composite) return false;
+    }
+    return true;
+}
+
+int64 inverse_mod(int64 a, int64 m) {
+    int128 old_r = modq(a, m), r = m;
+    int128 old_s = 1, s = 0;
+    while (r != 0) {
+        int128 quotient = old_r / r;
+        int128 tmp = r;
+        r = old_r - quotient * r;
+        old_r = tmp;
+        tmp = s;
+        s = old_s - quotient * s;
+        old_s = tmp;
+    }
+    if (old_r != 1) {
+        throw std::runtime_error("Value is not invertible modulo m");
+    }
+    return mod_int128(old_s, m);
+}
+
+int64 mod_int128(int128 x, int64 q) {
+    int64 r = static_cast<int64>(x % q);
+    if (r < 0) r += q;
+    return r;
+}
+
+int128 scale_round(int128 x, int64 num, int64 den) {
+    if (den <= 0) {
+        throw std::runtime_error("Non-positive denominator in scale_round");
+    }
+
+    // Split x = quo * den + rem so that rem * num cannot overflow
+    int128 quo = x / den;
+    int128 rem = x % den;
+    int128 scaled = rem * num;
+
+    int128 r = (scaled >= 0) ? (2 * scaled + den) / (2 * static_cast<int128>(den))
+                             : -((-2 * scaled + den) / (2 * static_cast<int128>(den)));
+    return quo * num + r;
+}
+
+int gadget_levels(int64 q, int64 beta) {
+    if (beta < 2) {
+        throw std::runtime_error("Gadget base must be at least 2");
+    }
+
+    int levels = 0;
+    int128 power = 1;
+    while (power < q) {
+        power *= beta;
+        levels++;
+    }
+    return levels;
+}
+
+uint64 derive_seed(uint64 seed, uint64 index) {
+    uint64 z = seed + (index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "turinged/core/metrics.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+namespace turinged {
+namespace core {
+
+// ========== Histogram ==========
+
+std::size_t LatencyHistogram::bucket(uint64 ns) {
+    if (ns < 2 * HISTOGRAM_SUB_BUCKETS) return static_cast<std::size_t>(ns);
+
+    // Top five significant bits pick the bucket within the power of two
+    std::size_t msb = 63 - static_cast<std::size_t>(__builtin_clzll(static_cast<unsigned long long>(ns)));
+    std::size_t shift = msb - 4;
+    return (shift + 1) * HISTOGRAM_SUB_BUCKETS + static_cast<std::size_t>(ns >> shift) - HISTOGRAM_SUB_BUCKETS;
+}
+
+uint64 LatencyHistogram::bucket_upper(std::size_t b) {
+    if (b < 2 * HISTOGRAM_SUB_BUCKETS) return b;
+
+    std::size_t shift = b / HISTOGRAM_SUB_BUCKETS - 1;
+    uint64 sub = b % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64 ns) {
+    ++counts[bucket(ns)];
+    min_ns = count == 0 ? ns : std::min(min_ns, ns);
+    max_ns = std::max(max_ns, ns);
+    total_ns += ns;
+    ++count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.count == 0) return;
+    for (std::size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) counts[b] += other.counts[b];
+    min_ns = count == 0 ? other.min_ns : std::min(min_ns, other.min_ns);
+    max_ns = std::max(max_ns, other.max_ns);
+    total_ns += other.total_ns;
+    count += other.count;
+}
+
+uint64 LatencyHistogram::percentile(double p) const {
+    if (count == 0) return 0;
+    if (p <= 0.0) return min_ns;
+
+    uint64 rank = static_cast<uint64>(std::ceil(std::min(p, 100.0) / 100.0 * static_cast<double>(count)));
+    rank = std::max<uint64>(rank, 1);
+
+    uint64 seen = 0;
+    for (std::size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen >= rank) return std::min(bucket_upper(b), max_ns);
+    }
+    return max_ns;
+}
+
+// ========== JSON export ==========
+
+void write_metrics_json(std::ostream& out, const MetricsSnapshot& snapshot) {
+    out << "{\n  \"operations\": [";
+    for (std::size_t i = 0; i < snapshot.operations.size(); ++i) {
+        const OperationMetrics& op = snapshot.operations[i];
+        const LatencyHistogram& h = op.latency;
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << op.name << "\", \"calls\": " << op.calls
+            << ", \"total_ns\": " << h.total_ns
+            << ", \"mean_ns\": " << (h.count == 0 ? 0 : h.total_ns / h.count)
+            << ", \"min_ns\": " << h.min_ns
+            << ", \"p50_ns\": " << h.percentile(50)
+            << ", \"p90_ns\": " << h.percentile(90)
+            << ", \"p99_ns\": " << h.percentile(99)
+            << ", \"p999_ns\": " << h.percentile(99.9)
+            << ", \"max_ns\": " << h.max_ns
+            << ", \"pool_allocations\": " << op.pool_allocations
+            << ", \"pool_bytes\": " << op.pool_bytes
+            << ", \"poly_multiplies\": " << op.poly_multiplies
+            << ", \"ntt_forward\": " << op.ntt_forward
+            << ", \"ntt_inverse\": " << op.ntt_inverse << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+#ifdef TURINGED_METRICS
+
+// ========== Recording ==========
+
+thread_local ThreadMetricCounters thread_metric_counters = {};
+
+// Lock-free accumulators for one operation name; scopes on any thread add to them
+struct OperationSite {
+    std::string name;
+    std::atomic<uint64> calls;
+    std::atomic<uint64> total_ns;
+    std::atomic<uint64> min_ns;
+    std::atomic<uint64> max_ns;
+    std::atomic<uint64> pool_allocations;
+    std::atomic<uint64> pool_bytes;
+    std::atomic<uint64> poly_multiplies;
+    std::atomic<uint64> ntt_forward;
+    std::atomic<uint64> ntt_inverse;
+    std::array<std::atomic<uint64>, HISTOGRAM_BUCKETS> buckets;
+
+    explicit OperationSite(const char* name) : name(name) { reset(); }
+
+    void reset() {
+        calls = 0;
+        total_ns = 0;
+        min_ns = ~uint64(0);
+        max_ns = 0;
+        pool_allocations = 0;
+        pool_bytes = 0;
+        poly_multiplies = 0;
+        ntt_forward = 0;
+        ntt_inverse = 0;
+        for (auto& b : buckets) b = 0;
+    }
+};
+
+// Sites are never freed, so scopes running during static destruction stay valid
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<OperationSite>> sites;
+};
+
+static Registry& registry() {
+    static Registry* r = new Registry();
+    return *r;
+}
+
+// Innermost operation running on this thread
+static thread_local OperationSite* current_site = nullptr;
+
+OperationSite* register_operation(const char* name) {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& site : r.sites) {
+        if (site->name == name) return site.get();
+    }
+    r.sites.emplace_back(new OperationSite(name));
+    return r.sites.back().get();
+}
+
+static uint64 now_ns() {
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static uint64 delta(uint64 now, uint64 before) {
+    return now >= before ? now - before : 0;   // the pool counters may have been reset meanwhile
+}
+
+OperationScope::OperationScope(OperationSite* site) : site_(nullptr), parent_(current_site) {
+    // An overload delegating to another one of the same name is recorded once
+    if (site == parent_) return;
+
+    site_ = site;
+    current_site = site;
+    PoolStats pool = pool_stats();
+    allocations_ = pool.allocations;
+    bytes_ = pool.bytes_allocated;
+    counters_ = thread_metric_counters;
+    start_ns_ = now_ns();
+}
+
+OperationScope::~OperationScope() {
+    if (!site_) return;
+
+    uint64 elapsed = now_ns() - start_ns_;
+    PoolStats pool = pool_stats();
+    const ThreadMetricCounters& c = thread_metric_counters;
+    auto relaxed = std::memory_order_relaxed;
+
+    site_->calls.fetch_add(1, relaxed);
+    site_->total_ns.fetch_add(elapsed, relaxed);
+    site_->buckets[LatencyHistogram::bucket(elapsed)].fetch_add(1, relaxed);
+    uint64 seen = site_->min_ns.load(relaxed);
+    while (elapsed < seen && !site_->min_ns.compare_exchange_weak(seen, elapsed, relaxed)) {}
+    seen = site_->max_ns.load(relaxed);
+    while (elapsed > seen && !site_->max_ns.compare_exchange_weak(seen, elapsed, relaxed)) {}
+
+    site_->pool_allocations.fetch_add(delta(pool.allocations, allocations_), relaxed);
+    site_->pool_bytes.fetch_add(delta(pool.bytes_allocated, bytes_), relaxed);
+    site_->poly_multiplies.fetch_add(c.poly_multiplies - counters_.poly_multiplies, relaxed);
+    site_->ntt_forward.fetch_add(c.ntt_forward - counters_.ntt_forward, relaxed);
+    site_->ntt_inverse.fetch_add(c.ntt_inverse - counters_.ntt_inverse, relaxed);
+
+    current_site = parent_;
+}
+
+MetricsSnapshot metrics_snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto relaxed = std::memory_order_relaxed;
+
+    MetricsSnapshot snapshot;
+    for (auto& site : r.sites) {
+        uint64 calls = site->calls.load(relaxed);
+        if (calls == 0) continue;
+
+        OperationMetrics op;
+        op.name = site->name;
+        op.calls = calls;
+        for (std::size_t b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            op.latency.counts[b] = site->buckets[b].load(relaxed);
+            op.latency.count += op.latency.counts[b];
+        }
+        op.latency.total_ns = site->total_ns.load(relaxed);
+        op.latency.min_ns = site->min_ns.load(relaxed);
+        op.latency.max_ns = site->max_ns.load(relaxed);
+        op.pool_allocations = site->pool_allocations.load(relaxed);
+        op.pool_bytes = site->pool_bytes.load(relaxed);
+        op.poly_multiplies = site->poly_multiplies.load(relaxed);
+        op.ntt_forward = site->ntt_forward.load(relaxed);
+        op.ntt_inverse = site->ntt_inverse.load(relaxed);
+        snapshot.operations.push_back(std::move(op));
+    }
+
+    std::sort(snapshot.operations.begin(), snapshot.operations.end(),
+              [](const OperationMetrics& a, const OperationMetrics& b) { return a.name < b.name; });
+    return snapshot;
+}
+
+void reset_metrics() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto& site : r.sites) site->reset();
+}
+
+#else
+
+MetricsSnapshot metrics_snapshot() {
+    return MetricsSnapshot();
+}
+
+void reset_metrics() {}
+
+#endif
+
+}
+}
@@ -0,0 +1,130 @@
+#include "turinged/core/parallel.hpp"
+#include "turinged/core/trace.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace turinged {
+namespace core {
+
+std::size_t default_thread_count() {
+    unsigned int hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<std::size_t>(hw);
+}
+
+namespace {
+
+// One parallel_for call. Helpers join while it is queued; the caller takes it
+// off the queue once the indices run out and waits only for helpers that joined.
+struct Job {
+    const std::function<void(std::size_t)>& fn;
+    std::size_t count;
+    std::atomic<std::size_t> next;
+    std::size_t helpers_wanted;     // guarded by the pool mutex, as are the two below
+    std::size_t helpers_running;
+    std::condition_variable helpers_done;
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    Job(const std::function<void(std::size_t)>& fn, std::size_t count, std::size_t helpers)
+        : fn(fn), count(count), next(0), helpers_wanted(helpers), helpers_running(0) {}
+
+    // Work is handed out one index at a time so uneven items balance out
+    void work() {
+        TURINGED_TRACE_SCOPE("parallel_for.worker");
+        while (true) {
+            std::size_t i = next.fetch_add(1);
+            if (i >= count) break;
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                next.store(count);
+            }
+        }
+    }
+};
+
+// Worker threads started on demand and kept for the life of the process, so
+// their thread-local state (pool allocator caches, RNGs) carries over between
+// calls. Because the caller works too and never waits for a helper that has
+// not joined, nested calls from inside fn cannot deadlock.
+class WorkerPool {
+public:
+    static WorkerPool& instance() {
+        // Never destroyed: idle workers may still be blocked on it at exit
+        static WorkerPool* pool = new WorkerPool();
+        return *pool;
+    }
+
+    void run(Job& job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (threads_ < job.helpers_wanted) {
+                std::thread(&WorkerPool::worker_loop, this).detach();
+                ++threads_;
+            }
+            jobs_.push_back(&job);
+        }
+        work_available_.notify_all();
+
+        job.work();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto it = jobs_.begin(); it != jobs_.end(); ++it) {
+            if (*it == &job) {
+                jobs_.erase(it);
+                break;
+            }
+        }
+        job.helpers_done.wait(lock, [&] { return job.helpers_running == 0; });
+    }
+
+private:
+    WorkerPool() : threads_(0) {}
+
+    void worker_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            work_available_.wait(lock, [&] { return !jobs_.empty(); });
+            Job* job = jobs_.front();
+            if (--job->helpers_wanted == 0) jobs_.pop_front();
+            ++job->helpers_running;
+
+            lock.unlock();
+            job->work();
+            lock.lock();
+
+            if (--job->helpers_running == 0) job->helpers_done.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::deque<Job*> jobs_;
+    std::size_t threads_;
+};
+
+}
+
+void parallel_for(std::size_t count, const std::function<void(std::size_t)>& fn, std::size_t num_threads) {
+    if (num_threads == 0) num_threads = default_thread_count();
+    if (num_threads > count) num_threads = count;
+
+    if (num_threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    Job job(fn, count, num_threads - 1);
+    WorkerPool::instance().run(job);
+
+    if (job.error) std::rethrow_exception(job.error);
+}
+
+}
+}
@@ -0,0 +1,115 @@
+#include "turinged/core/pool_allocator.hpp"
+#include <new>
+
+namespace turinged {
+namespace core {
+
+static constexpr std::size_t CLASS_COUNT = POOL_MAX_CLASS_BITS - POOL_MIN_CLASS_BITS + 1;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+// Trivially destructible so it stays usable while other thread_local and
+// static objects holding pooled buffers are torn down
+struct ThreadPool {
+    FreeBlock* free_lists[CLASS_COUNT];
+    PoolStats stats;
+    bool registered;
+    bool retired;
+};
+
+static thread_local ThreadPool pool = {};
+
+static void* global_allocate(std::size_t bytes) {
+    ++pool.stats.global_allocations;
+    return ::operator new(bytes, std::align_val_t(POOL_ALIGNMENT));
+}
+
+static void global_free(void* p) {
+    ++pool.stats.global_frees;
+    ::operator delete(p, std::align_val_t(POOL_ALIGNMENT));
+}
+
+// Smallest class holding `bytes`, or CLASS_COUNT if none does
+static std::size_t size_class(std::size_t bytes) {
+    if (bytes <= (std::size_t(1) << POOL_MIN_CLASS_BITS)) return 0;
+    std::size_t bits = 64 - static_cast<std::size_t>(__builtin_clzll(static_cast<unsigned long long>(bytes - 1)));
+    return bits > POOL_MAX_CLASS_BITS ? CLASS_COUNT : bits - POOL_MIN_CLASS_BITS;
+}
+
+static std::size_t class_bytes(std::size_t c) {
+    return std::size_t(1) << (c + POOL_MIN_CLASS_BITS);
+}
+
+void release_pool() {
+    for (std::size_t c = 0; c < CLASS_COUNT; ++c) {
+        while (FreeBlock* block = pool.free_lists[c]) {
+            pool.free_lists[c] = block->next;
+            global_free(block);
+        }
+    }
+    pool.stats.bytes_cached = 0;
+}
+
+// Hands the cache back when the thread exits; blocks freed afterwards bypass it
+struct PoolReaper {
+    ~PoolReaper() {
+        release_pool();
+        pool.retired = true;
+    }
+};
+
+static thread_local PoolReaper reaper;
+
+void* pool_allocate(std::size_t bytes) {
+    ++pool.stats.allocations;
+    pool.stats.bytes_allocated += bytes;
+    std::size_t c = size_class(bytes);
+    if (c == CLASS_COUNT) {
+        return global_allocate(bytes);
+    }
+
+    if (FreeBlock* block = pool.free_lists[c]) {
+        pool.free_lists[c] = block->next;
+        pool.stats.bytes_cached -= class_bytes(c);
+        ++pool.stats.reused;
+        return block;
+    }
+
+    return global_allocate(class_bytes(c));
+}
+
+void pool_deallocate(void* p, std::size_t bytes) {
+    if (!p) return;
+
+    std::size_t c = size_class(bytes);
+    if (c == CLASS_COUNT || pool.retired || pool.stats.bytes_cached + class_bytes(c) > POOL_CACHE_LIMIT) {
+        global_free(p);
+        return;
+    }
+
+    // The first block cached on this thread registers the reaper
+    if (!pool.registered) {
+        (void)&reaper;
+        pool.registered = true;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(p);
+    block->next = pool.free_lists[c];
+    pool.free_lists[c] = block;
+    pool.stats.bytes_cached += class_bytes(c);
+}
+
+PoolStats pool_stats() {
+    return pool.stats;
+}
+
+void reset_pool_stats() {
+    std::size_t cached = pool.stats.bytes_cached;
+    pool.stats = PoolStats();
+    pool.stats.bytes_cached = cached;
+}
+
+}
+}
@@ -0,0 +1,199 @@
+#include "turinged/core/trace.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace turinged {
+namespace core {
+
+#ifdef TURINGED_TRACE
+
+static void write_json_string(std::ostream& out, const std::string& s) {
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+struct TraceEvent {
+    const char* name;
+    const char* arg_name;
+    int64 arg;
+    uint64 start_ns;
+    uint64 duration_ns;
+};
+
+// Ring of the most recent events of one thread, allocated on its first event.
+// The owner is the only writer; the lock is uncontended except during a dump.
+struct TraceBuffer {
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    std::size_t capacity;
+    uint64 written;             // events recorded since the last start_tracing
+    std::size_t tid;
+    std::string name;
+
+    TraceBuffer(std::size_t capacity, std::size_t tid)
+        : capacity(capacity), written(0), tid(tid), name("thread " + std::to_string(tid)) {}
+};
+
+// Buffers outlive their threads so late dumps still see them; never freed, so
+// scopes running during static destruction stay valid
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    std::size_t capacity = TRACE_DEFAULT_CAPACITY;
+    uint64 epoch_ns = 0;
+    std::atomic<bool> active{false};
+};
+
+static TraceRegistry& registry() {
+    static TraceRegistry* r = new TraceRegistry();
+    return *r;
+}
+
+static thread_local std::shared_ptr<TraceBuffer> thread_buffer;
+
+// Name of the innermost recording scope on this thread
+static thread_local const char* current_name = nullptr;
+
+static uint64 now_ns() {
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static TraceBuffer& buffer() {
+    if (!thread_buffer) {
+        TraceRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        thread_buffer = std::make_shared<TraceBuffer>(r.capacity, r.buffers.size());
+        r.buffers.push_back(thread_buffer);
+    }
+    return *thread_buffer;
+}
+
+TraceScope::TraceScope(const char* name, const char* arg_name, int64 arg)
+    : name_(nullptr), parent_(current_name), arg_name_(arg_name), arg_(arg), start_ns_(0) {
+    if (!registry().active.load(std::memory_order_relaxed)) return;
+    if (parent_ && std::strcmp(parent_, name) == 0) return;
+    name_ = name;
+    current_name = name;
+    start_ns_ = now_ns();
+}
+
+TraceScope::~TraceScope() {
+    if (!name_) return;
+
+    uint64 end_ns = now_ns();
+    current_name = parent_;
+    TraceBuffer& b = buffer();
+    std::lock_guard<std::mutex> lock(b.mutex);
+    if (b.events.empty()) b.events.resize(b.capacity);
+    b.events[b.written % b.events.size()] = {name_, arg_name_, arg_, start_ns_, end_ns - start_ns_};
+    ++b.written;
+}
+
+void start_tracing(std::size_t events_per_thread) {
+    if (events_per_thread == 0) events_per_thread = 1;
+
+    TraceRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.capacity = events_per_thread;
+    for (auto& b : r.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(b->mutex);
+        std::vector<TraceEvent>().swap(b->events);
+        b->capacity = events_per_thread;
+        b->written = 0;
+    }
+    r.epoch_ns = now_ns();
+    r.active.store(true);
+}
+
+void stop_tracing() {
+    registry().active.store(false);
+}
+
+bool tracing_active() {
+    return registry().active.load();
+}
+
+void set_trace_thread_name(const std::string& name) {
+    TraceBuffer& b = buffer();
+    std::lock_guard<std::mutex> lock(b.mutex);
+    b.name = name;
+}
+
+void write_chrome_trace(std::ostream& out) {
+    TraceRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\": [";
+
+    bool first = true;
+    uint64 dropped = 0;
+    auto separator = [&]() {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (auto& b : r.buffers) {
+        std::lock_guard<std::mutex> buffer_lock(b->mutex);
+
+        separator();
+        out << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << b->tid << ", \"args\": {\"name\": ";
+        write_json_string(out, b->name);
+        out << "}}";
+
+        // Oldest surviving event first
+        std::size_t capacity = b->events.size();
+        uint64 count = b->written < capacity ? b->written : capacity;
+        dropped += b->written - count;
+        for (uint64 i = b->written - count; i < b->written; ++i) {
+            const TraceEvent& e = b->events[i % capacity];
+            double ts = static_cast<double>(e.start_ns >= r.epoch_ns ? e.start_ns - r.epoch_ns : 0) / 1000.0;
+            separator();
+            out << "  {\"name\": \"" << e.name << "\", \"cat\": \"turinged\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                << b->tid << ", \"ts\": " << ts << ", \"dur\": " << static_cast<double>(e.duration_ns) / 1000.0;
+            if (e.arg_name) out << ", \"args\": {\"" << e.arg_name << "\": " << e.arg << "}";
+            out << "}";
+        }
+    }
+
+    out << "\n], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+    out.flags(flags);
+}
+
+#else
+
+void start_tracing(std::size_t) {}
+
+void stop_tracing() {}
+
+bool tracing_active() {
+    return false;
+}
+
+void set_trace_thread_name(const std::string&) {}
+
+void write_chrome_trace(std::ostream& out) {
+    out << "{\"traceEvents\": [], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": 0}}\n";
+}
+
+#endif
+
+}
+}
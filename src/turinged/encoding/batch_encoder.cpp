@@ -0,0 +1,82 @@
+#include "turinged/encoding/batch_encoder.hpp"
+#include "turinged/core/math_utils.hpp"
+#include <stdexcept>
+
+namespace turinged {
+namespace encoding {
+
+BatchEncoder create_batch_encoder(const Parameters& params) {
+    std::size_t n = params.n;
+    int64 t = params.t;
+
+    if (n < 2 || !core::is_power_of_two(n)) {
+        throw std::runtime_error("Batching requires a power-of-two n");
+    }
+    if (!core::is_prime(static_cast<uint64>(t)) || (t - 1) % static_cast<int64>(2 * n) != 0) {
+        throw std::runtime_error("Batching requires a prime t = 1 mod 2n");
+    }
+
+    BatchEncoder encoder;
+    encoder.n = n;
+    encoder.t = t;
+    encoder.tables = polynomial::get_ntt_tables(n, static_cast<uint64>(t));
+    encoder.slot_index.resize(n);
+
+    int bits = 0;
+    while ((std::size_t(1) << bits) < n) bits++;
+
+    // NTT output position j holds the evaluation at psi^(2*bitrev(j)+1)
+    uint64 m = 2 * static_cast<uint64>(n);
+    uint64 pos = 1;
+    std::size_t half = n / 2;
+    for (std::size_t i = 0; i < half; ++i) {
+        uint64 neg = m - pos;
+        encoder.slot_index[i] = core::bit_reverse((pos - 1) / 2, bits);
+        encoder.slot_index[half + i] = core::bit_reverse((neg - 1) / 2, bits);
+        pos = (pos * 3) % m;
+    }
+
+    return encoder;
+}
+
+Polynomial encode_batch(const std::vector<int64>& slots, const BatchEncoder& encoder) {
+    if (slots.size() > encoder.n) {
+        throw std::runtime_error("Too many slot values for batch encoder");
+    }
+
+    std::vector<uint64> values(encoder.n, 0);
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        values[encoder.slot_index[i]] = static_cast<uint64>(core::modq(slots[i], encoder.t));
+    }
+
+    // Interpolate: evaluations -> coefficients
+    polynomial::ntt_inverse(values.data(), *encoder.tables);
+
+    Polynomial plain(encoder.n);
+    for (std::size_t i = 0; i < encoder.n; ++i) {
+        plain[i] = static_cast<int64>(values[i]);
+    }
+    return plain;
+}
+
+std::vector<int64> decode_batch(const Polynomial& plain, const BatchEncoder& encoder) {
+    if (plain.size() != encoder.n) {
+        throw std::runtime_error("Plaintext size mismatch with batch encoder");
+    }
+
+    std::vector<uint64> values(encoder.n);
+    for (std::size_t i = 0; i < encoder.n; ++i) {
+        values[i] = static_cast<uint64>(core::modq(plain[i], encoder.t));
+    }
+
+    polynomial::ntt_forward(values.data(), *encoder.tables);
+
+    std::vector<int64> slots(encoder.n);
+    for (std::size_t i = 0; i < encoder.n; ++i) {
+        slots[i] = static_cast<int64>(values[encoder.slot_index[i]]);
+    }
+    return slots;
+}
+
+}
+}
@@ -0,0 +1,147 @@
+#include "turinged/encoding/ckks_encoder.hpp"
+#include "turinged/core/math_utils.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace encoding {
+
+static void bit_reverse_permute(std::vector<std::complex<double>>& vals) {
+    std::size_t size = vals.size();
+    for (std::size_t i = 1, j = 0; i < size; ++i) {
+        std::size_t bit = size >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(vals[i], vals[j]);
+    }
+}
+
+// Evaluation at the slot roots (coefficients -> slots), the "special FFT"
+static void special_fft(std::vector<std::complex<double>>& vals, const CKKSEncoder& encoder) {
+    std::size_t size = vals.size();
+    std::size_t m = 2 * encoder.n;
+
+    bit_reverse_permute(vals);
+    for (std::size_t len = 2; len <= size; len <<= 1) {
+        std::size_t half = len >> 1;
+        std::size_t quarter_period = len << 2;
+        std::size_t gap = m / quarter_period;
+        for (std::size_t i = 0; i < size; i += len) {
+            for (std::size_t j = 0; j < half; ++j) {
+                std::size_t idx = (encoder.rot_group[j] % quarter_period) * gap;
+                std::complex<double> u = vals[i + j];
+                std::complex<double> v = vals[i + j + half] * encoder.roots[idx];
+                vals[i + j] = u + v;
+                vals[i + j + half] = u - v;
+            }
+        }
+    }
+}
+
+// Inverse of special_fft (slots -> coefficients)
+static void special_fft_inverse(std::vector<std::complex<double>>& vals, const CKKSEncoder& encoder) {
+    std::size_t size = vals.size();
+    std::size_t m = 2 * encoder.n;
+
+    for (std::size_t len = size; len >= 2; len >>= 1) {
+        std::size_t half = len >> 1;
+        std::size_t quarter_period = len << 2;
+        std::size_t gap = m / quarter_period;
+        for (std::size_t i = 0; i < size; i += len) {
+            for (std::size_t j = 0; j < half; ++j) {
+                std::size_t idx = (quarter_period - encoder.rot_group[j] % quarter_period) * gap;
+                std::complex<double> u = vals[i + j] + vals[i + j + half];
+                std::complex<double> v = (vals[i + j] - vals[i + j + half]) * encoder.roots[idx];
+                vals[i + j] = u;
+                vals[i + j + half] = v;
+            }
+        }
+    }
+    bit_reverse_permute(vals);
+
+    for (std::complex<double>& v : vals) {
+        v /= static_cast<double>(size);
+    }
+}
+
+CKKSEncoder create_ckks_encoder(std::size_t n) {
+    if (n < 4 || !core::is_power_of_two(n)) {
+        throw std::runtime_error("CKKS encoding requires a power-of-two n >= 4");
+    }
+
+    CKKSEncoder encoder;
+    encoder.n = n;
+
+    std::size_t m = 2 * n;
+    const double pi = std::acos(-1.0);
+    encoder.roots.resize(m);
+    for (std::size_t j = 0; j < m; ++j) {
+        double angle = 2.0 * pi * static_cast<double>(j) / static_cast<double>(m);
+        encoder.roots[j] = std::complex<double>(std::cos(angle), std::sin(angle));
+    }
+
+    std::size_t power = 1;
+    for (std::size_t j = 0; j < n / 2; ++j) {
+        encoder.rot_group.push_back(power);
+        power = (power * 5) % m;
+    }
+
+    return encoder;
+}
+
+CKKSPlaintext encode_ckks(const std::vector<std::complex<double>>& values, double scale, const CKKSEncoder& encoder) {
+    std::size_t slots = encoder.slot_count();
+    if (values.size() > slots) {
+        throw std::runtime_error("Too many slot values for CKKS encoder");
+    }
+    if (!(scale > 0.0)) {
+        throw std::runtime_error("CKKS scale must be positive");
+    }
+
+    std::vector<std::complex<double>> vals(slots, std::complex<double>(0.0, 0.0));
+    std::copy(values.begin(), values.end(), vals.begin());
+    special_fft_inverse(vals, encoder);
+
+    // Real parts fill the lower half of the coefficients, imaginary parts the upper half
+    CKKSPlaintext plain;
+    plain.scale = scale;
+    plain.coeffs.resize(encoder.n);
+    const double limit = 4611686018427387904.0;    // 2^62
+    for (std::size_t i = 0; i < slots; ++i) {
+        double re = std::round(vals[i].real() * scale);
+        double im = std::round(vals[i].imag() * scale);
+        if (std::fabs(re) >= limit || std::fabs(im) >= limit) {
+            throw std::runtime_error("CKKS encoding overflows 62 bits; lower the scale");
+        }
+        plain.coeffs[i] = static_cast<int64>(re);
+        plain.coeffs[i + slots] = static_cast<int64>(im);
+    }
+
+    return plain;
+}
+
+CKKSPlaintext encode_ckks(const std::vector<double>& values, double scale, const CKKSEncoder& encoder) {
+    std::vector<std::complex<double>> complex_values(values.begin(), values.end());
+    return encode_ckks(complex_values, scale, encoder);
+}
+
+std::vector<std::complex<double>> decode_ckks(const std::vector<long double>& coeffs, double scale, const CKKSEncoder& encoder) {
+    if (coeffs.size() != encoder.n) {
+        throw std::runtime_error("Coefficient count does not match CKKS encoder");
+    }
+
+    std::size_t slots = encoder.slot_count();
+    std::vector<std::complex<double>> vals(slots);
+    for (std::size_t i = 0; i < slots; ++i) {
+        vals[i] = std::complex<double>(
+            static_cast<double>(coeffs[i] / scale),
+            static_cast<double>(coeffs[i + slots] / scale)
+        );
+    }
+    special_fft(vals, encoder);
+
+    return vals;
+}
+
+}
+}
@@ -0,0 +1,189 @@
+#include "turinged/io/key_store.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+
+namespace turinged {
+namespace io {
+
+static constexpr uint64 BYTE_ORDER_MARK = 0x0102030405060708ULL;
+static constexpr std::size_t HEADER_WORDS = 17;
+
+// Header word indices
+enum : std::size_t {
+    H_MAGIC = 0, H_VERSION, H_TYPE, H_BYTE_ORDER,
+    H_N, H_Q, H_T, H_NOISE,
+    H_LAYOUT,                                   // 6 words
+    H_DATA_OFFSET = H_LAYOUT + 6, H_DATA_WORDS, H_CHECKSUM
+};
+
+static void write_mapped_file(
+    const std::string& path,
+    ObjectType type,
+    const Parameters& params,
+    const uint64 (&layout)[6],
+    const unsigned char* data,
+    std::size_t words
+) {
+    std::size_t bytes = words * sizeof(uint64);
+
+    uint64 header[HEADER_WORDS] = {};
+    header[H_MAGIC] = MAPPED_KEY_MAGIC;
+    header[H_VERSION] = MAPPED_KEY_VERSION;
+    header[H_TYPE] = static_cast<uint64>(type);
+    header[H_BYTE_ORDER] = BYTE_ORDER_MARK;
+    header[H_N] = params.n;
+    header[H_Q] = static_cast<uint64>(params.q);
+    header[H_T] = static_cast<uint64>(params.t);
+    header[H_NOISE] = static_cast<uint64>(params.noise_bound);
+    for (std::size_t i = 0; i < 6; ++i) header[H_LAYOUT + i] = layout[i];
+    header[H_DATA_OFFSET] = MAPPED_KEY_HEADER_BYTES;
+    header[H_DATA_WORDS] = words;
+    header[H_CHECKSUM] = crc32_update(0, data, bytes);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot create key file " + path);
+    }
+
+    std::vector<char> page(MAPPED_KEY_HEADER_BYTES, 0);
+    std::copy(reinterpret_cast<const char*>(header), reinterpret_cast<const char*>(header + HEADER_WORDS), page.begin());
+    out.write(page.data(), static_cast<std::streamsize>(page.size()));
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!out) {
+        throw std::runtime_error("Failed to write key file " + path);
+    }
+}
+
+void write_mapped_key(const std::string& path, const keys::BootstrappingKey& key, const Parameters& params) {
+    const uint64 layout[6] = {
+        key.n_lwe, key.k, key.n, static_cast<uint64>(key.l),
+        static_cast<uint64>(key.beta), key.transformed ? 1ULL : 0ULL
+    };
+    write_mapped_file(path, ObjectType::BootstrappingKey, params, layout,
+                      reinterpret_cast<const unsigned char*>(key.data.data()), key.data.size());
+}
+
+void write_mapped_key(const std::string& path, const keys::LWEKeySwitchKey& key, const Parameters& params) {
+    const uint64 layout[6] = {
+        key.n_in, key.n_out, static_cast<uint64>(key.beta), static_cast<uint64>(key.levels), 0, 0
+    };
+    write_mapped_file(path, ObjectType::LWEKeySwitchKey, params, layout,
+                      reinterpret_cast<const unsigned char*>(key.data.data()), key.data.size());
+}
+
+struct KeyStore::Mapping {
+    const unsigned char* base;
+    std::size_t size;
+
+    Mapping(const unsigned char* base, std::size_t size) : base(base), size(size) {}
+    ~Mapping() { munmap(const_cast<unsigned char*>(base), size); }
+
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+};
+
+KeyStore::KeyStore(const std::string& path) : params_(0, 0, 0, 0) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open key file " + path);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < MAPPED_KEY_HEADER_BYTES) {
+        close(fd);
+        throw std::runtime_error("Not a mapped key file: " + path);
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+
+    void* base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("Cannot map key file " + path);
+    }
+    mapping_ = std::make_shared<const Mapping>(static_cast<const unsigned char*>(base), size);
+
+    const uint64* header = reinterpret_cast<const uint64*>(mapping_->base);
+    if (header[H_MAGIC] != MAPPED_KEY_MAGIC) {
+        throw std::runtime_error("Not a mapped key file: " + path);
+    }
+    if (header[H_BYTE_ORDER] != BYTE_ORDER_MARK) {
+        throw std::runtime_error("Mapped key file written with a different byte order");
+    }
+    if (header[H_VERSION] != MAPPED_KEY_VERSION) {
+        throw std::runtime_error("Unsupported mapped key file version");
+    }
+
+    type_ = static_cast<ObjectType>(header[H_TYPE]);
+    params_ = Parameters(header[H_N], static_cast<int64>(header[H_Q]),
+                         static_cast<int64>(header[H_T]), static_cast<int64>(header[H_NOISE]));
+    for (std::size_t i = 0; i < 6; ++i) layout_[i] = header[H_LAYOUT + i];
+    data_offset_ = header[H_DATA_OFFSET];
+    data_words_ = header[H_DATA_WORDS];
+    checksum_ = header[H_CHECKSUM];
+
+    if (data_offset_ % sizeof(uint64) != 0 || data_offset_ > size ||
+        data_words_ > (size - data_offset_) / sizeof(uint64)) {
+        throw std::runtime_error("Truncated mapped key file " + path);
+    }
+}
+
+std::size_t KeyStore::size_bytes() const {
+    return mapping_->size;
+}
+
+// Layout fields come straight from the file. The gadget base must be a
+// coefficient mod q, and the sizes are checked products so a crafted header
+// cannot wrap them around to the mapped word count.
+static bool valid_gadget(uint64 beta, uint64 levels, const Parameters& params) {
+    return params.q > 1 && beta >= 2 && beta < static_cast<uint64>(params.q) && levels <= 64;
+}
+
+keys::BootstrappingKeyView KeyStore::bootstrapping_key() const {
+    if (type_ != ObjectType::BootstrappingKey) {
+        throw std::runtime_error("Mapped key file does not hold a bootstrapping key");
+    }
+
+    // n_lwe GGSWs of (k+1)(l+1) GLWEs of k+1 polynomials
+    uint64 n_lwe = layout_[0], k = layout_[1], n = layout_[2], l = layout_[3];
+    if (n != params_.n || k == 0 || k == SIZE_MAX || l >= 64 || !valid_gadget(layout_[4], l + 1, params_) || layout_[5] > 1) {
+        throw std::runtime_error("Bootstrapping key layout does not match its parameters");
+    }
+    keys::BootstrappingKeyLayout layout(n_lwe, k, n, static_cast<int>(l), static_cast<int64>(layout_[4]), layout_[5] != 0);
+    std::size_t polys = checked_product(checked_product(n_lwe, checked_product(k + 1, l + 1)), k + 1);
+    std::size_t poly_words = layout.transformed ? checked_product(polynomial::EXACT_PRIME_COUNT, n) : n;
+    if (checked_product(polys, poly_words) != data_words_) {
+        throw std::runtime_error("Bootstrapping key layout does not match the mapped data");
+    }
+    return keys::BootstrappingKeyView(layout, reinterpret_cast<const uint64*>(mapping_->base + data_offset_));
+}
+
+keys::LWEKeySwitchKeyView KeyStore::lwe_key_switch_key() const {
+    if (type_ != ObjectType::LWEKeySwitchKey) {
+        throw std::runtime_error("Mapped key file does not hold an LWE key switching key");
+    }
+
+    // n_in * levels entries of n_out + 1 words; the LWE dimensions are their own
+    // fields, as in the serialized format
+    uint64 n_in = layout_[0], n_out = layout_[1], levels = layout_[3];
+    if (n_out == SIZE_MAX || levels == 0 || !valid_gadget(layout_[2], levels, params_)) {
+        throw std::runtime_error("Key switching key layout does not match its parameters");
+    }
+    keys::LWEKeySwitchKeyLayout layout(n_in, n_out, static_cast<int64>(layout_[2]), static_cast<int>(levels));
+    if (checked_product(checked_product(n_in, levels), n_out + 1) != data_words_) {
+        throw std::runtime_error("Key switching key layout does not match the mapped data");
+    }
+    return keys::LWEKeySwitchKeyView(layout, reinterpret_cast<const int64*>(mapping_->base + data_offset_));
+}
+
+bool KeyStore::verify() const {
+    return crc32_update(0, mapping_->base + data_offset_, data_words_ * sizeof(uint64)) == checksum_;
+}
+
+}
+}
@@ -0,0 +1,809 @@
+#include "turinged/io/serialization.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/core/math_utils.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+namespace turinged {
+namespace io {
+
+// CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320)
+static const std::array<uint32_t, 256>& crc_table() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+uint32_t crc32_update(uint32_t crc, const unsigned char* data, std::size_t len) {
+    const std::array<uint32_t, 256>& table = crc_table();
+    crc = ~crc;
+    for (std::size_t i = 0; i < len; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static uint64 low_mask(unsigned bits) {
+    return bits >= 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+unsigned coefficient_bits(int64 q) {
+    unsigned bits = 0;
+    while (bits < 63 && (static_cast<uint64>(1) << bits) < static_cast<uint64>(q)) ++bits;
+    return bits;
+}
+
+// ========== Writer ==========
+
+Writer::Writer(std::ostream& out, ObjectType type, std::size_t n, int64 q, int64 t, int64 noise_bound, unsigned coeff_bits)
+    : out_(out), q_(q), coeff_bits_(coeff_bits), acc_(0), acc_bits_(0), buffer_len_(0), bytes_(0), crc_(0), finished_(false) {
+    write_bits(FORMAT_MAGIC, 32);
+    write_bits(FORMAT_VERSION, 16);
+    write_bits(static_cast<uint16_t>(type), 16);
+    write_u64(n);
+    write_u64(static_cast<uint64>(q));
+    write_u64(static_cast<uint64>(t));
+    write_u64(static_cast<uint64>(noise_bound));
+    write_bits(coeff_bits, 8);
+}
+
+Writer::Writer(std::ostream& out, ObjectType type, const Parameters& params)
+    : Writer(out, type, params.n, params.q, params.t, params.noise_bound, coefficient_bits(params.q)) {}
+
+void Writer::write_bits(uint64 value, unsigned bits) {
+    acc_ |= static_cast<uint128>(value & low_mask(bits)) << acc_bits_;
+    acc_bits_ += bits;
+
+    // Whole words leave the accumulator as soon as they are complete
+    if (acc_bits_ >= 64) {
+        if (buffer_len_ + 8 > buffer_.size()) flush();
+        uint64 word = static_cast<uint64>(acc_);
+        for (int b = 0; b < 8; ++b) {
+            buffer_[buffer_len_++] = static_cast<unsigned char>(word >> (8 * b));
+        }
+        acc_ >>= 64;
+        acc_bits_ -= 64;
+    }
+}
+
+void Writer::write_coefficients(const int64* values, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        write_bits(static_cast<uint64>(core::modq(values[i], q_)), coeff_bits_);
+    }
+}
+
+void Writer::write_packed(const uint64* values, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        write_bits(values[i], coeff_bits_);
+    }
+}
+
+void Writer::flush() {
+    crc_ = crc32_update(crc_, buffer_.data(), buffer_len_);
+    out_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_len_));
+    if (!out_) {
+        throw std::runtime_error("Failed to write serialized object");
+    }
+    bytes_ += buffer_len_;
+    buffer_len_ = 0;
+}
+
+void Writer::finish() {
+    if (finished_) return;
+
+    // Pad the last partial byte with zeros
+    while (acc_bits_ > 0) {
+        if (buffer_len_ == buffer_.size()) flush();
+        buffer_[buffer_len_++] = static_cast<unsigned char>(acc_);
+        acc_ >>= 8;
+        acc_bits_ = acc_bits_ > 8 ? acc_bits_ - 8 : 0;
+    }
+    flush();
+
+    unsigned char trailer[4];
+    for (int b = 0; b < 4; ++b) {
+        trailer[b] = static_cast<unsigned char>(crc_ >> (8 * b));
+    }
+    out_.write(reinterpret_cast<const char*>(trailer), 4);
+    if (!out_) {
+        throw std::runtime_error("Failed to write serialized object");
+    }
+    bytes_ += 4;
+    finished_ = true;
+}
+
+// ========== Reader ==========
+
+// Bytes left in a seekable stream, SIZE_MAX for pipes and the like
+static std::size_t stream_bytes_left(std::istream& in) {
+    std::istream::pos_type start = in.tellg();
+    if (start == std::istream::pos_type(-1)) return SIZE_MAX;
+    in.seekg(0, std::ios::end);
+    std::istream::pos_type end = in.tellg();
+    in.seekg(start);
+    if (!in || end == std::istream::pos_type(-1) || end < start) {
+        in.clear();
+        in.seekg(start);
+        return SIZE_MAX;
+    }
+    return static_cast<std::size_t>(end - start);
+}
+
+Reader::Reader(std::istream& in, ObjectType expected)
+    : in_(in), available_(stream_bytes_left(in)), acc_(0), acc_bits_(0), buffer_pos_(0), buffer_len_(0), bytes_(0), crc_(0) {
+    if (read_bits(32) != FORMAT_MAGIC) {
+        throw std::runtime_error("Not a serialized turinged object");
+    }
+    header_.version = static_cast<uint16_t>(read_bits(16));
+    if (header_.version != FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported serialization format version");
+    }
+    header_.type = static_cast<ObjectType>(read_bits(16));
+    if (header_.type != expected) {
+        throw std::runtime_error("Serialized object type mismatch");
+    }
+    header_.n = read_u64();
+    header_.q = static_cast<int64>(read_u64());
+    header_.t = static_cast<int64>(read_u64());
+    header_.noise_bound = static_cast<int64>(read_u64());
+    header_.coeff_bits = static_cast<unsigned>(read_bits(8));
+    if (header_.coeff_bits == 0 || header_.coeff_bits > 64 ||
+        (header_.q != 0 && header_.coeff_bits != coefficient_bits(header_.q))) {
+        throw std::runtime_error("Invalid coefficient width in serialized object");
+    }
+}
+
+std::size_t Reader::read_length(std::size_t min_bits_each) {
+    return check_length(read_u64(), min_bits_each);
+}
+
+std::size_t Reader::check_length(uint64 count, std::size_t min_bits_each) const {
+    if (count > SIZE_MAX) {
+        throw std::runtime_error("Invalid length in serialized object");
+    }
+    if (available_ == SIZE_MAX || min_bits_each == 0) return count;
+
+    // Unread bits: the rest of the stream less the checksum, plus what is buffered
+    std::size_t buffered = (buffer_len_ - buffer_pos_) * 8 + acc_bits_;
+    std::size_t unread = available_ >= bytes_ + 4 ? (available_ - bytes_ - 4) * 8 : 0;
+    if (count > (unread + buffered) / min_bits_each) {
+        throw std::runtime_error("Invalid length in serialized object");
+    }
+    return static_cast<std::size_t>(count);
+}
+
+void Reader::fetch(std::size_t bytes) {
+    in_.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(bytes));
+    if (static_cast<std::size_t>(in_.gcount()) != bytes) {
+        throw std::runtime_error("Truncated serialized object");
+    }
+    crc_ = crc32_update(crc_, buffer_.data(), bytes);
+    bytes_ += bytes;
+    buffer_pos_ = 0;
+    buffer_len_ = bytes;
+}
+
+// Makes `bits` available, reading ahead at most as far as the `following_bits`
+// the caller will consume next, so no byte past the object is ever read
+void Reader::require(unsigned bits, std::size_t following_bits) {
+    while (acc_bits_ < bits) {
+        if (buffer_pos_ == buffer_len_) {
+            std::size_t wanted = (bits - acc_bits_ + following_bits + 7) / 8;
+            fetch(wanted < buffer_.size() ? wanted : buffer_.size());
+        }
+        acc_ |= static_cast<uint128>(buffer_[buffer_pos_++]) << acc_bits_;
+        acc_bits_ += 8;
+    }
+}
+
+uint64 Reader::read_bits(unsigned bits) {
+    require(bits, 0);
+    uint64 value = static_cast<uint64>(acc_) & low_mask(bits);
+    acc_ >>= bits;
+    acc_bits_ -= bits;
+    return value;
+}
+
+void Reader::read_packed(uint64* values, std::size_t count) {
+    unsigned bits = header_.coeff_bits;
+    for (std::size_t i = 0; i < count; ++i) {
+        require(bits, (count - i - 1) * bits);
+        values[i] = static_cast<uint64>(acc_) & low_mask(bits);
+        acc_ >>= bits;
+        acc_bits_ -= bits;
+    }
+}
+
+void Reader::read_coefficients(int64* values, std::size_t count) {
+    read_packed(reinterpret_cast<uint64*>(values), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (values[i] < 0 || values[i] >= header_.q) {
+            throw std::runtime_error("Coefficient out of range in serialized object");
+        }
+    }
+}
+
+void Reader::finish() {
+    // Drop the zero padding of the last byte; it is already covered by the checksum
+    acc_ = 0;
+    acc_bits_ = 0;
+
+    unsigned char trailer[4];
+    in_.read(reinterpret_cast<char*>(trailer), 4);
+    if (in_.gcount() != 4) {
+        throw std::runtime_error("Truncated serialized object");
+    }
+    bytes_ += 4;
+    uint32_t stored = 0;
+    for (int b = 0; b < 4; ++b) {
+        stored |= static_cast<uint32_t>(trailer[b]) << (8 * b);
+    }
+    if (stored != crc_) {
+        throw std::runtime_error("Checksum mismatch in serialized object");
+    }
+}
+
+// ========== Body helpers ==========
+
+static void write_polynomial(Writer& w, const Polynomial& poly) {
+    w.write_u64(poly.size());
+    w.write_coefficients(poly.data(), poly.size());
+}
+
+static void invalid_length() {
+    throw std::runtime_error("Invalid length in serialized object");
+}
+
+std::size_t checked_product(std::size_t a, std::size_t b) {
+    if (a != 0 && b > SIZE_MAX / a) invalid_length();
+    return a * b;
+}
+
+// Reads `count` values, growing `values` a block at a time as the data
+// arrives; on streams of unknown size a corrupt count then runs into the end
+// of the stream instead of sizing an allocation
+template <typename Vec>
+static void read_values(Reader& r, Vec& values, std::size_t count, bool coefficients) {
+    const std::size_t block = std::size_t(1) << 16;
+    values.clear();
+    for (std::size_t done = 0; done < count;) {
+        std::size_t take = std::min(block, count - done);
+        values.resize(done + take);
+        uint64* dst = reinterpret_cast<uint64*>(values.data() + done);
+        if (coefficients) {
+            r.read_coefficients(reinterpret_cast<int64*>(dst), take);
+        } else {
+            r.read_packed(dst, take);
+        }
+        done += take;
+    }
+}
+
+// Ring polynomials have the header's degree; an empty one is a trivial mask
+static Polynomial read_polynomial(Reader& r) {
+    std::size_t size = r.read_length(r.header().coeff_bits);
+    if (size != 0 && size != r.header().n) invalid_length();
+    Polynomial poly;
+    read_values(r, poly, size, true);
+    return poly;
+}
+
+// Keys hold std::vector<Polynomial>, ciphertexts pooled vectors
+template <typename Polys>
+static void write_polynomials(Writer& w, const Polys& polys) {
+    w.write_u64(polys.size());
+    for (const Polynomial& poly : polys) write_polynomial(w, poly);
+}
+
+// Every item below takes at least its own 64-bit length field
+template <typename Polys = std::vector<Polynomial>>
+static Polys read_polynomials(Reader& r) {
+    std::size_t count = r.read_length(64);
+    Polys polys;
+    for (std::size_t i = 0; i < count; ++i) polys.push_back(read_polynomial(r));
+    return polys;
+}
+
+// NTT-form polynomials are stored as their coefficients mod q, which is a
+// quarter of the size; to_ntt of the centered lift restores them exactly
+static void write_ntt_polynomial(Writer& w, const polynomial::NTTPolynomial& poly, int64 q) {
+    write_polynomial(w, polynomial::from_ntt(poly, q));
+}
+
+static polynomial::NTTPolynomial read_ntt_polynomial(Reader& r) {
+    return polynomial::to_ntt(read_polynomial(r), r.header().q);
+}
+
+static void write_glwe_body(Writer& w, const schemes::GLWECiphertext& ct) {
+    write_polynomials(w, ct.d_tilde);
+    write_polynomial(w, ct.b);
+}
+
+static schemes::GLWECiphertext read_glwe_body(Reader& r) {
+    schemes::GLWECiphertext ct;
+    ct.d_tilde = read_polynomials<core::PooledVector<Polynomial>>(r);
+    ct.b = read_polynomial(r);
+    return ct;
+}
+
+static void write_glev_body(Writer& w, const schemes::GLevCiphertext& ct) {
+    w.write_u64(ct.levels.size());
+    for (const schemes::GLWECiphertext& level : ct.levels) write_glwe_body(w, level);
+}
+
+static schemes::GLevCiphertext read_glev_body(Reader& r) {
+    schemes::GLevCiphertext ct;
+    std::size_t levels = r.read_length(128);
+    for (std::size_t j = 0; j < levels; ++j) ct.levels.push_back(read_glwe_body(r));
+    return ct;
+}
+
+static void write_rlwe_ksk_body(Writer& w, const keys::RLWEKeySwitchKey& key, int64 q) {
+    w.write_u64(static_cast<uint64>(key.beta));
+    w.write_u64(static_cast<uint64>(key.levels));
+    for (int j = 0; j < key.levels; ++j) {
+        write_ntt_polynomial(w, key.a[j], q);
+        write_ntt_polynomial(w, key.b[j], q);
+    }
+}
+
+// Gadget of base beta >= 2 over q < 2^63 has at most 63 levels
+static void read_gadget(Reader& r, int64& beta, int& levels) {
+    beta = static_cast<int64>(r.read_u64());
+    uint64 count = r.read_u64();
+    if (beta < 2 || count == 0 || count > 64) invalid_length();
+    levels = static_cast<int>(count);
+}
+
+static keys::RLWEKeySwitchKey read_rlwe_ksk_body(Reader& r) {
+    keys::RLWEKeySwitchKey key;
+    read_gadget(r, key.beta, key.levels);
+    for (int j = 0; j < key.levels; ++j) {
+        key.a.push_back(read_ntt_polynomial(r));
+        key.b.push_back(read_ntt_polynomial(r));
+    }
+    return key;
+}
+
+static void write_glwe_ksk_body(Writer& w, const keys::GLWEKeySwitchKey& key, int64 q) {
+    w.write_u64(static_cast<uint64>(key.beta));
+    w.write_u64(static_cast<uint64>(key.levels));
+    w.write_u64(key.body.size());
+    w.write_u64(key.mask.empty() ? 0 : key.mask[0].size());
+    for (std::size_t row = 0; row < key.body.size(); ++row) {
+        for (const polynomial::NTTPolynomial& m : key.mask[row]) write_ntt_polynomial(w, m, q);
+        write_ntt_polynomial(w, key.body[row], q);
+    }
+}
+
+static keys::GLWEKeySwitchKey read_glwe_ksk_body(Reader& r) {
+    keys::GLWEKeySwitchKey key;
+    read_gadget(r, key.beta, key.levels);
+    std::size_t rows = r.read_length(64);
+    std::size_t k_out = r.read_length(64);
+    for (std::size_t row = 0; row < rows; ++row) {
+        key.mask.emplace_back();
+        for (std::size_t o = 0; o < k_out; ++o) key.mask[row].push_back(read_ntt_polynomial(r));
+        key.body.push_back(read_ntt_polynomial(r));
+    }
+    return key;
+}
+
+static void write_rns_polynomial(Writer& w, const rns::RNSPolynomial& poly) {
+    w.write_bits(poly.ntt_form ? 1 : 0, 8);
+    w.write_u64(poly.prime_count());
+    w.write_u64(poly.degree());
+    for (const std::vector<uint64>& residue : poly.residues) {
+        w.write_packed(residue.data(), residue.size());
+    }
+}
+
+static rns::RNSPolynomial read_rns_polynomial(Reader& r) {
+    bool ntt_form = r.read_bits(8) != 0;
+    uint64 prime_count = r.read_u64();
+    std::size_t degree = r.read_u64();
+    if (degree != r.header().n) invalid_length();
+    r.check_length(prime_count, checked_product(degree, r.header().coeff_bits));
+
+    rns::RNSPolynomial poly;
+    poly.ntt_form = ntt_form;
+    for (uint64 i = 0; i < prime_count; ++i) {
+        poly.residues.emplace_back();
+        read_values(r, poly.residues.back(), degree, false);
+    }
+    return poly;
+}
+
+static void write_rns_ksk_body(Writer& w, const keys::RNSKeySwitchKey& key) {
+    w.write_u64(key.body.size());
+    for (std::size_t i = 0; i < key.body.size(); ++i) {
+        w.write_u64(key.mask[i].size());
+        for (const rns::RNSPolynomial& m : key.mask[i]) write_rns_polynomial(w, m);
+        write_rns_polynomial(w, key.body[i]);
+    }
+}
+
+static keys::RNSKeySwitchKey read_rns_ksk_body(Reader& r) {
+    keys::RNSKeySwitchKey key;
+    std::size_t count = r.read_length(64);
+    for (std::size_t i = 0; i < count; ++i) {
+        key.mask.emplace_back();
+        std::size_t k = r.read_length(64);
+        for (std::size_t o = 0; o < k; ++o) key.mask[i].push_back(read_rns_polynomial(r));
+        key.body.push_back(read_rns_polynomial(r));
+    }
+    return key;
+}
+
+// RNS objects carry no single modulus; residues are packed at the width of
+// the largest prime in the chain or the auxiliary base
+static unsigned rns_residue_bits(const rns::RNSParameters& params) {
+    uint64 largest = 0;
+    for (uint64 p : params.q_base(params.top_level()).primes) largest = std::max(largest, p);
+    for (uint64 p : params.p_base.primes) largest = std::max(largest, p);
+    return coefficient_bits(static_cast<int64>(largest));
+}
+
+template <typename Body>
+static void write_object(std::ostream& out, ObjectType type, const Parameters& params, Body body) {
+    Writer w(out, type, params);
+    body(w);
+    w.finish();
+}
+
+template <typename T, typename Body>
+static T read_object(std::istream& in, ObjectType type, Header* header, Body body) {
+    Reader r(in, type);
+    T value = body(r);
+    r.finish();
+    if (header) *header = r.header();
+    return value;
+}
+
+// ========== Ciphertexts ==========
+
+void serialize(std::ostream& out, const schemes::LWECiphertext& ct, const Parameters& params) {
+    write_object(out, ObjectType::LWECiphertext, params, [&](Writer& w) {
+        w.write_u64(ct.a.size());
+        w.write_coefficients(ct.a.data(), ct.a.size());
+        w.write_coefficients(&ct.b, 1);
+    });
+}
+
+void serialize(std::ostream& out, const schemes::RLWECiphertext& ct, const Parameters& params) {
+    write_object(out, ObjectType::RLWECiphertext, params, [&](Writer& w) {
+        write_polynomial(w, ct.a);
+        write_polynomial(w, ct.b);
+    });
+}
+
+void serialize(std::ostream& out, const schemes::GLWECiphertext& ct, const Parameters& params) {
+    write_object(out, ObjectType::GLWECiphertext, params, [&](Writer& w) { write_glwe_body(w, ct); });
+}
+
+void serialize(std::ostream& out, const schemes::GLevCiphertext& ct, const Parameters& params) {
+    write_object(out, ObjectType::GLevCiphertext, params, [&](Writer& w) { write_glev_body(w, ct); });
+}
+
+void serialize(std::ostream& out, const schemes::GGSWCiphertext& ct, const Parameters& params) {
+    write_object(out, ObjectType::GGSWCiphertext, params, [&](Writer& w) {
+        w.write_u64(ct.glev_rows.size());
+        for (const schemes::GLevCiphertext& row : ct.glev_rows) write_glev_body(w, row);
+    });
+}
+
+schemes::LWECiphertext deserialize_lwe_ciphertext(std::istream& in, Header* header) {
+    return read_object<schemes::LWECiphertext>(in, ObjectType::LWECiphertext, header, [](Reader& r) {
+        schemes::LWECiphertext ct;
+        read_values(r, ct.a, r.read_length(r.header().coeff_bits), true);
+        r.read_coefficients(&ct.b, 1);
+        return ct;
+    });
+}
+
+schemes::RLWECiphertext deserialize_rlwe_ciphertext(std::istream& in, Header* header) {
+    return read_object<schemes::RLWECiphertext>(in, ObjectType::RLWECiphertext, header, [](Reader& r) {
+        schemes::RLWECiphertext ct;
+        ct.a = read_polynomial(r);
+        ct.b = read_polynomial(r);
+        return ct;
+    });
+}
+
+schemes::GLWECiphertext deserialize_glwe_ciphertext(std::istream& in, Header* header) {
+    return read_object<schemes::GLWECiphertext>(in, ObjectType::GLWECiphertext, header, read_glwe_body);
+}
+
+schemes::GLevCiphertext deserialize_glev_ciphertext(std::istream& in, Header* header) {
+    return read_object<schemes::GLevCiphertext>(in, ObjectType::GLevCiphertext, header, read_glev_body);
+}
+
+schemes::GGSWCiphertext deserialize_ggsw_ciphertext(std::istream& in, Header* header) {
+    return read_object<schemes::GGSWCiphertext>(in, ObjectType::GGSWCiphertext, header, [](Reader& r) {
+        schemes::GGSWCiphertext ct;
+        std::size_t rows = r.read_length(64);
+        for (std::size_t row = 0; row < rows; ++row) ct.glev_rows.push_back(read_glev_body(r));
+        return ct;
+    });
+}
+
+// ========== Keys ==========
+
+void serialize(std::ostream& out, const keys::LWESecretKey& key, const Parameters& params) {
+    write_object(out, ObjectType::LWESecretKey, params, [&](Writer& w) {
+        w.write_u64(key.s.size());
+        w.write_coefficients(key.s.data(), key.s.size());
+    });
+}
+
+void serialize(std::ostream& out, const keys::RLWESecretKey& key, const Parameters& params) {
+    write_object(out, ObjectType::RLWESecretKey, params, [&](Writer& w) { write_polynomial(w, key.s); });
+}
+
+void serialize(std::ostream& out, const keys::GLWESecretKey& key, const Parameters& params) {
+    write_object(out, ObjectType::GLWESecretKey, params, [&](Writer& w) { write_polynomials(w, key.s); });
+}
+
+void serialize(std::ostream& out, const keys::LWEPublicKey& key, const Parameters& params) {
+    write_object(out, ObjectType::LWEPublicKey, params, [&](Writer& w) {
+        w.write_u64(key.k);
+        w.write_u64(key.samples);
+        w.write_coefficients(key.a.data(), key.a.size());
+        w.write_coefficients(key.b.data(), key.b.size());
+    });
+}
+
+void serialize(std::ostream& out, const keys::RLWEPublicKey& key, const Parameters& params) {
+    write_object(out, ObjectType::RLWEPublicKey, params, [&](Writer& w) {
+        write_polynomial(w, key.a);
+        write_polynomial(w, key.b);
+    });
+}
+
+void serialize(std::ostream& out, const keys::GLWEPublicKey& key, const Parameters& params) {
+    write_object(out, ObjectType::GLWEPublicKey, params, [&](Writer& w) {
+        write_polynomial(w, key.pk1);
+        write_polynomials(w, key.pk2);
+    });
+}
+
+void serialize(std::ostream& out, const keys::RLWEKeySwitchKey& key, const Parameters& params) {
+    write_object(out, ObjectType::RLWEKeySwitchKey, params, [&](Writer& w) { write_rlwe_ksk_body(w, key, params.q); });
+}
+
+void serialize(std::ostream& out, const keys::GLWEKeySwitchKey& key, const Parameters& params) {
+    write_object(out, ObjectType::GLWEKeySwitchKey, params, [&](Writer& w) { write_glwe_ksk_body(w, key, params.q); });
+}
+
+void serialize(std::ostream& out, const keys::RLWEGaloisKeys& keys, const Parameters& params) {
+    write_object(out, ObjectType::RLWEGaloisKeys, params, [&](Writer& w) {
+        w.write_u64(keys.keys.size());
+        for (const auto& entry : keys.keys) {
+            w.write_u64(entry.first);
+            write_rlwe_ksk_body(w, entry.second, params.q);
+        }
+    });
+}
+
+void serialize(std::ostream& out, const keys::GLWEGaloisKeys& keys, const Parameters& params) {
+    write_object(out, ObjectType::GLWEGaloisKeys, params, [&](Writer& w) {
+        w.write_u64(keys.keys.size());
+        for (const auto& entry : keys.keys) {
+            w.write_u64(entry.first);
+            write_glwe_ksk_body(w, entry.second, params.q);
+        }
+    });
+}
+
+void serialize(std::ostream& out, const keys::LWEKeySwitchKey& key, const Parameters& params) {
+    write_object(out, ObjectType::LWEKeySwitchKey, params, [&](Writer& w) {
+        w.write_u64(key.n_in);
+        w.write_u64(key.n_out);
+        w.write_u64(static_cast<uint64>(key.beta));
+        w.write_u64(static_cast<uint64>(key.levels));
+        w.write_coefficients(key.data.data(), key.data.size());
+    });
+}
+
+void write_bootstrapping_key_shape(Writer& w, const keys::BootstrappingKey& key) {
+    w.write_u64(key.n_lwe);
+    w.write_u64(key.k);
+    w.write_u64(key.n);
+    w.write_u64(static_cast<uint64>(key.l));
+    w.write_u64(static_cast<uint64>(key.beta));
+    w.write_bits(key.transformed ? 1 : 0, 8);
+}
+
+void serialize(std::ostream& out, const keys::BootstrappingKey& key, const Parameters& params) {
+    write_object(out, ObjectType::BootstrappingKey, params, [&](Writer& w) {
+        write_bootstrapping_key_shape(w, key);
+        if (!key.transformed) {
+            w.write_packed(key.data.data(), key.data.size());
+            return;
+        }
+
+        // One polynomial at a time back to coefficients mod q
+        polynomial::NTTPolynomial ntt(key.n);
+        for (std::size_t offset = 0; offset < key.data.size(); offset += key.poly_words()) {
+            for (std::size_t p = 0; p < polynomial::EXACT_PRIME_COUNT; ++p) {
+                const uint64* src = key.data.data() + offset + p * key.n;
+                std::copy(src, src + key.n, ntt.residues[p].begin());
+            }
+            Polynomial coeffs = polynomial::from_ntt(ntt, params.q);
+            w.write_coefficients(coeffs.data(), coeffs.size());
+        }
+    });
+}
+
+void serialize(std::ostream& out, const keys::RNSKeySwitchKey& key, const rns::RNSParameters& params) {
+    Writer w(out, ObjectType::RNSKeySwitchKey, params.n, 0, params.t, params.noise_bound, rns_residue_bits(params));
+    write_rns_ksk_body(w, key);
+    w.finish();
+}
+
+void serialize(std::ostream& out, const keys::RNSRelinKey& key, const rns::RNSParameters& params) {
+    Writer w(out, ObjectType::RNSRelinKey, params.n, 0, params.t, params.noise_bound, rns_residue_bits(params));
+    w.write_u64(key.keys.size());
+    for (const keys::RNSKeySwitchKey& ksk : key.keys) write_rns_ksk_body(w, ksk);
+    w.finish();
+}
+
+keys::LWESecretKey deserialize_lwe_secret_key(std::istream& in, Header* header) {
+    return read_object<keys::LWESecretKey>(in, ObjectType::LWESecretKey, header, [](Reader& r) {
+        keys::LWESecretKey key;
+        read_values(r, key.s, r.read_length(r.header().coeff_bits), true);
+        return key;
+    });
+}
+
+keys::RLWESecretKey deserialize_rlwe_secret_key(std::istream& in, Header* header) {
+    return read_object<keys::RLWESecretKey>(in, ObjectType::RLWESecretKey, header, [](Reader& r) {
+        keys::RLWESecretKey key;
+        key.s = read_polynomial(r);
+        return key;
+    });
+}
+
+keys::GLWESecretKey deserialize_glwe_secret_key(std::istream& in, Header* header) {
+    return read_object<keys::GLWESecretKey>(in, ObjectType::GLWESecretKey, header, [](Reader& r) {
+        keys::GLWESecretKey key;
+        key.s = read_polynomials(r);
+        return key;
+    });
+}
+
+keys::LWEPublicKey deserialize_lwe_public_key(std::istream& in, Header* header) {
+    return read_object<keys::LWEPublicKey>(in, ObjectType::LWEPublicKey, header, [](Reader& r) {
+        keys::LWEPublicKey key;
+        key.k = r.read_u64();
+        key.samples = r.read_u64();
+        if (key.k == SIZE_MAX) invalid_length();
+        std::size_t words = r.check_length(checked_product(key.k + 1, key.samples), r.header().coeff_bits);
+        read_values(r, key.a, words - key.samples, true);
+        read_values(r, key.b, key.samples, true);
+        return key;
+    });
+}
+
+keys::RLWEPublicKey deserialize_rlwe_public_key(std::istream& in, Header* header) {
+    return read_object<keys::RLWEPublicKey>(in, ObjectType::RLWEPublicKey, header, [](Reader& r) {
+        keys::RLWEPublicKey key;
+        key.a = read_polynomial(r);
+        key.b = read_polynomial(r);
+        return key;
+    });
+}
+
+keys::GLWEPublicKey deserialize_glwe_public_key(std::istream& in, Header* header) {
+    return read_object<keys::GLWEPublicKey>(in, ObjectType::GLWEPublicKey, header, [](Reader& r) {
+        keys::GLWEPublicKey key;
+        key.pk1 = read_polynomial(r);
+        key.pk2 = read_polynomials(r);
+        return key;
+    });
+}
+
+keys::RLWEKeySwitchKey deserialize_rlwe_key_switch_key(std::istream& in, Header* header) {
+    return read_object<keys::RLWEKeySwitchKey>(in, ObjectType::RLWEKeySwitchKey, header, read_rlwe_ksk_body);
+}
+
+keys::GLWEKeySwitchKey deserialize_glwe_key_switch_key(std::istream& in, Header* header) {
+    return read_object<keys::GLWEKeySwitchKey>(in, ObjectType::GLWEKeySwitchKey, header, read_glwe_ksk_body);
+}
+
+keys::RLWEGaloisKeys deserialize_rlwe_galois_keys(std::istream& in, Header* header) {
+    return read_object<keys::RLWEGaloisKeys>(in, ObjectType::RLWEGaloisKeys, header, [](Reader& r) {
+        keys::RLWEGaloisKeys keys;
+        std::size_t count = r.read_length(64);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint64 galois_elt = r.read_u64();
+            keys.keys[galois_elt] = read_rlwe_ksk_body(r);
+        }
+        return keys;
+    });
+}
+
+keys::GLWEGaloisKeys deserialize_glwe_galois_keys(std::istream& in, Header* header) {
+    return read_object<keys::GLWEGaloisKeys>(in, ObjectType::GLWEGaloisKeys, header, [](Reader& r) {
+        keys::GLWEGaloisKeys keys;
+        std::size_t count = r.read_length(64);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint64 galois_elt = r.read_u64();
+            keys.keys[galois_elt] = read_glwe_ksk_body(r);
+        }
+        return keys;
+    });
+}
+
+keys::LWEKeySwitchKey deserialize_lwe_key_switch_key(std::istream& in, Header* header) {
+    return read_object<keys::LWEKeySwitchKey>(in, ObjectType::LWEKeySwitchKey, header, [](Reader& r) {
+        keys::LWEKeySwitchKey key;
+        key.n_in = r.read_u64();
+        key.n_out = r.read_u64();
+        read_gadget(r, key.beta, key.levels);
+        std::size_t words = checked_product(checked_product(key.n_in, key.levels), key.n_out + 1);
+        read_values(r, key.data, r.check_length(words, r.header().coeff_bits), true);
+        return key;
+    });
+}
+
+keys::BootstrappingKey deserialize_bootstrapping_key(std::istream& in, Header* header) {
+    return read_object<keys::BootstrappingKey>(in, ObjectType::BootstrappingKey, header, [](Reader& r) {
+        keys::BootstrappingKey key;
+        key.n_lwe = r.read_u64();
+        key.k = r.read_u64();
+        key.n = r.read_u64();
+        uint64 l = r.read_u64();
+        key.beta = static_cast<int64>(r.read_u64());
+        key.transformed = r.read_bits(8) != 0;
+        if (key.n != r.header().n || key.k == 0 || l > 63 || key.beta < 2) invalid_length();
+        key.l = static_cast<int>(l);
+
+        // Stored as coefficients either way: n_lwe GGSWs of (k+1)(l+1) GLWEs of k+1 polynomials
+        std::size_t glwes = checked_product(key.n_lwe, checked_product(key.k + 1, key.l + 1));
+        std::size_t polys = checked_product(glwes, key.k + 1);
+        r.check_length(checked_product(polys, key.n), r.header().coeff_bits);
+        if (!key.transformed) {
+            read_values(r, key.data, polys * key.n, false);
+            return key;
+        }
+
+        Polynomial coeffs(key.n);
+        for (std::size_t i = 0; i < polys; ++i) {
+            r.read_coefficients(coeffs.data(), key.n);
+            polynomial::NTTPolynomial ntt = polynomial::to_ntt(coeffs, r.header().q);
+            for (const auto& residue : ntt.residues) {
+                key.data.insert(key.data.end(), residue.begin(), residue.end());
+            }
+        }
+        return key;
+    });
+}
+
+keys::RNSKeySwitchKey deserialize_rns_key_switch_key(std::istream& in, Header* header) {
+    return read_object<keys::RNSKeySwitchKey>(in, ObjectType::RNSKeySwitchKey, header, read_rns_ksk_body);
+}
+
+keys::RNSRelinKey deserialize_rns_relin_key(std::istream& in, Header* header) {
+    return read_object<keys::RNSRelinKey>(in, ObjectType::RNSRelinKey, header, [](Reader& r) {
+        keys::RNSRelinKey key;
+        std::size_t count = r.read_length(64);
+        for (std::size_t i = 0; i < count; ++i) key.keys.push_back(read_rns_ksk_body(r));
+        return key;
+    });
+}
+
+}
+}
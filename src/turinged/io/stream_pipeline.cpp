@@ -0,0 +1,408 @@
+#include "turinged/io/stream_pipeline.hpp"
+#include "turinged/io/serialization.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/core/bounded_queue.hpp"
+#include "turinged/core/parallel.hpp"
+#include "turinged/core/trace.hpp"
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace turinged {
+namespace io {
+
+// ========== File descriptor records ==========
+
+RecordSource fd_record_source(int fd, std::size_t record_bytes) {
+    if (record_bytes == 0 || record_bytes > 7) {
+        throw std::runtime_error("Record width must be 1 to 7 bytes");
+    }
+
+    auto buffer = std::make_shared<std::vector<unsigned char>>();
+    return [fd, record_bytes, buffer](int64* records, std::size_t max) {
+        buffer->resize(max * record_bytes);
+
+        std::size_t filled = 0;
+        while (filled < buffer->size()) {
+            ssize_t got = read(fd, buffer->data() + filled, buffer->size() - filled);
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0) throw std::runtime_error("Failed to read plaintext records");
+            if (got == 0) break;
+            filled += static_cast<std::size_t>(got);
+        }
+
+        // A trailing partial record is zero-padded
+        std::size_t count = (filled + record_bytes - 1) / record_bytes;
+        std::fill(buffer->begin() + filled, buffer->begin() + count * record_bytes, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            uint64 value = 0;
+            for (std::size_t b = 0; b < record_bytes; ++b) {
+                value |= static_cast<uint64>((*buffer)[i * record_bytes + b]) << (8 * b);
+            }
+            records[i] = static_cast<int64>(value);
+        }
+        return count;
+    };
+}
+
+RecordSink fd_record_sink(int fd, std::size_t record_bytes) {
+    if (record_bytes == 0 || record_bytes > 7) {
+        throw std::runtime_error("Record width must be 1 to 7 bytes");
+    }
+
+    auto buffer = std::make_shared<std::vector<unsigned char>>();
+    return [fd, record_bytes, buffer](const int64* records, std::size_t count) {
+        buffer->resize(count * record_bytes);
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t b = 0; b < record_bytes; ++b) {
+                (*buffer)[i * record_bytes + b] = static_cast<unsigned char>(static_cast<uint64>(records[i]) >> (8 * b));
+            }
+        }
+
+        std::size_t written = 0;
+        while (written < buffer->size()) {
+            ssize_t put = write(fd, buffer->data() + written, buffer->size() - written);
+            if (put < 0 && errno == EINTR) continue;
+            if (put <= 0) throw std::runtime_error("Failed to write plaintext records");
+            written += static_cast<std::size_t>(put);
+        }
+    };
+}
+
+// ========== Pipeline ==========
+
+// produce(task) runs on the calling thread until it returns false, process(task)
+// on the worker pool, and consume(result) on a writer thread in input order.
+// The first exception from any stage stops the pipeline and is rethrown.
+// At most `window` tasks are between produce and consume at once, so results
+// held back behind a slow predecessor cannot pile up without bound.
+template <typename Task, typename Result, typename Produce, typename Process, typename Consume>
+static void run_pipeline(const StreamOptions& options, Produce produce, Process process, Consume consume) {
+    std::size_t workers = options.num_threads == 0 ? core::default_thread_count() : options.num_threads;
+    std::size_t depth = options.queue_depth == 0 ? 2 * workers : options.queue_depth;
+
+    core::BoundedQueue<std::pair<std::size_t, Task>> tasks(depth);
+    core::BoundedQueue<std::pair<std::size_t, Result>> results(depth);
+
+    // Sequence numbers consumed so far; the producer waits on it once the window is full
+    std::size_t window = 2 * depth + workers;
+    std::size_t consumed = 0;
+    bool stopped = false;
+    std::mutex window_mutex;
+    std::condition_variable window_cv;
+
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto fail = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = std::current_exception();
+        }
+        tasks.close();
+        results.close();
+        {
+            std::lock_guard<std::mutex> lock(window_mutex);
+            stopped = true;
+        }
+        window_cv.notify_all();
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t w = 0; w < workers; ++w) {
+        pool.emplace_back([&, w]() {
+            if (core::tracing_active()) core::set_trace_thread_name("stream worker " + std::to_string(w));
+            std::pair<std::size_t, Task> task;
+            while (tasks.pop(task)) {
+                try {
+                    // Only the work itself is traced; waits on the queues show as gaps
+                    Result result;
+                    {
+                        TURINGED_TRACE_SCOPE("stream.process");
+                        result = process(std::move(task.second));
+                    }
+                    results.push(std::make_pair(task.first, std::move(result)));
+                } catch (...) {
+                    fail();
+                }
+            }
+        });
+    }
+
+    // Results arrive out of order; hold them until their predecessors are written
+    std::thread writer([&]() {
+        if (core::tracing_active()) core::set_trace_thread_name("stream writer");
+        std::map<std::size_t, Result> pending;
+        std::size_t next = 0;
+        std::pair<std::size_t, Result> result;
+        try {
+            while (results.pop(result)) {
+                pending.emplace(result.first, std::move(result.second));
+                if (pending.begin()->first != next) continue;
+                while (!pending.empty() && pending.begin()->first == next) {
+                    TURINGED_TRACE_SCOPE("stream.consume");
+                    consume(std::move(pending.begin()->second));
+                    pending.erase(pending.begin());
+                    ++next;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(window_mutex);
+                    consumed = next;
+                }
+                window_cv.notify_one();
+            }
+        } catch (...) {
+            fail();
+        }
+    });
+
+    try {
+        std::size_t sequence = 0;
+        Task task;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(window_mutex);
+                window_cv.wait(lock, [&]() { return stopped || sequence - consumed < window; });
+                if (stopped) break;
+            }
+            {
+                TURINGED_TRACE_SCOPE("stream.produce");
+                if (!produce(task)) break;
+            }
+            if (!tasks.push(std::make_pair(sequence++, std::move(task)))) break;
+            task = Task();
+        }
+    } catch (...) {
+        fail();
+    }
+
+    tasks.close();
+    for (std::thread& t : pool) t.join();
+    results.close();
+    writer.join();
+
+    if (error) std::rethrow_exception(error);
+}
+
+struct PlainBatch {
+    std::vector<Polynomial> messages;
+    std::vector<std::size_t> counts;
+    std::size_t bytes = 0;              // serialized size, decrypt side
+};
+
+struct CipherBatch {
+    std::vector<schemes::RLWECiphertext> cts;
+    std::vector<std::size_t> counts;
+    std::size_t bytes = 0;
+};
+
+static std::size_t plaintext_bytes(std::size_t records, int64 t) {
+    std::size_t bits = 0;
+    while ((static_cast<int64>(1) << (bits + 1)) <= t) ++bits;
+    return records * bits / 8;
+}
+
+static void write_chunk(Writer& w, std::size_t count, const schemes::RLWECiphertext& ct) {
+    w.write_u64(count);
+    w.write_u64(ct.a.size());
+    w.write_coefficients(ct.a.data(), ct.a.size());
+    w.write_u64(ct.b.size());
+    w.write_coefficients(ct.b.data(), ct.b.size());
+}
+
+template <typename Encrypt>
+static StreamStats run_encrypt_stream(
+    const RecordSource& source,
+    std::ostream& out,
+    const Parameters& params,
+    const StreamOptions& options,
+    Encrypt encrypt
+) {
+    if (params.t <= 0) {
+        throw std::runtime_error("Streaming encryption needs a plaintext modulus");
+    }
+
+    std::size_t n = params.n;
+    std::size_t batch_size = options.batch_size == 0 ? 1 : options.batch_size;
+    bool exhausted = false;
+
+    StreamStats stats;
+    auto start = std::chrono::steady_clock::now();
+
+    auto produce = [&](PlainBatch& batch) {
+        while (!exhausted && batch.messages.size() < batch_size) {
+            Polynomial message(n, 0);
+            std::size_t filled = 0;
+            while (filled < n) {
+                std::size_t got = source(message.data() + filled, n - filled);
+                if (got == 0) {
+                    exhausted = true;
+                    break;
+                }
+                filled += got;
+            }
+            if (filled == 0) break;
+
+            for (std::size_t i = 0; i < filled; ++i) {
+                if (message[i] < 0 || message[i] >= params.t) {
+                    throw std::runtime_error("Plaintext record out of range for t");
+                }
+            }
+            batch.messages.push_back(std::move(message));
+            batch.counts.push_back(filled);
+        }
+        return !batch.messages.empty();
+    };
+
+    auto process = [&](PlainBatch&& batch) {
+        CipherBatch result;
+        result.cts = encrypt(batch.messages);
+        result.counts = std::move(batch.counts);
+        return result;
+    };
+
+    auto consume = [&](CipherBatch&& batch) {
+        for (std::size_t i = 0; i < batch.cts.size(); ++i) {
+            Writer w(out, ObjectType::StreamChunk, params);
+            write_chunk(w, batch.counts[i], batch.cts[i]);
+            w.finish();
+            stats.ciphertext_bytes += w.bytes_written();
+            stats.records += batch.counts[i];
+            ++stats.ciphertexts;
+        }
+        if (options.progress) {
+            stats.plaintext_bytes = plaintext_bytes(stats.records, params.t);
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            options.progress(stats);
+        }
+    };
+
+    run_pipeline<PlainBatch, CipherBatch>(options, produce, process, consume);
+
+    // End of stream marker
+    Writer w(out, ObjectType::StreamChunk, params);
+    w.write_u64(0);
+    w.finish();
+    stats.ciphertext_bytes += w.bytes_written();
+
+    stats.plaintext_bytes = plaintext_bytes(stats.records, params.t);
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+StreamStats encrypt_stream(
+    const RecordSource& source,
+    std::ostream& out,
+    const keys::RLWEPublicKey& pk,
+    const Parameters& params,
+    const StreamOptions& options
+) {
+    return run_encrypt_stream(source, out, params, options, [&](const std::vector<Polynomial>& messages) {
+        return schemes::encrypt_rlwe_batch(messages, pk, params, 1);
+    });
+}
+
+StreamStats encrypt_stream(
+    const RecordSource& source,
+    std::ostream& out,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params,
+    const StreamOptions& options
+) {
+    return run_encrypt_stream(source, out, params, options, [&](const std::vector<Polynomial>& messages) {
+        std::vector<schemes::RLWECiphertext> cts;
+        cts.reserve(messages.size());
+        for (const Polynomial& m : messages) cts.push_back(schemes::encrypt_rlwe(m, sk, params));
+        return cts;
+    });
+}
+
+StreamStats decrypt_stream(
+    std::istream& in,
+    const RecordSink& sink,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params,
+    const StreamOptions& options
+) {
+    std::size_t batch_size = options.batch_size == 0 ? 1 : options.batch_size;
+    bool finished = false;
+
+    StreamStats stats;
+    auto start = std::chrono::steady_clock::now();
+
+    auto produce = [&](CipherBatch& batch) {
+        while (!finished && batch.cts.size() < batch_size) {
+            Reader r(in, ObjectType::StreamChunk);
+            std::size_t count = r.read_u64();
+            if (count == 0) {
+                r.finish();
+                batch.bytes += r.bytes_read();
+                finished = true;
+                break;
+            }
+
+            // Both polynomials have the stream's degree; check before sizing them
+            if (count > params.n) {
+                throw std::runtime_error("Stream chunk holds more records than coefficients");
+            }
+            schemes::RLWECiphertext ct;
+            for (Polynomial* poly : {&ct.a, &ct.b}) {
+                if (r.read_length(r.header().coeff_bits) != params.n) {
+                    throw std::runtime_error("Invalid length in serialized object");
+                }
+                poly->resize(params.n);
+                r.read_coefficients(poly->data(), params.n);
+            }
+            r.finish();
+
+            batch.cts.push_back(std::move(ct));
+            batch.counts.push_back(count);
+            batch.bytes += r.bytes_read();
+        }
+        return !batch.cts.empty() || batch.bytes > 0;
+    };
+
+    auto process = [&](CipherBatch&& batch) {
+        PlainBatch result;
+        for (const schemes::RLWECiphertext& ct : batch.cts) {
+            result.messages.push_back(schemes::decrypt_rlwe(ct, sk, params));
+        }
+        result.counts = std::move(batch.counts);
+        result.bytes = batch.bytes;
+        return result;
+    };
+
+    auto consume = [&](PlainBatch&& batch) {
+        for (std::size_t i = 0; i < batch.messages.size(); ++i) {
+            sink(batch.messages[i].data(), batch.counts[i]);
+            stats.records += batch.counts[i];
+            ++stats.ciphertexts;
+        }
+        stats.ciphertext_bytes += batch.bytes;
+        if (options.progress) {
+            stats.plaintext_bytes = plaintext_bytes(stats.records, params.t);
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            options.progress(stats);
+        }
+    };
+
+    run_pipeline<CipherBatch, PlainBatch>(options, produce, process, consume);
+
+    if (!finished) {
+        throw std::runtime_error("Ciphertext stream ended without its end marker");
+    }
+
+    stats.plaintext_bytes = plaintext_bytes(stats.records, params.t);
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+}
+}
@@ -0,0 +1,348 @@
+#include "turinged/keys/key_generation.hpp"
+#include "turinged/io/serialization.hpp"
+#include "turinged/schemes/ggsw.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/parallel.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+
+namespace turinged {
+namespace keys {
+
+// Secret seed for the noise streams; unlike the mask seed it is never stored
+static uint64 fresh_seed() {
+    std::random_device device;
+    return (static_cast<uint64>(device()) << 32) ^ device();
+}
+
+static std::size_t thread_count(const KeygenOptions& options) {
+    return options.num_threads == 0 ? core::default_thread_count() : options.num_threads;
+}
+
+static std::size_t chunk_items(const KeygenOptions& options) {
+    return options.chunk_size == 0 ? 4 * thread_count(options) : options.chunk_size;
+}
+
+// Generates `total` items of `item_words` words in chunks across the thread pool.
+// target(begin) gives the destination of the chunk starting at item `begin`,
+// sink(data, words) consumes it once the chunk is complete.
+template <typename T, typename Target, typename Generate, typename Sink>
+static void generate_chunked(
+    std::size_t total,
+    std::size_t item_words,
+    const KeygenOptions& options,
+    Target target,
+    Generate generate,
+    Sink sink
+) {
+    std::size_t num_threads = thread_count(options);
+    std::size_t chunk = chunk_items(options);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t begin = 0; begin < total; begin += chunk) {
+        std::size_t count = std::min(chunk, total - begin);
+        T* dst = target(begin);
+        core::parallel_for(count, [&](std::size_t i) {
+            generate(begin + i, dst + i * item_words);
+        }, num_threads);
+        sink(dst, count * item_words);
+
+        if (options.progress) {
+            KeygenProgress progress;
+            progress.completed = begin + count;
+            progress.total = total;
+            progress.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            progress.items_per_second = progress.elapsed_seconds > 0 ? progress.completed / progress.elapsed_seconds : 0.0;
+            options.progress(progress);
+        }
+    }
+}
+
+// ========== Bootstrapping key ==========
+
+static BootstrappingKey bootstrapping_key_shape(
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    const KeygenOptions& options
+) {
+    std::size_t k = glwe_sk.s.size();
+    if (k == 0 || glwe_sk.s[0].size() != params.n || l < 0 || beta < 2) {
+        throw std::runtime_error("Invalid bootstrapping key parameters");
+    }
+
+    // The external product accumulates (k + 1) * (l + 1) digit products per component
+    if (options.transform && !polynomial::ntt_supported(params.n, params.q, (k + 1) * (l + 1))) {
+        throw std::runtime_error("Parameters not supported by the NTT bootstrapping key layout");
+    }
+
+    BootstrappingKey shape;
+    shape.n_lwe = lwe_sk.s.size();
+    shape.k = k;
+    shape.n = params.n;
+    shape.l = l;
+    shape.beta = beta;
+    shape.transformed = options.transform;
+    return shape;
+}
+
+// Writes GGSW(bit) into its slot of the contiguous layout. A coefficient key
+// has the GGSW view layout and is encrypted in place; a transformed key is
+// encrypted into a scratch GGSW and each polynomial transformed into dst.
+static void generate_bootstrapping_ggsw(
+    uint64* dst,
+    int64 bit,
+    const BootstrappingKey& shape,
+    const schemes::PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    uint64 seed,
+    uint64 noise_seed
+) {
+    Polynomial message(params.n, 0);
+    message[0] = bit;
+
+    if (!shape.transformed) {
+        schemes::GGSWCiphertextView out(reinterpret_cast<int64*>(dst), shape.k, shape.n, shape.l, params.q);
+        schemes::encrypt_ggsw_seeded(polynomial::view(message, params.q), sk, params, shape.beta, seed, noise_seed, out);
+        return;
+    }
+
+    std::size_t polys = (shape.k + 1) * (shape.l + 1) * (shape.k + 1);
+    Polynomial coeffs(polys * shape.n);
+    schemes::GGSWCiphertextView out(coeffs.data(), shape.k, shape.n, shape.l, params.q);
+    schemes::encrypt_ggsw_seeded(polynomial::view(message, params.q), sk, params, shape.beta, seed, noise_seed, out);
+
+    std::size_t poly_words = shape.poly_words();
+    for (std::size_t p = 0; p < polys; ++p) {
+        polynomial::NTTPolynomial ntt = polynomial::to_ntt(
+            polynomial::ConstPolynomialView(coeffs.data() + p * shape.n, shape.n, params.q));
+        for (std::size_t r = 0; r < polynomial::EXACT_PRIME_COUNT; ++r) {
+            std::copy(ntt.residues[r].begin(), ntt.residues[r].end(), dst + p * poly_words + r * shape.n);
+        }
+    }
+}
+
+template <typename Target, typename Sink>
+static void generate_bootstrapping_key_into(
+    const BootstrappingKey& shape,
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const Parameters& params,
+    const KeygenOptions& options,
+    Target target,
+    Sink sink
+) {
+    schemes::PreparedGLWESecretKey sk = schemes::prepare_glwe_secret_key(glwe_sk, params);
+    uint64 seed = options.seed == 0 ? fresh_seed() : options.seed;
+    uint64 noise_seed = fresh_seed();
+
+    generate_chunked<uint64>(shape.n_lwe, shape.ggsw_words(), options, target,
+        [&](std::size_t i, uint64* dst) {
+            generate_bootstrapping_ggsw(dst, lwe_sk.s[i], shape, sk, params,
+                core::derive_seed(seed, i), core::derive_seed(noise_seed, i));
+        }, sink);
+}
+
+BootstrappingKey generate_bootstrapping_key(
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    const KeygenOptions& options
+) {
+    BootstrappingKey shape = bootstrapping_key_shape(lwe_sk, glwe_sk, params, l, beta, options);
+    BootstrappingKey bsk(shape.n_lwe, shape.k, shape.n, shape.l, shape.beta, shape.transformed);
+
+    generate_bootstrapping_key_into(shape, lwe_sk, glwe_sk, params, options,
+        [&](std::size_t begin) { return bsk.ggsw(begin); },
+        [](const uint64*, std::size_t) {});
+
+    return bsk;
+}
+
+void write_bootstrapping_key(
+    std::ostream& out,
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    const KeygenOptions& options
+) {
+    BootstrappingKey shape = bootstrapping_key_shape(lwe_sk, glwe_sk, params, l, beta, options);
+
+    io::Writer writer(out, io::ObjectType::BootstrappingKey, params);
+    io::write_bootstrapping_key_shape(writer, shape);
+
+    // The file always holds coefficients; a transformed key is transformed on load
+    BootstrappingKey coefficient_shape = shape;
+    coefficient_shape.transformed = false;
+    std::vector<uint64> buffer(std::min(chunk_items(options), shape.n_lwe) * coefficient_shape.ggsw_words());
+
+    generate_bootstrapping_key_into(coefficient_shape, lwe_sk, glwe_sk, params, options,
+        [&](std::size_t) { return buffer.data(); },
+        [&](const uint64* data, std::size_t words) { writer.write_packed(data, words); });
+    writer.finish();
+}
+
+
+// ========== LWE key switching key ==========
+
+static LWEKeySwitchKey key_switch_key_shape(
+    const LWESecretKey& from_sk,
+    const LWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta
+) {
+    if (from_sk.s.empty() || to_sk.s.empty() || beta < 2) {
+        throw std::runtime_error("Invalid key switching key parameters");
+    }
+
+    LWEKeySwitchKey shape;
+    shape.n_in = from_sk.s.size();
+    shape.n_out = to_sk.s.size();
+    shape.beta = beta;
+    shape.levels = core::gadget_levels(params.q, beta);
+    return shape;
+}
+
+// Writes the `levels` entries encrypting beta^j * s'_i, each with its own mask
+// and noise drawn from generators seeded for row i
+static void generate_key_switch_row(
+    int64* dst,
+    int64 from_bit,
+    const LWEKeySwitchKey& shape,
+    const LWESecretKey& to_sk,
+    const Parameters& params,
+    uint64 seed,
+    uint64 noise_seed
+) {
+    uint64 q = static_cast<uint64>(params.q);
+    uint64 bits = 1;
+    while (bits < q - 1) bits = (bits << 1) | 1;
+
+    std::mt19937_64 mask_rng(seed);
+    std::mt19937_64 noise_rng(noise_seed);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+
+    int64 gadget = 1;
+    for (int j = 0; j < shape.levels; ++j) {
+        int64* entry = dst + j * shape.entry_words();
+        int128 dot = 0;
+        for (std::size_t o = 0; o < shape.n_out; ++o) {
+            uint64 v;
+            do {
+                v = mask_rng() & bits;
+            } while (v >= q);
+            entry[o] = static_cast<int64>(v);
+            dot += static_cast<int128>(v) * to_sk.s[o];
+        }
+
+        // body = <mask, s> + e + beta^j * s'_i
+        dot += static_cast<int128>(gadget) * from_bit + noise_dist(noise_rng);
+        entry[shape.n_out] = core::modq(static_cast<int64>(dot % params.q), params.q);
+
+        gadget = static_cast<int64>((static_cast<int128>(gadget) * shape.beta) % params.q);
+    }
+}
+
+template <typename Target, typename Sink>
+static void generate_key_switch_key_into(
+    const LWEKeySwitchKey& shape,
+    const LWESecretKey& from_sk,
+    const LWESecretKey& to_sk,
+    const Parameters& params,
+    const KeygenOptions& options,
+    Target target,
+    Sink sink
+) {
+    uint64 seed = options.seed == 0 ? fresh_seed() : options.seed;
+    uint64 noise_seed = fresh_seed();
+
+    generate_chunked<int64>(shape.n_in, shape.levels * shape.entry_words(), options, target,
+        [&](std::size_t i, int64* dst) {
+            generate_key_switch_row(dst, from_sk.s[i], shape, to_sk, params,
+                core::derive_seed(seed, i), core::derive_seed(noise_seed, i));
+        }, sink);
+}
+
+LWEKeySwitchKey generate_lwe_key_switch_key(
+    const LWESecretKey& from_sk,
+    const LWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta,
+    const KeygenOptions& options
+) {
+    LWEKeySwitchKey shape = key_switch_key_shape(from_sk, to_sk, params, beta);
+    LWEKeySwitchKey ksk(shape.n_in, shape.n_out, shape.beta, shape.levels);
+
+    generate_key_switch_key_into(shape, from_sk, to_sk, params, options,
+        [&](std::size_t begin) { return ksk.entry(begin, 0); },
+        [](const int64*, std::size_t) {});
+
+    return ksk;
+}
+
+void write_lwe_key_switch_key(
+    std::ostream& out,
+    const LWESecretKey& from_sk,
+    const LWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta,
+    const KeygenOptions& options
+) {
+    LWEKeySwitchKey shape = key_switch_key_shape(from_sk, to_sk, params, beta);
+
+    io::Writer writer(out, io::ObjectType::LWEKeySwitchKey, params);
+    writer.write_u64(shape.n_in);
+    writer.write_u64(shape.n_out);
+    writer.write_u64(static_cast<uint64>(shape.beta));
+    writer.write_u64(static_cast<uint64>(shape.levels));
+
+    std::vector<int64> buffer(std::min(chunk_items(options), shape.n_in) * shape.levels * shape.entry_words());
+
+    generate_key_switch_key_into(shape, from_sk, to_sk, params, options,
+        [&](std::size_t) { return buffer.data(); },
+        [&](const int64* data, std::size_t words) { writer.write_coefficients(data, words); });
+    writer.finish();
+}
+
+// ========== Gate bootstrapping key ==========
+
+GateBootstrappingKey generate_gate_bootstrapping_key(
+    const LWESecretKey& lwe_sk,
+    const GLWESecretKey& glwe_sk,
+    const GateBootstrappingParameters& params,
+    const KeygenOptions& options
+) {
+    if (params.k == 0 || lwe_sk.s.size() != params.lwe_dimension || glwe_sk.s.size() != params.k ||
+        glwe_sk.s[0].size() != params.n) {
+        throw std::runtime_error("Secret keys do not match the gate parameters");
+    }
+
+    // The two keys draw their masks from distinct seeds
+    KeygenOptions bsk_options = options;
+    KeygenOptions ksk_options = options;
+    if (options.seed != 0) {
+        bsk_options.seed = core::derive_seed(options.seed, 0);
+        ksk_options.seed = core::derive_seed(options.seed, 1);
+    }
+
+    GateBootstrappingKey key;
+    key.params = params;
+    key.bsk = generate_bootstrapping_key(lwe_sk, glwe_sk, params.glwe_parameters(),
+                                         params.bsk_l, params.bsk_beta, bsk_options);
+    key.ksk = generate_lwe_key_switch_key(extract_lwe_secret_key(glwe_sk), lwe_sk,
+                                          params.lwe_parameters(), params.ksk_beta, ksk_options);
+    return key;
+}
+
+}
+}
@@ -3,11 +3,16 @@
 #include "turinged/core/math_utils.hpp"
 #include <random>
 #include <chrono>
+#include <stdexcept>
+#include <thread>
 
 namespace turinged {
 namespace keys {
 
-static std::mt19937_64 rng(static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
 
 LWESecretKey generate_lwe_secret_key(std::size_t k) {
     LWESecretKey sk(k);
@@ -80,5 +85,302 @@ GLWEPublicKey generate_glwe_public_key(const GLWESecretKey& sk, const Parameters
     return pk;
 }
 
+LWEPublicKey generate_lwe_public_key(const LWESecretKey& sk, const Parameters& params, std::size_t samples) {
+    std::size_t k = sk.s.size();
+    if (samples == 0) {
+        throw std::runtime_error("LWE public key needs at least one sample");
+    }
+
+    LWEPublicKey pk(k, samples);
+
+    std::uniform_int_distribution<int64> uniform_dist(0, params.q - 1);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+
+    // Each row is an LWE encryption of zero
+    for (std::size_t i = 0; i < samples; ++i) {
+        int64* row = pk.a.data() + i * k;
+        int128 inner = 0;
+        for (std::size_t j = 0; j < k; ++j) {
+            row[j] = uniform_dist(rng);
+            inner += static_cast<int128>(row[j]) * sk.s[j];
+        }
+        pk.b[i] = core::modq(static_cast<int64>((inner + noise_dist(rng)) % params.q), params.q);
+    }
+
+    return pk;
+}
+
+RLWEPublicKey generate_rlwe_public_key(const RLWESecretKey& sk, const Parameters& params) {
+    std::size_t n = params.n;
+    int64 q = params.q;
+
+    RLWEPublicKey pk(n);
+
+    std::uniform_int_distribution<int64> uniform_dist(0, q - 1);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+
+    Polynomial e(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        pk.a[i] = uniform_dist(rng);
+        e[i] = core::modq(noise_dist(rng), q);
+    }
+
+    // b = a*s + e
+    pk.b = polynomial::add(polynomial::negacyclic_multiply(pk.a, sk.s, q), e, q);
+
+    return pk;
+}
+
+LWESecretKey extract_lwe_secret_key(const RLWESecretKey& sk) {
+    LWESecretKey lwe_sk;
+    lwe_sk.s.assign(sk.s.begin(), sk.s.end());
+    return lwe_sk;
+}
+
+LWESecretKey extract_lwe_secret_key(const GLWESecretKey& sk) {
+    LWESecretKey lwe_sk;
+    for (const Polynomial& s_i : sk.s) {
+        lwe_sk.s.insert(lwe_sk.s.end(), s_i.begin(), s_i.end());
+    }
+    return lwe_sk;
+}
+
+RLWEKeySwitchKey generate_rlwe_key_switch_key(
+    const Polynomial& from_s,
+    const RLWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta
+) {
+    std::size_t n = params.n;
+    int64 q = params.q;
+
+    if (from_s.size() != n || to_sk.s.size() != n) {
+        throw std::runtime_error("Key size mismatch in key switching key generation");
+    }
+
+    RLWEKeySwitchKey ksk;
+    ksk.beta = beta;
+    ksk.levels = core::gadget_levels(q, beta);
+
+    // Key switching accumulates `levels` products of beta-bounded digits with key polynomials
+    if (!polynomial::ntt_supported(n, q, static_cast<std::size_t>(ksk.levels))) {
+        throw std::runtime_error("Parameters not supported by the NTT key switching path");
+    }
+
+    std::uniform_int_distribution<int64> uniform_dist(0, q - 1);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+
+    int64 gadget = 1;
+    for (int j = 0; j < ksk.levels; ++j) {
+        Polynomial a(n), e(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = uniform_dist(rng);
+            e[i] = core::modq(noise_dist(rng), q);
+        }
+
+        // b_j = a_j * s + e_j + beta^j * s'
+        Polynomial as = polynomial::negacyclic_multiply(a, to_sk.s, q);
+        Polynomial scaled_s = polynomial::scalar_multiply(from_s, gadget, q);
+        Polynomial b = polynomial::add(polynomial::add(as, e, q), scaled_s, q);
+
+        ksk.a.push_back(polynomial::to_ntt(a, q));
+        ksk.b.push_back(polynomial::to_ntt(b, q));
+
+        gadget = static_cast<int64>((static_cast<int128>(gadget) * beta) % q);
+    }
+
+    return ksk;
+}
+
+RLWERelinKey generate_rlwe_relin_key(
+    const RLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta
+) {
+    Polynomial s_squared = polynomial::negacyclic_multiply(sk.s, sk.s, params.q);
+    return generate_rlwe_key_switch_key(s_squared, sk, params, beta);
+}
+
+GLWEKeySwitchKey generate_glwe_key_switch_key(
+    const std::vector<Polynomial>& from_s,
+    const GLWESecretKey& to_sk,
+    const Parameters& params,
+    int64 beta
+) {
+    std::size_t n = params.n;
+    std::size_t k = to_sk.s.size();
+    int64 q = params.q;
+
+    GLWEKeySwitchKey ksk;
+    ksk.beta = beta;
+    ksk.levels = core::gadget_levels(q, beta);
+
+    // A switch accumulates levels * k' digit products into every output component
+    std::size_t terms = static_cast<std::size_t>(ksk.levels) * from_s.size();
+    if (!polynomial::ntt_supported(n, q, terms)) {
+        throw std::runtime_error("Parameters not supported by the NTT key switching path");
+    }
+
+    std::uniform_int_distribution<int64> uniform_dist(0, q - 1);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+
+    for (const Polynomial& source : from_s) {
+        if (source.size() != n) {
+            throw std::runtime_error("Key size mismatch in key switching key generation");
+        }
+
+        int64 gadget = 1;
+        for (int j = 0; j < ksk.levels; ++j) {
+            // body = sum_o mask_o * s_o + e + beta^j * s'_i
+            Polynomial body(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                body[i] = core::modq(noise_dist(rng), q);
+            }
+            body = polynomial::add(body, polynomial::scalar_multiply(source, gadget, q), q);
+
+            std::vector<polynomial::NTTPolynomial> mask;
+            for (std::size_t o = 0; o < k; ++o) {
+                Polynomial a(n);
+                for (std::size_t i = 0; i < n; ++i) {
+                    a[i] = uniform_dist(rng);
+                }
+                body = polynomial::add(body, polynomial::negacyclic_multiply(a, to_sk.s[o], q), q);
+                mask.push_back(polynomial::to_ntt(a, q));
+            }
+
+            ksk.mask.push_back(mask);
+            ksk.body.push_back(polynomial::to_ntt(body, q));
+
+            gadget = static_cast<int64>((static_cast<int128>(gadget) * beta) % q);
+        }
+    }
+
+    return ksk;
+}
+
+RLWEGaloisKeys generate_rlwe_galois_keys(
+    const RLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    const std::vector<uint64>& galois_elts
+) {
+    RLWEGaloisKeys gk;
+    for (uint64 g : galois_elts) {
+        Polynomial rotated_s = polynomial::automorphism(sk.s, g, params.q);
+        gk.keys[g] = generate_rlwe_key_switch_key(rotated_s, sk, params, beta);
+    }
+    return gk;
+}
+
+GLWEGaloisKeys generate_glwe_galois_keys(
+    const GLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    const std::vector<uint64>& galois_elts
+) {
+    GLWEGaloisKeys gk;
+    for (uint64 g : galois_elts) {
+        std::vector<Polynomial> rotated_s;
+        for (const Polynomial& s_i : sk.s) {
+            rotated_s.push_back(polynomial::automorphism(s_i, g, params.q));
+        }
+        gk.keys[g] = generate_glwe_key_switch_key(rotated_s, sk, params, beta);
+    }
+    return gk;
+}
+
+RNSKeySwitchKey generate_rns_key_switch_key(
+    const rns::RNSPolynomial& from_s,
+    const GLWESecretKey& to_sk,
+    const rns::RNSParameters& params
+) {
+    const rns::RNSBase& base = params.q_base(params.top_level());
+    std::size_t n = params.n;
+    std::size_t k = to_sk.s.size();
+
+    if (from_s.prime_count() != base.size() || from_s.degree() != n || from_s.ntt_form) {
+        throw std::runtime_error("Source key must be a coefficient-form polynomial over the top-level modulus");
+    }
+
+    std::vector<rns::RNSPolynomial> s_ntt;
+    for (const Polynomial& s_o : to_sk.s) {
+        rns::RNSPolynomial s_rns = rns::to_rns(s_o, base);
+        rns::to_ntt_inplace(s_rns, base);
+        s_ntt.push_back(s_rns);
+    }
+
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+
+    RNSKeySwitchKey ksk;
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        // body = sum_o mask_o * s_o + e + e_i * s'
+        Polynomial e(n);
+        for (std::size_t c = 0; c < n; ++c) {
+            e[c] = noise_dist(rng);
+        }
+        rns::RNSPolynomial body = rns::to_rns(e, base);
+        for (std::size_t c = 0; c < n; ++c) {
+            uint64 p = base.primes[i];
+            uint64 sum = body.residues[i][c] + from_s.residues[i][c];
+            body.residues[i][c] = sum >= p ? sum - p : sum;
+        }
+        rns::to_ntt_inplace(body, base);
+
+        std::vector<rns::RNSPolynomial> mask;
+        for (std::size_t o = 0; o < k; ++o) {
+            rns::RNSPolynomial a(base.size(), n);
+            for (std::size_t j = 0; j < base.size(); ++j) {
+                std::uniform_int_distribution<uint64> uniform_dist(0, base.primes[j] - 1);
+                for (std::size_t c = 0; c < n; ++c) {
+                    a.residues[j][c] = uniform_dist(rng);
+                }
+            }
+            a.ntt_form = true;
+            rns::multiply_accumulate_ntt(body, a, s_ntt[o], base);
+            mask.push_back(a);
+        }
+
+        ksk.mask.push_back(mask);
+        ksk.body.push_back(body);
+    }
+
+    return ksk;
+}
+
+RNSRelinKey generate_rns_relin_key(
+    const GLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    if (params.top_level() < 1) {
+        throw std::runtime_error("RNS relinearisation needs at least two primes");
+    }
+
+    const rns::RNSBase& base = params.q_base(params.top_level());
+    RNSRelinKey rlk;
+    std::size_t k = sk.s.size();
+    for (std::size_t i = 0; i < k; ++i) {
+        for (std::size_t j = i; j < k; ++j) {
+            // s_i * s_j has coefficients in [-n, n], exact in every residue
+            rns::RNSPolynomial product = rns::multiply(
+                rns::to_rns(sk.s[i], base),
+                rns::to_rns(sk.s[j], base),
+                base
+            );
+            rlk.keys.push_back(generate_rns_key_switch_key(product, sk, params));
+        }
+    }
+
+    return rlk;
+}
+
+RNSRelinKey generate_rns_relin_key(
+    const RLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    GLWESecretKey glwe_sk;
+    glwe_sk.s.push_back(sk.s);
+    return generate_rns_relin_key(glwe_sk, params);
+}
+
 }
 }
\ No newline at end of file
@@ -0,0 +1,319 @@
+#include "turinged/noise/noise.hpp"
+#include "turinged/polynomial/polynomial.hpp"
+#include "turinged/core/math_utils.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace noise {
+
+// Error of one phase coefficient (mod q): against Delta * expected if given,
+// otherwise against the nearest multiple of Delta
+static int64 coefficient_error(int64 phase, const int64* expected, const Parameters& params) {
+    int64 delta = params.q / params.t;
+    if (expected) {
+        int64 scaled = static_cast<int64>((static_cast<int128>(delta) * core::modq(*expected, params.t)) % params.q);
+        return core::center_rep(core::modq(phase - scaled, params.q), params.q);
+    }
+
+    int64 centered = core::center_rep(phase, params.q);
+    int64 rounded = (centered >= 0) ? (centered + delta / 2) / delta : (centered - delta / 2) / delta;
+    return centered - rounded * delta;
+}
+
+static NoiseMeasurement measure_phase(
+    const int64* phase,
+    std::size_t count,
+    const int64* expected,
+    const Parameters& params
+) {
+    NoiseMeasurement result{0, 0.0, 0.0};
+    double sum_squares = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        int64 e = coefficient_error(phase[i], expected ? expected + i : nullptr, params);
+        int64 magnitude = e < 0 ? -e : e;
+        if (magnitude > result.max_abs) result.max_abs = magnitude;
+        sum_squares += static_cast<double>(e) * static_cast<double>(e);
+    }
+
+    result.variance = count > 0 ? sum_squares / static_cast<double>(count) : 0.0;
+    double half_delta = static_cast<double>(params.q / params.t) / 2.0;
+    result.budget_bits = std::log2(half_delta / static_cast<double>(result.max_abs));
+    return result;
+}
+
+static int64 lwe_phase(const schemes::LWECiphertext& ct, const keys::LWESecretKey& sk, const Parameters& params) {
+    if (!ct.is_trivial() && ct.a.size() != sk.s.size()) {
+        throw std::runtime_error("Ciphertext size mismatch with secret key");
+    }
+    int64 inner = ct.is_trivial() ? 0 : core::dot_product_modq(ct.a.data(), sk.s.data(), sk.s.size(), params.q);
+    return core::modq(ct.b - inner, params.q);
+}
+
+static Polynomial rlwe_phase(const schemes::RLWECiphertext& ct, const keys::RLWESecretKey& sk, const Parameters& params) {
+    if ((!ct.is_trivial() && ct.a.size() != params.n) || ct.b.size() != params.n || sk.s.size() != params.n) {
+        throw std::runtime_error("Ciphertext size mismatch with key");
+    }
+    if (ct.is_trivial()) return ct.b;
+    return polynomial::subtract(ct.b, polynomial::negacyclic_multiply(ct.a, sk.s, params.q), params.q);
+}
+
+static Polynomial glwe_phase(const schemes::GLWECiphertext& ct, const keys::GLWESecretKey& sk, const Parameters& params) {
+    if ((!ct.is_trivial() && ct.d_tilde.size() != sk.s.size()) || ct.b.size() != params.n) {
+        throw std::runtime_error("Ciphertext size mismatch with key");
+    }
+    Polynomial phase = ct.b;
+    for (std::size_t j = 0; j < ct.d_tilde.size(); ++j) {
+        phase = polynomial::subtract(phase, polynomial::negacyclic_multiply(ct.d_tilde[j], sk.s[j], params.q), params.q);
+    }
+    return phase;
+}
+
+static void check_message(const Polynomial& message, const Parameters& params) {
+    if (message.size() != params.n) {
+        throw std::runtime_error("Message size mismatch");
+    }
+}
+
+NoiseMeasurement measure_noise_lwe(
+    const schemes::LWECiphertext& ct,
+    const keys::LWESecretKey& sk,
+    const Parameters& params
+) {
+    int64 phase = lwe_phase(ct, sk, params);
+    return measure_phase(&phase, 1, nullptr, params);
+}
+
+NoiseMeasurement measure_noise_lwe(
+    const schemes::LWECiphertext& ct,
+    int64 message,
+    const keys::LWESecretKey& sk,
+    const Parameters& params
+) {
+    int64 phase = lwe_phase(ct, sk, params);
+    return measure_phase(&phase, 1, &message, params);
+}
+
+NoiseMeasurement measure_noise_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params
+) {
+    Polynomial phase = rlwe_phase(ct, sk, params);
+    return measure_phase(phase.data(), phase.size(), nullptr, params);
+}
+
+NoiseMeasurement measure_noise_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& message,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params
+) {
+    check_message(message, params);
+    Polynomial phase = rlwe_phase(ct, sk, params);
+    return measure_phase(phase.data(), phase.size(), message.data(), params);
+}
+
+NoiseMeasurement measure_noise_glwe(
+    const schemes::GLWECiphertext& ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params
+) {
+    Polynomial phase = glwe_phase(ct, sk, params);
+    return measure_phase(phase.data(), phase.size(), nullptr, params);
+}
+
+NoiseMeasurement measure_noise_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params
+) {
+    check_message(message, params);
+    Polynomial phase = glwe_phase(ct, sk, params);
+    return measure_phase(phase.data(), phase.size(), message.data(), params);
+}
+
+// ========== Variance model ==========
+
+double fresh_variance(const Parameters& params) {
+    double b = static_cast<double>(params.noise_bound);
+    return b * (b + 1.0) / 3.0;
+}
+
+double lwe_public_key_variance(const Parameters& params, std::size_t samples) {
+    return static_cast<double>(samples) / 2.0 * fresh_variance(params);
+}
+
+double glwe_public_key_variance(const Parameters& params, std::size_t k) {
+    // Binary u and s have E[x^2] = 1/2
+    double n = static_cast<double>(params.n);
+    return fresh_variance(params) * (1.0 + n * static_cast<double>(k + 1) / 2.0);
+}
+
+double lwe_public_key_coherent_variance(const Parameters& params, std::size_t samples) {
+    // Two encryptions share a quarter of the rows
+    return static_cast<double>(samples) / 4.0 * fresh_variance(params);
+}
+
+double glwe_public_key_coherent_variance(const Parameters& params, std::size_t k) {
+    // Binary u and s have mean 1/2: half of e*u and of e2*s is (1/2) * ones * e
+    double n = static_cast<double>(params.n);
+    return fresh_variance(params) * n * static_cast<double>(k + 1) / 4.0;
+}
+
+// Sums over the levels of E[d^2] and E[d]^2 for the unsigned digits of a
+// uniform value mod q: every level spans [0, beta) except the top one, which
+// only reaches q / beta^(levels - 1)
+static void digit_moments(int64 q, int64 beta, int levels, double& second_moment, double& mean_squared) {
+    second_moment = 0.0;
+    mean_squared = 0.0;
+    long double below = 1.0L;
+    for (int j = 0; j < levels; ++j) {
+        long double range = std::ceil(static_cast<long double>(q) / below);
+        if (range > static_cast<long double>(beta)) range = static_cast<long double>(beta);
+        double r = static_cast<double>(range);
+        second_moment += (r - 1.0) * (2.0 * r - 1.0) / 6.0;
+        mean_squared += (r - 1.0) * (r - 1.0) / 4.0;
+        below *= static_cast<long double>(beta);
+    }
+}
+
+double key_switch_variance(const Parameters& params, int64 beta, int levels, std::size_t terms) {
+    double second_moment, mean_squared;
+    digit_moments(params.q, beta, levels, second_moment, mean_squared);
+    return static_cast<double>(terms) * second_moment * fresh_variance(params);
+}
+
+double key_switch_coherent_variance(const Parameters& params, int64 beta, int levels, std::size_t terms) {
+    double second_moment, mean_squared;
+    digit_moments(params.q, beta, levels, second_moment, mean_squared);
+    return static_cast<double>(terms) * mean_squared * fresh_variance(params);
+}
+
+double modulus_switch_variance(double variance, int64 q, int64 q_new, std::size_t key_terms) {
+    double ratio = static_cast<double>(q_new) / static_cast<double>(q);
+    return variance * ratio * ratio + (1.0 + static_cast<double>(key_terms) / 2.0) / 12.0;
+}
+
+double modulus_switch_coherent_variance(double coherent, int64 q, int64 q_new, std::size_t key_terms) {
+    // The mask rounding meets the mean of the binary secret
+    double ratio = static_cast<double>(q_new) / static_cast<double>(q);
+    return coherent * ratio * ratio + static_cast<double>(key_terms) / 4.0 / 12.0;
+}
+
+double blind_rotation_variance(const Parameters& params, std::size_t k, std::size_t n_lwe, int l, int64 beta) {
+    // Each external product adds the key noise weighted by (k + 1) * (l + 1) * n
+    // digits of variance beta^2 / 12, and the rounding of the input to the
+    // gadget precision q / beta^(l + 1) multiplied by the secret (1 + k * n / 2)
+    double n = static_cast<double>(params.n);
+    double b = static_cast<double>(beta);
+    double digits = static_cast<double>((k + 1) * static_cast<std::size_t>(l + 1)) * n * b * b / 12.0;
+    double precision = static_cast<double>(params.q) / std::pow(b, l + 1);
+    double rounding = (1.0 + static_cast<double>(k) * n / 2.0) * precision * precision / 12.0;
+    return static_cast<double>(n_lwe) * (digits * fresh_variance(params) + rounding);
+}
+
+double sum_variance(double variance1, double coherent1, double variance2, double coherent2) {
+    return variance1 + variance2 + 2.0 * std::sqrt(coherent1 * coherent2);
+}
+
+double sum_coherent_variance(double coherent1, double coherent2) {
+    double deviation = std::sqrt(coherent1) + std::sqrt(coherent2);
+    return deviation * deviation;
+}
+
+// With r = q mod t, Delta * t = q - r, so the carry K of the integer product
+// m * p leaves -r * K; K ~ m * p / t for uniform messages m on [0, t), whose
+// mean (t - 1) / 2 makes it slowly varying
+static double plain_encoding_variance(double norm_squared, double ramp_norm_squared, const Parameters& params) {
+    double r = static_cast<double>(params.q % params.t);
+    return r * r * (norm_squared / 12.0 + ramp_norm_squared / 4.0);
+}
+
+double plain_product_variance(
+    double variance,
+    double coherent,
+    double norm_squared,
+    double ramp_norm_squared,
+    const Parameters& params
+) {
+    return (variance - coherent) * norm_squared + coherent * ramp_norm_squared +
+           plain_encoding_variance(norm_squared, ramp_norm_squared, params);
+}
+
+double plain_product_coherent_variance(
+    double variance,
+    double coherent,
+    double mean_norm_squared,
+    double ramp_norm_squared,
+    const Parameters& params
+) {
+    double r = static_cast<double>(params.q % params.t);
+    return (variance - coherent) * mean_norm_squared + coherent * ramp_norm_squared +
+           r * r * ramp_norm_squared / 4.0;
+}
+
+// Pieces of the tensor noise. Phase over the integers is Delta*m + e + q*k, and
+// after scaling by t/q each error e_i is multiplied by the other input's lifted
+// phase L = (t/q) * (b - a*s), which has E[L^2] = t^2 (1 + n/2) / 12. The binary
+// secret's mean turns a*s into (1/2) * ones * a plus an incoherent rest, so L
+// has a slowly varying part of variance t^2 n / 48, and ones * L has mean
+// square t^2 n^3 / 144 on top of the n times its incoherent part.
+struct TensorTerms {
+    double total;
+    double coherent;
+};
+
+static TensorTerms tensor_terms(double variance1, double coherent1, double variance2, double coherent2, const Parameters& params) {
+    double n = static_cast<double>(params.n);
+    double t = static_cast<double>(params.t);
+
+    double lift_moment = t * t * (1.0 + n / 2.0) / 12.0;
+    double lift_slow = t * t * n / 48.0;
+    double lift_ramp_norm = t * t * n * n * n / 144.0 + n * (lift_moment - lift_slow);
+
+    double incoherent = (variance1 - coherent1) + (variance2 - coherent2);
+    double coherent = coherent1 + coherent2;
+
+    // The rounding r0 + r1*s + r2*s^2 of the three components; s^2 carries
+    // (1/4) * ones * ones, a ramp of mean square n^2 / 48
+    double rounding = (1.0 + n / 2.0 + n * (n / 4.0 + n * n / 48.0)) / 12.0;
+    double rounding_slow = (n / 4.0 + n * n * n / 48.0) / 12.0;
+
+    // With r = q mod t, Delta * t = q - r leaves r * (m1*k2 + m2*k1). The
+    // uncentered messages pick up the slowly varying part of k, so this grows
+    // as n^3 (fitted; it dominates everything else unless r is tiny).
+    double r = static_cast<double>(params.q % params.t);
+    double encoding = r * r * t * t * n * n * (1.0 + n / 256.0);
+
+    TensorTerms terms;
+    terms.total = n * incoherent * lift_moment + coherent * lift_ramp_norm + rounding + encoding;
+    terms.coherent = n * incoherent * lift_slow + coherent * lift_ramp_norm + rounding_slow + encoding;
+    return terms;
+}
+
+double tensor_variance(double variance1, double coherent1, double variance2, double coherent2, const Parameters& params) {
+    return tensor_terms(variance1, coherent1, variance2, coherent2, params).total;
+}
+
+double tensor_coherent_variance(double variance1, double coherent1, double variance2, double coherent2, const Parameters& params) {
+    return tensor_terms(variance1, coherent1, variance2, coherent2, params).coherent;
+}
+
+double noise_budget_bits(double variance, const Parameters& params, double sigmas) {
+    double half_delta = static_cast<double>(params.q / params.t) / 2.0;
+    return std::log2(half_delta / (sigmas * std::sqrt(variance)));
+}
+
+double failure_probability(double variance, const Parameters& params, std::size_t coefficients) {
+    if (std::isnan(variance)) return variance;
+    if (variance <= 0.0) return 0.0;
+
+    double half_delta = static_cast<double>(params.q / params.t) / 2.0;
+    double single = std::erfc(half_delta / std::sqrt(2.0 * variance));
+    return -std::expm1(static_cast<double>(coefficients) * std::log1p(-single));
+}
+
+}
+}
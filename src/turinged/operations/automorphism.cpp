@@ -0,0 +1,233 @@
+#include "turinged/operations/automorphism.hpp"
+#include "turinged/operations/key_switching.hpp"
+#include "turinged/operations/homomorphic.hpp"
+#include "turinged/polynomial/polynomial.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+uint64 galois_element_for_rotation(int steps, std::size_t n) {
+    // 3 has order n/2 modulo 2n
+    int64 order = static_cast<int64>(n / 2);
+    int64 s = core::modq(steps, order);
+    return core::pow_mod(3, static_cast<uint64>(s), 2 * static_cast<uint64>(n));
+}
+
+uint64 galois_element_for_row_swap(std::size_t n) {
+    return 2 * static_cast<uint64>(n) - 1;
+}
+
+std::vector<uint64> power_of_two_galois_elements(std::size_t n) {
+    std::vector<uint64> elts;
+    for (std::size_t step = 1; step < n / 2; step <<= 1) {
+        elts.push_back(galois_element_for_rotation(static_cast<int>(step), n));
+    }
+    elts.push_back(galois_element_for_row_swap(n));
+    return elts;
+}
+
+template <typename KeyMap>
+static const typename KeyMap::mapped_type& find_galois_key(const KeyMap& keys, uint64 galois_elt) {
+    auto it = keys.find(galois_elt);
+    if (it == keys.end()) {
+        throw std::runtime_error("Missing Galois key for requested element");
+    }
+    return it->second;
+}
+
+schemes::RLWECiphertext apply_galois_rlwe(
+    const schemes::RLWECiphertext& ct,
+    uint64 galois_elt,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::apply_galois_rlwe");
+    // sigma(ct) decrypts under sigma(s); the Galois key switches it back to s.
+    // A trivial ciphertext decrypts under any key, so sigma(b) is the result.
+    schemes::RLWECiphertext rotated;
+    if (!ct.is_trivial()) rotated.a = polynomial::automorphism(ct.a, galois_elt, params.q);
+    rotated.b = polynomial::automorphism(ct.b, galois_elt, params.q);
+    rotated.noise_variance = ct.noise_variance;
+    rotated.coherent_variance = ct.coherent_variance;
+    if (rotated.is_trivial()) {
+        return rotated;
+    }
+
+    return key_switch_rlwe(rotated, find_galois_key(gk.keys, galois_elt), params);
+}
+
+schemes::GLWECiphertext apply_galois_glwe(
+    const schemes::GLWECiphertext& ct,
+    uint64 galois_elt,
+    const keys::GLWEGaloisKeys& gk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::apply_galois_glwe");
+    std::size_t k = ct.d_tilde.size();
+    schemes::GLWECiphertext rotated(k, params.n);
+    rotated.b = polynomial::automorphism(ct.b, galois_elt, params.q);
+    for (std::size_t i = 0; i < k; ++i) {
+        rotated.d_tilde[i] = polynomial::automorphism(ct.d_tilde[i], galois_elt, params.q);
+    }
+    rotated.noise_variance = ct.noise_variance;
+    rotated.coherent_variance = ct.coherent_variance;
+    if (rotated.is_trivial()) {
+        return rotated;
+    }
+
+    return key_switch_glwe(rotated, find_galois_key(gk.keys, galois_elt), params);
+}
+
+schemes::RLWECiphertext rotate_rows_rlwe(
+    const schemes::RLWECiphertext& ct,
+    int steps,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::rotate_rows_rlwe");
+    uint64 galois_elt = galois_element_for_rotation(steps, params.n);
+    if (gk.keys.count(galois_elt) != 0) {
+        return apply_galois_rlwe(ct, galois_elt, gk, params);
+    }
+
+    // No exact key: compose the power-of-two rotations making up steps mod n/2
+    int64 order = static_cast<int64>(params.n / 2);
+    uint64 remaining = static_cast<uint64>(core::modq(steps, order));
+    schemes::RLWECiphertext result = ct;
+    for (uint64 step = 1; remaining != 0; step <<= 1) {
+        if (remaining & step) {
+            result = apply_galois_rlwe(result, galois_element_for_rotation(static_cast<int>(step), params.n), gk, params);
+            remaining &= ~step;
+        }
+    }
+    return result;
+}
+
+schemes::RLWECiphertext swap_rows_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::swap_rows_rlwe");
+    return apply_galois_rlwe(ct, galois_element_for_row_swap(params.n), gk, params);
+}
+
+HoistedRLWECiphertext hoist_rlwe(
+    const schemes::RLWECiphertext& ct,
+    int64 beta,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::hoist_rlwe");
+    HoistedRLWECiphertext hoisted;
+    hoisted.b = ct.b;
+    hoisted.beta = beta;
+    hoisted.levels = core::gadget_levels(params.q, beta);
+    hoisted.noise_variance = ct.noise_variance;
+    hoisted.coherent_variance = ct.coherent_variance;
+    if (ct.is_trivial()) {
+        return hoisted;
+    }
+
+    std::vector<Polynomial> digits = gadget_decompose(polynomial::negate(ct.a, params.q), beta, hoisted.levels);
+    for (const Polynomial& digit : digits) {
+        hoisted.digits.push_back(polynomial::to_ntt(digit, params.q));
+    }
+
+    return hoisted;
+}
+
+schemes::RLWECiphertext apply_galois_hoisted(
+    const HoistedRLWECiphertext& hoisted,
+    uint64 galois_elt,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::apply_galois_hoisted");
+    if (hoisted.is_trivial()) {
+        schemes::RLWECiphertext result;
+        result.b = polynomial::automorphism(hoisted.b, galois_elt, params.q);
+        result.noise_variance = hoisted.noise_variance;
+        result.coherent_variance = hoisted.coherent_variance;
+        return result;
+    }
+
+    const keys::RLWEKeySwitchKey& ksk = find_galois_key(gk.keys, galois_elt);
+    if (ksk.beta != hoisted.beta || ksk.levels != hoisted.levels) {
+        throw std::runtime_error("Galois key gadget does not match hoisted decomposition");
+    }
+
+    std::size_t n = params.n;
+    polynomial::NTTPolynomial acc_a(n), acc_b(n);
+
+    // sigma(digit_j) are the digits of sigma(-a), permuted in place in the NTT domain
+    for (int j = 0; j < hoisted.levels; ++j) {
+        polynomial::NTTPolynomial digit = polynomial::ntt_automorphism(hoisted.digits[j], galois_elt);
+        polynomial::ntt_multiply_accumulate(acc_a, digit, ksk.a[j]);
+        polynomial::ntt_multiply_accumulate(acc_b, digit, ksk.b[j]);
+    }
+
+    schemes::RLWECiphertext result(n);
+    result.a = polynomial::from_ntt(acc_a, params.q);
+    result.b = polynomial::add(
+        polynomial::automorphism(hoisted.b, galois_elt, params.q),
+        polynomial::from_ntt(acc_b, params.q),
+        params.q
+    );
+    double switch_coherent = noise::key_switch_coherent_variance(params, ksk.beta, ksk.levels, n);
+    result.noise_variance = noise::sum_variance(hoisted.noise_variance, hoisted.coherent_variance,
+                                                noise::key_switch_variance(params, ksk.beta, ksk.levels, n), switch_coherent);
+    result.coherent_variance = noise::sum_coherent_variance(hoisted.coherent_variance, switch_coherent);
+
+    return result;
+}
+
+std::vector<schemes::RLWECiphertext> rotate_rows_hoisted(
+    const schemes::RLWECiphertext& ct,
+    const std::vector<int>& steps,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::rotate_rows_hoisted");
+    if (gk.keys.empty()) {
+        throw std::runtime_error("No Galois keys provided");
+    }
+
+    HoistedRLWECiphertext hoisted = hoist_rlwe(ct, gk.keys.begin()->second.beta, params);
+
+    std::vector<schemes::RLWECiphertext> result;
+    result.reserve(steps.size());
+    for (int step : steps) {
+        uint64 galois_elt = galois_element_for_rotation(step, params.n);
+        if (gk.keys.count(galois_elt) != 0) {
+            result.push_back(apply_galois_hoisted(hoisted, galois_elt, gk, params));
+        } else {
+            result.push_back(rotate_rows_rlwe(ct, step, gk, params));
+        }
+    }
+
+    return result;
+}
+
+schemes::RLWECiphertext sum_slots_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::sum_slots_rlwe");
+    schemes::RLWECiphertext acc = ct;
+
+    // Rotate-and-add within rows, then fold the two rows together
+    for (std::size_t step = 1; step < params.n / 2; step <<= 1) {
+        acc = add_rlwe(acc, rotate_rows_rlwe(acc, static_cast<int>(step), gk, params), params);
+    }
+    acc = add_rlwe(acc, swap_rows_rlwe(acc, gk, params), params);
+
+    return acc;
+}
+
+}
+}
@@ -0,0 +1,487 @@
+#include "turinged/operations/bootstrapping.hpp"
+#include "turinged/operations/key_switching.hpp"
+#include "turinged/operations/modulus_switching.hpp"
+#include "turinged/polynomial/polynomial.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+using polynomial::EXACT_PRIME_COUNT;
+using polynomial::EXACT_PRIMES;
+
+// Buffers reused by every external product of a blind rotation
+struct ExternalProductWorkspace {
+    keys::BootstrappingKeyLayout layout;    // of one GGSW, always in NTT form
+    int64 q;
+    std::array<std::shared_ptr<const polynomial::NTTTables>, EXACT_PRIME_COUNT> tables;
+    std::vector<int64> digits;              // (l + 1) * n signed digits of one polynomial
+    std::vector<uint64> transformed;        // one digit polynomial in NTT form
+    std::vector<uint128> sums;              // (k + 1) * EXACT_PRIME_COUNT * n lazy products
+    std::vector<uint64> ggsw;               // GGSW i transformed, for keys in coefficient form
+    polynomial::NTTPolynomial product;
+    core::PooledVector<Polynomial> rotated; // (X^a - 1) * accumulator
+
+    // Gadget precision beta^(l + 1), q / precision when it divides q, and
+    // their log2 when they are powers of two (0 otherwise)
+    uint64 precision;
+    uint64 unit;
+    int beta_bits;
+    int unit_bits;
+
+    // Residues used: the products of small digits with the centered key stay
+    // within the first prime unless the gadget is very coarse
+    std::size_t primes;
+};
+
+static int power_of_two_bits(uint64 x) {
+    if (x < 2 || (x & (x - 1)) != 0) return 0;
+    int bits = 0;
+    while ((1ULL << bits) != x) ++bits;
+    return bits;
+}
+
+static ExternalProductWorkspace make_workspace(const keys::BootstrappingKeyView& bsk, const Parameters& params) {
+    if (bsk.k == 0 || bsk.n != params.n || bsk.beta < 2 || bsk.l < 0) {
+        throw std::runtime_error("Bootstrapping key does not match the GLWE parameters");
+    }
+
+    ExternalProductWorkspace ws;
+    ws.layout = bsk;
+    ws.layout.n_lwe = 1;
+    ws.layout.transformed = true;
+    ws.q = params.q;
+    for (std::size_t p = 0; p < EXACT_PRIME_COUNT; ++p) {
+        ws.tables[p] = polynomial::get_ntt_tables(params.n, EXACT_PRIMES[p]);
+    }
+    ws.digits.assign((bsk.l + 1) * params.n, 0);
+    ws.transformed.assign(params.n, 0);
+    ws.sums.assign((bsk.k + 1) * EXACT_PRIME_COUNT * params.n, 0);
+    if (!bsk.transformed) ws.ggsw.assign(ws.layout.ggsw_words(), 0);
+    ws.product = polynomial::NTTPolynomial(params.n);
+    ws.rotated.assign(bsk.k + 1, Polynomial(params.n, 0));
+
+    uint128 precision = 1;
+    for (int j = 0; j <= bsk.l; ++j) {
+        precision *= static_cast<uint64>(bsk.beta);
+        if (precision > static_cast<uint128>(params.q)) {
+            throw std::runtime_error("Bootstrapping key gadget exceeds the modulus");
+        }
+    }
+    ws.precision = static_cast<uint64>(precision);
+    ws.unit = static_cast<uint64>(params.q) % ws.precision == 0 ? static_cast<uint64>(params.q) / ws.precision : 0;
+    ws.beta_bits = power_of_two_bits(static_cast<uint64>(bsk.beta));
+    ws.unit_bits = power_of_two_bits(ws.unit);
+
+    // |sum| <= (k + 1) * (l + 1) * n * (beta / 2) * (q / 2) must stay below p / 2
+    long double bound = static_cast<long double>((bsk.k + 1) * static_cast<std::size_t>(bsk.l + 1) * params.n) *
+                        static_cast<long double>(bsk.beta) * static_cast<long double>(params.q) / 4.0L;
+    ws.primes = bound < static_cast<long double>(EXACT_PRIMES[0] / 2) ? 1 : EXACT_PRIME_COUNT;
+    return ws;
+}
+
+// GGSW i in NTT form: the key itself, or a copy transformed into ws.ggsw
+static const uint64* transformed_ggsw(const keys::BootstrappingKeyView& bsk, std::size_t i, ExternalProductWorkspace& ws) {
+    if (bsk.transformed) return bsk.ggsw(i);
+
+    std::size_t n = bsk.n;
+    const uint64* src = bsk.ggsw(i);
+    Polynomial poly(n);
+    for (std::size_t c = 0; c < ws.layout.ggsw_words() / ws.layout.poly_words(); ++c) {
+        for (std::size_t x = 0; x < n; ++x) poly[x] = static_cast<int64>(src[c * n + x]);
+        polynomial::NTTPolynomial ntt = polynomial::to_ntt(poly, ws.q);
+        for (std::size_t p = 0; p < EXACT_PRIME_COUNT; ++p) {
+            std::copy(ntt.residues[p].begin(), ntt.residues[p].end(), ws.ggsw.data() + c * ws.layout.poly_words() + p * n);
+        }
+    }
+    return ws.ggsw.data();
+}
+
+// Balanced base-beta digits of round(x * beta^(l + 1) / q), level 0 most
+// significant, so that x ~ sum_j digit_j * q / beta^(j + 1). The carry out of
+// level 0 is a multiple of q and is dropped.
+static void decompose(const int64* x, ExternalProductWorkspace& ws) {
+    std::size_t n = ws.layout.n;
+    int l = ws.layout.l;
+    uint64 beta = static_cast<uint64>(ws.layout.beta);
+    uint64 q = static_cast<uint64>(ws.q);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        uint64 value = static_cast<uint64>(x[i]);
+        uint64 r;
+        if (ws.unit_bits != 0) {
+            r = (value + ws.unit / 2) >> ws.unit_bits;
+        } else if (ws.unit != 0) {
+            r = (value + ws.unit / 2) / ws.unit;
+        } else {
+            r = static_cast<uint64>((static_cast<uint128>(value) * ws.precision + q / 2) / q);
+        }
+
+        for (int j = l; j >= 0; --j) {
+            int64 digit;
+            if (ws.beta_bits != 0) {
+                digit = static_cast<int64>(r & (beta - 1));
+                r >>= ws.beta_bits;
+            } else {
+                digit = static_cast<int64>(r % beta);
+                r /= beta;
+            }
+            if (digit >= static_cast<int64>(beta / 2)) {
+                digit -= static_cast<int64>(beta);
+                ++r;
+            }
+            ws.digits[j * n + i] = digit;
+        }
+    }
+}
+
+// acc += GGSW(s_i) x (input[0..k-1] masks, input[k] body), all mod q; a null
+// input polynomial is zero
+static void external_product_accumulate(
+    const uint64* ggsw,
+    const Polynomial* const* input,
+    Polynomial* acc,
+    ExternalProductWorkspace& ws
+) {
+    TURINGED_TRACE_SCOPE("ggsw.external_product");
+    const keys::BootstrappingKeyLayout& layout = ws.layout;
+    std::size_t n = layout.n;
+    std::size_t k = layout.k;
+
+    // Products are below 2^124, so sixteen fit in the 128-bit sums
+    constexpr std::size_t flush_every = 16;
+    std::fill(ws.sums.begin(), ws.sums.end(), 0);
+    std::size_t pending = 0;
+
+    for (std::size_t row = 0; row <= k; ++row) {
+        if (!input[row]) continue;
+        decompose(input[row]->data(), ws);
+
+        for (int j = 0; j <= layout.l; ++j) {
+            if (pending == flush_every) {
+                for (std::size_t c = 0; c <= k; ++c) {
+                    for (std::size_t p = 0; p < ws.primes; ++p) {
+                        uint128* sums = ws.sums.data() + (c * EXACT_PRIME_COUNT + p) * n;
+                        for (std::size_t x = 0; x < n; ++x) sums[x] %= EXACT_PRIMES[p];
+                    }
+                }
+                pending = 0;
+            }
+
+            const int64* digits = ws.digits.data() + j * n;
+            const uint64* sample = ggsw + (row * (layout.l + 1) + j) * layout.glwe_words();
+            for (std::size_t p = 0; p < ws.primes; ++p) {
+                uint64 prime = EXACT_PRIMES[p];
+                for (std::size_t x = 0; x < n; ++x) {
+                    ws.transformed[x] = digits[x] < 0 ? prime - static_cast<uint64>(-digits[x]) : static_cast<uint64>(digits[x]);
+                }
+                polynomial::ntt_forward(ws.transformed.data(), *ws.tables[p]);
+
+                for (std::size_t c = 0; c <= k; ++c) {
+                    TURINGED_METRICS_COUNT(poly_multiplies);
+                    const uint64* key = sample + c * layout.poly_words() + p * n;
+                    uint128* sums = ws.sums.data() + (c * EXACT_PRIME_COUNT + p) * n;
+                    for (std::size_t x = 0; x < n; ++x) {
+                        sums[x] += static_cast<uint128>(ws.transformed[x]) * key[x];
+                    }
+                }
+            }
+            ++pending;
+        }
+    }
+
+    for (std::size_t c = 0; c <= k; ++c) {
+        for (std::size_t p = 0; p < ws.primes; ++p) {
+            const uint128* sums = ws.sums.data() + (c * EXACT_PRIME_COUNT + p) * n;
+            uint64* residues = ws.product.residues[p].data();
+            for (std::size_t x = 0; x < n; ++x) residues[x] = static_cast<uint64>(sums[x] % EXACT_PRIMES[p]);
+        }
+
+        if (ws.primes == 1) {
+            uint64 prime = EXACT_PRIMES[0];
+            int64 q_mask = power_of_two_bits(static_cast<uint64>(ws.q)) != 0 ? ws.q - 1 : 0;
+            uint64* residues = ws.product.residues[0].data();
+            polynomial::ntt_inverse(residues, *ws.tables[0]);
+            for (std::size_t x = 0; x < n; ++x) {
+                int64 centered = residues[x] > prime / 2 ? -static_cast<int64>(prime - residues[x]) : static_cast<int64>(residues[x]);
+                int64 reduced = q_mask != 0 ? (centered & q_mask) : core::modq(centered, ws.q);
+                int64 sum = acc[c][x] + reduced;
+                acc[c][x] = sum >= ws.q ? sum - ws.q : sum;
+            }
+        } else {
+            Polynomial product = polynomial::from_ntt(ws.product, ws.q);
+            for (std::size_t x = 0; x < n; ++x) {
+                int64 sum = acc[c][x] + product[x];
+                acc[c][x] = sum >= ws.q ? sum - ws.q : sum;
+            }
+        }
+    }
+}
+
+schemes::GLWECiphertext external_product(
+    const keys::BootstrappingKeyView& bsk,
+    std::size_t i,
+    const schemes::GLWECiphertext& ct,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::external_product");
+    if (i >= bsk.n_lwe || (!ct.is_trivial() && ct.d_tilde.size() != bsk.k) || ct.b.size() != params.n) {
+        throw std::runtime_error("Bootstrapping key does not match ciphertext");
+    }
+    ExternalProductWorkspace ws = make_workspace(bsk, params);
+
+    std::vector<const Polynomial*> input(bsk.k + 1, nullptr);
+    if (!ct.is_trivial()) {
+        for (std::size_t c = 0; c < bsk.k; ++c) input[c] = &ct.d_tilde[c];
+    }
+    input[bsk.k] = &ct.b;
+
+    core::PooledVector<Polynomial> acc(bsk.k + 1, Polynomial(params.n, 0));
+    external_product_accumulate(transformed_ggsw(bsk, i, ws), input.data(), acc.data(), ws);
+
+    schemes::GLWECiphertext result;
+    result.b = acc[bsk.k];
+    result.d_tilde.assign(acc.begin(), acc.begin() + bsk.k);
+
+    // The message is a key bit, so the input noise survives at most once
+    result.noise_variance = ct.noise_variance + noise::blind_rotation_variance(params, bsk.k, 1, bsk.l, bsk.beta);
+    result.coherent_variance = ct.coherent_variance;
+    return result;
+}
+
+// out = (X^r - 1) * a mod (X^n + 1, q), r in [0, 2n)
+static void rotate_minus_one(const Polynomial& a, std::size_t r, int64 q, Polynomial& out) {
+    std::size_t n = a.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t idx = i + r;
+        if (idx >= 2 * n) idx -= 2 * n;
+        if (idx < n) {
+            out[idx] = a[i];
+        } else {
+            out[idx - n] = a[i] == 0 ? 0 : q - a[i];
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        int64 diff = out[i] - a[i];
+        out[i] = diff < 0 ? diff + q : diff;
+    }
+}
+
+schemes::GLWECiphertext blind_rotate(
+    const schemes::LWECiphertext& ct,
+    const Polynomial& test_polynomial,
+    const keys::BootstrappingKeyView& bsk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+) {
+    TURINGED_OPERATION_SCOPE("operations::blind_rotate");
+    if (lwe_params.q != glwe_params.q) {
+        throw std::runtime_error("Blind rotation needs one modulus for LWE and GLWE");
+    }
+    if (!ct.is_trivial() && ct.a.size() != bsk.n_lwe) {
+        throw std::runtime_error("Bootstrapping key does not match ciphertext");
+    }
+    if (test_polynomial.size() != glwe_params.n) {
+        throw std::runtime_error("Test polynomial size mismatch");
+    }
+    ExternalProductWorkspace ws = make_workspace(bsk, glwe_params);
+    std::size_t n = glwe_params.n;
+    std::size_t k = bsk.k;
+
+    schemes::LWECiphertext switched = modulus_switch_lwe(ct, lwe_params, static_cast<int64>(2 * n));
+
+    // Accumulator (d_0, ..., d_{k-1}, b) starts as the trivial X^(-b) * test
+    core::PooledVector<Polynomial> acc(k + 1, Polynomial(n, 0));
+    acc[k] = polynomial::multiply_monomial(test_polynomial, 2 * n - static_cast<std::size_t>(switched.b), glwe_params.q);
+
+    // CMux: acc += s_i * (X^(a_i) - 1) * acc, leaving X^(-b + <a, s>) * test
+    std::vector<const Polynomial*> input(k + 1);
+    for (std::size_t c = 0; c <= k; ++c) input[c] = &ws.rotated[c];
+    for (std::size_t i = 0; i < switched.a.size(); ++i) {
+        std::size_t r = static_cast<std::size_t>(switched.a[i]);
+        if (r == 0) continue;
+
+        TURINGED_TRACE_SCOPE_ARG("blind_rotate.step", "i", i);
+        for (std::size_t c = 0; c <= k; ++c) rotate_minus_one(acc[c], r, glwe_params.q, ws.rotated[c]);
+        external_product_accumulate(transformed_ggsw(bsk, i, ws), input.data(), acc.data(), ws);
+    }
+
+    schemes::GLWECiphertext result;
+    result.b = acc[k];
+    result.d_tilde.assign(acc.begin(), acc.begin() + k);
+    result.noise_variance = noise::blind_rotation_variance(glwe_params, k, bsk.n_lwe, bsk.l, bsk.beta);
+    result.coherent_variance = 0.0;
+    return result;
+}
+
+schemes::LWECiphertext sample_extract(
+    const schemes::GLWECiphertext& ct,
+    std::size_t index,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::sample_extract");
+    std::size_t n = params.n;
+    if (ct.b.size() != n || index >= n) {
+        throw std::runtime_error("Sample index out of range");
+    }
+
+    schemes::LWECiphertext result;
+    result.b = ct.b[index];
+    result.noise_variance = ct.noise_variance;
+    result.coherent_variance = ct.coherent_variance;
+    if (ct.is_trivial()) return result;
+
+    // Coefficient `index` of d_j * s_j is sum_i d_j[index - i] s_j[i], the
+    // wrapped terms negated by X^n = -1
+    result.a = Polynomial(ct.d_tilde.size() * n);
+    for (std::size_t j = 0; j < ct.d_tilde.size(); ++j) {
+        const Polynomial& d = ct.d_tilde[j];
+        int64* a = result.a.data() + j * n;
+        for (std::size_t i = 0; i <= index; ++i) a[i] = d[index - i];
+        for (std::size_t i = index + 1; i < n; ++i) a[i] = d[n + index - i] == 0 ? 0 : params.q - d[n + index - i];
+    }
+    return result;
+}
+
+schemes::LWECiphertext bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const Polynomial& test_polynomial,
+    const keys::BootstrappingKeyView& bsk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+) {
+    TURINGED_OPERATION_SCOPE("operations::bootstrap_lwe");
+    return sample_extract(blind_rotate(ct, test_polynomial, bsk, lwe_params, glwe_params), 0, glwe_params);
+}
+
+schemes::LWECiphertext bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const Polynomial& test_polynomial,
+    const keys::BootstrappingKeyView& bsk,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+) {
+    TURINGED_OPERATION_SCOPE("operations::bootstrap_lwe");
+    return key_switch_lwe(bootstrap_lwe(ct, test_polynomial, bsk, lwe_params, glwe_params), ksk, lwe_params);
+}
+
+// ========== Multi-value bootstrapping ==========
+
+static void check_lut_modulus(const Parameters& params) {
+    if (params.t < 2 || params.t % 2 != 0) {
+        throw std::runtime_error("Multi-value bootstrapping needs an even plaintext modulus");
+    }
+}
+
+Polynomial multi_value_test_polynomial(const Parameters& glwe_params) {
+    check_lut_modulus(glwe_params);
+    return Polynomial(glwe_params.n, glwe_params.q / glwe_params.t / 2);
+}
+
+Polynomial lut_factor_polynomial(const std::vector<int64>& table, const Parameters& glwe_params) {
+    check_lut_modulus(glwe_params);
+    std::size_t n = glwe_params.n;
+    std::size_t messages = static_cast<std::size_t>(glwe_params.t / 2);
+    if (table.size() != messages || messages > n) {
+        throw std::runtime_error("Lookup table must have t/2 entries, at most N");
+    }
+
+    // Centered entries keep the jumps, and so the noise growth, small
+    auto entry = [&](std::size_t i) {
+        return core::center_rep(core::modq(table[i * messages / n], glwe_params.t), glwe_params.t);
+    };
+
+    // (1 - X) * F, where X * F wraps F[N-1] around to -F[N-1]
+    Polynomial factor(n);
+    factor[0] = core::modq(entry(0) + entry(n - 1), glwe_params.q);
+    for (std::size_t i = 1; i < n; ++i) {
+        factor[i] = core::modq(entry(i) - entry(i - 1), glwe_params.q);
+    }
+    return factor;
+}
+
+std::vector<schemes::LWECiphertext> multi_value_bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const std::vector<std::vector<int64>>& tables,
+    const keys::BootstrappingKeyView& bsk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multi_value_bootstrap_lwe");
+    check_lut_modulus(lwe_params);
+    if (lwe_params.t != glwe_params.t) {
+        throw std::runtime_error("LWE and GLWE plaintext moduli differ");
+    }
+    std::vector<Polynomial> factors;
+    for (const std::vector<int64>& table : tables) factors.push_back(lut_factor_polynomial(table, glwe_params));
+
+    // Half a step of Delta centres every message in its window of the rotation
+    int64 half_step = lwe_params.q / lwe_params.t / 2;
+    schemes::LWECiphertext shifted = ct;
+    shifted.b = core::modq(ct.b + half_step, lwe_params.q);
+    schemes::GLWECiphertext rotated = blind_rotate(shifted, multi_value_test_polynomial(glwe_params), bsk, lwe_params, glwe_params);
+
+    // The accumulator is transformed once and shared by every table
+    std::size_t n = glwe_params.n;
+    int64 q = glwe_params.q;
+    bool hoisted = polynomial::ntt_supported(n, q);
+    core::PooledVector<polynomial::NTTPolynomial> rotated_ntt;
+    if (hoisted) {
+        rotated_ntt.push_back(polynomial::to_ntt(rotated.b, q));
+        for (const Polynomial& d : rotated.d_tilde) rotated_ntt.push_back(polynomial::to_ntt(d, q));
+    }
+
+    std::vector<schemes::LWECiphertext> result;
+    for (const Polynomial& factor : factors) {
+        TURINGED_TRACE_SCOPE("multi_value.table");
+        polynomial::NTTPolynomial factor_ntt;
+        if (hoisted) factor_ntt = polynomial::to_ntt(factor, q);
+        auto multiply = [&](std::size_t c, const Polynomial& poly) {
+            return hoisted ? polynomial::from_ntt(polynomial::ntt_multiply(rotated_ntt[c], factor_ntt), q)
+                           : polynomial::negacyclic_multiply(poly, factor, q);
+        };
+
+        schemes::GLWECiphertext product;
+        product.b = multiply(0, rotated.b);
+        for (std::size_t j = 0; j < rotated.d_tilde.size(); ++j) {
+            product.d_tilde.push_back(multiply(j + 1, rotated.d_tilde[j]));
+        }
+
+        // The blind rotation leaves no coherent part, but the mean of the
+        // factor makes part of the product slowly varying
+        double norm = 0.0;
+        double sum = 0.0;
+        for (int64 v : factor) {
+            double c = static_cast<double>(core::center_rep(v, q));
+            norm += c * c;
+            sum += c;
+        }
+        product.noise_variance = rotated.noise_variance * norm;
+        product.coherent_variance = rotated.noise_variance * sum * sum / static_cast<double>(n);
+        result.push_back(sample_extract(product, 0, glwe_params));
+    }
+    return result;
+}
+
+std::vector<schemes::LWECiphertext> multi_value_bootstrap_lwe(
+    const schemes::LWECiphertext& ct,
+    const std::vector<std::vector<int64>>& tables,
+    const keys::BootstrappingKeyView& bsk,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& lwe_params,
+    const Parameters& glwe_params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multi_value_bootstrap_lwe");
+    std::vector<schemes::LWECiphertext> result = multi_value_bootstrap_lwe(ct, tables, bsk, lwe_params, glwe_params);
+    for (schemes::LWECiphertext& out : result) out = key_switch_lwe(out, ksk, lwe_params);
+    return result;
+}
+
+}
+}
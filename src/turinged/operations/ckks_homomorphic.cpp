@@ -0,0 +1,134 @@
+#include "turinged/operations/ckks_homomorphic.hpp"
+#include "turinged/operations/rns_homomorphic.hpp"
+#include "turinged/core/metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+static void check_scales(const schemes::CKKSCiphertext& ct1, const schemes::CKKSCiphertext& ct2) {
+    if (std::fabs(ct1.scale - ct2.scale) > 1e-9 * std::max(ct1.scale, ct2.scale)) {
+        throw std::runtime_error("CKKS ciphertext scale mismatch");
+    }
+}
+
+schemes::CKKSCiphertext mod_drop_ckks(
+    const schemes::CKKSCiphertext& ct,
+    std::size_t level,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::mod_drop_ckks");
+    if (level > ct.level()) {
+        throw std::runtime_error("Cannot switch a ciphertext up the modulus chain");
+    }
+    params.level(level);
+
+    schemes::CKKSCiphertext result;
+    result.a = rns::drop_primes(ct.a, level + 1);
+    result.b = rns::drop_primes(ct.b, level + 1);
+    result.scale = ct.scale;
+    return result;
+}
+
+schemes::CKKSCiphertext rescale_ckks(
+    const schemes::CKKSCiphertext& ct,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::rescale_ckks");
+    std::size_t l = ct.level();
+
+    schemes::CKKSCiphertext result;
+    result.a = rns::rescale_by_last_prime(ct.a, params);
+    result.b = rns::rescale_by_last_prime(ct.b, params);
+    result.scale = ct.scale / static_cast<double>(params.q_base(l).primes[l]);
+    return result;
+}
+
+schemes::CKKSCiphertext add_ckks(
+    const schemes::CKKSCiphertext& ct1,
+    const schemes::CKKSCiphertext& ct2,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_ckks");
+    check_scales(ct1, ct2);
+
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::CKKSCiphertext x = mod_drop_ckks(ct1, level, params);
+    schemes::CKKSCiphertext y = mod_drop_ckks(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    schemes::CKKSCiphertext result;
+    result.a = rns::add(x.a, y.a, base);
+    result.b = rns::add(x.b, y.b, base);
+    result.scale = x.scale;
+    return result;
+}
+
+schemes::CKKSCiphertext subtract_ckks(
+    const schemes::CKKSCiphertext& ct1,
+    const schemes::CKKSCiphertext& ct2,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::subtract_ckks");
+    check_scales(ct1, ct2);
+
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::CKKSCiphertext x = mod_drop_ckks(ct1, level, params);
+    schemes::CKKSCiphertext y = mod_drop_ckks(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    schemes::CKKSCiphertext result;
+    result.a = rns::subtract(x.a, y.a, base);
+    result.b = rns::subtract(x.b, y.b, base);
+    result.scale = x.scale;
+    return result;
+}
+
+schemes::CKKSCiphertext multiply_ckks(
+    const schemes::CKKSCiphertext& ct1,
+    const schemes::CKKSCiphertext& ct2,
+    const keys::RNSRelinKey& rlk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_ckks");
+    if (rlk.keys.size() != 1) {
+        throw std::runtime_error("CKKS multiplication needs an RLWE relinearisation key");
+    }
+
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    if (level == 0) {
+        throw std::runtime_error("Multiplication needs at least two primes left in the modulus chain");
+    }
+    schemes::CKKSCiphertext x = mod_drop_ckks(ct1, level, params);
+    schemes::CKKSCiphertext y = mod_drop_ckks(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    rns::to_ntt_inplace(x.a, base);
+    rns::to_ntt_inplace(x.b, base);
+    rns::to_ntt_inplace(y.a, base);
+    rns::to_ntt_inplace(y.b, base);
+
+    // (b1 - a1 s)(b2 - a2 s) = d0 - d1 s + d2 s^2
+    rns::RNSPolynomial d0 = rns::multiply_ntt(x.b, y.b, base);
+    rns::RNSPolynomial d1 = rns::multiply_ntt(x.a, y.b, base);
+    rns::multiply_accumulate_ntt(d1, x.b, y.a, base);
+    rns::RNSPolynomial d2 = rns::multiply_ntt(x.a, y.a, base);
+    rns::from_ntt_inplace(d0, base);
+    rns::from_ntt_inplace(d1, base);
+    rns::from_ntt_inplace(d2, base);
+
+    // The switched component encrypts d2 * s^2 under s
+    schemes::RNSGLWECiphertext switched = key_switch_component_rns(d2, rlk.keys[0], params);
+
+    schemes::CKKSCiphertext result;
+    result.b = rns::add(d0, switched.b, base);
+    result.a = rns::add(d1, switched.d_tilde[0], base);
+    result.scale = x.scale * y.scale;
+
+    return rescale_ckks(result, params);
+}
+
+}
+}
@@ -0,0 +1,149 @@
+#include "turinged/operations/gates.hpp"
+#include "turinged/operations/bootstrapping.hpp"
+#include "turinged/operations/homomorphic.hpp"
+#include "turinged/operations/key_switching.hpp"
+#include "turinged/params/params.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/core/parallel.hpp"
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+// Messages mod t = 8: true is Delta = q/8, false is 7 * Delta = -q/8
+static int64 bit_message(bool bit) {
+    return bit ? 1 : 7;
+}
+
+keys::GateBootstrappingParameters default_gate_parameters() {
+    keys::GateBootstrappingParameters gp;
+    gp.lwe_dimension = 750;
+    gp.k = 1;
+    gp.n = 1024;
+    gp.q = 1LL << 32;
+    gp.lwe_noise_bound = params::noise_bound_for_stddev(params::min_noise_stddev(gp.lwe_dimension, gp.q, 128));
+    gp.glwe_noise_bound = params::noise_bound_for_stddev(params::min_noise_stddev(gp.k * gp.n, gp.q, 128));
+    gp.bsk_l = 2;
+    gp.bsk_beta = 1LL << 7;
+    gp.ksk_beta = 1LL << 4;
+    return gp;
+}
+
+schemes::LWECiphertext encrypt_bit(bool bit, const keys::LWESecretKey& sk, const keys::GateBootstrappingParameters& params) {
+    return schemes::encrypt_lwe(bit_message(bit), sk, params.lwe_parameters());
+}
+
+bool decrypt_bit(const schemes::LWECiphertext& ct, const keys::LWESecretKey& sk, const keys::GateBootstrappingParameters& params) {
+    if (!ct.is_trivial() && ct.a.size() != sk.s.size()) {
+        throw std::runtime_error("Ciphertext size mismatch with secret key");
+    }
+    int64 inner = ct.is_trivial() ? 0 : core::dot_product_modq(ct.a.data(), sk.s.data(), sk.s.size(), params.q);
+    int64 phase = core::modq(ct.b - inner, params.q);
+    return phase > 0 && phase < params.q / 2;
+}
+
+schemes::LWECiphertext trivial_bit(bool bit, const keys::GateBootstrappingParameters& params) {
+    return schemes::trivial_lwe(bit_message(bit), params.lwe_parameters());
+}
+
+static Polynomial sign_test_polynomial(const keys::GateBootstrappingParameters& params) {
+    return Polynomial(params.n, params.q / 8);
+}
+
+// Constant plus multiple of a + b whose phase is in (0, q/2) exactly when the gate is true
+static schemes::LWECiphertext gate_combination(
+    Gate gate,
+    const schemes::LWECiphertext& a,
+    const schemes::LWECiphertext& b,
+    const Parameters& params
+) {
+    schemes::LWECiphertext sum = add_lwe(a, b, params);
+    switch (gate) {
+        case Gate::NAND: return add_plain_lwe(scalar_multiply_lwe(sum, -1, params), 1, params);
+        case Gate::AND: return add_plain_lwe(sum, 7, params);
+        case Gate::OR: return add_plain_lwe(sum, 1, params);
+        case Gate::NOR: return add_plain_lwe(scalar_multiply_lwe(sum, -1, params), 7, params);
+        case Gate::XOR: return add_plain_lwe(scalar_multiply_lwe(sum, 2, params), 2, params);
+        case Gate::XNOR: return add_plain_lwe(scalar_multiply_lwe(sum, -2, params), 6, params);
+    }
+    throw std::runtime_error("Unknown gate");
+}
+
+schemes::LWECiphertext evaluate_gate(
+    Gate gate,
+    const schemes::LWECiphertext& a,
+    const schemes::LWECiphertext& b,
+    const keys::GateBootstrappingKeyView& key
+) {
+    TURINGED_OPERATION_SCOPE("operations::evaluate_gate");
+    Parameters lwe_params = key.params.lwe_parameters();
+    return bootstrap_lwe(gate_combination(gate, a, b, lwe_params), sign_test_polynomial(key.params),
+                         key.bsk, key.ksk, lwe_params, key.params.glwe_parameters());
+}
+
+schemes::LWECiphertext gate_not(const schemes::LWECiphertext& a, const keys::GateBootstrappingParameters& params) {
+    TURINGED_OPERATION_SCOPE("operations::gate_not");
+    return scalar_multiply_lwe(a, -1, params.lwe_parameters());
+}
+
+schemes::LWECiphertext gate_mux(
+    const schemes::LWECiphertext& select,
+    const schemes::LWECiphertext& a,
+    const schemes::LWECiphertext& b,
+    const keys::GateBootstrappingKeyView& key
+) {
+    TURINGED_OPERATION_SCOPE("operations::gate_mux");
+    Parameters lwe_params = key.params.lwe_parameters();
+    Parameters glwe_params = key.params.glwe_parameters();
+    Polynomial test = sign_test_polynomial(key.params);
+
+    // AND(select, a) + AND(NOT select, b): at most one is true, so adding q/8
+    // gives +-q/8; the sum is key switched once under the extracted key
+    schemes::LWECiphertext left = bootstrap_lwe(
+        add_plain_lwe(add_lwe(select, a, lwe_params), 7, lwe_params), test, key.bsk, lwe_params, glwe_params);
+    schemes::LWECiphertext right = bootstrap_lwe(
+        add_plain_lwe(subtract_lwe(b, select, lwe_params), 7, lwe_params), test, key.bsk, lwe_params, glwe_params);
+    return key_switch_lwe(add_plain_lwe(add_lwe(left, right, lwe_params), 1, lwe_params), key.ksk, lwe_params);
+}
+
+std::vector<schemes::LWECiphertext> evaluate_gates(
+    Gate gate,
+    const std::vector<schemes::LWECiphertext>& a,
+    const std::vector<schemes::LWECiphertext>& b,
+    const keys::GateBootstrappingKeyView& key,
+    std::size_t num_threads
+) {
+    TURINGED_OPERATION_SCOPE("operations::evaluate_gates");
+    if (a.size() != b.size()) {
+        throw std::runtime_error("Gate input count mismatch");
+    }
+
+    std::vector<schemes::LWECiphertext> result(a.size());
+    core::parallel_for(a.size(), [&](std::size_t i) {
+        result[i] = evaluate_gate(gate, a[i], b[i], key);
+    }, num_threads);
+    return result;
+}
+
+std::vector<schemes::LWECiphertext> evaluate_mux_gates(
+    const std::vector<schemes::LWECiphertext>& select,
+    const std::vector<schemes::LWECiphertext>& a,
+    const std::vector<schemes::LWECiphertext>& b,
+    const keys::GateBootstrappingKeyView& key,
+    std::size_t num_threads
+) {
+    TURINGED_OPERATION_SCOPE("operations::evaluate_mux_gates");
+    if (a.size() != select.size() || b.size() != select.size()) {
+        throw std::runtime_error("Gate input count mismatch");
+    }
+
+    std::vector<schemes::LWECiphertext> result(select.size());
+    core::parallel_for(select.size(), [&](std::size_t i) {
+        result[i] = gate_mux(select[i], a[i], b[i], key);
+    }, num_threads);
+    return result;
+}
+
+}
+}
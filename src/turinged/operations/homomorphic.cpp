@@ -1,27 +1,217 @@
 #include "turinged/operations/homomorphic.hpp"
+#include "turinged/operations/key_switching.hpp"
 #include "turinged/polynomial/polynomial.hpp"
+#include "turinged/polynomial/ntt.hpp"
 #include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace turinged {
 namespace operations {
 
+PreparedPlaintext prepare_plaintext(const Polynomial& plain, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("operations::prepare_plaintext");
+    if (plain.size() != params.n) {
+        throw std::runtime_error("Plaintext size mismatch");
+    }
+
+    // to_ntt centers mod t, keeping the noise growth at |plain| <= t/2
+    PreparedPlaintext result;
+    result.value = polynomial::to_ntt(plain, params.t);
+    result.bound = params.t / 2;
+    result.norm_squared = 0.0;
+    std::vector<double> prefix(plain.size());
+    double sum = 0.0;
+    for (std::size_t i = 0; i < plain.size(); ++i) {
+        double centered = static_cast<double>(core::center_rep(core::modq(plain[i], params.t), params.t));
+        result.norm_squared += centered * centered;
+        sum += centered;
+        prefix[i] = sum;
+    }
+
+    // Coefficient i of plain * (1 + x + ... + x^(n-1)) is the prefix sum up to
+    // i minus the rest, which wraps around negated
+    double n = static_cast<double>(params.n);
+    result.ramp_norm_squared = 0.0;
+    for (double p : prefix) {
+        double coefficient = 2.0 * p - sum;
+        result.ramp_norm_squared += coefficient * coefficient / n;
+    }
+    result.mean_norm_squared = sum * sum / n;
+    return result;
+}
+
+// How many plaintext-ciphertext products can be summed exactly before the
+// NTT accumulator has to be reduced mod q
+static std::size_t exact_plain_terms(const Parameters& params, int64 bound) {
+    long double limit = 1.0L;
+    for (uint64 p : polynomial::EXACT_PRIMES) {
+        limit *= static_cast<long double>(p);
+    }
+    long double per_term = static_cast<long double>(params.n) * (static_cast<long double>(params.q) / 2.0L) *
+                           static_cast<long double>(bound > 0 ? bound : 1);
+    long double terms = limit / 4.0L / per_term;
+    if (terms < 1.0L) {
+        throw std::runtime_error("Parameters not supported by the exact plaintext product");
+    }
+    return terms > 1e18L ? static_cast<std::size_t>(1e18) : static_cast<std::size_t>(terms);
+}
+
+// sum_i plain_i * component_i mod q written into out, where component(i)
+// yields the i-th ciphertext polynomial view (empty for a missing mask)
+template <typename Component>
+static void plain_dot_product(
+    std::size_t count,
+    Component component,
+    const PreparedPlaintext* plains,
+    const Parameters& params,
+    polynomial::PolynomialView out
+) {
+    int64 bound = 0;
+    for (std::size_t i = 0; i < count; ++i) bound = std::max(bound, plains[i].bound);
+    std::size_t chunk = exact_plain_terms(params, bound);
+
+    // The first chunk is written straight into out, so a single-term product
+    // may write over its own input
+    bool written = false;
+    Polynomial partial;
+    polynomial::NTTPolynomial acc(params.n);
+    std::size_t pending = 0;
+
+    auto flush = [&]() {
+        if (written) {
+            partial.resize(params.n);
+            polynomial::from_ntt(acc, polynomial::view(partial, params.q));
+            polynomial::add(out, polynomial::view(partial, params.q), out);
+        } else {
+            polynomial::from_ntt(acc, out);
+            written = true;
+        }
+        acc = polynomial::NTTPolynomial(params.n);
+        pending = 0;
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        // Trivial ciphertexts contribute nothing to the mask
+        polynomial::ConstPolynomialView c = component(i);
+        if (c.empty()) continue;
+
+        polynomial::ntt_multiply_accumulate(acc, polynomial::to_ntt(c), plains[i].value);
+        if (++pending == chunk) flush();
+    }
+    if (pending > 0) flush();
+    if (!written) std::fill(out.begin(), out.end(), 0);
+}
+
+template <typename Component>
+static Polynomial plain_dot_product(
+    std::size_t count,
+    Component component,
+    const PreparedPlaintext* plains,
+    const Parameters& params
+) {
+    Polynomial result(params.n);
+    plain_dot_product(count, [&](std::size_t i) { return polynomial::view(component(i), params.q); },
+                      plains, params, polynomial::view(result, params.q));
+    return result;
+}
+
+// Sum or difference of two masks where an empty mask stands for all zeros,
+// so trivial ciphertexts never allocate one
+static Polynomial combine_masks(
+    const Polynomial& x,
+    const Polynomial& y,
+    bool subtract,
+    int64 q
+) {
+    if (y.empty()) return x;
+    if (x.empty()) return subtract ? polynomial::negate(y, q) : y;
+    if (x.size() != y.size()) {
+        throw std::runtime_error("Ciphertext mask size mismatch");
+    }
+    return subtract ? polynomial::subtract(x, y, q) : polynomial::add(x, y, q);
+}
+
+static core::PooledVector<Polynomial> combine_masks(
+    const core::PooledVector<Polynomial>& x,
+    const core::PooledVector<Polynomial>& y,
+    bool subtract,
+    int64 q
+) {
+    if (y.empty()) return x;
+    if (!x.empty() && x.size() != y.size()) {
+        throw std::runtime_error("GLWE ciphertext size mismatch");
+    }
+
+    static const Polynomial zero;
+    core::PooledVector<Polynomial> result;
+    for (std::size_t i = 0; i < y.size(); ++i) {
+        result.push_back(combine_masks(x.empty() ? zero : x[i], y[i], subtract, q));
+    }
+    return result;
+}
+
+// Noise of scalar * ct
+static double scaled_variance(double variance, int64 scalar) {
+    double s = static_cast<double>(scalar);
+    return variance * s * s;
+}
+
+// Noise of x + y or x - y
+template <typename Ciphertext>
+static void set_sum_noise(Ciphertext& result, const Ciphertext& x, const Ciphertext& y) {
+    result.noise_variance = noise::sum_variance(x.noise_variance, x.coherent_variance, y.noise_variance, y.coherent_variance);
+    result.coherent_variance = noise::sum_coherent_variance(x.coherent_variance, y.coherent_variance);
+}
+
+template <typename Ciphertext>
+static void set_scaled_noise(Ciphertext& result, const Ciphertext& ct, int64 scalar) {
+    result.noise_variance = scaled_variance(ct.noise_variance, scalar);
+    result.coherent_variance = scaled_variance(ct.coherent_variance, scalar);
+}
+
+// Noise of sum_i cts[i] * plains[i]
+template <typename Ciphertext>
+static void set_plain_product_noise(
+    Ciphertext& result,
+    const Ciphertext* cts,
+    const PreparedPlaintext* plains,
+    std::size_t count,
+    const Parameters& params
+) {
+    result.noise_variance = 0.0;
+    result.coherent_variance = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Ciphertext& ct = cts[i];
+        const PreparedPlaintext& plain = plains[i];
+        double variance = noise::plain_product_variance(ct.noise_variance, ct.coherent_variance,
+                                                        plain.norm_squared, plain.ramp_norm_squared, params);
+        double coherent = noise::plain_product_coherent_variance(ct.noise_variance, ct.coherent_variance,
+                                                                 plain.mean_norm_squared, plain.ramp_norm_squared, params);
+        result.noise_variance = noise::sum_variance(result.noise_variance, result.coherent_variance, variance, coherent);
+        result.coherent_variance = noise::sum_coherent_variance(result.coherent_variance, coherent);
+    }
+}
+
 // LWE Homomorphic Operations
 schemes::LWECiphertext add_lwe(
     const schemes::LWECiphertext& ct1,
     const schemes::LWECiphertext& ct2,
     const Parameters& params
 ) {
-    if (ct1.a.size() != ct2.a.size()) {
+    TURINGED_OPERATION_SCOPE("operations::add_lwe");
+    if (!ct1.is_trivial() && !ct2.is_trivial() && ct1.a.size() != ct2.a.size()) {
         throw std::runtime_error("LWE ciphertext size mismatch");
     }
 
-    schemes::LWECiphertext result(ct1.a.size());
+    schemes::LWECiphertext result;
 
-    for (std::size_t i = 0; i < ct1.a.size(); ++i) {
-        result.a[i] = core::modq(ct1.a[i] + ct2.a[i], params.q);
-    }
+    result.a = combine_masks(ct1.a, ct2.a, false, params.q);
     result.b = core::modq(ct1.b + ct2.b, params.q);
+    set_sum_noise(result, ct1, ct2);
 
     return result;
 }
@@ -31,16 +221,16 @@ schemes::LWECiphertext subtract_lwe(
     const schemes::LWECiphertext& ct2,
     const Parameters& params
 ) {
-    if (ct1.a.size() != ct2.a.size()) {
+    TURINGED_OPERATION_SCOPE("operations::subtract_lwe");
+    if (!ct1.is_trivial() && !ct2.is_trivial() && ct1.a.size() != ct2.a.size()) {
         throw std::runtime_error("LWE ciphertext size mismatch");
     }
 
-    schemes::LWECiphertext result(ct1.a.size());
+    schemes::LWECiphertext result;
 
-    for (std::size_t i = 0; i < ct1.a.size(); ++i) {
-        result.a[i] = core::modq(ct1.a[i] - ct2.a[i], params.q);
-    }
+    result.a = combine_masks(ct1.a, ct2.a, true, params.q);
     result.b = core::modq(ct1.b - ct2.b, params.q);
+    set_sum_noise(result, ct1, ct2);
 
     return result;
 }
@@ -50,6 +240,7 @@ schemes::LWECiphertext scalar_multiply_lwe(
     int64 scalar,
     const Parameters& params
 ) {
+    TURINGED_OPERATION_SCOPE("operations::scalar_multiply_lwe");
     schemes::LWECiphertext result(ct.a.size());
 
     for (std::size_t i = 0; i < ct.a.size(); ++i) {
@@ -59,20 +250,45 @@ schemes::LWECiphertext scalar_multiply_lwe(
 
     int128 tmp_b = static_cast<int128>(ct.b) * scalar;
     result.b = core::modq(static_cast<int64>(tmp_b % params.q), params.q);
+    set_scaled_noise(result, ct, scalar);
 
     return result;
 }
 
+schemes::LWECiphertext add_plain_lwe(
+    const schemes::LWECiphertext& ct,
+    int64 message,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_plain_lwe");
+    schemes::LWECiphertext result = ct;
+    int64 delta = params.q / params.t;
+    int128 scaled = static_cast<int128>(delta) * core::modq(message, params.t);
+    result.b = core::modq(static_cast<int64>((static_cast<int128>(ct.b) + scaled) % params.q), params.q);
+    return result;
+}
+
+schemes::LWECiphertext sub_plain_lwe(
+    const schemes::LWECiphertext& ct,
+    int64 message,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::sub_plain_lwe");
+    return add_plain_lwe(ct, params.t - core::modq(message, params.t), params);
+}
+
 // RLWE Homomorphic Operations
 schemes::RLWECiphertext add_rlwe(
     const schemes::RLWECiphertext& ct1,
     const schemes::RLWECiphertext& ct2,
     const Parameters& params
 ) {
-    schemes::RLWECiphertext result(params.n);
+    TURINGED_OPERATION_SCOPE("operations::add_rlwe");
+    schemes::RLWECiphertext result;
 
-    result.a = polynomial::add(ct1.a, ct2.a, params.q);
+    result.a = combine_masks(ct1.a, ct2.a, false, params.q);
     result.b = polynomial::add(ct1.b, ct2.b, params.q);
+    set_sum_noise(result, ct1, ct2);
 
     return result;
 }
@@ -82,10 +298,12 @@ schemes::RLWECiphertext subtract_rlwe(
     const schemes::RLWECiphertext& ct2,
     const Parameters& params
 ) {
-    schemes::RLWECiphertext result(params.n);
+    TURINGED_OPERATION_SCOPE("operations::subtract_rlwe");
+    schemes::RLWECiphertext result;
 
-    result.a = polynomial::subtract(ct1.a, ct2.a, params.q);
+    result.a = combine_masks(ct1.a, ct2.a, true, params.q);
     result.b = polynomial::subtract(ct1.b, ct2.b, params.q);
+    set_sum_noise(result, ct1, ct2);
 
     return result;
 }
@@ -95,51 +313,252 @@ schemes::RLWECiphertext scalar_multiply_rlwe(
     int64 scalar,
     const Parameters& params
 ) {
+    TURINGED_OPERATION_SCOPE("operations::scalar_multiply_rlwe");
     schemes::RLWECiphertext result(params.n);
 
     result.a = polynomial::scalar_multiply(ct.a, scalar, params.q);
     result.b = polynomial::scalar_multiply(ct.b, scalar, params.q);
+    set_scaled_noise(result, ct, scalar);
 
     return result;
 }
 
-schemes::RLWECiphertext multiply_rlwe(
+// Delta * m added to (or subtracted from) a body polynomial
+static void shift_body(
+    polynomial::ConstPolynomialView b,
+    polynomial::ConstPolynomialView message,
+    bool subtract,
+    const Parameters& params,
+    polynomial::PolynomialView out
+) {
+    if (message.n != b.n || out.n != b.n) {
+        throw std::runtime_error("Message size mismatch");
+    }
+
+    int64 delta = params.q / params.t;
+    for (std::size_t i = 0; i < b.n; ++i) {
+        int64 m = core::modq(message[i], params.t);
+        int64 scaled = static_cast<int64>((static_cast<int128>(delta) * m) % params.q);
+        out[i] = core::modq(subtract ? b[i] - scaled : b[i] + scaled, params.q);
+    }
+}
+
+static Polynomial shift_body(const Polynomial& b, const Polynomial& message, bool subtract, const Parameters& params) {
+    Polynomial result(b.size());
+    shift_body(polynomial::view(b, params.q), polynomial::view(message, params.t), subtract, params,
+               polynomial::view(result, params.q));
+    return result;
+}
+
+schemes::RLWECiphertext add_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& message,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_plain_rlwe");
+    schemes::RLWECiphertext result;
+    result.a = ct.a;
+    result.b = shift_body(ct.b, message, false, params);
+    result.noise_variance = ct.noise_variance;
+    result.coherent_variance = ct.coherent_variance;
+    return result;
+}
+
+schemes::RLWECiphertext sub_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& message,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::sub_plain_rlwe");
+    schemes::RLWECiphertext result;
+    result.a = ct.a;
+    result.b = shift_body(ct.b, message, true, params);
+    result.noise_variance = ct.noise_variance;
+    result.coherent_variance = ct.coherent_variance;
+    return result;
+}
+
+schemes::RLWECiphertext multiply_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Polynomial& plain,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_rlwe");
+    return multiply_plain_rlwe(ct, prepare_plaintext(plain, params), params);
+}
+
+schemes::RLWECiphertext multiply_plain_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_rlwe");
+    if ((!ct.is_trivial() && ct.a.size() != params.n) || ct.b.size() != params.n) {
+        throw std::runtime_error("RLWE ciphertext size mismatch");
+    }
+
+    schemes::RLWECiphertext result;
+    if (!ct.is_trivial()) result.a = plain_dot_product(1, [&](std::size_t) -> const Polynomial& { return ct.a; }, &plain, params);
+    result.b = plain_dot_product(1, [&](std::size_t) -> const Polynomial& { return ct.b; }, &plain, params);
+    set_plain_product_noise(result, &ct, &plain, 1, params);
+
+    return result;
+}
+
+schemes::RLWECiphertext multiply_plain_accumulate_rlwe(
+    const std::vector<schemes::RLWECiphertext>& cts,
+    const std::vector<PreparedPlaintext>& plains,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_accumulate_rlwe");
+    if (cts.size() != plains.size()) {
+        throw std::runtime_error("Ciphertext and plaintext counts differ");
+    }
+    bool all_trivial = true;
+    for (const schemes::RLWECiphertext& ct : cts) {
+        if ((!ct.is_trivial() && ct.a.size() != params.n) || ct.b.size() != params.n) {
+            throw std::runtime_error("RLWE ciphertext size mismatch");
+        }
+        all_trivial = all_trivial && ct.is_trivial();
+    }
+
+    schemes::RLWECiphertext result;
+    if (!all_trivial) result.a = plain_dot_product(cts.size(), [&](std::size_t i) -> const Polynomial& { return cts[i].a; }, plains.data(), params);
+    result.b = plain_dot_product(cts.size(), [&](std::size_t i) -> const Polynomial& { return cts[i].b; }, plains.data(), params);
+    set_plain_product_noise(result, cts.data(), plains.data(), cts.size(), params);
+
+    return result;
+}
+
+// Message of a trivial ciphertext, read off its body as decryption would
+static Polynomial trivial_message(const schemes::RLWECiphertext& ct, const Parameters& params) {
+    int64 delta = params.q / params.t;
+    Polynomial m(ct.b.size());
+    for (std::size_t i = 0; i < m.size(); ++i) {
+        double val = static_cast<double>(core::center_rep(ct.b[i], params.q)) / static_cast<double>(delta);
+        m[i] = core::modq(static_cast<int64>(std::llround(val)), params.t);
+    }
+    return m;
+}
+
+// A trivial operand is a known plaintext, so the product is a plaintext product
+// of the other operand and needs neither the tensor nor relinearization
+static schemes::RLWECiphertext trivial_product(
     const schemes::RLWECiphertext& ct1,
     const schemes::RLWECiphertext& ct2,
     const Parameters& params
 ) {
-    // Basic polynomial multiplication - this would need more sophisticated implementation
-    // for noise management in practice
-    schemes::RLWECiphertext result(params.n);
+    const schemes::RLWECiphertext& plain = ct1.is_trivial() ? ct1 : ct2;
+    const schemes::RLWECiphertext& other = ct1.is_trivial() ? ct2 : ct1;
+    return multiply_plain_rlwe(other, trivial_message(plain, params), params);
+}
 
-    // This is a simplified version - real implementation needs careful noise analysis
-    Polynomial a_mult = polynomial::negacyclic_multiply(ct1.a, ct2.a, params.q);
-    Polynomial b_mult = polynomial::negacyclic_multiply(ct1.b, ct2.b, params.q);
+RLWETensorCiphertext tensor_rlwe(
+    const schemes::RLWECiphertext& ct1,
+    const schemes::RLWECiphertext& ct2,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::tensor_rlwe");
+    std::size_t n = params.n;
+    for (const schemes::RLWECiphertext* ct : {&ct1, &ct2}) {
+        if ((!ct->is_trivial() && ct->a.size() != n) || ct->b.size() != n) {
+            throw std::runtime_error("RLWE ciphertext size mismatch");
+        }
+    }
+    if (ct1.is_trivial() || ct2.is_trivial()) {
+        // (c0, c1, c2) = (b, -a, 0) of the plaintext product
+        schemes::RLWECiphertext product = trivial_product(ct1, ct2, params);
+        RLWETensorCiphertext result;
+        result.c0 = std::move(product.b);
+        result.c1 = product.is_trivial() ? Polynomial(n, 0) : polynomial::negate(product.a, params.q);
+        result.c2 = Polynomial(n, 0);
+        result.noise_variance = product.noise_variance;
+        result.coherent_variance = product.coherent_variance;
+        return result;
+    }
+    if (!polynomial::ntt_supported(n, params.q, 2)) {
+        throw std::runtime_error("Parameters not supported by the exact tensor product");
+    }
+
+    // Phase is b - a*s, i.e. (c0, c1) = (b, -a). Products are exact over the integers.
+    polynomial::NTTPolynomial a1 = polynomial::to_ntt(ct1.a, params.q);
+    polynomial::NTTPolynomial b1 = polynomial::to_ntt(ct1.b, params.q);
+    polynomial::NTTPolynomial a2 = polynomial::to_ntt(ct2.a, params.q);
+    polynomial::NTTPolynomial b2 = polynomial::to_ntt(ct2.b, params.q);
+
+    polynomial::NTTPolynomial d0 = polynomial::ntt_multiply(b1, b2);
+    polynomial::NTTPolynomial d1 = polynomial::ntt_multiply(b1, a2);
+    polynomial::ntt_multiply_accumulate(d1, a1, b2);
+    polynomial::ntt_negate_inplace(d1);
+    polynomial::NTTPolynomial d2 = polynomial::ntt_multiply(a1, a2);
+
+    // Scale each component by t/q and round, then reduce mod q
+    auto scale_down = [&](const polynomial::NTTPolynomial& d) {
+        core::PooledVector<int128> exact = polynomial::from_ntt_exact(d);
+        Polynomial out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = core::mod_int128(core::scale_round(exact[i], params.t, params.q), params.q);
+        }
+        return out;
+    };
+
+    RLWETensorCiphertext result;
+    result.c0 = scale_down(d0);
+    result.c1 = scale_down(d1);
+    result.c2 = scale_down(d2);
+    result.noise_variance = noise::tensor_variance(ct1.noise_variance, ct1.coherent_variance,
+                                                   ct2.noise_variance, ct2.coherent_variance, params);
+    result.coherent_variance = noise::tensor_coherent_variance(ct1.noise_variance, ct1.coherent_variance,
+                                                               ct2.noise_variance, ct2.coherent_variance, params);
+
+    return result;
+}
+
+schemes::RLWECiphertext relinearize_rlwe(
+    const RLWETensorCiphertext& ct,
+    const keys::RLWERelinKey& rlk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::relinearize_rlwe");
+    // (a', b') encrypts c2 * s^2 under s
+    schemes::RLWECiphertext switched = key_switch_component(ct.c2, rlk, params);
 
-    result.a = a_mult;
-    result.b = b_mult;
+    // b - a*s = c0 + c1*s + c2*s^2  with  b = c0 + b',  a = a' - c1
+    schemes::RLWECiphertext result(params.n);
+    result.b = polynomial::add(ct.c0, switched.b, params.q);
+    result.a = polynomial::subtract(switched.a, ct.c1, params.q);
+    result.noise_variance = noise::sum_variance(ct.noise_variance, ct.coherent_variance,
+                                                switched.noise_variance, switched.coherent_variance);
+    result.coherent_variance = noise::sum_coherent_variance(ct.coherent_variance, switched.coherent_variance);
 
     return result;
 }
 
+schemes::RLWECiphertext multiply_rlwe(
+    const schemes::RLWECiphertext& ct1,
+    const schemes::RLWECiphertext& ct2,
+    const keys::RLWERelinKey& rlk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_rlwe");
+    if (ct1.is_trivial() || ct2.is_trivial()) {
+        return trivial_product(ct1, ct2, params);
+    }
+    return relinearize_rlwe(tensor_rlwe(ct1, ct2, params), rlk, params);
+}
+
 // GLWE Homomorphic Operations
 schemes::GLWECiphertext add_glwe(
     const schemes::GLWECiphertext& ct1,
     const schemes::GLWECiphertext& ct2,
     const Parameters& params
 ) {
-    if (ct1.d_tilde.size() != ct2.d_tilde.size()) {
-        throw std::runtime_error("GLWE ciphertext size mismatch");
-    }
-
-    std::size_t k = ct1.d_tilde.size();
-    schemes::GLWECiphertext result(k, params.n);
+    TURINGED_OPERATION_SCOPE("operations::add_glwe");
+    schemes::GLWECiphertext result;
 
     result.b = polynomial::add(ct1.b, ct2.b, params.q);
-
-    for (std::size_t i = 0; i < k; ++i) {
-        result.d_tilde[i] = polynomial::add(ct1.d_tilde[i], ct2.d_tilde[i], params.q);
-    }
+    result.d_tilde = combine_masks(ct1.d_tilde, ct2.d_tilde, false, params.q);
+    set_sum_noise(result, ct1, ct2);
 
     return result;
 }
@@ -149,18 +568,12 @@ schemes::GLWECiphertext subtract_glwe(
     const schemes::GLWECiphertext& ct2,
     const Parameters& params
 ) {
-    if (ct1.d_tilde.size() != ct2.d_tilde.size()) {
-        throw std::runtime_error("GLWE ciphertext size mismatch");
-    }
-
-    std::size_t k = ct1.d_tilde.size();
-    schemes::GLWECiphertext result(k, params.n);
+    TURINGED_OPERATION_SCOPE("operations::subtract_glwe");
+    schemes::GLWECiphertext result;
 
     result.b = polynomial::subtract(ct1.b, ct2.b, params.q);
-
-    for (std::size_t i = 0; i < k; ++i) {
-        result.d_tilde[i] = polynomial::subtract(ct1.d_tilde[i], ct2.d_tilde[i], params.q);
-    }
+    result.d_tilde = combine_masks(ct1.d_tilde, ct2.d_tilde, true, params.q);
+    set_sum_noise(result, ct1, ct2);
 
     return result;
 }
@@ -170,6 +583,7 @@ schemes::GLWECiphertext scalar_multiply_glwe(
     int64 scalar,
     const Parameters& params
 ) {
+    TURINGED_OPERATION_SCOPE("operations::scalar_multiply_glwe");
     std::size_t k = ct.d_tilde.size();
     schemes::GLWECiphertext result(k, params.n);
 
@@ -178,21 +592,391 @@ schemes::GLWECiphertext scalar_multiply_glwe(
     for (std::size_t i = 0; i < k; ++i) {
         result.d_tilde[i] = polynomial::scalar_multiply(ct.d_tilde[i], scalar, params.q);
     }
+    set_scaled_noise(result, ct, scalar);
 
     return result;
 }
 
-// Placeholder implementations for advanced operations
-schemes::LWECiphertext key_switch_lwe_to_lwe(
-    const schemes::LWECiphertext& ct,
-    const keys::LWESecretKey& from_key,
-    const keys::LWESecretKey& to_key,
+schemes::GLWECiphertext add_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& message,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_plain_glwe");
+    schemes::GLWECiphertext result;
+    result.b = shift_body(ct.b, message, false, params);
+    result.d_tilde = ct.d_tilde;
+    result.noise_variance = ct.noise_variance;
+    result.coherent_variance = ct.coherent_variance;
+    return result;
+}
+
+schemes::GLWECiphertext sub_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& message,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::sub_plain_glwe");
+    schemes::GLWECiphertext result;
+    result.b = shift_body(ct.b, message, true, params);
+    result.d_tilde = ct.d_tilde;
+    result.noise_variance = ct.noise_variance;
+    result.coherent_variance = ct.coherent_variance;
+    return result;
+}
+
+schemes::GLWECiphertext multiply_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Polynomial& plain,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_glwe");
+    return multiply_plain_glwe(ct, prepare_plaintext(plain, params), params);
+}
+
+schemes::GLWECiphertext multiply_plain_glwe(
+    const schemes::GLWECiphertext& ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_glwe");
+    std::size_t k = ct.d_tilde.size();
+    schemes::GLWECiphertext result(k, params.n);
+    result.b = plain_dot_product(1, [&](std::size_t) -> const Polynomial& { return ct.b; }, &plain, params);
+    for (std::size_t j = 0; j < k; ++j) {
+        result.d_tilde[j] = plain_dot_product(1, [&](std::size_t) -> const Polynomial& { return ct.d_tilde[j]; }, &plain, params);
+    }
+    set_plain_product_noise(result, &ct, &plain, 1, params);
+
+    return result;
+}
+
+schemes::GLWECiphertext multiply_plain_accumulate_glwe(
+    const std::vector<schemes::GLWECiphertext>& cts,
+    const std::vector<PreparedPlaintext>& plains,
     const Parameters& params
 ) {
-    // This is a placeholder - real key switching requires additional key switching keys
-    // For now, just return the original ciphertext
-    // TODO: Implement proper key switching
-    return ct;
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_accumulate_glwe");
+    if (cts.empty() || cts.size() != plains.size()) {
+        throw std::runtime_error("Ciphertext and plaintext counts differ");
+    }
+    // Mask width comes from the first non-trivial ciphertext
+    std::size_t k = 0;
+    for (const schemes::GLWECiphertext& ct : cts) {
+        if (!ct.is_trivial()) {
+            k = ct.d_tilde.size();
+            break;
+        }
+    }
+    for (const schemes::GLWECiphertext& ct : cts) {
+        if ((!ct.is_trivial() && ct.d_tilde.size() != k) || ct.b.size() != params.n) {
+            throw std::runtime_error("GLWE ciphertext size mismatch");
+        }
+    }
+
+    static const Polynomial empty;
+    schemes::GLWECiphertext result(k, params.n);
+    result.b = plain_dot_product(cts.size(), [&](std::size_t i) -> const Polynomial& { return cts[i].b; }, plains.data(), params);
+    for (std::size_t j = 0; j < k; ++j) {
+        result.d_tilde[j] = plain_dot_product(cts.size(), [&](std::size_t i) -> const Polynomial& {
+            return cts[i].is_trivial() ? empty : cts[i].d_tilde[j];
+        }, plains.data(), params);
+    }
+    set_plain_product_noise(result, cts.data(), plains.data(), cts.size(), params);
+
+    return result;
+}
+
+// ========== View overloads ==========
+
+// Mask arithmetic over raw buffers: a null input mask counts as zero, and a
+// null out is only allowed when the result has no mask either
+static void require_mask(const int64* out, bool needed) {
+    if (!out && needed) {
+        throw std::runtime_error("Output view has no mask for a non-trivial result");
+    }
+}
+
+static void combine_masks(const int64* x, const int64* y, bool subtract, std::size_t count, int64 q, int64* out) {
+    require_mask(out, x || y);
+    if (!out) return;
+    for (std::size_t i = 0; i < count; ++i) {
+        int64 xi = x ? x[i] : 0;
+        int64 yi = y ? y[i] : 0;
+        out[i] = core::modq(subtract ? xi - yi : xi + yi, q);
+    }
+}
+
+static void scale_mask(const int64* x, int64 scalar, std::size_t count, int64 q, int64* out) {
+    require_mask(out, x != nullptr);
+    if (!out) return;
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = x ? core::modq(static_cast<int64>((static_cast<int128>(x[i]) * scalar) % q), q) : 0;
+    }
+}
+
+static void copy_mask(const int64* x, std::size_t count, int64* out) {
+    require_mask(out, x != nullptr);
+    if (!out || out == x) return;
+    if (x) {
+        std::copy(x, x + count, out);
+    } else {
+        std::fill(out, out + count, 0);
+    }
+}
+
+static void check_lwe_views(schemes::ConstLWECiphertextView ct, schemes::LWECiphertextView out, const Parameters& params) {
+    if (ct.q != params.q || out.q != params.q || (!ct.is_trivial() && ct.dim != out.dim)) {
+        throw std::runtime_error("LWE ciphertext size mismatch");
+    }
+}
+
+static void check_rlwe_views(schemes::ConstRLWECiphertextView ct, schemes::RLWECiphertextView out, const Parameters& params) {
+    if (ct.b.n != params.n || out.b.n != params.n || ct.q() != params.q || out.q() != params.q ||
+        (!ct.is_trivial() && ct.a.n != params.n) || (!out.is_trivial() && out.a.n != params.n)) {
+        throw std::runtime_error("RLWE ciphertext size mismatch");
+    }
+}
+
+static void check_glwe_views(schemes::ConstGLWECiphertextView ct, schemes::GLWECiphertextView out, const Parameters& params) {
+    if (ct.n != params.n || out.n != params.n || ct.q != params.q || out.q != params.q ||
+        (!ct.is_trivial() && !out.is_trivial() && ct.k != out.k)) {
+        throw std::runtime_error("GLWE ciphertext size mismatch");
+    }
+}
+
+void add_lwe(
+    schemes::ConstLWECiphertextView ct1,
+    schemes::ConstLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_lwe");
+    check_lwe_views(ct1, out, params);
+    check_lwe_views(ct2, out, params);
+
+    combine_masks(ct1.a, ct2.a, false, out.dim, params.q, out.a);
+    *out.b = core::modq(*ct1.b + *ct2.b, params.q);
+}
+
+void subtract_lwe(
+    schemes::ConstLWECiphertextView ct1,
+    schemes::ConstLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::subtract_lwe");
+    check_lwe_views(ct1, out, params);
+    check_lwe_views(ct2, out, params);
+
+    combine_masks(ct1.a, ct2.a, true, out.dim, params.q, out.a);
+    *out.b = core::modq(*ct1.b - *ct2.b, params.q);
+}
+
+void scalar_multiply_lwe(
+    schemes::ConstLWECiphertextView ct,
+    int64 scalar,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::scalar_multiply_lwe");
+    check_lwe_views(ct, out, params);
+
+    scale_mask(ct.a, scalar, out.dim, params.q, out.a);
+    *out.b = core::modq(static_cast<int64>((static_cast<int128>(*ct.b) * scalar) % params.q), params.q);
+}
+
+void add_plain_lwe(
+    schemes::ConstLWECiphertextView ct,
+    int64 message,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_plain_lwe");
+    check_lwe_views(ct, out, params);
+
+    copy_mask(ct.a, out.dim, out.a);
+    int64 delta = params.q / params.t;
+    int128 scaled = static_cast<int128>(delta) * core::modq(message, params.t);
+    *out.b = core::modq(static_cast<int64>((static_cast<int128>(*ct.b) + scaled) % params.q), params.q);
+}
+
+void sub_plain_lwe(
+    schemes::ConstLWECiphertextView ct,
+    int64 message,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::sub_plain_lwe");
+    add_plain_lwe(ct, params.t - core::modq(message, params.t), params, out);
+}
+
+void add_rlwe(
+    schemes::ConstRLWECiphertextView ct1,
+    schemes::ConstRLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_rlwe");
+    check_rlwe_views(ct1, out, params);
+    check_rlwe_views(ct2, out, params);
+
+    combine_masks(ct1.a.data, ct2.a.data, false, params.n, params.q, out.a.data);
+    polynomial::add(ct1.b, ct2.b, out.b);
+}
+
+void subtract_rlwe(
+    schemes::ConstRLWECiphertextView ct1,
+    schemes::ConstRLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::subtract_rlwe");
+    check_rlwe_views(ct1, out, params);
+    check_rlwe_views(ct2, out, params);
+
+    combine_masks(ct1.a.data, ct2.a.data, true, params.n, params.q, out.a.data);
+    polynomial::subtract(ct1.b, ct2.b, out.b);
+}
+
+void scalar_multiply_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    int64 scalar,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::scalar_multiply_rlwe");
+    check_rlwe_views(ct, out, params);
+
+    scale_mask(ct.a.data, scalar, params.n, params.q, out.a.data);
+    polynomial::scalar_multiply(ct.b, scalar, out.b);
+}
+
+void add_plain_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_plain_rlwe");
+    check_rlwe_views(ct, out, params);
+
+    copy_mask(ct.a.data, params.n, out.a.data);
+    shift_body(ct.b, message, false, params, out.b);
+}
+
+void sub_plain_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::sub_plain_rlwe");
+    check_rlwe_views(ct, out, params);
+
+    copy_mask(ct.a.data, params.n, out.a.data);
+    shift_body(ct.b, message, true, params, out.b);
+}
+
+void multiply_plain_rlwe(
+    schemes::ConstRLWECiphertextView ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params,
+    schemes::RLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_rlwe");
+    check_rlwe_views(ct, out, params);
+    require_mask(out.a.data, !ct.is_trivial());
+
+    if (!out.is_trivial()) {
+        plain_dot_product(1, [&](std::size_t) { return ct.a; }, &plain, params, out.a);
+    }
+    plain_dot_product(1, [&](std::size_t) { return ct.b; }, &plain, params, out.b);
+}
+
+void add_glwe(
+    schemes::ConstGLWECiphertextView ct1,
+    schemes::ConstGLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_glwe");
+    check_glwe_views(ct1, out, params);
+    check_glwe_views(ct2, out, params);
+
+    combine_masks(ct1.mask, ct2.mask, false, out.k * params.n, params.q, out.mask);
+    polynomial::add(ct1.b(), ct2.b(), out.b());
+}
+
+void subtract_glwe(
+    schemes::ConstGLWECiphertextView ct1,
+    schemes::ConstGLWECiphertextView ct2,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::subtract_glwe");
+    check_glwe_views(ct1, out, params);
+    check_glwe_views(ct2, out, params);
+
+    combine_masks(ct1.mask, ct2.mask, true, out.k * params.n, params.q, out.mask);
+    polynomial::subtract(ct1.b(), ct2.b(), out.b());
+}
+
+void scalar_multiply_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    int64 scalar,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::scalar_multiply_glwe");
+    check_glwe_views(ct, out, params);
+
+    scale_mask(ct.mask, scalar, out.k * params.n, params.q, out.mask);
+    polynomial::scalar_multiply(ct.b(), scalar, out.b());
+}
+
+void add_plain_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_plain_glwe");
+    check_glwe_views(ct, out, params);
+
+    copy_mask(ct.mask, out.k * params.n, out.mask);
+    shift_body(ct.b(), message, false, params, out.b());
+}
+
+void sub_plain_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    polynomial::ConstPolynomialView message,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::sub_plain_glwe");
+    check_glwe_views(ct, out, params);
+
+    copy_mask(ct.mask, out.k * params.n, out.mask);
+    shift_body(ct.b(), message, true, params, out.b());
+}
+
+void multiply_plain_glwe(
+    schemes::ConstGLWECiphertextView ct,
+    const PreparedPlaintext& plain,
+    const Parameters& params,
+    schemes::GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_plain_glwe");
+    check_glwe_views(ct, out, params);
+    require_mask(out.mask, !ct.is_trivial());
+
+    for (std::size_t j = 0; j < out.k && !out.is_trivial(); ++j) {
+        plain_dot_product(1, [&](std::size_t) {
+            return ct.is_trivial() ? polynomial::ConstPolynomialView() : ct.d_tilde(j);
+        }, &plain, params, out.d_tilde(j));
+    }
+    plain_dot_product(1, [&](std::size_t) { return ct.b(); }, &plain, params, out.b());
 }
 
 std::vector<int64> decompose(int64 value, int64 base, int levels) {
@@ -207,4 +991,4 @@ std::vector<int64> decompose(int64 value, int64 base, int levels) {
 }
 
 }
-}
\ No newline at end of file
+}
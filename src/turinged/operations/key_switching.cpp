@@ -0,0 +1,213 @@
+#include "turinged/operations/key_switching.hpp"
+#include "turinged/polynomial/polynomial.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+// Noise of ct plus the error of a key switch with the given moments
+template <typename Ciphertext>
+static void set_switched_noise(Ciphertext& result, const Ciphertext& ct, double variance, double coherent) {
+    result.noise_variance = noise::sum_variance(ct.noise_variance, ct.coherent_variance, variance, coherent);
+    result.coherent_variance = noise::sum_coherent_variance(ct.coherent_variance, coherent);
+}
+
+std::vector<Polynomial> gadget_decompose(const Polynomial& a, int64 beta, int levels) {
+    std::size_t n = a.size();
+    std::vector<Polynomial> digits(levels, Polynomial(n));
+
+    for (std::size_t i = 0; i < n; ++i) {
+        int64 value = a[i];
+        for (int j = 0; j < levels; ++j) {
+            digits[j][i] = value % beta;
+            value /= beta;
+        }
+    }
+
+    return digits;
+}
+
+schemes::RLWECiphertext key_switch_component(
+    const Polynomial& c,
+    const keys::RLWEKeySwitchKey& ksk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::key_switch_component");
+    std::size_t n = params.n;
+    if (c.size() != n || ksk.a.size() != static_cast<std::size_t>(ksk.levels)) {
+        throw std::runtime_error("Key switching key does not match ciphertext");
+    }
+
+    std::vector<Polynomial> digits = gadget_decompose(c, ksk.beta, ksk.levels);
+
+    // Accumulate sum_j digit_j * (a_j, b_j) in the NTT domain, one inverse per component
+    polynomial::NTTPolynomial acc_a(n), acc_b(n);
+    for (int j = 0; j < ksk.levels; ++j) {
+        polynomial::NTTPolynomial digit = polynomial::to_ntt(digits[j], params.q);
+        polynomial::ntt_multiply_accumulate(acc_a, digit, ksk.a[j]);
+        polynomial::ntt_multiply_accumulate(acc_b, digit, ksk.b[j]);
+    }
+
+    schemes::RLWECiphertext result;
+    result.a = polynomial::from_ntt(acc_a, params.q);
+    result.b = polynomial::from_ntt(acc_b, params.q);
+    result.noise_variance = noise::key_switch_variance(params, ksk.beta, ksk.levels, n);
+    result.coherent_variance = noise::key_switch_coherent_variance(params, ksk.beta, ksk.levels, n);
+
+    return result;
+}
+
+schemes::RLWECiphertext key_switch_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const keys::RLWEKeySwitchKey& ksk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::key_switch_rlwe");
+    if (ct.is_trivial()) {
+        return ct;
+    }
+
+    // Phase b - a*s' : switch the -a component, keep b
+    schemes::RLWECiphertext switched = key_switch_component(polynomial::negate(ct.a, params.q), ksk, params);
+
+    schemes::RLWECiphertext result;
+    result.a = switched.a;
+    result.b = polynomial::add(ct.b, switched.b, params.q);
+    set_switched_noise(result, ct, switched.noise_variance, switched.coherent_variance);
+
+    return result;
+}
+
+void key_switch_lwe(
+    schemes::ConstLWECiphertextView ct,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& params,
+    schemes::LWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("operations::key_switch_lwe");
+    if ((!ct.is_trivial() && ct.dim != ksk.n_in) || out.is_trivial() || out.dim != ksk.n_out) {
+        throw std::runtime_error("Key switching key does not match ciphertext");
+    }
+    if (ct.is_trivial()) {
+        std::fill(out.a, out.a + out.dim, 0);
+        *out.b = *ct.b;
+        return;
+    }
+
+    uint64 q = static_cast<uint64>(params.q);
+    std::size_t words = ksk.entry_words();
+
+    // Digit products are below beta * q: accumulate lazily and reduce only
+    // when another term could overflow 64 bits
+    uint64 term_bound = static_cast<uint64>(ksk.beta - 1) * (q - 1);
+    uint64 flush_every = term_bound == 0 ? 1 : (~0ULL - q) / term_bound;
+    if (flush_every == 0) {
+        throw std::runtime_error("Key switching base too large for the modulus");
+    }
+
+    std::vector<uint64> acc(words, 0);
+    uint64 pending = 0;
+
+    // Phase b - <a, s'> : switch every -a_i, keep b
+    for (std::size_t i = 0; i < ksk.n_in; ++i) {
+        uint64 value = static_cast<uint64>(core::modq(-ct.a[i], params.q));
+        for (int j = 0; j < ksk.levels && value != 0; ++j) {
+            uint64 digit = value % static_cast<uint64>(ksk.beta);
+            value /= static_cast<uint64>(ksk.beta);
+            if (digit == 0) continue;
+
+            if (pending == flush_every) {
+                for (uint64& v : acc) v %= q;
+                pending = 0;
+            }
+            const int64* entry = ksk.entry(i, j);
+            for (std::size_t c = 0; c < words; ++c) {
+                acc[c] += digit * static_cast<uint64>(entry[c]);
+            }
+            ++pending;
+        }
+    }
+
+    for (std::size_t c = 0; c < ksk.n_out; ++c) {
+        out.a[c] = static_cast<int64>(acc[c] % q);
+    }
+    *out.b = core::modq(*ct.b + static_cast<int64>(acc[ksk.n_out] % q), params.q);
+}
+
+schemes::LWECiphertext key_switch_lwe(
+    const schemes::LWECiphertext& ct,
+    const keys::LWEKeySwitchKeyView& ksk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::key_switch_lwe");
+    if (ct.is_trivial()) {
+        return ct;
+    }
+
+    schemes::LWECiphertext result(ksk.n_out);
+    key_switch_lwe(schemes::view(ct, params.q), ksk, params, schemes::view(result, params.q));
+    set_switched_noise(result, ct, noise::key_switch_variance(params, ksk.beta, ksk.levels, ksk.n_in),
+                       noise::key_switch_coherent_variance(params, ksk.beta, ksk.levels, ksk.n_in));
+    return result;
+}
+
+schemes::LWECiphertext key_switch_lwe(
+    const schemes::LWECiphertext& ct,
+    const keys::LWEKeySwitchKey& ksk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::key_switch_lwe");
+    return key_switch_lwe(ct, ksk.view(), params);
+}
+
+schemes::GLWECiphertext key_switch_glwe(
+    const schemes::GLWECiphertext& ct,
+    const keys::GLWEKeySwitchKey& ksk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::key_switch_glwe");
+    if (ct.is_trivial()) {
+        return ct;
+    }
+
+    std::size_t n = params.n;
+    std::size_t k_in = ct.d_tilde.size();
+    if (ksk.body.size() != k_in * static_cast<std::size_t>(ksk.levels) || ksk.mask.empty()) {
+        throw std::runtime_error("Key switching key does not match ciphertext");
+    }
+    std::size_t k_out = ksk.mask[0].size();
+
+    std::vector<polynomial::NTTPolynomial> acc_mask(k_out, polynomial::NTTPolynomial(n));
+    polynomial::NTTPolynomial acc_body(n);
+
+    // Phase b - sum_i d_i * s'_i : switch every -d_i component, keep b
+    for (std::size_t i = 0; i < k_in; ++i) {
+        std::vector<Polynomial> digits = gadget_decompose(polynomial::negate(ct.d_tilde[i], params.q), ksk.beta, ksk.levels);
+        for (int j = 0; j < ksk.levels; ++j) {
+            std::size_t row = i * ksk.levels + j;
+            polynomial::NTTPolynomial digit = polynomial::to_ntt(digits[j], params.q);
+            for (std::size_t o = 0; o < k_out; ++o) {
+                polynomial::ntt_multiply_accumulate(acc_mask[o], digit, ksk.mask[row][o]);
+            }
+            polynomial::ntt_multiply_accumulate(acc_body, digit, ksk.body[row]);
+        }
+    }
+
+    schemes::GLWECiphertext result(k_out, n);
+    for (std::size_t o = 0; o < k_out; ++o) {
+        result.d_tilde[o] = polynomial::from_ntt(acc_mask[o], params.q);
+    }
+    result.b = polynomial::add(ct.b, polynomial::from_ntt(acc_body, params.q), params.q);
+    set_switched_noise(result, ct, noise::key_switch_variance(params, ksk.beta, ksk.levels, k_in * n),
+                       noise::key_switch_coherent_variance(params, ksk.beta, ksk.levels, k_in * n));
+
+    return result;
+}
+
+}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "turinged/operations/modulus_switching.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/core/parallel.hpp"
+#include "turinged/noise/noise.hpp"
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+static void check_target_modulus(int64 q_new) {
+    if (q_new <= 1) {
+        throw std::runtime_error("Target modulus must be greater than 1");
+    }
+}
+
+// Switches mask and body in place; the variances are rescaled from the input's
+static void switch_lwe_inplace(schemes::LWECiphertext& ct, int64 q, int64 q_new) {
+    core::switch_modulus_inplace(ct.a.data(), ct.a.size(), q, q_new);
+    ct.b = core::switch_modulus(ct.b, q, q_new);
+    ct.noise_variance = noise::modulus_switch_variance(ct.noise_variance, q, q_new, ct.a.size());
+    ct.coherent_variance = noise::modulus_switch_coherent_variance(ct.coherent_variance, q, q_new, ct.a.size());
+}
+
+schemes::LWECiphertext modulus_switch_lwe(
+    const schemes::LWECiphertext& ct,
+    const Parameters& params,
+    int64 q_new
+) {
+    TURINGED_OPERATION_SCOPE("operations::modulus_switch_lwe");
+    check_target_modulus(q_new);
+
+    schemes::LWECiphertext result = ct;
+    switch_lwe_inplace(result, params.q, q_new);
+    return result;
+}
+
+schemes::RLWECiphertext modulus_switch_rlwe(
+    const schemes::RLWECiphertext& ct,
+    const Parameters& params,
+    int64 q_new
+) {
+    TURINGED_OPERATION_SCOPE("operations::modulus_switch_rlwe");
+    check_target_modulus(q_new);
+
+    schemes::RLWECiphertext result = ct;
+    core::switch_modulus_inplace(result.a.data(), result.a.size(), params.q, q_new);
+    core::switch_modulus_inplace(result.b.data(), result.b.size(), params.q, q_new);
+    result.noise_variance = noise::modulus_switch_variance(ct.noise_variance, params.q, q_new, ct.a.size());
+    result.coherent_variance = noise::modulus_switch_coherent_variance(ct.coherent_variance, params.q, q_new, ct.a.size());
+
+    return result;
+}
+
+schemes::GLWECiphertext modulus_switch_glwe(
+    const schemes::GLWECiphertext& ct,
+    const Parameters& params,
+    int64 q_new
+) {
+    TURINGED_OPERATION_SCOPE("operations::modulus_switch_glwe");
+    check_target_modulus(q_new);
+
+    schemes::GLWECiphertext result = ct;
+    core::switch_modulus_inplace(result.b.data(), result.b.size(), params.q, q_new);
+    for (Polynomial& d : result.d_tilde) {
+        core::switch_modulus_inplace(d.data(), d.size(), params.q, q_new);
+    }
+    result.noise_variance = noise::modulus_switch_variance(ct.noise_variance, params.q, q_new, ct.d_tilde.size() * params.n);
+    result.coherent_variance = noise::modulus_switch_coherent_variance(ct.coherent_variance, params.q, q_new, ct.d_tilde.size() * params.n);
+
+    return result;
+}
+
+std::vector<schemes::LWECiphertext> modulus_switch_lwe_batch(
+    const std::vector<schemes::LWECiphertext>& cts,
+    const Parameters& params,
+    int64 q_new,
+    std::size_t num_threads
+) {
+    TURINGED_OPERATION_SCOPE("operations::modulus_switch_lwe_batch");
+    check_target_modulus(q_new);
+
+    std::vector<schemes::LWECiphertext> result(cts);
+    core::parallel_for(result.size(), [&](std::size_t i) {
+        switch_lwe_inplace(result[i], params.q, q_new);
+    }, num_threads);
+
+    return result;
+}
+
+Parameters switched_parameters(const Parameters& params, int64 q_new) {
+    return Parameters(params.n, q_new, params.t, params.noise_bound);
+}
+
+}
+}
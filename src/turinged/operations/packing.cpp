@@ -0,0 +1,255 @@
+#include "turinged/operations/packing.hpp"
+#include "turinged/operations/automorphism.hpp"
+#include "turinged/operations/homomorphic.hpp"
+#include "turinged/polynomial/polynomial.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/parallel.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+std::vector<uint64> packing_galois_elements(std::size_t n) {
+    std::vector<uint64> elts;
+    for (std::size_t j = 1; (std::size_t(1) << j) <= n; ++j) {
+        elts.push_back((uint64(1) << j) + 1);
+    }
+    return elts;
+}
+
+// Maps <a, s> onto the constant coefficient of a(X) * s(X): a'_0 = a_0, a'_{n-i} = -a_i
+static Polynomial lwe_mask_to_polynomial(const Polynomial& a, std::size_t offset, std::size_t n, int64 q) {
+    Polynomial poly(n);
+    poly[0] = a[offset];
+    for (std::size_t i = 1; i < n; ++i) {
+        poly[n - i] = core::modq(-a[offset + i], q);
+    }
+    return poly;
+}
+
+schemes::RLWECiphertext lwe_to_rlwe(
+    const schemes::LWECiphertext& ct,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::lwe_to_rlwe");
+    std::size_t n = params.n;
+    if (ct.a.size() != n) {
+        throw std::runtime_error("LWE dimension must equal the ring degree");
+    }
+
+    schemes::RLWECiphertext result(n);
+    result.a = lwe_mask_to_polynomial(ct.a, 0, n, params.q);
+    std::fill(result.b.begin(), result.b.end(), 0);
+    result.b[0] = ct.b;
+    result.noise_variance = ct.noise_variance;
+    result.coherent_variance = ct.coherent_variance;
+
+    return result;
+}
+
+schemes::GLWECiphertext lwe_to_glwe(
+    const schemes::LWECiphertext& ct,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::lwe_to_glwe");
+    std::size_t n = params.n;
+    if (ct.a.size() == 0 || ct.a.size() % n != 0) {
+        throw std::runtime_error("LWE dimension must be a multiple of the ring degree");
+    }
+
+    std::size_t k = ct.a.size() / n;
+    schemes::GLWECiphertext result(k, n);
+    for (std::size_t i = 0; i < k; ++i) {
+        result.d_tilde[i] = lwe_mask_to_polynomial(ct.a, i * n, n, params.q);
+    }
+    std::fill(result.b.begin(), result.b.end(), 0);
+    result.b[0] = ct.b;
+    result.noise_variance = ct.noise_variance;
+    result.coherent_variance = ct.coherent_variance;
+
+    return result;
+}
+
+// Per-type building blocks for the shared packing tree
+static schemes::RLWECiphertext monomial_multiply(const schemes::RLWECiphertext& ct, std::size_t r, int64 q) {
+    schemes::RLWECiphertext result;
+    result.a = polynomial::multiply_monomial(ct.a, r, q);
+    result.b = polynomial::multiply_monomial(ct.b, r, q);
+    return result;
+}
+
+static schemes::GLWECiphertext monomial_multiply(const schemes::GLWECiphertext& ct, std::size_t r, int64 q) {
+    schemes::GLWECiphertext result;
+    result.b = polynomial::multiply_monomial(ct.b, r, q);
+    for (const Polynomial& d : ct.d_tilde) {
+        result.d_tilde.push_back(polynomial::multiply_monomial(d, r, q));
+    }
+    return result;
+}
+
+static schemes::RLWECiphertext add_ct(const schemes::RLWECiphertext& x, const schemes::RLWECiphertext& y, const Parameters& params) {
+    return add_rlwe(x, y, params);
+}
+
+static schemes::GLWECiphertext add_ct(const schemes::GLWECiphertext& x, const schemes::GLWECiphertext& y, const Parameters& params) {
+    return add_glwe(x, y, params);
+}
+
+static schemes::RLWECiphertext sub_ct(const schemes::RLWECiphertext& x, const schemes::RLWECiphertext& y, const Parameters& params) {
+    return subtract_rlwe(x, y, params);
+}
+
+static schemes::GLWECiphertext sub_ct(const schemes::GLWECiphertext& x, const schemes::GLWECiphertext& y, const Parameters& params) {
+    return subtract_glwe(x, y, params);
+}
+
+static schemes::RLWECiphertext galois_ct(const schemes::RLWECiphertext& ct, uint64 g, const keys::RLWEGaloisKeys& gk, const Parameters& params) {
+    return apply_galois_rlwe(ct, g, gk, params);
+}
+
+static schemes::GLWECiphertext galois_ct(const schemes::GLWECiphertext& ct, uint64 g, const keys::GLWEGaloisKeys& gk, const Parameters& params) {
+    return apply_galois_glwe(ct, g, gk, params);
+}
+
+static schemes::RLWECiphertext zero_like(const schemes::RLWECiphertext& ct) {
+    return schemes::RLWECiphertext(ct.b.size());
+}
+
+static schemes::GLWECiphertext zero_like(const schemes::GLWECiphertext& ct) {
+    return schemes::GLWECiphertext(ct.d_tilde.size(), ct.b.size());
+}
+
+static std::size_t key_terms(const schemes::RLWECiphertext& ct) {
+    return ct.b.size();
+}
+
+static std::size_t key_terms(const schemes::GLWECiphertext& ct) {
+    return ct.d_tilde.size() * ct.b.size();
+}
+
+// Chen-Dai-Kim-Song packing: merge pairs level by level, then trace away the
+// coefficients that do not belong to a packed slot
+template <typename Ciphertext, typename GaloisKeys, typename Convert>
+static Ciphertext pack_tree(
+    const std::vector<schemes::LWECiphertext>& cts,
+    const GaloisKeys& gk,
+    const Parameters& params,
+    std::size_t num_threads,
+    Convert convert
+) {
+    std::size_t n = params.n;
+    if (cts.empty() || cts.size() > n) {
+        throw std::runtime_error("Can pack between 1 and n LWE ciphertexts");
+    }
+    if (params.q % 2 == 0) {
+        throw std::runtime_error("Ring packing requires an odd modulus q");
+    }
+
+    int log_m = 0;
+    while ((std::size_t(1) << log_m) < cts.size()) log_m++;
+    std::size_t m = std::size_t(1) << log_m;
+
+    int log_n = 0;
+    while ((std::size_t(1) << log_n) < n) log_n++;
+
+    // The tree and trace multiply every phase by n; pre-scale by n^-1 mod q
+    int64 n_inv = core::inverse_mod(static_cast<int64>(n), params.q);
+
+    // Leaves in bit-reversed order so that each level merges adjacent pairs
+    std::vector<Ciphertext> level(m);
+    core::parallel_for(m, [&](std::size_t r) {
+        std::size_t j = 0;
+        for (int bit = 0; bit < log_m; ++bit) {
+            if (r & (std::size_t(1) << bit)) j |= std::size_t(1) << (log_m - 1 - bit);
+        }
+        if (j < cts.size()) {
+            schemes::LWECiphertext scaled(cts[j].a.size());
+            for (std::size_t i = 0; i < scaled.a.size(); ++i) {
+                scaled.a[i] = static_cast<int64>((static_cast<int128>(cts[j].a[i]) * n_inv) % params.q);
+            }
+            scaled.b = static_cast<int64>((static_cast<int128>(cts[j].b) * n_inv) % params.q);
+            level[r] = convert(scaled);
+        }
+    }, num_threads);
+
+    // Pad missing leaves with zero ciphertexts of the right shape
+    for (std::size_t r = 0; r < m; ++r) {
+        if (level[r].b.empty()) level[r] = zero_like(convert(cts[0]));
+    }
+
+    // Level h: ct = (even + X^(n/2^h) odd) + sigma_(2^h+1)(even - X^(n/2^h) odd)
+    for (int h = 1; h <= log_m; ++h) {
+        std::size_t shift = n >> h;
+        uint64 g = (uint64(1) << h) + 1;
+        std::vector<Ciphertext> next(level.size() / 2);
+
+        core::parallel_for(next.size(), [&](std::size_t i) {
+            Ciphertext shifted = monomial_multiply(level[2 * i + 1], shift, params.q);
+            Ciphertext sum = add_ct(level[2 * i], shifted, params);
+            Ciphertext diff = sub_ct(level[2 * i], shifted, params);
+            next[i] = add_ct(sum, galois_ct(diff, g, gk, params), params);
+        }, num_threads);
+
+        level.swap(next);
+    }
+
+    // Field trace over the remaining automorphisms zeroes the garbage coefficients
+    Ciphertext result = level[0];
+    for (int j = log_m + 1; j <= log_n; ++j) {
+        uint64 g = (uint64(1) << j) + 1;
+        result = add_ct(result, galois_ct(result, g, gk, params), params);
+    }
+
+    // The leaves were scaled by n^-1, so the propagated estimate is meaningless.
+    // Each slot keeps its LWE noise. Key-switching noise is spread over all
+    // coefficients, so every later step roughly doubles its variance; tree
+    // level h runs m / 2^h key switches, each trace step one.
+    double variance = 0.0;
+    double coherent = 0.0;
+    for (const schemes::LWECiphertext& ct : cts) {
+        if (std::isnan(ct.noise_variance) || ct.noise_variance > variance) variance = ct.noise_variance;
+        if (std::isnan(ct.coherent_variance) || ct.coherent_variance > coherent) coherent = ct.coherent_variance;
+    }
+    if (!gk.keys.empty()) {
+        const auto& key = gk.keys.begin()->second;
+        double switch_variance = noise::key_switch_variance(params, key.beta, key.levels, key_terms(result));
+        double switch_coherent = noise::key_switch_coherent_variance(params, key.beta, key.levels, key_terms(result));
+        for (int step = 1; step <= log_n; ++step) {
+            double switches = step <= log_m ? static_cast<double>(m >> step) : 1.0;
+            variance += switches * std::ldexp(switch_variance, log_n - step);
+            coherent += switches * std::ldexp(switch_coherent, log_n - step);
+        }
+    }
+    result.noise_variance = variance;
+    result.coherent_variance = coherent;
+
+    return result;
+}
+
+schemes::RLWECiphertext pack_lwe_rlwe(
+    const std::vector<schemes::LWECiphertext>& cts,
+    const keys::RLWEGaloisKeys& gk,
+    const Parameters& params,
+    std::size_t num_threads
+) {
+    TURINGED_OPERATION_SCOPE("operations::pack_lwe_rlwe");
+    return pack_tree<schemes::RLWECiphertext>(cts, gk, params, num_threads,
+        [&](const schemes::LWECiphertext& ct) { return lwe_to_rlwe(ct, params); });
+}
+
+schemes::GLWECiphertext pack_lwe_glwe(
+    const std::vector<schemes::LWECiphertext>& cts,
+    const keys::GLWEGaloisKeys& gk,
+    const Parameters& params,
+    std::size_t num_threads
+) {
+    TURINGED_OPERATION_SCOPE("operations::pack_lwe_glwe");
+    return pack_tree<schemes::GLWECiphertext>(cts, gk, params, num_threads,
+        [&](const schemes::LWECiphertext& ct) { return lwe_to_glwe(ct, params); });
+}
+
+}
+}
@@ -0,0 +1,363 @@
+#include "turinged/operations/rns_homomorphic.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace operations {
+
+// Lift a coefficient-form polynomial over Q_l to Q_l*P (exact, centered) and transform
+static rns::RNSPolynomial extend_to_qp(const rns::RNSPolynomial& x, const rns::RNSLevel& level) {
+    rns::RNSPolynomial in_p = rns::convert_base(x, level.q_to_p);
+
+    rns::RNSPolynomial result;
+    result.residues = x.residues;
+    result.residues.insert(result.residues.end(), in_p.residues.begin(), in_p.residues.end());
+    result.ntt_form = false;
+
+    rns::to_ntt_inplace(result, level.qp_base);
+    return result;
+}
+
+// round(t * x / Q_l) for x over Q_l*P (coefficient form), returned over Q_l
+static rns::RNSPolynomial scale_down(const rns::RNSPolynomial& x, const rns::RNSLevel& level, const rns::RNSBase& p_base) {
+    const rns::RNSBase& q_base = level.q_base;
+    std::size_t k = q_base.size();
+    std::size_t n = x.degree();
+
+    rns::RNSPolynomial in_p(p_base.size(), n);
+    std::vector<uint64> y(k);
+
+    for (std::size_t c = 0; c < n; ++c) {
+        // t*x/Q = sum_i y_i * (I_i + F_i) + (terms that vanish mod p_j except x_j * t/Q)
+        long double frac = 0.0L;
+        for (std::size_t i = 0; i < k; ++i) {
+            y[i] = core::mul_mod(x.residues[i][c], level.scale_y_factor[i], q_base.primes[i]);
+            frac += static_cast<long double>(y[i]) * level.scale_fraction[i];
+        }
+        uint64 rounded = static_cast<uint64>(std::llround(frac));
+
+        for (std::size_t j = 0; j < p_base.size(); ++j) {
+            uint64 p = p_base.primes[j];
+            uint128 acc = rounded % p;
+            for (std::size_t i = 0; i < k; ++i) {
+                acc += static_cast<uint128>(y[i]) * level.scale_integer[i][j];
+            }
+            acc += static_cast<uint128>(x.residues[k + j][c]) * level.scale_t_q_inv[j];
+            in_p.residues[j][c] = static_cast<uint64>(acc % p);
+        }
+    }
+
+    return rns::convert_base(in_p, level.p_to_q);
+}
+
+schemes::RNSGLWECiphertext key_switch_component_rns(
+    const rns::RNSPolynomial& x,
+    const keys::RNSKeySwitchKey& ksk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::key_switch_component_rns");
+    const rns::RNSBase& base = params.q_base(rns::level_of(x));
+    std::size_t n = x.degree();
+    if (x.ntt_form || ksk.body.size() < base.size()) {
+        throw std::runtime_error("RNS key switching key does not match input");
+    }
+    std::size_t k_out = ksk.mask[0].size();
+
+    rns::RNSPolynomial acc_body(base.size(), n);
+    acc_body.ntt_form = true;
+    std::vector<rns::RNSPolynomial> acc_mask(k_out, acc_body);
+
+    // Digit i is the centered residue [x]_{q_i}, spread to every prime. Key
+    // samples for primes above the current level are not needed.
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        uint64 q_i = base.primes[i];
+        Polynomial centered(n);
+        for (std::size_t c = 0; c < n; ++c) {
+            uint64 v = x.residues[i][c];
+            centered[c] = v > q_i / 2 ? -static_cast<int64>(q_i - v) : static_cast<int64>(v);
+        }
+
+        rns::RNSPolynomial digit = rns::to_rns(centered, base);
+        rns::to_ntt_inplace(digit, base);
+
+        rns::multiply_accumulate_ntt(acc_body, digit, ksk.body[i], base);
+        for (std::size_t o = 0; o < k_out; ++o) {
+            rns::multiply_accumulate_ntt(acc_mask[o], digit, ksk.mask[i][o], base);
+        }
+    }
+
+    schemes::RNSGLWECiphertext result;
+    rns::from_ntt_inplace(acc_body, base);
+    result.b = acc_body;
+    for (rns::RNSPolynomial& m : acc_mask) {
+        rns::from_ntt_inplace(m, base);
+        result.d_tilde.push_back(m);
+    }
+
+    return result;
+}
+
+// Tensor, scale and relinearise ciphertexts given as phase components
+// (c_0 = b, c_{1+i} = -d_tilde[i]), all at the same level; returns (b, d_tilde)
+// of the product at that level
+static schemes::RNSGLWECiphertext multiply_components(
+    const std::vector<rns::RNSPolynomial>& x,
+    const std::vector<rns::RNSPolynomial>& y,
+    const keys::RNSRelinKey& rlk,
+    const rns::RNSParameters& params
+) {
+    if (params.t == 0) {
+        throw std::runtime_error("BFV multiplication requires parameters with a plaintext modulus");
+    }
+
+    std::size_t k = x.size() - 1;
+    if (y.size() != x.size() || rlk.keys.size() != k * (k + 1) / 2) {
+        throw std::runtime_error("Relinearisation key does not match ciphertexts");
+    }
+
+    std::size_t l = rns::level_of(x[0]);
+    if (l == 0) {
+        throw std::runtime_error("Multiplication needs at least two primes left in the modulus chain");
+    }
+    const rns::RNSLevel& level = params.level(l);
+    const rns::RNSBase& q_base = level.q_base;
+    const rns::RNSBase& qp_base = level.qp_base;
+
+    std::vector<rns::RNSPolynomial> ex, ey;
+    for (std::size_t i = 0; i <= k; ++i) {
+        ex.push_back(extend_to_qp(x[i], level));
+        ey.push_back(extend_to_qp(y[i], level));
+    }
+
+    auto finish = [&](rns::RNSPolynomial d) {
+        rns::from_ntt_inplace(d, qp_base);
+        return scale_down(d, level, params.p_base);
+    };
+
+    // Constant and linear terms: D_0 = c_0 c'_0, D_i = c_0 c'_i + c_i c'_0
+    std::vector<rns::RNSPolynomial> linear;
+    linear.push_back(finish(rns::multiply_ntt(ex[0], ey[0], qp_base)));
+    for (std::size_t i = 1; i <= k; ++i) {
+        rns::RNSPolynomial d = rns::multiply_ntt(ex[0], ey[i], qp_base);
+        rns::multiply_accumulate_ntt(d, ex[i], ey[0], qp_base);
+        linear.push_back(finish(d));
+    }
+
+    // Quadratic terms D_ij (i <= j) multiply s_i * s_j and are switched back to s
+    rns::RNSPolynomial body = linear[0];
+    std::vector<rns::RNSPolynomial> mask(k);
+    for (std::size_t i = 0; i < k; ++i) {
+        mask[i] = rns::negate(linear[1 + i], q_base);
+    }
+
+    std::size_t pair = 0;
+    for (std::size_t i = 1; i <= k; ++i) {
+        for (std::size_t j = i; j <= k; ++j, ++pair) {
+            rns::RNSPolynomial d = rns::multiply_ntt(ex[i], ey[j], qp_base);
+            if (i != j) rns::multiply_accumulate_ntt(d, ex[j], ey[i], qp_base);
+
+            schemes::RNSGLWECiphertext switched = key_switch_component_rns(finish(d), rlk.keys[pair], params);
+            body = rns::add(body, switched.b, q_base);
+            for (std::size_t o = 0; o < k; ++o) {
+                mask[o] = rns::add(mask[o], switched.d_tilde[o], q_base);
+            }
+        }
+    }
+
+    schemes::RNSGLWECiphertext result;
+    result.b = body;
+    result.d_tilde = mask;
+    return result;
+}
+
+schemes::RNSRLWECiphertext drop_level_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::drop_level_rlwe_rns");
+    schemes::RNSRLWECiphertext result;
+    result.a = rns::rescale_by_last_prime(ct.a, params);
+    result.b = rns::rescale_by_last_prime(ct.b, params);
+    return result;
+}
+
+schemes::RNSRLWECiphertext mod_switch_to_level_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct,
+    std::size_t level,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::mod_switch_to_level_rlwe_rns");
+    if (level > ct.level()) {
+        throw std::runtime_error("Cannot switch a ciphertext up the modulus chain");
+    }
+
+    schemes::RNSRLWECiphertext result = ct;
+    while (result.level() > level) {
+        result = drop_level_rlwe_rns(result, params);
+    }
+    return result;
+}
+
+schemes::RNSGLWECiphertext drop_level_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::drop_level_glwe_rns");
+    schemes::RNSGLWECiphertext result;
+    result.b = rns::rescale_by_last_prime(ct.b, params);
+    for (const rns::RNSPolynomial& d : ct.d_tilde) {
+        result.d_tilde.push_back(rns::rescale_by_last_prime(d, params));
+    }
+    return result;
+}
+
+schemes::RNSGLWECiphertext mod_switch_to_level_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct,
+    std::size_t level,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::mod_switch_to_level_glwe_rns");
+    if (level > ct.level()) {
+        throw std::runtime_error("Cannot switch a ciphertext up the modulus chain");
+    }
+
+    schemes::RNSGLWECiphertext result = ct;
+    while (result.level() > level) {
+        result = drop_level_glwe_rns(result, params);
+    }
+    return result;
+}
+
+schemes::RNSRLWECiphertext add_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct1,
+    const schemes::RNSRLWECiphertext& ct2,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_rlwe_rns");
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::RNSRLWECiphertext x = mod_switch_to_level_rlwe_rns(ct1, level, params);
+    schemes::RNSRLWECiphertext y = mod_switch_to_level_rlwe_rns(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    schemes::RNSRLWECiphertext result;
+    result.a = rns::add(x.a, y.a, base);
+    result.b = rns::add(x.b, y.b, base);
+    return result;
+}
+
+schemes::RNSRLWECiphertext subtract_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct1,
+    const schemes::RNSRLWECiphertext& ct2,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::subtract_rlwe_rns");
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::RNSRLWECiphertext x = mod_switch_to_level_rlwe_rns(ct1, level, params);
+    schemes::RNSRLWECiphertext y = mod_switch_to_level_rlwe_rns(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    schemes::RNSRLWECiphertext result;
+    result.a = rns::subtract(x.a, y.a, base);
+    result.b = rns::subtract(x.b, y.b, base);
+    return result;
+}
+
+schemes::RNSRLWECiphertext multiply_rlwe_rns(
+    const schemes::RNSRLWECiphertext& ct1,
+    const schemes::RNSRLWECiphertext& ct2,
+    const keys::RNSRelinKey& rlk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_rlwe_rns");
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::RNSRLWECiphertext x = mod_switch_to_level_rlwe_rns(ct1, level, params);
+    schemes::RNSRLWECiphertext y = mod_switch_to_level_rlwe_rns(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    std::vector<rns::RNSPolynomial> cx = {x.b, rns::negate(x.a, base)};
+    std::vector<rns::RNSPolynomial> cy = {y.b, rns::negate(y.a, base)};
+
+    schemes::RNSGLWECiphertext product = multiply_components(cx, cy, rlk, params);
+
+    schemes::RNSRLWECiphertext result;
+    result.a = product.d_tilde[0];
+    result.b = product.b;
+    return drop_level_rlwe_rns(result, params);
+}
+
+schemes::RNSGLWECiphertext add_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct1,
+    const schemes::RNSGLWECiphertext& ct2,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::add_glwe_rns");
+    if (ct1.d_tilde.size() != ct2.d_tilde.size()) {
+        throw std::runtime_error("GLWE ciphertext size mismatch");
+    }
+
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::RNSGLWECiphertext x = mod_switch_to_level_glwe_rns(ct1, level, params);
+    schemes::RNSGLWECiphertext y = mod_switch_to_level_glwe_rns(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    schemes::RNSGLWECiphertext result;
+    result.b = rns::add(x.b, y.b, base);
+    for (std::size_t i = 0; i < x.d_tilde.size(); ++i) {
+        result.d_tilde.push_back(rns::add(x.d_tilde[i], y.d_tilde[i], base));
+    }
+    return result;
+}
+
+schemes::RNSGLWECiphertext subtract_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct1,
+    const schemes::RNSGLWECiphertext& ct2,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::subtract_glwe_rns");
+    if (ct1.d_tilde.size() != ct2.d_tilde.size()) {
+        throw std::runtime_error("GLWE ciphertext size mismatch");
+    }
+
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::RNSGLWECiphertext x = mod_switch_to_level_glwe_rns(ct1, level, params);
+    schemes::RNSGLWECiphertext y = mod_switch_to_level_glwe_rns(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    schemes::RNSGLWECiphertext result;
+    result.b = rns::subtract(x.b, y.b, base);
+    for (std::size_t i = 0; i < x.d_tilde.size(); ++i) {
+        result.d_tilde.push_back(rns::subtract(x.d_tilde[i], y.d_tilde[i], base));
+    }
+    return result;
+}
+
+schemes::RNSGLWECiphertext multiply_glwe_rns(
+    const schemes::RNSGLWECiphertext& ct1,
+    const schemes::RNSGLWECiphertext& ct2,
+    const keys::RNSRelinKey& rlk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("operations::multiply_glwe_rns");
+    if (ct1.d_tilde.size() != ct2.d_tilde.size()) {
+        throw std::runtime_error("GLWE ciphertext size mismatch");
+    }
+
+    std::size_t level = std::min(ct1.level(), ct2.level());
+    schemes::RNSGLWECiphertext x = mod_switch_to_level_glwe_rns(ct1, level, params);
+    schemes::RNSGLWECiphertext y = mod_switch_to_level_glwe_rns(ct2, level, params);
+    const rns::RNSBase& base = params.q_base(level);
+
+    std::vector<rns::RNSPolynomial> cx = {x.b}, cy = {y.b};
+    for (std::size_t i = 0; i < x.d_tilde.size(); ++i) {
+        cx.push_back(rns::negate(x.d_tilde[i], base));
+        cy.push_back(rns::negate(y.d_tilde[i], base));
+    }
+
+    return drop_level_glwe_rns(multiply_components(cx, cy, rlk, params), params);
+}
+
+}
+}
@@ -0,0 +1,368 @@
+#include "turinged/params/params.hpp"
+#include "turinged/noise/noise.hpp"
+#include "turinged/keys/keys.hpp"
+#include "turinged/schemes/rlwe.hpp"
+#include "turinged/schemes/glwe.hpp"
+#include "turinged/operations/homomorphic.hpp"
+#include "turinged/operations/automorphism.hpp"
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/core/math_utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace turinged {
+namespace params {
+
+// ========== Security model ==========
+
+// Largest log2(q) for 128, 192 and 256 bits of security (HE standard, Table 1)
+struct StandardEntry {
+    std::size_t n;
+    double log_q[3];
+};
+
+static const StandardEntry HE_STANDARD[] = {
+    {1024, {27, 19, 14}},
+    {2048, {54, 37, 29}},
+    {4096, {109, 75, 58}},
+    {8192, {218, 152, 118}},
+    {16384, {438, 305, 237}},
+    {32768, {881, 611, 476}},
+};
+
+static const double HE_STANDARD_LEVELS[3] = {128.0, 192.0, 256.0};
+
+// c = security * log2(q / sigma) / n, smallest over the three columns
+static double entry_coefficient(const StandardEntry& entry) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < 3; ++i) {
+        double c = HE_STANDARD_LEVELS[i] * (entry.log_q[i] - std::log2(MIN_NOISE_STDDEV)) /
+                   static_cast<double>(entry.n);
+        best = std::min(best, c);
+    }
+    return best;
+}
+
+static double security_coefficient(std::size_t dimension) {
+    const std::size_t count = sizeof(HE_STANDARD) / sizeof(HE_STANDARD[0]);
+    if (dimension <= HE_STANDARD[0].n) return entry_coefficient(HE_STANDARD[0]);
+    if (dimension >= HE_STANDARD[count - 1].n) return entry_coefficient(HE_STANDARD[count - 1]);
+
+    std::size_t i = 1;
+    while (HE_STANDARD[i].n < dimension) ++i;
+    double lo = std::log2(static_cast<double>(HE_STANDARD[i - 1].n));
+    double hi = std::log2(static_cast<double>(HE_STANDARD[i].n));
+    double w = (std::log2(static_cast<double>(dimension)) - lo) / (hi - lo);
+    return (1.0 - w) * entry_coefficient(HE_STANDARD[i - 1]) + w * entry_coefficient(HE_STANDARD[i]);
+}
+
+double estimated_security_bits(std::size_t dimension, int64 q, double sigma) {
+    if (dimension == 0 || sigma <= 0.0) return 0.0;
+    double gap = std::log2(static_cast<double>(q)) - std::log2(sigma);
+    if (gap <= 0.0) return std::numeric_limits<double>::infinity();
+    return security_coefficient(dimension) * static_cast<double>(dimension) / gap;
+}
+
+double min_noise_stddev(std::size_t dimension, int64 q, int security_bits) {
+    if (dimension == 0 || security_bits <= 0) {
+        throw std::runtime_error("Invalid dimension or security level");
+    }
+    double gap = security_coefficient(dimension) * static_cast<double>(dimension) / static_cast<double>(security_bits);
+    return std::max(static_cast<double>(q) * std::exp2(-gap), MIN_NOISE_STDDEV);
+}
+
+int64 noise_bound_for_stddev(double sigma) {
+    // Variance of the uniform noise on [-B, B] is B(B + 1) / 3
+    double target = sigma * sigma;
+    int64 bound = static_cast<int64>(std::ceil((std::sqrt(1.0 + 12.0 * target) - 1.0) / 2.0));
+    if (bound < 1) bound = 1;
+    while (bound > 1 && static_cast<double>(bound - 1) * static_cast<double>(bound) / 3.0 >= target) --bound;
+    while (static_cast<double>(bound) * static_cast<double>(bound + 1) / 3.0 < target) ++bound;
+    return bound;
+}
+
+// ========== Cost model ==========
+
+OperationCosts model_operation_costs(std::size_t n, std::size_t k) {
+    // Every product runs a length-n transform per exact prime; the counts
+    // follow the implementations (keys prepared in NTT form where they are)
+    const double butterfly = 8e-9;
+    const double coefficient = 5e-9;
+    double nd = static_cast<double>(n);
+    double kd = static_cast<double>(k);
+    double transform = polynomial::EXACT_PRIME_COUNT * butterfly * nd * std::log2(nd) / 2.0;
+    double pass = coefficient * nd;
+
+    OperationCosts c;
+    c.encrypt = (2.0 * kd + 1.0) * transform + (kd + 2.0) * pass;
+    c.public_key_encrypt = (2.0 * kd + 3.0) * transform + (kd + 3.0) * pass;
+    c.decrypt = (2.0 * kd + 1.0) * transform + (kd + 1.0) * pass;
+    c.add = (kd + 1.0) * pass;
+    c.multiply_plain = 2.0 * (kd + 1.0) * transform + 2.0 * (kd + 1.0) * pass;
+    c.tensor = k == 1 ? 7.0 * transform + 12.0 * pass : std::numeric_limits<double>::infinity();
+    c.key_switch_fixed = (kd + 1.0) * transform + 2.0 * (kd + 1.0) * pass;
+    c.key_switch_per_level = kd * transform + 2.0 * kd * (kd + 1.0) * pass;
+    return c;
+}
+
+// Seconds per call of op, repeating until min_time has passed
+template <typename Op>
+static double seconds_per_call(Op op, double min_time) {
+    using clock = std::chrono::steady_clock;
+    op();
+
+    std::size_t iterations = 1;
+    while (true) {
+        auto start = clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) op();
+        double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        if (elapsed >= min_time || iterations >= (std::size_t(1) << 30)) {
+            return elapsed / static_cast<double>(iterations);
+        }
+        iterations *= 2;
+    }
+}
+
+OperationCosts measure_operation_costs(std::size_t n, std::size_t k, double min_time) {
+    if (n == 0 || k == 0) {
+        throw std::runtime_error("Invalid ring degree or GLWE dimension");
+    }
+
+    Parameters params(n, int64(1) << 40, 16, 1);
+    const int64 coarse = int64(1) << 20;            // 2 levels
+    const int64 fine = int64(1) << 5;               // 8 levels
+    uint64 elt = operations::galois_element_for_rotation(1, n);
+
+    Polynomial message(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        message[i] = static_cast<int64>(core::derive_seed(0x5eed, i) % static_cast<uint64>(params.t));
+    }
+    operations::PreparedPlaintext plain = operations::prepare_plaintext(message, params);
+
+    OperationCosts c;
+    double rotate_coarse;
+    double rotate_fine;
+    if (k == 1) {
+        auto sk = keys::generate_rlwe_secret_key(n);
+        auto pk = keys::generate_rlwe_public_key(sk, params);
+        auto ct = schemes::encrypt_rlwe(message, sk, params);
+        auto gk_coarse = keys::generate_rlwe_galois_keys(sk, params, coarse, {elt});
+        auto gk_fine = keys::generate_rlwe_galois_keys(sk, params, fine, {elt});
+
+        c.encrypt = seconds_per_call([&]() { schemes::encrypt_rlwe(message, sk, params); }, min_time);
+        c.public_key_encrypt = seconds_per_call([&]() { schemes::encrypt_rlwe(message, pk, params); }, min_time);
+        c.decrypt = seconds_per_call([&]() { schemes::decrypt_rlwe(ct, sk, params); }, min_time);
+        c.add = seconds_per_call([&]() { operations::add_rlwe(ct, ct, params); }, min_time);
+        c.multiply_plain = seconds_per_call([&]() { operations::multiply_plain_rlwe(ct, plain, params); }, min_time);
+        c.tensor = seconds_per_call([&]() { operations::tensor_rlwe(ct, ct, params); }, min_time);
+        rotate_coarse = seconds_per_call([&]() { operations::apply_galois_rlwe(ct, elt, gk_coarse, params); }, min_time);
+        rotate_fine = seconds_per_call([&]() { operations::apply_galois_rlwe(ct, elt, gk_fine, params); }, min_time);
+    } else {
+        auto sk = keys::generate_glwe_secret_key(k, n);
+        auto pk = keys::generate_glwe_public_key(sk, params);
+        auto ct = schemes::encrypt_glwe(message, sk, params);
+        auto gk_coarse = keys::generate_glwe_galois_keys(sk, params, coarse, {elt});
+        auto gk_fine = keys::generate_glwe_galois_keys(sk, params, fine, {elt});
+
+        c.encrypt = seconds_per_call([&]() { schemes::encrypt_glwe(message, sk, params); }, min_time);
+        c.public_key_encrypt = seconds_per_call([&]() { schemes::encrypt_glwe(message, pk, params); }, min_time);
+        c.decrypt = seconds_per_call([&]() { schemes::decrypt_glwe(ct, sk, params); }, min_time);
+        c.add = seconds_per_call([&]() { operations::add_glwe(ct, ct, params); }, min_time);
+        c.multiply_plain = seconds_per_call([&]() { operations::multiply_plain_glwe(ct, plain, params); }, min_time);
+        c.tensor = std::numeric_limits<double>::infinity();
+        rotate_coarse = seconds_per_call([&]() { operations::apply_galois_glwe(ct, elt, gk_coarse, params); }, min_time);
+        rotate_fine = seconds_per_call([&]() { operations::apply_galois_glwe(ct, elt, gk_fine, params); }, min_time);
+    }
+
+    int coarse_levels = core::gadget_levels(params.q, coarse);
+    int fine_levels = core::gadget_levels(params.q, fine);
+    c.key_switch_per_level = std::max(0.0, (rotate_fine - rotate_coarse) / (fine_levels - coarse_levels));
+    c.key_switch_fixed = std::max(0.0, rotate_coarse - coarse_levels * c.key_switch_per_level);
+    return c;
+}
+
+// ========== Selection ==========
+
+OperationMix operation_mix(const Requirements& req) {
+    if (!req.mix.empty()) return req.mix;
+
+    // Whole tree behind the output: every level's summands are products (or
+    // inputs) whose operands are full sums of the level below
+    OperationMix mix;
+    double fan_in = static_cast<double>(std::max<std::size_t>(req.fan_in, 1));
+    int levels = std::max(req.depth, 1);
+    double summands = fan_in;
+    for (int level = levels - 1; level >= 0; --level) {
+        mix.additions += summands - summands / fan_in;
+        mix.plaintext_multiplies += summands * static_cast<double>(req.plaintext_multiplies);
+        mix.rotations += summands * static_cast<double>(req.rotations);
+
+        double inputs = summands;
+        if (level < req.depth) {
+            mix.multiplies += summands;
+            inputs = 2.0 * summands;
+        }
+        if (level > 0) {
+            summands = inputs * fan_in;
+        } else {
+            mix.encryptions = inputs;
+        }
+    }
+    mix.decryptions = 1.0;
+    return mix;
+}
+
+double path_variance(const Requirements& req, const Parameters& params, std::size_t k, int64 beta, int levels) {
+    double n = static_cast<double>(params.n);
+    double t = static_cast<double>(params.t);
+
+    double variance = req.public_key ? noise::glwe_public_key_variance(params, k) : noise::fresh_variance(params);
+    double coherent = req.public_key ? noise::glwe_public_key_coherent_variance(params, k) : 0.0;
+    // Expected norms of a uniform plaintext mod t, centered: its coefficients have
+    // variance (t^2 - 1) / 12 and mean mu = 1/2 for even t (0 for odd t), and the
+    // mean makes p * (1 + x + ... + x^(n-1)) grow as mu^2 n^2 / 3
+    double mu = params.t % 2 == 0 ? 0.5 : 0.0;
+    double spread = (t * t - 1.0) / 12.0;
+    double plain_norm = n * (spread + mu * mu);
+    double plain_ramp = n * spread + mu * mu * n * n / 3.0;
+    double plain_mean = spread + mu * mu * n;
+    double relin = levels > 0 ? noise::key_switch_variance(params, beta, levels, params.n) : 0.0;
+    double relin_coherent = levels > 0 ? noise::key_switch_coherent_variance(params, beta, levels, params.n) : 0.0;
+    double rotation = levels > 0 ? noise::key_switch_variance(params, beta, levels, k * params.n) : 0.0;
+    double rotation_coherent = levels > 0 ? noise::key_switch_coherent_variance(params, beta, levels, k * params.n) : 0.0;
+
+    // Adds the error of one key switch
+    auto add = [&](double other, double other_coherent) {
+        variance = noise::sum_variance(variance, coherent, other, other_coherent);
+        coherent = noise::sum_coherent_variance(coherent, other_coherent);
+    };
+
+    for (int level = 0; level < std::max(req.depth, 1); ++level) {
+        if (level < req.depth) {
+            double tensor = noise::tensor_variance(variance, coherent, variance, coherent, params);
+            coherent = noise::tensor_coherent_variance(variance, coherent, variance, coherent, params);
+            variance = tensor;
+            add(relin, relin_coherent);
+        }
+        for (std::size_t i = 0; i < req.plaintext_multiplies; ++i) {
+            double product = noise::plain_product_variance(variance, coherent, plain_norm, plain_ramp, params);
+            coherent = noise::plain_product_coherent_variance(variance, coherent, plain_mean, plain_ramp, params);
+            variance = product;
+        }
+        for (std::size_t i = 0; i < req.rotations; ++i) add(rotation, rotation_coherent);
+        // fan_in such ciphertexts: the coherent parts add up in deviation
+        double fan_in = static_cast<double>(std::max<std::size_t>(req.fan_in, 1));
+        variance = (variance - coherent) * fan_in + coherent * fan_in * fan_in;
+        coherent *= fan_in * fan_in;
+    }
+    return variance;
+}
+
+// Same bound as the exact plaintext product: n * (q/2) * (t/2) below P/4
+static bool plain_product_supported(std::size_t n, int64 q, int64 t) {
+    long double limit = 1.0L;
+    for (uint64 p : polynomial::EXACT_PRIMES) {
+        limit *= static_cast<long double>(p);
+    }
+    long double per_term = static_cast<long double>(n) * (static_cast<long double>(q) / 2.0L) *
+                           (static_cast<long double>(t) / 2.0L);
+    return per_term <= limit / 4.0L;
+}
+
+static double mix_cost(const OperationMix& mix, const OperationCosts& c, int levels, bool public_key) {
+    double key_switch = c.key_switch_fixed + static_cast<double>(levels) * c.key_switch_per_level;
+    double cost = mix.encryptions * (public_key ? c.public_key_encrypt : c.encrypt) +
+                  mix.decryptions * c.decrypt +
+                  mix.additions * c.add +
+                  mix.plaintext_multiplies * c.multiply_plain +
+                  mix.rotations * key_switch;
+    // Skip the term when unused so an infinite tensor cost does not give NaN
+    if (mix.multiplies > 0.0) cost += mix.multiplies * (c.tensor + key_switch);
+    return cost;
+}
+
+std::vector<ParameterSet> feasible_parameters(const Requirements& req, const CostFunction& costs) {
+    if (req.t < 2 || req.depth < 0 || req.security_bits <= 0 || req.min_n == 0 || req.min_n > req.max_n ||
+        !(req.variance_margin >= 1.0)) {
+        throw std::runtime_error("Invalid parameter requirements");
+    }
+
+    OperationMix mix = operation_mix(req);
+    bool needs_tensor = req.depth > 0 || mix.multiplies > 0.0;
+    bool needs_plain = req.plaintext_multiplies > 0 || mix.plaintext_multiplies > 0.0;
+    bool needs_key_switch = needs_tensor || req.rotations > 0 || mix.rotations > 0.0;
+    std::size_t max_k = needs_tensor ? 1 : std::max<std::size_t>(req.max_k, 1);
+
+    std::size_t first_n = 1;
+    while (first_n < req.min_n) first_n *= 2;
+
+    std::vector<ParameterSet> result;
+    for (std::size_t n = first_n; n <= req.max_n; n *= 2) {
+        for (std::size_t k = 1; k <= max_k; ++k) {
+            // Smallest q reaching each level count, with the smallest base giving it
+            std::map<int, ParameterSet> by_levels;
+            for (int bits = 2; bits <= 62; ++bits) {
+                int64 q = int64(1) << bits;
+                if (q / req.t < 2) continue;
+                if (!polynomial::ntt_supported(n, q, needs_tensor ? 2 : 1)) break;
+                if (needs_plain && !plain_product_supported(n, q, req.t)) break;
+
+                int64 bound = noise_bound_for_stddev(min_noise_stddev(k * n, q, req.security_bits));
+                Parameters params(n, q, req.t, bound);
+
+                ParameterSet candidate;
+                candidate.params = params;
+                candidate.k = k;
+                candidate.security_bits = estimated_security_bits(k * n, q, std::sqrt(noise::fresh_variance(params)));
+
+                for (int base_bits = 1; base_bits <= (needs_key_switch ? std::min(bits, 63 - bits) : 1); ++base_bits) {
+                    int64 beta = needs_key_switch ? int64(1) << base_bits : 0;
+                    int levels = needs_key_switch ? core::gadget_levels(q, beta) : 0;
+                    if (by_levels.count(levels)) continue;
+
+                    candidate.beta = beta;
+                    candidate.levels = levels;
+                    candidate.variance = path_variance(req, params, k, beta, levels);
+                    candidate.failure_probability =
+                        noise::failure_probability(candidate.variance * req.variance_margin, params, n);
+                    if (candidate.failure_probability <= req.failure_probability) {
+                        by_levels[levels] = candidate;
+                    }
+                }
+            }
+            if (by_levels.empty()) continue;
+
+            OperationCosts c = costs(n, k);
+            ParameterSet best;
+            best.cost = std::numeric_limits<double>::infinity();
+            for (auto& entry : by_levels) {
+                entry.second.cost = mix_cost(mix, c, entry.first, req.public_key);
+                if (entry.second.cost < best.cost ||
+                    (entry.second.cost == best.cost && entry.second.params.q < best.params.q)) {
+                    best = entry.second;
+                }
+            }
+            result.push_back(best);
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const ParameterSet& a, const ParameterSet& b) {
+        return a.cost < b.cost;
+    });
+    return result;
+}
+
+ParameterSet select_parameters(const Requirements& req, const CostFunction& costs) {
+    std::vector<ParameterSet> sets = feasible_parameters(req, costs);
+    if (sets.empty()) {
+        throw std::runtime_error("No parameter set meets the security and failure probability targets");
+    }
+    return sets.front();
+}
+
+}
+}
@@ -0,0 +1,308 @@
+#include "turinged/polynomial/ntt.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/core/trace.hpp"
+#include <map>
+#include <mutex>
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace polynomial {
+
+static constexpr std::size_t MAX_NTT_SIZE = 1 << 16;
+
+static inline uint64 shoup_constant(uint64 w, uint64 p) {
+    return static_cast<uint64>((static_cast<uint128>(w) << 64) / p);
+}
+
+// a * w mod p using the precomputed Shoup constant of w
+static inline uint64 mul_shoup(uint64 a, uint64 w, uint64 w_shoup, uint64 p) {
+    uint64 hi = static_cast<uint64>((static_cast<uint128>(a) * w_shoup) >> 64);
+    uint64 r = a * w - hi * p;
+    return r >= p ? r - p : r;
+}
+
+// Primitive 2n-th root of unity modulo p
+static uint64 find_psi(std::size_t n, uint64 p) {
+    uint64 order = 2 * static_cast<uint64>(n);
+    if ((p - 1) % order != 0) {
+        throw std::runtime_error("Prime does not support NTT of this size");
+    }
+
+    for (uint64 g = 2; g < p; ++g) {
+        uint64 psi = core::pow_mod(g, (p - 1) / order, p);
+        // Order is a power of two, so it is exact once psi^n = -1
+        if (core::pow_mod(psi, order / 2, p) == p - 1) {
+            return psi;
+        }
+    }
+    throw std::runtime_error("No primitive root of unity found");
+}
+
+static std::shared_ptr<const NTTTables> build_ntt_tables(std::size_t n, uint64 p) {
+    auto tables = std::make_shared<NTTTables>();
+    tables->n = n;
+    tables->p = p;
+
+    int bits = 0;
+    while ((std::size_t(1) << bits) < n) bits++;
+
+    uint64 psi = find_psi(n, p);
+    uint64 psi_inv = core::pow_mod(psi, p - 2, p);
+
+    tables->psi_rev.resize(n);
+    tables->psi_rev_shoup.resize(n);
+    tables->psi_inv_rev.resize(n);
+    tables->psi_inv_rev_shoup.resize(n);
+
+    uint64 power = 1, power_inv = 1;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t r = core::bit_reverse(i, bits);
+        tables->psi_rev[r] = power;
+        tables->psi_rev_shoup[r] = shoup_constant(power, p);
+        tables->psi_inv_rev[r] = power_inv;
+        tables->psi_inv_rev_shoup[r] = shoup_constant(power_inv, p);
+        power = core::mul_mod(power, psi, p);
+        power_inv = core::mul_mod(power_inv, psi_inv, p);
+    }
+
+    tables->n_inv = core::pow_mod(n % p, p - 2, p);
+    tables->n_inv_shoup = shoup_constant(tables->n_inv, p);
+
+    return tables;
+}
+
+std::shared_ptr<const NTTTables> get_ntt_tables(std::size_t n, uint64 p) {
+    if (!core::is_power_of_two(n) || n > MAX_NTT_SIZE) {
+        throw std::runtime_error("NTT size must be a power of two up to 65536");
+    }
+
+    static std::mutex cache_mutex;
+    static std::map<std::pair<std::size_t, uint64>, std::shared_ptr<const NTTTables>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto key = std::make_pair(n, p);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    auto tables = build_ntt_tables(n, p);
+    cache[key] = tables;
+    return tables;
+}
+
+void ntt_forward(uint64* a, const NTTTables& tables) {
+    TURINGED_METRICS_COUNT(ntt_forward);
+    std::size_t n = tables.n;
+    uint64 p = tables.p;
+
+    // Cooley-Tukey butterflies with psi folded into the twiddles
+    std::size_t t = n;
+    for (std::size_t m = 1; m < n; m <<= 1) {
+        t >>= 1;
+        for (std::size_t i = 0; i < m; ++i) {
+            std::size_t j1 = 2 * i * t;
+            uint64 w = tables.psi_rev[m + i];
+            uint64 w_shoup = tables.psi_rev_shoup[m + i];
+            for (std::size_t j = j1; j < j1 + t; ++j) {
+                uint64 u = a[j];
+                uint64 v = mul_shoup(a[j + t], w, w_shoup, p);
+                uint64 sum = u + v;
+                a[j] = sum >= p ? sum - p : sum;
+                a[j + t] = u >= v ? u - v : u + p - v;
+            }
+        }
+    }
+}
+
+void ntt_inverse(uint64* a, const NTTTables& tables) {
+    TURINGED_METRICS_COUNT(ntt_inverse);
+    std::size_t n = tables.n;
+    uint64 p = tables.p;
+
+    // Gentleman-Sande butterflies, mirror image of ntt_forward
+    std::size_t t = 1;
+    for (std::size_t m = n; m > 1; m >>= 1) {
+        std::size_t h = m >> 1;
+        std::size_t j1 = 0;
+        for (std::size_t i = 0; i < h; ++i) {
+            uint64 w = tables.psi_inv_rev[h + i];
+            uint64 w_shoup = tables.psi_inv_rev_shoup[h + i];
+            for (std::size_t j = j1; j < j1 + t; ++j) {
+                uint64 u = a[j];
+                uint64 v = a[j + t];
+                uint64 sum = u + v;
+                a[j] = sum >= p ? sum - p : sum;
+                a[j + t] = mul_shoup(u >= v ? u - v : u + p - v, w, w_shoup, p);
+            }
+            j1 += 2 * t;
+        }
+        t <<= 1;
+    }
+
+    for (std::size_t j = 0; j < n; ++j) {
+        a[j] = mul_shoup(a[j], tables.n_inv, tables.n_inv_shoup, p);
+    }
+}
+
+bool ntt_supported(std::size_t n, int64 q, std::size_t terms) {
+    if (!core::is_power_of_two(n) || n > MAX_NTT_SIZE || q < 2) {
+        return false;
+    }
+
+    // Largest coefficient magnitude: terms * n * (q/2)^2, must stay below P/2
+    long double half_q = static_cast<long double>(q) / 2.0L;
+    long double bound = static_cast<long double>(terms) * static_cast<long double>(n) * half_q * half_q;
+    long double limit = 1.0L;
+    for (uint64 p : EXACT_PRIMES) {
+        limit *= static_cast<long double>(p);
+    }
+    return bound < limit / 4.0L;
+}
+
+NTTPolynomial to_ntt(ConstPolynomialView a) {
+    TURINGED_TRACE_SCOPE("polynomial::to_ntt");
+    std::size_t n = a.n;
+    NTTPolynomial result(n);
+
+    // |centered| <= q/2 < p, so one conditional add maps it into [0, p)
+    for (std::size_t k = 0; k < EXACT_PRIME_COUNT; ++k) {
+        uint64 p = EXACT_PRIMES[k];
+        core::PooledVector<uint64>& r = result.residues[k];
+        for (std::size_t i = 0; i < n; ++i) {
+            int64 c = core::center_rep(a[i], a.q);
+            r[i] = c >= 0 ? static_cast<uint64>(c) : p - static_cast<uint64>(-c);
+        }
+        ntt_forward(r.data(), *get_ntt_tables(n, p));
+    }
+
+    return result;
+}
+
+NTTPolynomial to_ntt(const Polynomial& a, int64 q) {
+    return to_ntt(view(a, q));
+}
+
+NTTPolynomial ntt_multiply(const NTTPolynomial& a, const NTTPolynomial& b) {
+    NTTPolynomial result(a.size());
+    ntt_multiply_accumulate(result, a, b);
+    return result;
+}
+
+void ntt_multiply_accumulate(NTTPolynomial& acc, const NTTPolynomial& a, const NTTPolynomial& b) {
+    if (a.size() != b.size() || acc.size() != a.size()) {
+        throw std::runtime_error("Polynomial size mismatch in NTT multiplication");
+    }
+    TURINGED_METRICS_COUNT(poly_multiplies);
+
+    for (std::size_t k = 0; k < EXACT_PRIME_COUNT; ++k) {
+        uint64 p = EXACT_PRIMES[k];
+        const uint64* x = a.residues[k].data();
+        const uint64* y = b.residues[k].data();
+        uint64* z = acc.residues[k].data();
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            uint128 prod = static_cast<uint128>(x[i]) * y[i] + z[i];
+            z[i] = static_cast<uint64>(prod % p);
+        }
+    }
+}
+
+void ntt_add_inplace(NTTPolynomial& acc, const NTTPolynomial& a) {
+    if (acc.size() != a.size()) {
+        throw std::runtime_error("Polynomial size mismatch in NTT addition");
+    }
+
+    for (std::size_t k = 0; k < EXACT_PRIME_COUNT; ++k) {
+        uint64 p = EXACT_PRIMES[k];
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            uint64 sum = acc.residues[k][i] + a.residues[k][i];
+            acc.residues[k][i] = sum >= p ? sum - p : sum;
+        }
+    }
+}
+
+void ntt_negate_inplace(NTTPolynomial& a) {
+    for (std::size_t k = 0; k < EXACT_PRIME_COUNT; ++k) {
+        uint64 p = EXACT_PRIMES[k];
+        for (uint64& v : a.residues[k]) {
+            v = v == 0 ? 0 : p - v;
+        }
+    }
+}
+
+NTTPolynomial ntt_automorphism(const NTTPolynomial& a, uint64 galois_elt) {
+    std::size_t n = a.size();
+    uint64 m = 2 * static_cast<uint64>(n);
+    if ((galois_elt & 1) == 0) {
+        throw std::runtime_error("Galois element must be odd");
+    }
+
+    int bits = 0;
+    while ((std::size_t(1) << bits) < n) bits++;
+
+    // Output j evaluates at psi^e with e = 2*bitrev(j)+1; sigma(a)(psi^e) = a(psi^(e*g))
+    std::vector<std::size_t> source(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        uint64 e = 2 * static_cast<uint64>(core::bit_reverse(j, bits)) + 1;
+        uint64 e_src = e * (galois_elt % m) % m;
+        source[j] = core::bit_reverse(static_cast<std::size_t>((e_src - 1) / 2), bits);
+    }
+
+    NTTPolynomial result(n);
+    for (std::size_t k = 0; k < EXACT_PRIME_COUNT; ++k) {
+        for (std::size_t j = 0; j < n; ++j) {
+            result.residues[k][j] = a.residues[k][source[j]];
+        }
+    }
+    return result;
+}
+
+core::PooledVector<int128> from_ntt_exact(const NTTPolynomial& a) {
+    TURINGED_TRACE_SCOPE("polynomial::from_ntt");
+    std::size_t n = a.size();
+    const uint64 p0 = EXACT_PRIMES[0];
+    const uint64 p1 = EXACT_PRIMES[1];
+
+    core::PooledVector<uint64> r0 = a.residues[0];
+    core::PooledVector<uint64> r1 = a.residues[1];
+    ntt_inverse(r0.data(), *get_ntt_tables(n, p0));
+    ntt_inverse(r1.data(), *get_ntt_tables(n, p1));
+
+    // Garner: x = r0 + p0 * ((r1 - r0) * p0^-1 mod p1), then center around 0
+    static const uint64 p0_inv = static_cast<uint64>(core::inverse_mod(static_cast<int64>(p0 % p1), static_cast<int64>(p1)));
+    const uint128 big_p = static_cast<uint128>(p0) * p1;
+    const uint128 half_p = big_p / 2;
+
+    core::PooledVector<int128> result(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        uint64 r0_mod_p1 = r0[i] % p1;
+        uint64 diff = r1[i] >= r0_mod_p1 ? r1[i] - r0_mod_p1 : r1[i] + p1 - r0_mod_p1;
+        uint64 v = core::mul_mod(diff, p0_inv, p1);
+        uint128 x = static_cast<uint128>(r0[i]) + static_cast<uint128>(p0) * v;
+        result[i] = x > half_p ? -static_cast<int128>(big_p - x) : static_cast<int128>(x);
+    }
+
+    return result;
+}
+
+void from_ntt(const NTTPolynomial& a, PolynomialView out) {
+    if (a.size() != out.n) {
+        throw std::runtime_error("NTT polynomial size mismatch");
+    }
+
+    core::PooledVector<int128> exact = from_ntt_exact(a);
+    for (std::size_t i = 0; i < exact.size(); ++i) {
+        out[i] = core::mod_int128(exact[i], out.q);
+    }
+}
+
+Polynomial from_ntt(const NTTPolynomial& a, int64 q) {
+    Polynomial result(a.size());
+    from_ntt(a, view(result, q));
+    return result;
+}
+
+}
+}
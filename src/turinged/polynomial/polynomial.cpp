@@ -1,5 +1,7 @@
 #include "turinged/polynomial/polynomial.hpp"
+#include "turinged/polynomial/ntt.hpp"
 #include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
 #include <iostream>
 #include <algorithm>
 #include <stdexcept>
@@ -7,59 +9,54 @@
 namespace turinged {
 namespace polynomial {
 
-Polynomial add(const Polynomial& a, const Polynomial& b, int64 q) {
-    if (a.size() != b.size()) {
-        throw std::runtime_error("Polynomial size mismatch in addition");
+static void check_views(std::size_t n_a, int64 q_a, PolynomialView out, const char* op) {
+    if (n_a != out.n || q_a != out.q) {
+        throw std::runtime_error(std::string("Polynomial size mismatch in ") + op);
     }
+}
 
-    std::size_t n = a.size();
-    Polynomial result(n);
-    for (std::size_t i = 0; i < n; i++) {
-        result[i] = core::modq(a[i] + b[i], q);
+void add(ConstPolynomialView a, ConstPolynomialView b, PolynomialView out) {
+    check_views(a.n, a.q, out, "addition");
+    check_views(b.n, b.q, out, "addition");
+
+    int64 q = out.q;
+    for (std::size_t i = 0; i < out.n; i++) {
+        out[i] = core::modq(a[i] + b[i], q);
     }
-    return result;
 }
 
-Polynomial subtract(const Polynomial& a, const Polynomial& b, int64 q) {
-    if (a.size() != b.size()) {
-        throw std::runtime_error("Polynomial size mismatch in subtraction");
-    }
+void subtract(ConstPolynomialView a, ConstPolynomialView b, PolynomialView out) {
+    check_views(a.n, a.q, out, "subtraction");
+    check_views(b.n, b.q, out, "subtraction");
 
-    std::size_t n = a.size();
-    Polynomial result(n);
-    for (std::size_t i = 0; i < n; i++) {
-        result[i] = core::modq(a[i] - b[i], q);
+    int64 q = out.q;
+    for (std::size_t i = 0; i < out.n; i++) {
+        out[i] = core::modq(a[i] - b[i], q);
     }
-    return result;
 }
 
-Polynomial scalar_multiply(const Polynomial& a, int64 scalar, int64 q) {
-    std::size_t n = a.size();
-    Polynomial result(n);
-    for (std::size_t i = 0; i < n; i++) {
+void scalar_multiply(ConstPolynomialView a, int64 scalar, PolynomialView out) {
+    check_views(a.n, a.q, out, "scalar multiplication");
+
+    int64 q = out.q;
+    for (std::size_t i = 0; i < out.n; i++) {
         int128 tmp = static_cast<int128>(a[i]) * scalar;
-        result[i] = core::modq(static_cast<int64>(tmp % q), q);
+        out[i] = core::modq(static_cast<int64>(tmp % q), q);
     }
-    return result;
 }
 
-Polynomial negate(const Polynomial& a, int64 q) {
-    std::size_t n = a.size();
-    Polynomial result(n);
-    for (std::size_t i = 0; i < n; i++) {
-        result[i] = core::modq(-a[i], q);
-    }
-    return result;
-}
+void negate(ConstPolynomialView a, PolynomialView out) {
+    check_views(a.n, a.q, out, "negation");
 
-Polynomial negacyclic_multiply(const Polynomial& a, const Polynomial& b, int64 q) {
-    if (a.size() != b.size()) {
-        throw std::runtime_error("Polynomial size mismatch in multiplication");
+    int64 q = out.q;
+    for (std::size_t i = 0; i < out.n; i++) {
+        out[i] = core::modq(-a[i], q);
     }
+}
 
-    std::size_t n = a.size();
-    Polynomial result(n, 0);
-
+// result must be zeroed and must not alias a or b
+static void schoolbook_multiply(const int64* a, const int64* b, std::size_t n, int64 q, int64* result) {
+    TURINGED_METRICS_COUNT(poly_multiplies);
     for (std::size_t i = 0; i < n; i++) {
         for (std::size_t j = 0; j < n; j++) {
             std::size_t idx = j + i;
@@ -79,7 +76,109 @@ Polynomial negacyclic_multiply(const Polynomial& a, const Polynomial& b, int64 q
     for (std::size_t i = 0; i < n; i++) {
         result[i] = core::modq(result[i], q);
     }
+}
+
+void negacyclic_multiply(ConstPolynomialView a, ConstPolynomialView b, PolynomialView out) {
+    check_views(a.n, a.q, out, "multiplication");
+    check_views(b.n, b.q, out, "multiplication");
+
+    // Both inputs are transformed before out is written, so aliasing is safe
+    if (ntt_supported(out.n, out.q)) {
+        from_ntt(ntt_multiply(to_ntt(a), to_ntt(b)), out);
+        return;
+    }
+
+    Polynomial result(out.n, 0);
+    schoolbook_multiply(a.data, b.data, out.n, out.q, result.data());
+    std::copy(result.begin(), result.end(), out.begin());
+}
+
+Polynomial add(const Polynomial& a, const Polynomial& b, int64 q) {
+    Polynomial result(a.size());
+    add(view(a, q), view(b, q), view(result, q));
+    return result;
+}
+
+Polynomial subtract(const Polynomial& a, const Polynomial& b, int64 q) {
+    Polynomial result(a.size());
+    subtract(view(a, q), view(b, q), view(result, q));
+    return result;
+}
+
+Polynomial scalar_multiply(const Polynomial& a, int64 scalar, int64 q) {
+    Polynomial result(a.size());
+    scalar_multiply(view(a, q), scalar, view(result, q));
+    return result;
+}
+
+Polynomial negate(const Polynomial& a, int64 q) {
+    Polynomial result(a.size());
+    negate(view(a, q), view(result, q));
+    return result;
+}
+
+Polynomial negacyclic_multiply(const Polynomial& a, const Polynomial& b, int64 q) {
+    if (a.size() != b.size()) {
+        throw std::runtime_error("Polynomial size mismatch in multiplication");
+    }
+
+    // O(n log n) exact product through the CRT/NTT path whenever it fits
+    if (ntt_supported(a.size(), q)) {
+        return from_ntt(ntt_multiply(to_ntt(a, q), to_ntt(b, q)), q);
+    }
+
+    return negacyclic_multiply_schoolbook(a, b, q);
+}
+
+Polynomial negacyclic_multiply_schoolbook(const Polynomial& a, const Polynomial& b, int64 q) {
+    if (a.size() != b.size()) {
+        throw std::runtime_error("Polynomial size mismatch in multiplication");
+    }
+
+    Polynomial result(a.size(), 0);
+    schoolbook_multiply(a.data(), b.data(), a.size(), q, result.data());
+    return result;
+}
+
+Polynomial multiply_monomial(const Polynomial& a, std::size_t r, int64 q) {
+    std::size_t n = a.size();
+    r %= 2 * n;
+
+    Polynomial result(n);
+    for (std::size_t i = 0; i < n; i++) {
+        std::size_t idx = (i + r) % (2 * n);
+        if (idx < n) {
+            result[idx] = a[i];
+        } else {
+            result[idx - n] = core::modq(-a[i], q);
+        }
+    }
+    return result;
+}
+
+Polynomial automorphism(const Polynomial& a, uint64 galois_elt, int64 q) {
+    std::size_t n = a.size();
+    uint64 m = 2 * static_cast<uint64>(n);
+    if ((galois_elt & 1) == 0) {
+        throw std::runtime_error("Galois element must be odd");
+    }
+
+    // X^i -> X^(i*g mod 2n), with X^n = -1
+    Polynomial result(n);
+    for (std::size_t i = 0; i < n; i++) {
+        uint64 idx = static_cast<uint64>(i) * (galois_elt % m) % m;
+        if (idx < n) {
+            result[idx] = a[i];
+        } else {
+            result[idx - n] = core::modq(-a[i], q);
+        }
+    }
+    return result;
+}
 
+Polynomial switch_modulus(const Polynomial& a, int64 q, int64 q_new) {
+    Polynomial result(a);
+    core::switch_modulus_inplace(result.data(), result.size(), q, q_new);
     return result;
 }
 
@@ -0,0 +1,380 @@
+#include "turinged/rns/rns.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/core/trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace rns {
+
+std::vector<uint64> generate_ntt_primes(int bits, std::size_t n, std::size_t count, const std::vector<uint64>& exclude) {
+    if (bits < 2 || bits > 61) {
+        throw std::runtime_error("RNS prime size must be between 2 and 61 bits");
+    }
+
+    uint64 step = 2 * static_cast<uint64>(n);
+    uint64 upper = uint64(1) << bits;
+    uint64 candidate = ((upper - 1) / step) * step + 1;
+    if (candidate >= upper) candidate -= step;
+
+    std::vector<uint64> primes;
+    while (primes.size() < count && candidate > step) {
+        bool excluded = std::find(exclude.begin(), exclude.end(), candidate) != exclude.end();
+        if (!excluded && core::is_prime(candidate)) {
+            primes.push_back(candidate);
+        }
+        candidate -= step;
+    }
+
+    if (primes.size() < count) {
+        throw std::runtime_error("Not enough NTT primes of the requested size");
+    }
+    return primes;
+}
+
+RNSBase create_rns_base(std::size_t n, const std::vector<uint64>& primes) {
+    if (primes.empty()) {
+        throw std::runtime_error("RNS base needs at least one prime");
+    }
+
+    RNSBase base;
+    base.n = n;
+    base.primes = primes;
+
+    for (std::size_t i = 0; i < primes.size(); ++i) {
+        uint64 p = primes[i];
+        base.tables.push_back(polynomial::get_ntt_tables(n, p));
+        base.inv_primes.push_back(1.0L / static_cast<long double>(p));
+
+        // Q / q_i mod q_i is the product of the other primes
+        uint64 q_hat = 1;
+        for (std::size_t j = 0; j < primes.size(); ++j) {
+            if (j != i) q_hat = core::mul_mod(q_hat, primes[j] % p, p);
+        }
+        base.q_hat_inv.push_back(core::pow_mod(q_hat, p - 2, p));
+    }
+
+    return base;
+}
+
+RNSBase prefix_base(const RNSBase& base, std::size_t count) {
+    if (count == 0 || count > base.size()) {
+        throw std::runtime_error("Invalid RNS prefix size");
+    }
+    return create_rns_base(base.n, std::vector<uint64>(base.primes.begin(), base.primes.begin() + count));
+}
+
+long double log2_modulus(const RNSBase& base) {
+    long double bits = 0.0L;
+    for (uint64 p : base.primes) {
+        bits += std::log2(static_cast<long double>(p));
+    }
+    return bits;
+}
+
+static void check_compatible(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base) {
+    if (a.prime_count() != base.size() || b.prime_count() != base.size() || a.degree() != b.degree()) {
+        throw std::runtime_error("RNS polynomial shape mismatch");
+    }
+    if (a.ntt_form != b.ntt_form) {
+        throw std::runtime_error("RNS polynomial form mismatch");
+    }
+}
+
+RNSPolynomial to_rns(const Polynomial& coeffs, const RNSBase& base) {
+    RNSPolynomial result(base.size(), coeffs.size());
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        int64 p = static_cast<int64>(base.primes[i]);
+        for (std::size_t j = 0; j < coeffs.size(); ++j) {
+            result.residues[i][j] = static_cast<uint64>(core::modq(coeffs[j], p));
+        }
+    }
+    return result;
+}
+
+void to_ntt_inplace(RNSPolynomial& a, const RNSBase& base) {
+    TURINGED_TRACE_SCOPE("rns::to_ntt");
+    if (a.ntt_form) return;
+    for (std::size_t i = 0; i < a.prime_count(); ++i) {
+        polynomial::ntt_forward(a.residues[i].data(), *base.tables[i]);
+    }
+    a.ntt_form = true;
+}
+
+void from_ntt_inplace(RNSPolynomial& a, const RNSBase& base) {
+    TURINGED_TRACE_SCOPE("rns::from_ntt");
+    if (!a.ntt_form) return;
+    for (std::size_t i = 0; i < a.prime_count(); ++i) {
+        polynomial::ntt_inverse(a.residues[i].data(), *base.tables[i]);
+    }
+    a.ntt_form = false;
+}
+
+RNSPolynomial add(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base) {
+    check_compatible(a, b, base);
+    RNSPolynomial result = a;
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        uint64 p = base.primes[i];
+        for (std::size_t j = 0; j < a.degree(); ++j) {
+            uint64 sum = a.residues[i][j] + b.residues[i][j];
+            result.residues[i][j] = sum >= p ? sum - p : sum;
+        }
+    }
+    return result;
+}
+
+RNSPolynomial subtract(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base) {
+    check_compatible(a, b, base);
+    RNSPolynomial result = a;
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        uint64 p = base.primes[i];
+        for (std::size_t j = 0; j < a.degree(); ++j) {
+            uint64 x = a.residues[i][j], y = b.residues[i][j];
+            result.residues[i][j] = x >= y ? x - y : x + p - y;
+        }
+    }
+    return result;
+}
+
+RNSPolynomial negate(const RNSPolynomial& a, const RNSBase& base) {
+    RNSPolynomial result = a;
+    for (std::size_t i = 0; i < a.prime_count(); ++i) {
+        uint64 p = base.primes[i];
+        for (uint64& v : result.residues[i]) {
+            v = v == 0 ? 0 : p - v;
+        }
+    }
+    return result;
+}
+
+RNSPolynomial scalar_multiply(const RNSPolynomial& a, int64 scalar, const RNSBase& base) {
+    RNSPolynomial result = a;
+    for (std::size_t i = 0; i < a.prime_count(); ++i) {
+        uint64 p = base.primes[i];
+        uint64 s = static_cast<uint64>(core::modq(scalar, static_cast<int64>(p)));
+        for (uint64& v : result.residues[i]) {
+            v = core::mul_mod(v, s, p);
+        }
+    }
+    return result;
+}
+
+RNSPolynomial multiply_ntt(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base) {
+    RNSPolynomial result(base.size(), a.degree());
+    result.ntt_form = true;
+    multiply_accumulate_ntt(result, a, b, base);
+    return result;
+}
+
+void multiply_accumulate_ntt(RNSPolynomial& acc, const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base) {
+    if (a.prime_count() < base.size() || b.prime_count() < base.size() || acc.prime_count() < base.size() ||
+        a.degree() != b.degree() || acc.degree() != a.degree()) {
+        throw std::runtime_error("RNS polynomial shape mismatch");
+    }
+    if (!a.ntt_form || !b.ntt_form || !acc.ntt_form) {
+        throw std::runtime_error("Pointwise RNS multiplication requires NTT form");
+    }
+    TURINGED_METRICS_COUNT(poly_multiplies);
+
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        uint64 p = base.primes[i];
+        const uint64* x = a.residues[i].data();
+        const uint64* y = b.residues[i].data();
+        uint64* z = acc.residues[i].data();
+        for (std::size_t j = 0; j < a.degree(); ++j) {
+            z[j] = static_cast<uint64>((static_cast<uint128>(x[j]) * y[j] + z[j]) % p);
+        }
+    }
+}
+
+RNSPolynomial multiply(const RNSPolynomial& a, const RNSPolynomial& b, const RNSBase& base) {
+    RNSPolynomial x = a, y = b;
+    to_ntt_inplace(x, base);
+    to_ntt_inplace(y, base);
+    RNSPolynomial result = multiply_ntt(x, y, base);
+    from_ntt_inplace(result, base);
+    return result;
+}
+
+RNSPolynomial drop_primes(const RNSPolynomial& a, std::size_t count) {
+    if (count == 0 || count > a.prime_count()) {
+        throw std::runtime_error("Invalid number of primes to keep");
+    }
+    RNSPolynomial result;
+    result.residues.assign(a.residues.begin(), a.residues.begin() + count);
+    result.ntt_form = a.ntt_form;
+    return result;
+}
+
+BaseConverter create_base_converter(const RNSBase& from, const RNSBase& to) {
+    BaseConverter converter;
+    converter.from = from;
+    converter.to = to;
+
+    converter.q_hat_mod_p.assign(from.size(), std::vector<uint64>(to.size()));
+    for (std::size_t j = 0; j < to.size(); ++j) {
+        uint64 p = to.primes[j];
+        uint64 q_mod = 1;
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            q_mod = core::mul_mod(q_mod, from.primes[i] % p, p);
+
+            uint64 q_hat = 1;
+            for (std::size_t l = 0; l < from.size(); ++l) {
+                if (l != i) q_hat = core::mul_mod(q_hat, from.primes[l] % p, p);
+            }
+            converter.q_hat_mod_p[i][j] = q_hat;
+        }
+        converter.q_mod_p.push_back(q_mod);
+    }
+
+    return converter;
+}
+
+RNSPolynomial convert_base(const RNSPolynomial& x, const BaseConverter& converter) {
+    const RNSBase& from = converter.from;
+    const RNSBase& to = converter.to;
+    if (x.ntt_form || x.prime_count() != from.size()) {
+        throw std::runtime_error("Base conversion expects a coefficient-form polynomial in the source base");
+    }
+
+    std::size_t n = x.degree();
+    std::size_t k = from.size();
+    RNSPolynomial result(to.size(), n);
+    std::vector<uint64> y(k);
+
+    for (std::size_t c = 0; c < n; ++c) {
+        // x = sum_i y_i * (Q/q_i) - v * Q with y_i = [x_i * (Q/q_i)^-1]_{q_i}
+        long double frac = 0.0L;
+        for (std::size_t i = 0; i < k; ++i) {
+            y[i] = core::mul_mod(x.residues[i][c], from.q_hat_inv[i], from.primes[i]);
+            frac += static_cast<long double>(y[i]) * from.inv_primes[i];
+        }
+        // Rounding (not flooring) selects the centered representative
+        uint64 v = static_cast<uint64>(std::llround(frac));
+
+        for (std::size_t j = 0; j < to.size(); ++j) {
+            uint64 p = to.primes[j];
+            uint128 acc = 0;
+            for (std::size_t i = 0; i < k; ++i) {
+                acc += static_cast<uint128>(y[i]) * converter.q_hat_mod_p[i][j];
+            }
+            uint64 sum = static_cast<uint64>(acc % p);
+            uint64 correction = core::mul_mod(v % p, converter.q_mod_p[j], p);
+            result.residues[j][c] = sum >= correction ? sum - correction : sum + p - correction;
+        }
+    }
+
+    return result;
+}
+
+// Minimal multiprecision helpers on little-endian 64-bit limbs
+static void limbs_mul_add(std::vector<uint64>& acc, const std::vector<uint64>& a, uint64 w) {
+    uint128 carry = 0;
+    for (std::size_t i = 0; i < acc.size(); ++i) {
+        uint128 term = carry + acc[i];
+        if (i < a.size()) term += static_cast<uint128>(a[i]) * w;
+        acc[i] = static_cast<uint64>(term);
+        carry = term >> 64;
+    }
+}
+
+static bool limbs_less(const std::vector<uint64>& a, const std::vector<uint64>& b) {
+    for (std::size_t i = a.size(); i-- > 0;) {
+        uint64 bi = i < b.size() ? b[i] : 0;
+        if (a[i] != bi) return a[i] < bi;
+    }
+    return false;
+}
+
+static void limbs_sub(std::vector<uint64>& a, const std::vector<uint64>& b) {
+    uint64 borrow = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        uint64 bi = i < b.size() ? b[i] : 0;
+        uint128 sub = static_cast<uint128>(bi) + borrow;
+        borrow = static_cast<uint128>(a[i]) < sub ? 1 : 0;
+        a[i] = static_cast<uint64>(static_cast<uint128>(a[i]) - sub);
+    }
+}
+
+static long double limbs_to_long_double(const std::vector<uint64>& a) {
+    long double v = 0.0L;
+    for (std::size_t i = a.size(); i-- > 0;) {
+        v = v * 18446744073709551616.0L + static_cast<long double>(a[i]);
+    }
+    return v;
+}
+
+std::vector<std::vector<uint64>> compose(const RNSPolynomial& x, const RNSBase& base) {
+    if (x.ntt_form || x.prime_count() != base.size()) {
+        throw std::runtime_error("CRT composition expects a coefficient-form polynomial in the base");
+    }
+
+    std::size_t k = base.size();
+    std::size_t limbs = k + 1;
+
+    // Q and Q/q_i as multiprecision integers
+    std::vector<uint64> big_q(limbs, 0);
+    big_q[0] = 1;
+    std::vector<std::vector<uint64>> q_hat(k, std::vector<uint64>(limbs, 0));
+    for (std::size_t i = 0; i < k; ++i) q_hat[i][0] = 1;
+
+    for (std::size_t i = 0; i < k; ++i) {
+        std::vector<uint64> next(limbs, 0);
+        limbs_mul_add(next, big_q, base.primes[i]);
+        big_q = next;
+        for (std::size_t l = 0; l < k; ++l) {
+            if (l == i) continue;
+            std::vector<uint64> scaled(limbs, 0);
+            limbs_mul_add(scaled, q_hat[l], base.primes[i]);
+            q_hat[l] = scaled;
+        }
+    }
+
+    std::vector<std::vector<uint64>> result(x.degree(), std::vector<uint64>(limbs, 0));
+    for (std::size_t c = 0; c < x.degree(); ++c) {
+        std::vector<uint64>& acc = result[c];
+        for (std::size_t i = 0; i < k; ++i) {
+            uint64 y = core::mul_mod(x.residues[i][c], base.q_hat_inv[i], base.primes[i]);
+            limbs_mul_add(acc, q_hat[i], y);
+        }
+        // The sum is below k * Q
+        while (!limbs_less(acc, big_q)) {
+            limbs_sub(acc, big_q);
+        }
+    }
+
+    return result;
+}
+
+std::vector<long double> compose_centered(const RNSPolynomial& x, const RNSBase& base) {
+    std::vector<std::vector<uint64>> composed = compose(x, base);
+
+    std::vector<uint64> big_q(base.size() + 1, 0);
+    big_q[0] = 1;
+    for (uint64 p : base.primes) {
+        std::vector<uint64> next(big_q.size(), 0);
+        limbs_mul_add(next, big_q, p);
+        big_q = next;
+    }
+    std::vector<uint64> half_q = big_q;
+    for (std::size_t i = 0; i < half_q.size(); ++i) {
+        half_q[i] = (half_q[i] >> 1) | (i + 1 < half_q.size() ? half_q[i + 1] << 63 : 0);
+    }
+
+    std::vector<long double> result(composed.size());
+    for (std::size_t c = 0; c < composed.size(); ++c) {
+        if (limbs_less(half_q, composed[c])) {
+            std::vector<uint64> neg = big_q;
+            limbs_sub(neg, composed[c]);
+            result[c] = -limbs_to_long_double(neg);
+        } else {
+            result[c] = limbs_to_long_double(composed[c]);
+        }
+    }
+    return result;
+}
+
+}
+}
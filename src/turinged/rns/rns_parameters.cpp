@@ -0,0 +1,227 @@
+#include "turinged/rns/rns_parameters.hpp"
+#include "turinged/core/math_utils.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace turinged {
+namespace rns {
+
+const RNSLevel& RNSParameters::level(std::size_t l) const {
+    if (l >= levels.size()) {
+        throw std::runtime_error("Level exceeds the modulus chain");
+    }
+    return levels[l];
+}
+
+// Chain constants shared by BFV and CKKS
+static RNSLevel create_level(std::size_t n, const std::vector<uint64>& q_primes) {
+    RNSLevel level;
+    level.q_base = create_rns_base(n, q_primes);
+
+    uint64 last = q_primes.back();
+    for (std::size_t i = 0; i + 1 < q_primes.size(); ++i) {
+        uint64 q = q_primes[i];
+        level.last_prime_inv.push_back(core::pow_mod(last % q, q - 2, q));
+    }
+
+    return level;
+}
+
+// BFV encoding and scale-and-round constants for one level
+static void add_bfv_constants(RNSLevel& level, std::size_t n, int64 t, const RNSBase& p_base) {
+    const std::vector<uint64>& q_primes = level.q_base.primes;
+    const std::vector<uint64>& p_primes = p_base.primes;
+
+    std::vector<uint64> qp_primes = q_primes;
+    qp_primes.insert(qp_primes.end(), p_primes.begin(), p_primes.end());
+    level.qp_base = create_rns_base(n, qp_primes);
+
+    level.q_to_p = create_base_converter(level.q_base, p_base);
+    level.p_to_q = create_base_converter(p_base, level.q_base);
+
+    // floor(Q/t) = (Q - (Q mod t)) / t, and Q = 0 mod q_i
+    int64 q_mod_t = 1;
+    for (uint64 q : q_primes) {
+        q_mod_t = static_cast<int64>(core::mul_mod(static_cast<uint64>(q_mod_t), q % static_cast<uint64>(t), static_cast<uint64>(t)));
+    }
+    for (uint64 q : q_primes) {
+        uint64 t_inv = core::pow_mod(static_cast<uint64>(t) % q, q - 2, q);
+        uint64 neg_r = (q - static_cast<uint64>(q_mod_t) % q) % q;
+        level.delta_mod_q.push_back(core::mul_mod(neg_r, t_inv, q));
+    }
+
+    // Scale-and-round constants
+    std::size_t k = q_primes.size();
+    level.scale_integer.assign(k, std::vector<uint64>(p_primes.size()));
+    for (std::size_t i = 0; i < k; ++i) {
+        uint64 q = q_primes[i];
+
+        uint64 p_mod_q = 1;
+        for (uint64 p : p_primes) p_mod_q = core::mul_mod(p_mod_q, p % q, q);
+
+        uint64 q_hat_inv = level.q_base.q_hat_inv[i];
+        uint64 p_inv = core::pow_mod(p_mod_q, q - 2, q);
+        level.scale_y_factor.push_back(core::mul_mod(q_hat_inv, p_inv, q));
+
+        // r_i = t * P mod q_i gives F_i = r_i / q_i and I_i = (t*P - r_i) / q_i
+        uint64 r = core::mul_mod(static_cast<uint64>(t) % q, p_mod_q, q);
+        level.scale_fraction.push_back(static_cast<long double>(r) / static_cast<long double>(q));
+
+        for (std::size_t j = 0; j < p_primes.size(); ++j) {
+            uint64 p = p_primes[j];
+            uint64 q_inv = core::pow_mod(q % p, p - 2, p);
+            uint64 neg_r = (p - r % p) % p;
+            level.scale_integer[i][j] = core::mul_mod(neg_r, q_inv, p);
+        }
+    }
+    for (uint64 p : p_primes) {
+        uint64 q_mod_p = 1;
+        for (uint64 q : q_primes) q_mod_p = core::mul_mod(q_mod_p, q % p, p);
+        uint64 q_inv = core::pow_mod(q_mod_p, p - 2, p);
+        level.scale_t_q_inv.push_back(core::mul_mod(static_cast<uint64>(t) % p, q_inv, p));
+    }
+}
+
+RNSParameters create_rns_parameters(
+    std::size_t n,
+    int64 t,
+    int64 noise_bound,
+    int prime_bits,
+    std::size_t prime_count
+) {
+    if (t < 2) {
+        throw std::runtime_error("Plaintext modulus must be at least 2");
+    }
+
+    RNSParameters params;
+    params.n = n;
+    params.t = t;
+    params.noise_bound = noise_bound;
+
+    std::vector<uint64> q_primes = generate_ntt_primes(prime_bits, n, prime_count);
+    if (q_primes.back() <= static_cast<uint64>(t)) {
+        throw std::runtime_error("RNS primes must exceed the plaintext modulus");
+    }
+
+    // P must hold round(t * x / Q) for tensor coefficients x up to 2 * n * (Q/2)^2
+    // at the top level, which then covers every lower level too
+    long double log_q = log2_modulus(create_rns_base(n, q_primes));
+    long double needed = log_q + std::log2(static_cast<long double>(t) * static_cast<long double>(n)) + 4.0L;
+    std::vector<uint64> p_primes;
+    long double log_p = 0.0L;
+    while (log_p < needed) {
+        std::vector<uint64> exclude = q_primes;
+        exclude.insert(exclude.end(), p_primes.begin(), p_primes.end());
+        uint64 p = generate_ntt_primes(prime_bits, n, 1, exclude)[0];
+        p_primes.push_back(p);
+        log_p += std::log2(static_cast<long double>(p));
+    }
+    params.p_base = create_rns_base(n, p_primes);
+
+    for (std::size_t l = 1; l <= prime_count; ++l) {
+        std::vector<uint64> prefix(q_primes.begin(), q_primes.begin() + l);
+        RNSLevel level = create_level(n, prefix);
+        add_bfv_constants(level, n, t, params.p_base);
+        params.levels.push_back(level);
+    }
+
+    return params;
+}
+
+RNSParameters create_ckks_parameters(
+    std::size_t n,
+    int64 noise_bound,
+    int prime_bits,
+    std::size_t prime_count
+) {
+    RNSParameters params;
+    params.n = n;
+    params.t = 0;
+    params.noise_bound = noise_bound;
+
+    std::vector<uint64> q_primes = generate_ntt_primes(prime_bits, n, prime_count);
+    for (std::size_t l = 1; l <= prime_count; ++l) {
+        std::vector<uint64> prefix(q_primes.begin(), q_primes.begin() + l);
+        params.levels.push_back(create_level(n, prefix));
+    }
+
+    return params;
+}
+
+std::size_t level_of(const RNSPolynomial& a) {
+    if (a.prime_count() == 0) {
+        throw std::runtime_error("RNS polynomial has no residues");
+    }
+    return a.prime_count() - 1;
+}
+
+RNSPolynomial scale_message(const Polynomial& message, const RNSParameters& params, std::size_t level) {
+    if (params.t == 0) {
+        throw std::runtime_error("Integer encoding requires parameters with a plaintext modulus");
+    }
+
+    const RNSLevel& lvl = params.level(level);
+    const RNSBase& base = lvl.q_base;
+    RNSPolynomial result(base.size(), message.size());
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        uint64 q = base.primes[i];
+        for (std::size_t c = 0; c < message.size(); ++c) {
+            uint64 m = static_cast<uint64>(core::modq(message[c], params.t));
+            result.residues[i][c] = core::mul_mod(m, lvl.delta_mod_q[i], q);
+        }
+    }
+    return result;
+}
+
+Polynomial scale_to_plaintext(const RNSPolynomial& phase, const RNSParameters& params) {
+    const RNSBase& base = params.q_base(level_of(phase));
+    if (phase.ntt_form) {
+        throw std::runtime_error("Phase must be a coefficient-form polynomial");
+    }
+
+    // x = sum_i y_i * (Q/q_i) - v*Q, so t*x/Q = sum_i y_i * t / q_i (mod t)
+    Polynomial result(phase.degree());
+    long double t = static_cast<long double>(params.t);
+    for (std::size_t c = 0; c < phase.degree(); ++c) {
+        long double sum = 0.0L;
+        for (std::size_t i = 0; i < base.size(); ++i) {
+            uint64 y = core::mul_mod(phase.residues[i][c], base.q_hat_inv[i], base.primes[i]);
+            sum += static_cast<long double>(y) * t * base.inv_primes[i];
+        }
+        result[c] = core::modq(static_cast<int64>(std::llround(std::fmod(sum, t))), params.t);
+    }
+    return result;
+}
+
+RNSPolynomial rescale_by_last_prime(const RNSPolynomial& x, const RNSParameters& params) {
+    std::size_t l = level_of(x);
+    if (l == 0) {
+        throw std::runtime_error("Cannot drop the last prime of the modulus chain");
+    }
+    if (x.ntt_form) {
+        throw std::runtime_error("Rescaling expects a coefficient-form polynomial");
+    }
+
+    const RNSLevel& lvl = params.level(l);
+    const RNSBase& base = lvl.q_base;
+    uint64 last = base.primes[l];
+
+    // (x - r) / q_l with r the centered residue of x mod q_l
+    RNSPolynomial result = drop_primes(x, l);
+    for (std::size_t c = 0; c < x.degree(); ++c) {
+        uint64 v = x.residues[l][c];
+        bool negative = v > last / 2;
+        uint64 magnitude = negative ? last - v : v;
+        for (std::size_t i = 0; i < l; ++i) {
+            uint64 q = base.primes[i];
+            uint64 r = magnitude % q;
+            if (negative) r = r == 0 ? 0 : q - r;
+            uint64 diff = result.residues[i][c] >= r ? result.residues[i][c] - r : result.residues[i][c] + q - r;
+            result.residues[i][c] = core::mul_mod(diff, lvl.last_prime_inv[i], q);
+        }
+    }
+    return result;
+}
+
+}
+}
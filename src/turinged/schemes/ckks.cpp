@@ -0,0 +1,73 @@
+#include "turinged/schemes/ckks.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include <random>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace turinged {
+namespace schemes {
+
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+CKKSCiphertext encrypt_ckks(
+    const encoding::CKKSPlaintext& plain,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_ckks");
+    const rns::RNSBase& base = params.q_base(params.top_level());
+    std::size_t n = params.n;
+    if (plain.coeffs.size() != n || sk.s.size() != n) {
+        throw std::runtime_error("Plaintext size mismatch with key");
+    }
+
+    CKKSCiphertext ct(base.size(), n);
+    ct.scale = plain.scale;
+
+    // Sample a uniformly mod Q, one residue per prime
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        std::uniform_int_distribution<uint64> uniform_dist(0, base.primes[i] - 1);
+        for (std::size_t c = 0; c < n; ++c) {
+            ct.a.residues[i][c] = uniform_dist(rng);
+        }
+    }
+
+    // Sample noise polynomial e
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+    Polynomial e(n);
+    for (std::size_t c = 0; c < n; ++c) {
+        e[c] = noise_dist(rng);
+    }
+
+    // Compute b = a*s + m + e
+    rns::RNSPolynomial as = rns::multiply(ct.a, rns::to_rns(sk.s, base), base);
+    ct.b = rns::add(rns::add(as, rns::to_rns(plain.coeffs, base), base), rns::to_rns(e, base), base);
+
+    return ct;
+}
+
+std::vector<long double> decrypt_ckks(
+    const CKKSCiphertext& ct,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_ckks");
+    const rns::RNSBase& base = params.q_base(ct.level());
+    if (ct.a.degree() != sk.s.size()) {
+        throw std::runtime_error("Ciphertext size mismatch with key");
+    }
+
+    // Compute b - a*s and lift it to centered integers
+    rns::RNSPolynomial as = rns::multiply(ct.a, rns::to_rns(sk.s, base), base);
+    rns::RNSPolynomial phase = rns::subtract(ct.b, as, base);
+
+    return rns::compose_centered(phase, base);
+}
+
+}
+}
@@ -1,9 +1,21 @@
 #include "turinged/schemes/ggsw.hpp"
 #include "turinged/polynomial/polynomial.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/core/trace.hpp"
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
 
 namespace turinged {
 namespace schemes {
 
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
+
 GGSWCiphertext encrypt_ggsw(
     const Polynomial& message,
     const keys::GLWEPublicKey& pk,
@@ -12,22 +24,133 @@ GGSWCiphertext encrypt_ggsw(
     int l,
     int64 beta
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_ggsw/pk");
     std::size_t k = sk.s.size();
     GGSWCiphertext ggsw_ct(k);
 
     // Encrypt the first k rows: GLev(-S_i * M)
     for (std::size_t i = 0; i < k; ++i) {
+        TURINGED_TRACE_SCOPE_ARG("ggsw.row", "row", i);
         Polynomial si_m = polynomial::negacyclic_multiply(sk.s[i], message, params.q);
         Polynomial neg_si_m = polynomial::negate(si_m, params.q);
         ggsw_ct.glev_rows[i] = encrypt_glev(neg_si_m, pk, params, l, beta);
     }
 
     // Encrypt the final row: GLev(M)
-    ggsw_ct.glev_rows[k] = encrypt_glev(message, pk, params, l, beta);
+    {
+        TURINGED_TRACE_SCOPE_ARG("ggsw.row", "row", k);
+        ggsw_ct.glev_rows[k] = encrypt_glev(message, pk, params, l, beta);
+    }
 
     return ggsw_ct;
 }
 
+SeededGGSWCiphertext encrypt_ggsw_seeded(
+    const Polynomial& message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_ggsw_seeded");
+    std::size_t k = sk.k;
+    SeededGGSWCiphertext ggsw_ct(k);
+
+    // Rows i < k: GLev(-S_i * M), row k: GLev(M)
+    for (std::size_t i = 0; i < k; ++i) {
+        TURINGED_TRACE_SCOPE_ARG("ggsw.row", "row", i);
+        Polynomial si_m = polynomial::negacyclic_multiply(sk.s[i], message, params.q);
+        Polynomial neg_si_m = polynomial::negate(si_m, params.q);
+        ggsw_ct.glev_rows[i] = encrypt_glev_seeded(neg_si_m, sk, params, l, beta, core::derive_seed(seed, i), core::derive_seed(noise_seed, i));
+    }
+    {
+        TURINGED_TRACE_SCOPE_ARG("ggsw.row", "row", k);
+        ggsw_ct.glev_rows[k] = encrypt_glev_seeded(message, sk, params, l, beta, core::derive_seed(seed, k), core::derive_seed(noise_seed, k));
+    }
+
+    return ggsw_ct;
+}
+
+GGSWCiphertext expand_seeded_ggsw(const SeededGGSWCiphertext& ct, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::expand_seeded_ggsw");
+    std::size_t k = ct.glev_rows.size() - 1;
+    GGSWCiphertext ggsw_ct(k);
+    for (std::size_t i = 0; i <= k; ++i) {
+        ggsw_ct.glev_rows[i] = expand_seeded_glev(ct.glev_rows[i], k, params);
+    }
+    return ggsw_ct;
+}
+
+GGSWCiphertext encrypt_ggsw(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_ggsw");
+    PreparedGLWESecretKey prepared = prepare_glwe_secret_key(sk, params);
+    return expand_seeded_ggsw(encrypt_ggsw_seeded(message, prepared, params, l, beta, rng(), rng()), params);
+}
+
+void encrypt_ggsw_seeded(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed,
+    GGSWCiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_ggsw_seeded");
+    std::size_t k = sk.k;
+    if (out.k != k) {
+        throw std::runtime_error("Output ciphertext view does not match the key");
+    }
+
+    // Rows i < k: GLev(-S_i * M), row k: GLev(M)
+    Polynomial neg_si_m(params.n);
+    polynomial::PolynomialView row_message = polynomial::view(neg_si_m, params.q);
+    for (std::size_t i = 0; i < k; ++i) {
+        TURINGED_TRACE_SCOPE_ARG("ggsw.row", "row", i);
+        polynomial::negacyclic_multiply(polynomial::view(sk.s[i], params.q),
+                                        polynomial::ConstPolynomialView(message.data, message.n, params.q), row_message);
+        polynomial::negate(row_message, row_message);
+        encrypt_glev_seeded(row_message, sk, params, beta, core::derive_seed(seed, i), core::derive_seed(noise_seed, i), out.row(i));
+    }
+    {
+        TURINGED_TRACE_SCOPE_ARG("ggsw.row", "row", k);
+        encrypt_glev_seeded(message, sk, params, beta, core::derive_seed(seed, k), core::derive_seed(noise_seed, k), out.row(k));
+    }
+}
+
+void encrypt_ggsw(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    GGSWCiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_ggsw");
+    uint64 seed = rng();
+    encrypt_ggsw_seeded(message, sk, params, beta, seed, rng(), out);
+}
+
+void decrypt_ggsw(
+    ConstGGSWCiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int level_idx,
+    int64 beta,
+    polynomial::PolynomialView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_ggsw");
+    // Decrypt using the last GLev row, which encrypts M
+    decrypt_glev_level(ct.row(ct.k), sk, params, level_idx, beta, out);
+}
+
 Polynomial decrypt_ggsw(
     const GGSWCiphertext& ct,
     const keys::GLWESecretKey& sk,
@@ -35,6 +158,7 @@ Polynomial decrypt_ggsw(
     int level_idx,
     int64 beta
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_ggsw");
     // Decrypt using the last GLev row, which encrypts M
     const GLevCiphertext& final_glev_row = ct.glev_rows.back();
     return decrypt_glev_level(final_glev_row, sk, params, level_idx, beta);
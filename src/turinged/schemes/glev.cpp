@@ -1,15 +1,21 @@
 #include "turinged/schemes/glev.hpp"
 #include "turinged/polynomial/polynomial.hpp"
 #include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/core/trace.hpp"
 #include <random>
 #include <chrono>
 #include <cmath>
 #include <stdexcept>
+#include <thread>
 
 namespace turinged {
 namespace schemes {
 
-static std::mt19937_64 rng(static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
 
 GLevCiphertext encrypt_glev(
     const Polynomial& message,
@@ -18,6 +24,7 @@ GLevCiphertext encrypt_glev(
     int l,
     int64 beta
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glev/pk");
     std::size_t k = pk.pk2.size();
     std::size_t n = params.n;
 
@@ -29,6 +36,8 @@ GLevCiphertext encrypt_glev(
     int64 beta_pow_j = 1;
 
     for (int j = 0; j <= l; ++j) {
+        TURINGED_TRACE_SCOPE_ARG("glev.level", "level", j);
+
         // Calculate scaling factor for this level
         int64 delta_j = params.q / (beta * beta_pow_j);
         if (delta_j == 0) delta_j = 1;
@@ -46,7 +55,7 @@ GLevCiphertext encrypt_glev(
             e1[i] = core::modq(noise_dist(rng), params.q);
         }
 
-        std::vector<Polynomial> e2(k, Polynomial(n));
+        core::PooledVector<Polynomial> e2(k, Polynomial(n));
         for (std::size_t i = 0; i < k; ++i) {
             for (std::size_t co = 0; co < n; ++co) {
                 e2[i][co] = core::modq(noise_dist(rng), params.q);
@@ -58,7 +67,7 @@ GLevCiphertext encrypt_glev(
         Polynomial b = polynomial::add(pk1u, scaled_m, params.q);
         b = polynomial::add(b, e1, params.q);
 
-        std::vector<Polynomial> d_tilde(k, Polynomial(n));
+        core::PooledVector<Polynomial> d_tilde(k, Polynomial(n));
         for (std::size_t i = 0; i < k; ++i) {
             Polynomial tmp = polynomial::negacyclic_multiply(pk.pk2[i], u, params.q);
             d_tilde[i] = polynomial::add(tmp, e2[i], params.q);
@@ -74,6 +83,128 @@ GLevCiphertext encrypt_glev(
     return glev_ct;
 }
 
+SeededGLevCiphertext encrypt_glev_seeded(
+    const Polynomial& message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glev_seeded");
+    SeededGLevCiphertext glev_ct;
+    glev_ct.seed = seed;
+    glev_ct.bodies.reserve(l + 1);
+
+    int64 beta_pow_j = 1;
+
+    for (int j = 0; j <= l; ++j) {
+        TURINGED_TRACE_SCOPE_ARG("glev.level", "level", j);
+        int64 delta_j = params.q / (beta * beta_pow_j);
+        if (delta_j == 0) delta_j = 1;
+
+        Polynomial scaled_m = polynomial::scalar_multiply(message, delta_j, params.q);
+        uint64 level_seed = core::derive_seed(seed, static_cast<uint64>(j));
+        uint64 level_noise_seed = core::derive_seed(noise_seed, static_cast<uint64>(j));
+        glev_ct.bodies.push_back(encrypt_glwe_seeded_scaled(scaled_m, level_seed, level_noise_seed, sk, params).b);
+
+        beta_pow_j *= beta;
+    }
+
+    return glev_ct;
+}
+
+GLevCiphertext expand_seeded_glev(const SeededGLevCiphertext& ct, std::size_t k, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::expand_seeded_glev");
+    GLevCiphertext glev_ct(static_cast<int>(ct.bodies.size()) - 1);
+    for (std::size_t j = 0; j < ct.bodies.size(); ++j) {
+        glev_ct.levels[j].b = ct.bodies[j];
+        glev_ct.levels[j].d_tilde = glwe_mask_from_seed(core::derive_seed(ct.seed, j), k, params);
+    }
+    return glev_ct;
+}
+
+GLevCiphertext encrypt_glev(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int l,
+    int64 beta
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glev");
+    PreparedGLWESecretKey prepared = prepare_glwe_secret_key(sk, params);
+    SeededGLevCiphertext seeded = encrypt_glev_seeded(message, prepared, params, l, beta, rng(), rng());
+    return expand_seeded_glev(seeded, prepared.k, params);
+}
+
+// q / beta^(j+1), at least 1
+static int64 level_delta(int64 q, int64 beta, int j) {
+    int64 beta_pow_j = 1;
+    for (int i = 0; i < j; ++i) {
+        beta_pow_j *= beta;
+    }
+    int64 delta_j = q / (beta * beta_pow_j);
+    return delta_j == 0 ? 1 : delta_j;
+}
+
+void encrypt_glev_seeded(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    uint64 seed,
+    uint64 noise_seed,
+    GLevCiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glev_seeded");
+    for (int j = 0; j <= out.l; ++j) {
+        TURINGED_TRACE_SCOPE_ARG("glev.level", "level", j);
+        uint64 level_seed = core::derive_seed(seed, static_cast<uint64>(j));
+        uint64 level_noise_seed = core::derive_seed(noise_seed, static_cast<uint64>(j));
+        encrypt_glwe_seeded_scaled(message, level_delta(params.q, beta, j), level_seed, level_noise_seed, sk, params, out.level(j));
+    }
+}
+
+void encrypt_glev(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    int64 beta,
+    GLevCiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glev");
+    uint64 seed = rng();
+    encrypt_glev_seeded(message, sk, params, beta, seed, rng(), out);
+}
+
+void decrypt_glev_level(
+    ConstGLevCiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    int level_idx,
+    int64 beta,
+    polynomial::PolynomialView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_glev_level");
+    if (level_idx < 0 || level_idx > ct.l) {
+        throw std::runtime_error("Level index out of bounds");
+    }
+    if (out.q != params.t) {
+        throw std::runtime_error("Output view must carry the plaintext modulus");
+    }
+
+    glwe_phase(ct.level(level_idx), sk, params, out);
+
+    // Scale down and round
+    int64 delta_i = level_delta(params.q, beta, level_idx);
+    for (std::size_t i = 0; i < out.n; ++i) {
+        int64 centered = core::center_rep(out[i], params.q);
+        int64 rounded = (centered >= 0) ? (centered + delta_i / 2) / delta_i : (centered - delta_i / 2) / delta_i;
+        out[i] = core::modq(rounded, params.t);
+    }
+}
+
 Polynomial decrypt_glev_level(
     const GLevCiphertext& ct,
     const keys::GLWESecretKey& sk,
@@ -81,6 +212,7 @@ Polynomial decrypt_glev_level(
     int level_idx,
     int64 beta
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_glev_level");
     if (level_idx >= static_cast<int>(ct.levels.size())) {
         throw std::runtime_error("Level index out of bounds");
     }
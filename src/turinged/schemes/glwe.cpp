@@ -1,21 +1,29 @@
 #include "turinged/schemes/glwe.hpp"
 #include "turinged/polynomial/polynomial.hpp"
 #include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <algorithm>
 #include <random>
 #include <chrono>
 #include <cmath>
 #include <stdexcept>
+#include <thread>
 
 namespace turinged {
 namespace schemes {
 
-static std::mt19937_64 rng(static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
 
 GLWECiphertext encrypt_glwe(
     const Polynomial& message,
     const keys::GLWEPublicKey& pk,
     const Parameters& params
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glwe/pk");
     std::size_t k = pk.pk2.size();
     std::size_t n = params.n;
 
@@ -44,7 +52,7 @@ GLWECiphertext encrypt_glwe(
         e1[i] = core::modq(noise_dist(rng), params.q);
     }
 
-    std::vector<Polynomial> e2(k, Polynomial(n));
+    core::PooledVector<Polynomial> e2(k, Polynomial(n));
     for (std::size_t i = 0; i < k; ++i) {
         for (std::size_t j = 0; j < n; ++j) {
             e2[i][j] = core::modq(noise_dist(rng), params.q);
@@ -60,25 +68,215 @@ GLWECiphertext encrypt_glwe(
         Polynomial tmp = polynomial::negacyclic_multiply(pk.pk2[i], u, params.q);
         ct.d_tilde[i] = polynomial::add(tmp, e2[i], params.q);
     }
+    ct.noise_variance = noise::glwe_public_key_variance(params, k);
+    ct.coherent_variance = noise::glwe_public_key_coherent_variance(params, k);
 
     return ct;
 }
 
+PreparedGLWESecretKey prepare_glwe_secret_key(const keys::GLWESecretKey& sk, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::prepare_glwe_secret_key");
+    PreparedGLWESecretKey prepared;
+    prepared.k = sk.s.size();
+    prepared.s.assign(sk.s.begin(), sk.s.end());
+
+    // Binary secrets keep every product within n * q/2, so the bound for k
+    // accumulated full-size products is conservative
+    prepared.use_ntt = polynomial::ntt_supported(params.n, params.q, prepared.k);
+    if (prepared.use_ntt) {
+        for (const Polynomial& s_i : sk.s) {
+            prepared.s_ntt.push_back(polynomial::to_ntt(s_i, params.q));
+        }
+    }
+    return prepared;
+}
+
+// Rejection sampling on a fixed generator, so a seed expands identically everywhere
+static void sample_mask(std::mt19937_64& gen, int64 q, int64* out, std::size_t count) {
+    uint64 uq = static_cast<uint64>(q);
+    uint64 bits = 1;
+    while (bits < uq - 1) bits = (bits << 1) | 1;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        uint64 v;
+        do {
+            v = gen() & bits;
+        } while (v >= uq);
+        out[i] = static_cast<int64>(v);
+    }
+}
+
+core::PooledVector<Polynomial> glwe_mask_from_seed(uint64 seed, std::size_t k, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::glwe_mask_from_seed");
+    std::mt19937_64 gen(seed);
+    core::PooledVector<Polynomial> mask(k, Polynomial(params.n));
+    for (Polynomial& a : mask) {
+        sample_mask(gen, params.q, a.data(), a.size());
+    }
+    return mask;
+}
+
+// <mask, s> mod q written into out, where mask(i) is the i-th mask polynomial view
+template <typename Mask>
+static void mask_dot_secret(
+    Mask mask,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    polynomial::PolynomialView out
+) {
+    if (!sk.use_ntt) {
+        Polynomial prod(params.n);
+        std::fill(out.begin(), out.end(), 0);
+        for (std::size_t i = 0; i < sk.k; ++i) {
+            polynomial::negacyclic_multiply(mask(i), polynomial::view(sk.s[i], params.q), polynomial::view(prod, params.q));
+            polynomial::add(out, polynomial::view(prod, params.q), out);
+        }
+        return;
+    }
+
+    polynomial::NTTPolynomial acc(params.n);
+    for (std::size_t i = 0; i < sk.k; ++i) {
+        polynomial::ntt_multiply_accumulate(acc, polynomial::to_ntt(mask(i)), sk.s_ntt[i]);
+    }
+    polynomial::from_ntt(acc, out);
+}
+
+SeededGLWECiphertext encrypt_glwe_seeded_scaled(
+    const Polynomial& scaled,
+    uint64 seed,
+    uint64 noise_seed,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glwe_seeded_scaled");
+    std::size_t n = params.n;
+    if (scaled.size() != n) {
+        throw std::runtime_error("Message size mismatch");
+    }
+
+    std::mt19937_64 noise_rng(noise_seed);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+
+    SeededGLWECiphertext ct;
+    ct.seed = seed;
+    ct.b.resize(n);
+    core::PooledVector<Polynomial> mask = glwe_mask_from_seed(seed, sk.k, params);
+    mask_dot_secret([&](std::size_t i) { return polynomial::view(mask[i], params.q); }, sk, params, polynomial::view(ct.b, params.q));
+
+    // b = <mask, s> + scaled + e
+    for (std::size_t i = 0; i < n; ++i) {
+        ct.b[i] = core::modq(ct.b[i] + core::modq(scaled[i], params.q) - params.q + noise_dist(noise_rng), params.q);
+    }
+
+    return ct;
+}
+
+SeededGLWECiphertext encrypt_glwe_seeded(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    uint64 seed
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glwe_seeded");
+    int64 delta = params.q / params.t;
+    Polynomial scaled = polynomial::scalar_multiply(message, delta, params.q);
+    return encrypt_glwe_seeded_scaled(scaled, seed, rng(), prepare_glwe_secret_key(sk, params), params);
+}
+
+void encrypt_glwe_seeded_scaled(
+    polynomial::ConstPolynomialView message,
+    int64 delta,
+    uint64 seed,
+    uint64 noise_seed,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glwe_seeded_scaled");
+    std::size_t n = params.n;
+    if (message.n != n) {
+        throw std::runtime_error("Message size mismatch");
+    }
+    if (out.is_trivial() || out.k != sk.k || out.n != n || out.q != params.q) {
+        throw std::runtime_error("Output ciphertext view does not match the key");
+    }
+
+    std::mt19937_64 gen(seed);
+    sample_mask(gen, params.q, out.mask, sk.k * n);
+    mask_dot_secret([&](std::size_t i) { return polynomial::ConstPolynomialView(out.d_tilde(i)); }, sk, params, out.b());
+
+    // b = <mask, s> + delta * message + e
+    std::mt19937_64 noise_rng(noise_seed);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+    for (std::size_t i = 0; i < n; ++i) {
+        int64 scaled = core::modq(static_cast<int64>((static_cast<int128>(message[i]) * delta) % params.q), params.q);
+        out.body[i] = core::modq(out.body[i] + scaled - params.q + noise_dist(noise_rng), params.q);
+    }
+}
+
+void encrypt_glwe(
+    polynomial::ConstPolynomialView message,
+    const PreparedGLWESecretKey& sk,
+    const Parameters& params,
+    GLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glwe");
+    if (message.q != params.t) {
+        throw std::runtime_error("Message view must carry the plaintext modulus");
+    }
+    uint64 seed = rng();
+    encrypt_glwe_seeded_scaled(message, params.q / params.t, seed, rng(), sk, params, out);
+}
+
+GLWECiphertext expand_seeded_glwe(const SeededGLWECiphertext& ct, std::size_t k, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::expand_seeded_glwe");
+    GLWECiphertext result;
+    result.b = ct.b;
+    result.d_tilde = glwe_mask_from_seed(ct.seed, k, params);
+    result.noise_variance = noise::fresh_variance(params);
+    result.coherent_variance = 0.0;
+    return result;
+}
+
+GLWECiphertext encrypt_glwe(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glwe");
+    return expand_seeded_glwe(encrypt_glwe_seeded(message, sk, params, rng()), sk.s.size(), params);
+}
+
+GLWECiphertext trivial_glwe(const Polynomial& message, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::trivial_glwe");
+    if (message.size() != params.n) {
+        throw std::runtime_error("Message size mismatch");
+    }
+
+    GLWECiphertext ct;
+    int64 delta = params.q / params.t;
+    ct.b = polynomial::scalar_multiply(message, delta, params.q);
+    ct.noise_variance = 0.0;
+    ct.coherent_variance = 0.0;
+    return ct;
+}
+
 Polynomial decrypt_glwe(
     const GLWECiphertext& ct,
     const keys::GLWESecretKey& sk,
     const Parameters& params
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_glwe");
     std::size_t k = sk.s.size();
     std::size_t n = params.n;
 
-    if (ct.d_tilde.size() != k || ct.b.size() != n) {
+    if ((!ct.is_trivial() && ct.d_tilde.size() != k) || ct.b.size() != n) {
         throw std::runtime_error("Ciphertext size mismatch with key");
     }
 
     // Compute d_tilde · s = sum_j d_tilde[j] * s[j]
     Polynomial d_times_s(n, 0);
-    for (std::size_t j = 0; j < k; ++j) {
+    for (std::size_t j = 0; j < ct.d_tilde.size(); ++j) {
         Polynomial prod = polynomial::negacyclic_multiply(ct.d_tilde[j], sk.s[j], params.q);
         d_times_s = polynomial::add(d_times_s, prod, params.q);
     }
@@ -101,5 +299,56 @@ Polynomial decrypt_glwe(
     return m_rec;
 }
 
+void glwe_phase(
+    ConstGLWECiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    polynomial::PolynomialView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::glwe_phase");
+    std::size_t n = params.n;
+    if ((!ct.is_trivial() && ct.k != sk.s.size()) || ct.n != n || ct.q != params.q) {
+        throw std::runtime_error("Ciphertext size mismatch with key");
+    }
+    if (out.n != n) {
+        throw std::runtime_error("Output view does not match the parameters");
+    }
+
+    // Accumulate d_tilde · s in out, then subtract from b in place
+    polynomial::PolynomialView acc(out.data, n, params.q);
+    std::fill(acc.begin(), acc.end(), 0);
+    if (!ct.is_trivial()) {
+        Polynomial prod(n);
+        for (std::size_t j = 0; j < ct.k; ++j) {
+            polynomial::negacyclic_multiply(ct.d_tilde(j), polynomial::view(sk.s[j], params.q), polynomial::view(prod, params.q));
+            polynomial::add(acc, polynomial::view(prod, params.q), acc);
+        }
+    }
+    polynomial::subtract(ct.b(), acc, acc);
+}
+
+void decrypt_glwe(
+    ConstGLWECiphertextView ct,
+    const keys::GLWESecretKey& sk,
+    const Parameters& params,
+    polynomial::PolynomialView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_glwe");
+    if (out.q != params.t) {
+        throw std::runtime_error("Output view must carry the plaintext modulus");
+    }
+    glwe_phase(ct, sk, params, out);
+
+    // Scale down and round
+    int64 delta = params.q / params.t;
+    for (std::size_t i = 0; i < out.n; ++i) {
+        int64 centered = core::center_rep(out[i], params.q);
+        int64 rounded = (centered >= 0) ? (centered + delta / 2) / delta : (centered - delta / 2) / delta;
+        int64 mm = rounded % params.t;
+        if (mm < 0) mm += params.t;
+        out[i] = mm;
+    }
+}
+
 }
 }
\ No newline at end of file
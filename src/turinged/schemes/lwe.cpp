@@ -1,37 +1,53 @@
 #include "turinged/schemes/lwe.hpp"
 #include "turinged/core/math_utils.hpp"
+#include "turinged/core/parallel.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <algorithm>
+#include <limits>
 #include <random>
 #include <chrono>
 #include <cmath>
 #include <stdexcept>
+#include <thread>
 
 namespace turinged {
 namespace schemes {
 
-static std::mt19937_64 rng(static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
 
-LWECiphertext encrypt_lwe(
+static void check_output(LWECiphertextView out, std::size_t k, const Parameters& params) {
+    if (out.is_trivial() || out.dim != k || out.q != params.q) {
+        throw std::runtime_error("Output ciphertext view does not match the key");
+    }
+}
+
+void encrypt_lwe(
     int64 message,
     const keys::LWESecretKey& sk,
-    const Parameters& params
+    const Parameters& params,
+    LWECiphertextView out
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_lwe");
     std::size_t k = sk.s.size();
     if (message < 0 || message >= params.t) {
         throw std::runtime_error("Message out of range");
     }
-
-    LWECiphertext ct(k);
+    check_output(out, k, params);
 
     std::uniform_int_distribution<int64> uniform_dist(0, params.q - 1);
     std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
 
     // Sample random a
     for (std::size_t i = 0; i < k; ++i) {
-        ct.a[i] = uniform_dist(rng);
+        out.a[i] = uniform_dist(rng);
     }
 
     // Compute inner product a·s
-    int64 inner = core::dot_product_modq(ct.a, sk.s, params.q);
+    int64 inner = core::dot_product_modq(out.a, sk.s.data(), k, params.q);
 
     // Compute Delta*m + e
     int64 delta = params.q / params.t;
@@ -42,24 +58,210 @@ LWECiphertext encrypt_lwe(
     int128 s128 = static_cast<int128>(inner) + static_cast<int128>(scaled_m) + static_cast<int128>(e);
     int64 s64 = static_cast<int64>(s128 % params.q);
     if (s64 < 0) s64 += params.q;
-    ct.b = s64;
+    *out.b = s64;
+}
 
+LWECiphertext encrypt_lwe(
+    int64 message,
+    const keys::LWESecretKey& sk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_lwe");
+    LWECiphertext ct(sk.s.size());
+    encrypt_lwe(message, sk, params, view(ct, params.q));
+    ct.noise_variance = noise::fresh_variance(params);
+    ct.coherent_variance = 0.0;
+    return ct;
+}
+
+void encrypt_lwe(
+    int64 message,
+    const keys::LWEPublicKey& pk,
+    const Parameters& params,
+    LWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_lwe/pk");
+    std::size_t k = pk.k;
+    if (pk.samples == 0 || pk.a.size() != k * pk.samples || pk.b.size() != pk.samples) {
+        throw std::runtime_error("Malformed LWE public key");
+    }
+    if (message < 0 || message >= params.t) {
+        throw std::runtime_error("Message out of range");
+    }
+    check_output(out, k, params);
+
+    // Add each zero encryption with probability 1/2
+    std::uniform_int_distribution<int> binary_dist(0, 1);
+    std::vector<int128> acc(k + 1, 0);
+    for (std::size_t r = 0; r < pk.samples; ++r) {
+        if (!binary_dist(rng)) continue;
+        const int64* row = pk.a.data() + r * k;
+        for (std::size_t j = 0; j < k; ++j) {
+            acc[j] += row[j];
+        }
+        acc[k] += pk.b[r];
+    }
+
+    for (std::size_t j = 0; j < k; ++j) {
+        out.a[j] = static_cast<int64>(acc[j] % params.q);
+    }
+    int64 delta = params.q / params.t;
+    *out.b = static_cast<int64>((acc[k] + static_cast<int128>(delta) * message) % params.q);
+}
+
+LWECiphertext encrypt_lwe(
+    int64 message,
+    const keys::LWEPublicKey& pk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_lwe/pk");
+    LWECiphertext ct(pk.k);
+    encrypt_lwe(message, pk, params, view(ct, params.q));
+    ct.noise_variance = noise::lwe_public_key_variance(params, pk.samples);
+    ct.coherent_variance = noise::lwe_public_key_coherent_variance(params, pk.samples);
+    return ct;
+}
+
+// Key rows are taken four at a time: the 16 possible subset sums of a group
+// are built once per tile of MESSAGE_BLOCK messages, and each message then
+// adds a single table entry per group instead of up to four key rows
+static constexpr std::size_t GROUP_BITS = 4;
+static constexpr std::size_t GROUP_SIZE = std::size_t(1) << GROUP_BITS;
+static constexpr std::size_t MESSAGE_BLOCK = 128;
+
+std::vector<LWECiphertext> encrypt_lwe_batch(
+    const std::vector<int64>& messages,
+    const keys::LWEPublicKey& pk,
+    const Parameters& params,
+    std::size_t num_threads
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_lwe_batch");
+    std::size_t k = pk.k;
+    std::size_t samples = pk.samples;
+    if (samples == 0 || pk.a.size() != k * samples || pk.b.size() != samples) {
+        throw std::runtime_error("Malformed LWE public key");
+    }
+    for (int64 m : messages) {
+        if (m < 0 || m >= params.t) {
+            throw std::runtime_error("Message out of range");
+        }
+    }
+
+    // One selector bit per (message, key row); bits past the last row are cleared
+    std::size_t words = (samples + 63) / 64;
+    uint64 tail_mask = samples % 64 == 0 ? ~uint64(0) : (uint64(1) << (samples % 64)) - 1;
+    std::vector<uint64> selectors(messages.size() * words);
+    for (std::size_t i = 0; i < selectors.size(); ++i) {
+        selectors[i] = rng();
+        if (i % words == words - 1) selectors[i] &= tail_mask;
+    }
+
+    // Table entries are below q, so `lazy` additions fit in 64 bits before the
+    // accumulators need reducing
+    uint64 q = static_cast<uint64>(params.q);
+    std::size_t lazy = static_cast<std::size_t>(std::numeric_limits<uint64>::max() / q - 1);
+    int64 delta = params.q / params.t;
+    std::size_t width = k + 1;
+    std::size_t groups = (samples + GROUP_BITS - 1) / GROUP_BITS;
+
+    std::vector<LWECiphertext> result(messages.size(), LWECiphertext(k));
+    std::size_t blocks = (messages.size() + MESSAGE_BLOCK - 1) / MESSAGE_BLOCK;
+
+    core::parallel_for(blocks, [&](std::size_t block) {
+        std::size_t first = block * MESSAGE_BLOCK;
+        std::size_t count = std::min(MESSAGE_BLOCK, messages.size() - first);
+
+        // Row i of acc is (a, b) of message first + i; table row e is the sum of
+        // the group rows selected by the bits of e
+        std::vector<uint64> acc(count * width, 0);
+        std::vector<uint64> table(GROUP_SIZE * width, 0);
+        std::size_t pending = 0;
+
+        for (std::size_t g = 0; g < groups; ++g) {
+            std::size_t r0 = g * GROUP_BITS;
+
+            for (std::size_t e = 1; e < GROUP_SIZE; ++e) {
+                std::size_t low = e & (~e + 1);
+                std::size_t bit = 0;
+                while ((std::size_t(1) << bit) != low) ++bit;
+
+                uint64* dst = table.data() + e * width;
+                const uint64* src = table.data() + (e ^ low) * width;
+                std::size_t r = r0 + bit;
+                if (r >= samples) {
+                    std::copy(src, src + width, dst);
+                    continue;
+                }
+                const int64* row = pk.a.data() + r * k;
+                for (std::size_t j = 0; j < k; ++j) {
+                    uint64 sum = src[j] + static_cast<uint64>(row[j]);
+                    dst[j] = sum >= q ? sum - q : sum;
+                }
+                uint64 sum = src[k] + static_cast<uint64>(pk.b[r]);
+                dst[k] = sum >= q ? sum - q : sum;
+            }
+
+            if (pending == lazy) {
+                for (uint64& v : acc) v %= q;
+                pending = 0;
+            }
+
+            for (std::size_t i = 0; i < count; ++i) {
+                uint64 word = selectors[(first + i) * words + r0 / 64];
+                std::size_t entry = static_cast<std::size_t>((word >> (r0 % 64)) & (GROUP_SIZE - 1));
+                const uint64* src = table.data() + entry * width;
+                uint64* out = acc.data() + i * width;
+                for (std::size_t j = 0; j < width; ++j) {
+                    out[j] += src[j];
+                }
+            }
+            pending++;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const uint64* out = acc.data() + i * width;
+            LWECiphertext& ct = result[first + i];
+            for (std::size_t j = 0; j < k; ++j) {
+                ct.a[j] = static_cast<int64>(out[j] % q);
+            }
+            uint64 scaled = static_cast<uint64>((static_cast<int128>(delta) * messages[first + i]) % params.q);
+            ct.b = static_cast<int64>((out[k] % q + scaled) % q);
+            ct.noise_variance = noise::lwe_public_key_variance(params, samples);
+            ct.coherent_variance = noise::lwe_public_key_coherent_variance(params, samples);
+        }
+    }, num_threads);
+
+    return result;
+}
+
+LWECiphertext trivial_lwe(int64 message, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::trivial_lwe");
+    if (message < 0 || message >= params.t) {
+        throw std::runtime_error("Message out of range");
+    }
+
+    LWECiphertext ct;
+    int64 delta = params.q / params.t;
+    ct.b = static_cast<int64>((static_cast<int128>(delta) * message) % params.q);
+    ct.noise_variance = 0.0;
+    ct.coherent_variance = 0.0;
     return ct;
 }
 
 int64 decrypt_lwe(
-    const LWECiphertext& ct,
+    ConstLWECiphertextView ct,
     const keys::LWESecretKey& sk,
     const Parameters& params
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_lwe");
     std::size_t k = sk.s.size();
-    if (ct.a.size() != k) {
+    if ((!ct.is_trivial() && ct.dim != k) || ct.q != params.q) {
         throw std::runtime_error("Ciphertext size mismatch with secret key");
     }
 
     // Compute b - a·s (mod q)
-    int64 inner = core::dot_product_modq(ct.a, sk.s, params.q);
-    int64 diff = core::modq(ct.b - inner, params.q);
+    int64 inner = ct.is_trivial() ? 0 : core::dot_product_modq(ct.a, sk.s.data(), k, params.q);
+    int64 diff = core::modq(*ct.b - inner, params.q);
 
     // Choose centered representative
     int64 centered = core::center_rep(diff, params.q);
@@ -76,5 +278,14 @@ int64 decrypt_lwe(
     return m_hat;
 }
 
+int64 decrypt_lwe(
+    const LWECiphertext& ct,
+    const keys::LWESecretKey& sk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_lwe");
+    return decrypt_lwe(view(ct, params.q), sk, params);
+}
+
+}
 }
-}
\ No newline at end of file
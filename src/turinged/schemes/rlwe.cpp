@@ -1,88 +1,268 @@
 #include "turinged/schemes/rlwe.hpp"
 #include "turinged/polynomial/polynomial.hpp"
+#include "turinged/polynomial/ntt.hpp"
 #include "turinged/core/math_utils.hpp"
+#include "turinged/core/parallel.hpp"
+#include "turinged/core/metrics.hpp"
+#include "turinged/noise/noise.hpp"
+#include <algorithm>
 #include <random>
 #include <chrono>
 #include <cmath>
 #include <stdexcept>
+#include <thread>
 
 namespace turinged {
 namespace schemes {
 
-static std::mt19937_64 rng(static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()));
+// One generator per thread so encryptions can run concurrently from worker pools
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
 
-RLWECiphertext encrypt_rlwe(
-    const Polynomial& message,
+static void check_message(polynomial::ConstPolynomialView message, const Parameters& params) {
+    if (message.n != params.n || message.q != params.t) {
+        throw std::runtime_error("Message size mismatch with key");
+    }
+}
+
+static void check_output(RLWECiphertextView out, const Parameters& params) {
+    if (out.is_trivial() || out.a.n != params.n || out.b.n != params.n || out.a.q != params.q || out.b.q != params.q) {
+        throw std::runtime_error("Output ciphertext view does not match the parameters");
+    }
+}
+
+// b[i] += Delta * m[i] (mod q)
+static void add_scaled_message(polynomial::ConstPolynomialView message, const Parameters& params, polynomial::PolynomialView b) {
+    int64 delta = params.q / params.t;
+    for (std::size_t i = 0; i < b.n; ++i) {
+        int64 scaled = core::modq(static_cast<int64>((static_cast<int128>(message[i]) * delta) % params.q), params.q);
+        b[i] = core::modq(b[i] + scaled - params.q, params.q);
+    }
+}
+
+void encrypt_rlwe(
+    polynomial::ConstPolynomialView message,
     const keys::RLWESecretKey& sk,
-    const Parameters& params
+    const Parameters& params,
+    RLWECiphertextView out
 ) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_rlwe");
     std::size_t n = sk.s.size();
-    if (message.size() != n) {
+    if (n != params.n) {
         throw std::runtime_error("Message size mismatch with key");
     }
-
-    RLWECiphertext ct(n);
+    check_message(message, params);
+    check_output(out, params);
 
     std::uniform_int_distribution<int64> uniform_dist(0, params.q - 1);
     std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
 
     // Sample random polynomial a
     for (std::size_t i = 0; i < n; ++i) {
-        ct.a[i] = uniform_dist(rng);
+        out.a[i] = uniform_dist(rng);
     }
 
-    // Sample noise polynomial e
-    Polynomial e(n);
+    // b = a*s + delta*m + e, built in place
+    polynomial::negacyclic_multiply(out.a, polynomial::view(sk.s, params.q), out.b);
+    add_scaled_message(message, params, out.b);
     for (std::size_t i = 0; i < n; ++i) {
-        e[i] = core::modq(noise_dist(rng), params.q);
+        out.b[i] = core::modq(out.b[i] + noise_dist(rng), params.q);
     }
+}
 
-    // Scale message
-    int64 delta = params.q / params.t;
-    Polynomial scaled_m = polynomial::scalar_multiply(message, delta, params.q);
+RLWECiphertext encrypt_rlwe(
+    const Polynomial& message,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_rlwe");
+    RLWECiphertext ct(params.n);
+    encrypt_rlwe(polynomial::view(message, params.t), sk, params, view(ct, params.q));
+    ct.noise_variance = noise::fresh_variance(params);
+    ct.coherent_variance = 0.0;
+    return ct;
+}
 
-    // Compute a*s
-    Polynomial as = polynomial::negacyclic_multiply(ct.a, sk.s, params.q);
+struct PublicKeyRandomness {
+    Polynomial u;
+    Polynomial e1;
+    Polynomial e2;
+};
 
-    // Compute b = a*s + delta*m + e
-    ct.b = polynomial::add(polynomial::add(as, scaled_m, params.q), e, params.q);
+static PublicKeyRandomness sample_public_key_randomness(const Parameters& params) {
+    std::uniform_int_distribution<int> binary_dist(0, 1);
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
 
-    return ct;
+    PublicKeyRandomness r{Polynomial(params.n), Polynomial(params.n), Polynomial(params.n)};
+    for (std::size_t j = 0; j < params.n; ++j) {
+        r.u[j] = binary_dist(rng);
+        r.e1[j] = core::modq(noise_dist(rng), params.q);
+        r.e2[j] = core::modq(noise_dist(rng), params.q);
+    }
+    return r;
 }
 
-Polynomial decrypt_rlwe(
-    const RLWECiphertext& ct,
-    const keys::RLWESecretKey& sk,
+static void check_public_key(const keys::RLWEPublicKey& pk, const Parameters& params) {
+    if (pk.a.size() != params.n || pk.b.size() != params.n) {
+        throw std::runtime_error("Public key size mismatch");
+    }
+}
+
+// (a*u + e2, b*u + e1 + Delta*m); pk_ntt holds the transformed key when the NTT path applies
+static void encrypt_with_randomness(
+    polynomial::ConstPolynomialView message,
+    const keys::RLWEPublicKey& pk,
+    const polynomial::NTTPolynomial* pk_ntt,
+    const PublicKeyRandomness& r,
+    const Parameters& params,
+    RLWECiphertextView out
+) {
+    int64 q = params.q;
+    if (pk_ntt) {
+        polynomial::NTTPolynomial u_ntt = polynomial::to_ntt(r.u, q);
+        polynomial::from_ntt(polynomial::ntt_multiply(pk_ntt[0], u_ntt), out.a);
+        polynomial::from_ntt(polynomial::ntt_multiply(pk_ntt[1], u_ntt), out.b);
+    } else {
+        polynomial::negacyclic_multiply(polynomial::view(pk.a, q), polynomial::view(r.u, q), out.a);
+        polynomial::negacyclic_multiply(polynomial::view(pk.b, q), polynomial::view(r.u, q), out.b);
+    }
+
+    polynomial::add(out.a, polynomial::view(r.e2, q), out.a);
+    polynomial::add(out.b, polynomial::view(r.e1, q), out.b);
+    add_scaled_message(message, params, out.b);
+}
+
+void encrypt_rlwe(
+    polynomial::ConstPolynomialView message,
+    const keys::RLWEPublicKey& pk,
+    const Parameters& params,
+    RLWECiphertextView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_rlwe/pk");
+    check_public_key(pk, params);
+    check_message(message, params);
+    check_output(out, params);
+
+    PublicKeyRandomness r = sample_public_key_randomness(params);
+    if (polynomial::ntt_supported(params.n, params.q)) {
+        polynomial::NTTPolynomial pk_ntt[2] = {polynomial::to_ntt(pk.a, params.q), polynomial::to_ntt(pk.b, params.q)};
+        encrypt_with_randomness(message, pk, pk_ntt, r, params, out);
+    } else {
+        encrypt_with_randomness(message, pk, nullptr, r, params, out);
+    }
+}
+
+RLWECiphertext encrypt_rlwe(
+    const Polynomial& message,
+    const keys::RLWEPublicKey& pk,
     const Parameters& params
 ) {
-    std::size_t n = sk.s.size();
-    if (ct.a.size() != n || ct.b.size() != n) {
-        throw std::runtime_error("Ciphertext size mismatch with key");
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_rlwe/pk");
+    RLWECiphertext ct(params.n);
+    encrypt_rlwe(polynomial::view(message, params.t), pk, params, view(ct, params.q));
+    ct.noise_variance = noise::glwe_public_key_variance(params, 1);
+    ct.coherent_variance = noise::glwe_public_key_coherent_variance(params, 1);
+    return ct;
+}
+
+std::vector<RLWECiphertext> encrypt_rlwe_batch(
+    const std::vector<Polynomial>& messages,
+    const keys::RLWEPublicKey& pk,
+    const Parameters& params,
+    std::size_t num_threads
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_rlwe_batch");
+    check_public_key(pk, params);
+    for (const Polynomial& m : messages) {
+        check_message(polynomial::view(m, params.t), params);
     }
 
-    // Compute a*s
-    Polynomial as = polynomial::negacyclic_multiply(ct.a, sk.s, params.q);
+    // Randomness is drawn sequentially; only the products run in parallel
+    std::vector<PublicKeyRandomness> randomness;
+    randomness.reserve(messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        randomness.push_back(sample_public_key_randomness(params));
+    }
+
+    bool use_ntt = polynomial::ntt_supported(params.n, params.q);
+    polynomial::NTTPolynomial pk_ntt[2];
+    if (use_ntt) {
+        pk_ntt[0] = polynomial::to_ntt(pk.a, params.q);
+        pk_ntt[1] = polynomial::to_ntt(pk.b, params.q);
+    }
 
-    // Compute b - a*s
-    Polynomial diff = polynomial::subtract(ct.b, as, params.q);
+    std::vector<RLWECiphertext> result(messages.size(), RLWECiphertext(params.n));
 
-    // Get centered representation
-    std::vector<int64> centered = polynomial::center_representation(diff, params.q);
+    core::parallel_for(messages.size(), [&](std::size_t i) {
+        encrypt_with_randomness(polynomial::view(messages[i], params.t), pk, use_ntt ? pk_ntt : nullptr,
+                                randomness[i], params, view(result[i], params.q));
+        result[i].noise_variance = noise::glwe_public_key_variance(params, 1);
+        result[i].coherent_variance = noise::glwe_public_key_coherent_variance(params, 1);
+    }, num_threads);
+
+    return result;
+}
+
+RLWECiphertext trivial_rlwe(const Polynomial& message, const Parameters& params) {
+    TURINGED_OPERATION_SCOPE("schemes::trivial_rlwe");
+    if (message.size() != params.n) {
+        throw std::runtime_error("Message size mismatch");
+    }
 
-    // Scale down and round
+    RLWECiphertext ct;
     int64 delta = params.q / params.t;
-    Polynomial m_hat(n);
+    ct.b = polynomial::scalar_multiply(message, delta, params.q);
+    ct.noise_variance = 0.0;
+    ct.coherent_variance = 0.0;
+    return ct;
+}
+
+void decrypt_rlwe(
+    ConstRLWECiphertextView ct,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params,
+    polynomial::PolynomialView out
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_rlwe");
+    std::size_t n = sk.s.size();
+    if ((!ct.is_trivial() && ct.a.n != n) || ct.b.n != n || ct.q() != params.q) {
+        throw std::runtime_error("Ciphertext size mismatch with key");
+    }
+    if (out.n != n || out.q != params.t) {
+        throw std::runtime_error("Output view does not match the parameters");
+    }
 
+    // The phase b - a*s is built mod q in the output buffer, then scaled down in place
+    polynomial::PolynomialView phase(out.data, n, params.q);
+    if (ct.is_trivial()) {
+        std::copy(ct.b.begin(), ct.b.end(), phase.begin());
+    } else {
+        polynomial::negacyclic_multiply(ct.a, polynomial::view(sk.s, params.q), phase);
+        polynomial::subtract(ct.b, phase, phase);
+    }
+
+    // Scale down and round the centered representative
+    int64 delta = params.q / params.t;
     for (std::size_t i = 0; i < n; ++i) {
-        double val = static_cast<double>(centered[i]) / static_cast<double>(delta);
+        double val = static_cast<double>(core::center_rep(phase[i], params.q)) / static_cast<double>(delta);
         int64 rounded = static_cast<int64>(std::llround(val));
         int64 m_coeff = rounded % params.t;
         if (m_coeff < 0) m_coeff += params.t;
-        m_hat[i] = m_coeff;
+        out[i] = m_coeff;
     }
+}
 
+Polynomial decrypt_rlwe(
+    const RLWECiphertext& ct,
+    const keys::RLWESecretKey& sk,
+    const Parameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_rlwe");
+    Polynomial m_hat(params.n);
+    decrypt_rlwe(view(ct, params.q), sk, params, polynomial::view(m_hat, params.t));
     return m_hat;
 }
 
 }
-}
\ No newline at end of file
+}
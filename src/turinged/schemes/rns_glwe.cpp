@@ -0,0 +1,96 @@
+#include "turinged/schemes/rns_glwe.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include <random>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace turinged {
+namespace schemes {
+
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+RNSGLWECiphertext encrypt_glwe_rns(
+    const Polynomial& message,
+    const keys::GLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_glwe_rns");
+    const rns::RNSBase& base = params.q_base(params.top_level());
+    std::size_t k = sk.s.size();
+    std::size_t n = params.n;
+
+    if (message.size() != n) {
+        throw std::runtime_error("Message size mismatch");
+    }
+
+    RNSGLWECiphertext ct(k, base.size(), n);
+
+    // Sample noise polynomial e
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+    Polynomial e(n);
+    for (std::size_t c = 0; c < n; ++c) {
+        e[c] = noise_dist(rng);
+    }
+
+    // b = sum_j d_tilde[j] * s_j + Delta*m + e, accumulated in the NTT domain
+    rns::RNSPolynomial acc(base.size(), n);
+    acc.ntt_form = true;
+    for (std::size_t j = 0; j < k; ++j) {
+        for (std::size_t i = 0; i < base.size(); ++i) {
+            std::uniform_int_distribution<uint64> uniform_dist(0, base.primes[i] - 1);
+            for (std::size_t c = 0; c < n; ++c) {
+                ct.d_tilde[j].residues[i][c] = uniform_dist(rng);
+            }
+        }
+
+        rns::RNSPolynomial d_ntt = ct.d_tilde[j];
+        rns::RNSPolynomial s_ntt = rns::to_rns(sk.s[j], base);
+        rns::to_ntt_inplace(d_ntt, base);
+        rns::to_ntt_inplace(s_ntt, base);
+        rns::multiply_accumulate_ntt(acc, d_ntt, s_ntt, base);
+    }
+    rns::from_ntt_inplace(acc, base);
+
+    ct.b = rns::add(rns::add(acc, rns::scale_message(message, params, params.top_level()), base), rns::to_rns(e, base), base);
+
+    return ct;
+}
+
+Polynomial decrypt_glwe_rns(
+    const RNSGLWECiphertext& ct,
+    const keys::GLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_glwe_rns");
+    const rns::RNSBase& base = params.q_base(ct.level());
+    std::size_t k = sk.s.size();
+    std::size_t n = params.n;
+
+    if (ct.d_tilde.size() != k || ct.b.degree() != n || ct.b.prime_count() != base.size()) {
+        throw std::runtime_error("Ciphertext size mismatch with key");
+    }
+
+    // Compute d_tilde · s in the NTT domain
+    rns::RNSPolynomial acc(base.size(), n);
+    acc.ntt_form = true;
+    for (std::size_t j = 0; j < k; ++j) {
+        rns::RNSPolynomial d_ntt = ct.d_tilde[j];
+        rns::RNSPolynomial s_ntt = rns::to_rns(sk.s[j], base);
+        rns::to_ntt_inplace(d_ntt, base);
+        rns::to_ntt_inplace(s_ntt, base);
+        rns::multiply_accumulate_ntt(acc, d_ntt, s_ntt, base);
+    }
+    rns::from_ntt_inplace(acc, base);
+
+    rns::RNSPolynomial phase = rns::subtract(ct.b, acc, base);
+
+    return rns::scale_to_plaintext(phase, params);
+}
+
+}
+}
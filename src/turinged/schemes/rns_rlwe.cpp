@@ -0,0 +1,72 @@
+#include "turinged/schemes/rns_rlwe.hpp"
+#include "turinged/core/math_utils.hpp"
+#include "turinged/core/metrics.hpp"
+#include <random>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace turinged {
+namespace schemes {
+
+// One generator per thread so calls can run concurrently
+static thread_local std::mt19937_64 rng(core::derive_seed(
+    static_cast<uint64>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+    std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+RNSRLWECiphertext encrypt_rlwe_rns(
+    const Polynomial& message,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::encrypt_rlwe_rns");
+    const rns::RNSBase& base = params.q_base(params.top_level());
+    std::size_t n = params.n;
+    if (message.size() != n || sk.s.size() != n) {
+        throw std::runtime_error("Message size mismatch with key");
+    }
+
+    RNSRLWECiphertext ct(base.size(), n);
+
+    // Sample a uniformly mod Q, one residue per prime
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        std::uniform_int_distribution<uint64> uniform_dist(0, base.primes[i] - 1);
+        for (std::size_t c = 0; c < n; ++c) {
+            ct.a.residues[i][c] = uniform_dist(rng);
+        }
+    }
+
+    // Sample noise polynomial e
+    std::uniform_int_distribution<int64> noise_dist(-params.noise_bound, params.noise_bound);
+    Polynomial e(n);
+    for (std::size_t c = 0; c < n; ++c) {
+        e[c] = noise_dist(rng);
+    }
+
+    // Compute b = a*s + Delta*m + e
+    rns::RNSPolynomial as = rns::multiply(ct.a, rns::to_rns(sk.s, base), base);
+    ct.b = rns::add(rns::add(as, rns::scale_message(message, params, params.top_level()), base), rns::to_rns(e, base), base);
+
+    return ct;
+}
+
+Polynomial decrypt_rlwe_rns(
+    const RNSRLWECiphertext& ct,
+    const keys::RLWESecretKey& sk,
+    const rns::RNSParameters& params
+) {
+    TURINGED_OPERATION_SCOPE("schemes::decrypt_rlwe_rns");
+    const rns::RNSBase& base = params.q_base(ct.level());
+    if (ct.a.degree() != sk.s.size() || ct.a.prime_count() != base.size()) {
+        throw std::runtime_error("Ciphertext size mismatch with key");
+    }
+
+    // Compute b - a*s, then round t * phase / Q
+    rns::RNSPolynomial as = rns::multiply(ct.a, rns::to_rns(sk.s, base), base);
+    rns::RNSPolynomial phase = rns::subtract(ct.b, as, base);
+
+    return rns::scale_to_plaintext(phase, params);
+}
+
+}
+}
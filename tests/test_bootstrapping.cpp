@@ -0,0 +1,136 @@
+// Gate bootstrapping truth tables and multi-value lookup tables
+
+#include "test_common.hpp"
+
+using namespace turinged;
+
+namespace {
+
+struct GateKeys {
+    keys::GateBootstrappingParameters params;
+    keys::LWESecretKey lwe_sk;
+    keys::GateBootstrappingKey key;
+};
+
+// Key generation dominates, so every case shares one set of keys
+const GateKeys& gate_keys() {
+    static const GateKeys keys = [] {
+        GateKeys g;
+        g.params = operations::default_gate_parameters();
+        g.lwe_sk = keys::generate_lwe_secret_key(g.params.lwe_dimension);
+        auto glwe_sk = keys::generate_glwe_secret_key(g.params.k, g.params.n);
+        g.key = keys::generate_gate_bootstrapping_key(g.lwe_sk, glwe_sk, g.params);
+        return g;
+    }();
+    return keys;
+}
+
+bool plain_gate(operations::Gate gate, bool a, bool b) {
+    switch (gate) {
+        case operations::Gate::NAND: return !(a && b);
+        case operations::Gate::AND: return a && b;
+        case operations::Gate::OR: return a || b;
+        case operations::Gate::NOR: return !(a || b);
+        case operations::Gate::XOR: return a != b;
+        case operations::Gate::XNOR: return a == b;
+    }
+    return false;
+}
+
+}
+
+TEST(gate_truth_tables) {
+    const GateKeys& g = gate_keys();
+    const operations::Gate gates[] = {
+        operations::Gate::NAND, operations::Gate::AND, operations::Gate::OR,
+        operations::Gate::NOR, operations::Gate::XOR, operations::Gate::XNOR
+    };
+
+    // All four input pairs of a gate in one batch
+    std::vector<schemes::LWECiphertext> a;
+    std::vector<schemes::LWECiphertext> b;
+    for (int x = 0; x < 4; ++x) {
+        a.push_back(operations::encrypt_bit(x & 1, g.lwe_sk, g.params));
+        b.push_back(operations::encrypt_bit(x & 2, g.lwe_sk, g.params));
+    }
+    for (operations::Gate gate : gates) {
+        auto out = operations::evaluate_gates(gate, a, b, g.key.view());
+        REQUIRE(out.size() == 4);
+        for (int x = 0; x < 4; ++x) {
+            CHECK(operations::decrypt_bit(out[x], g.lwe_sk, g.params) == plain_gate(gate, x & 1, x & 2));
+        }
+    }
+
+    for (bool bit : {false, true}) {
+        auto ct = operations::encrypt_bit(bit, g.lwe_sk, g.params);
+        CHECK(operations::decrypt_bit(operations::gate_not(ct, g.params), g.lwe_sk, g.params) == !bit);
+        auto trivial = operations::trivial_bit(bit, g.params);
+        auto out = operations::evaluate_gate(operations::Gate::AND, ct, trivial, g.key.view());
+        CHECK(operations::decrypt_bit(out, g.lwe_sk, g.params) == bit);
+    }
+}
+
+TEST(gate_mux_and_chaining) {
+    const GateKeys& g = gate_keys();
+    std::vector<schemes::LWECiphertext> select;
+    std::vector<schemes::LWECiphertext> a;
+    std::vector<schemes::LWECiphertext> b;
+    for (int x = 0; x < 8; ++x) {
+        select.push_back(operations::encrypt_bit(x & 1, g.lwe_sk, g.params));
+        a.push_back(operations::encrypt_bit(x & 2, g.lwe_sk, g.params));
+        b.push_back(operations::encrypt_bit(x & 4, g.lwe_sk, g.params));
+    }
+    auto out = operations::evaluate_mux_gates(select, a, b, g.key.view());
+    for (int x = 0; x < 8; ++x) {
+        bool expected = (x & 1) ? (x & 2) != 0 : (x & 4) != 0;
+        CHECK(operations::decrypt_bit(out[x], g.lwe_sk, g.params) == expected);
+    }
+
+    // Bootstrapped outputs feed further gates: a chain of XORs is a parity
+    bool parity = false;
+    auto acc = operations::encrypt_bit(false, g.lwe_sk, g.params);
+    for (int i = 0; i < 6; ++i) {
+        bool bit = (0x2d >> i) & 1;
+        parity = parity != bit;
+        acc = operations::evaluate_gate(operations::Gate::XOR, acc, operations::encrypt_bit(bit, g.lwe_sk, g.params), g.key.view());
+    }
+    CHECK(operations::decrypt_bit(acc, g.lwe_sk, g.params) == parity);
+
+    CHECK_THROWS(operations::evaluate_gates(operations::Gate::AND, a, {}, g.key.view()));
+}
+
+TEST(multi_value_lookup_tables) {
+    // The gate set with N = 2048 leaves room for the table products' noise
+    keys::GateBootstrappingParameters gp = operations::default_gate_parameters();
+    gp.n = 2048;
+    gp.glwe_noise_bound = params::noise_bound_for_stddev(params::min_noise_stddev(gp.k * gp.n, gp.q, 128));
+    auto lwe_sk = keys::generate_lwe_secret_key(gp.lwe_dimension);
+    auto glwe_sk = keys::generate_glwe_secret_key(gp.k, gp.n);
+    auto key = keys::generate_gate_bootstrapping_key(lwe_sk, glwe_sk, gp);
+
+    for (int64 t : {int64(8), int64(16)}) {
+        Parameters lwe_params(0, gp.q, t, gp.lwe_noise_bound);
+        Parameters glwe_params(gp.n, gp.q, t, gp.glwe_noise_bound);
+        int64 messages = t / 2;
+
+        std::vector<std::vector<int64>> tables(4, std::vector<int64>(messages));
+        for (int64 m = 0; m < messages; ++m) {
+            tables[0][m] = m;
+            tables[1][m] = (m * m) % messages;
+            tables[2][m] = messages - 1 - m;
+            tables[3][m] = m % 2;
+        }
+
+        for (int64 m = 0; m < messages; ++m) {
+            auto ct = schemes::encrypt_lwe(m, lwe_sk, lwe_params);
+            auto outs = operations::multi_value_bootstrap_lwe(ct, tables, key.bsk.view(), key.ksk.view(), lwe_params, glwe_params);
+            REQUIRE(outs.size() == tables.size());
+            for (std::size_t j = 0; j < tables.size(); ++j) {
+                CHECK(schemes::decrypt_lwe(outs[j], lwe_sk, lwe_params) == tables[j][m]);
+            }
+        }
+    }
+
+    Parameters odd(gp.n, gp.q, 7, gp.glwe_noise_bound);
+    CHECK_THROWS(operations::lut_factor_polynomial({0, 1, 2}, odd));
+}
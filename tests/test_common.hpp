@@ -0,0 +1,62 @@
+#pragma once
+
+#include "turinged/turinged.hpp"
+#include <string>
+#include <vector>
+
+// Minimal test harness. TEST(name) registers a case with the executable it is
+// linked into; test_main.cpp runs every case (or those whose name contains the
+// first argument) and exits non-zero if any check failed. CHECK records a
+// failure and carries on, REQUIRE also ends the case. An exception escaping a
+// case counts as a failure.
+
+namespace turinged {
+namespace test {
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& registry();
+
+void report_failure(const char* file, int line, const std::string& what);
+
+struct Registrar {
+    Registrar(const char* name, void (*run)()) { registry().push_back({name, run}); }
+};
+
+// Thrown by REQUIRE to leave the current case
+struct RequireFailed {};
+
+}
+}
+
+#define TEST(name)                                                              \
+    static void name();                                                         \
+    static ::turinged::test::Registrar name##_registrar(#name, name);           \
+    static void name()
+
+#define CHECK(cond)                                                             \
+    do {                                                                        \
+        if (!(cond)) ::turinged::test::report_failure(__FILE__, __LINE__, "CHECK(" #cond ")"); \
+    } while (0)
+
+#define REQUIRE(cond)                                                           \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            ::turinged::test::report_failure(__FILE__, __LINE__, "REQUIRE(" #cond ")"); \
+            throw ::turinged::test::RequireFailed();                            \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_THROWS(expr)                                                      \
+    do {                                                                        \
+        bool thrown_ = false;                                                   \
+        try {                                                                   \
+            (void)(expr);                                                       \
+        } catch (const std::exception&) {                                       \
+            thrown_ = true;                                                     \
+        }                                                                       \
+        if (!thrown_) ::turinged::test::report_failure(__FILE__, __LINE__, "CHECK_THROWS(" #expr ")"); \
+    } while (0)
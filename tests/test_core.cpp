@@ -0,0 +1,300 @@
+// Thread pool, pool allocator, polynomial arithmetic, operation metrics and
+// trace dumps
+
+#include "test_common.hpp"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace turinged;
+
+namespace {
+
+// Just enough JSON to read a trace dump back: objects, arrays, strings, numbers
+struct JsonValue {
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> items;
+    std::map<std::string, JsonValue> members;
+
+    const JsonValue& operator[](const std::string& key) const {
+        auto it = members.find(key);
+        if (it == members.end()) throw std::runtime_error("Missing JSON member " + key);
+        return it->second;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text_(text), pos_(0) {}
+
+    JsonValue parse() {
+        JsonValue v = value();
+        skip_space();
+        if (pos_ != text_.size()) fail();
+        return v;
+    }
+
+private:
+    const std::string& text_;
+    std::size_t pos_;
+
+    [[noreturn]] void fail() const { throw std::runtime_error("Malformed JSON at " + std::to_string(pos_)); }
+
+    void skip_space() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+    }
+
+    bool consume(char c) {
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) fail();
+    }
+
+    std::string string() {
+        expect('"');
+        std::string out;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\') {
+                if (pos_ >= text_.size()) fail();
+                char e = text_[pos_++];
+                if (e == 'u') {
+                    if (pos_ + 4 > text_.size()) fail();
+                    out += static_cast<char>(std::stoi(text_.substr(pos_, 4), nullptr, 16));
+                    pos_ += 4;
+                } else {
+                    out += e == 'n' ? '\n' : e == 't' ? '\t' : e;
+                }
+            } else {
+                out += c;
+            }
+        }
+        expect('"');
+        return out;
+    }
+
+    JsonValue value() {
+        skip_space();
+        if (pos_ >= text_.size()) fail();
+        JsonValue v;
+        char c = text_[pos_];
+        if (c == '{') {
+            ++pos_;
+            if (consume('}')) return v;
+            do {
+                std::string key = string();
+                expect(':');
+                v.members[key] = value();
+            } while (consume(','));
+            expect('}');
+        } else if (c == '[') {
+            ++pos_;
+            if (consume(']')) return v;
+            do {
+                v.items.push_back(value());
+            } while (consume(','));
+            expect(']');
+        } else if (c == '"') {
+            v.string = string();
+        } else {
+            std::size_t used = 0;
+            v.number = std::stod(text_.substr(pos_), &used);
+            pos_ += used;
+        }
+        return v;
+    }
+};
+
+}
+
+TEST(parallel_for_runs_every_index) {
+    std::vector<std::atomic<int>> hits(1000);
+    for (auto& h : hits) h.store(0);
+    core::parallel_for(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); }, 4);
+    bool once = true;
+    for (auto& h : hits) once = once && h.load() == 1;
+    CHECK(once);
+
+    // Nested calls make progress even with every worker busy
+    std::atomic<std::size_t> inner(0);
+    core::parallel_for(8, [&](std::size_t) {
+        core::parallel_for(16, [&](std::size_t) { inner.fetch_add(1); }, 4);
+    }, 4);
+    CHECK(inner.load() == 8 * 16);
+
+    CHECK_THROWS(core::parallel_for(100, [](std::size_t i) {
+        if (i == 37) throw std::runtime_error("item failed");
+    }, 4));
+}
+
+namespace {
+
+std::atomic<int> threads_seen(0);
+
+// Counted once per thread, on its first item
+struct ThreadMarker {
+    ThreadMarker() { threads_seen.fetch_add(1); }
+};
+
+}
+
+TEST(parallel_for_reuses_workers) {
+    // Workers outlive the call, so repeated calls run on the same threads and
+    // their pool caches serve the buffers after the first round
+    const std::size_t threads = 4;
+    std::atomic<std::uint64_t> late_global_allocations(0);
+    for (int round = 0; round < 6; ++round) {
+        core::parallel_for(64, [&](std::size_t) {
+            static thread_local ThreadMarker marker;
+            static thread_local bool warmed_up = false;
+            core::PoolStats before = core::pool_stats();
+            Polynomial scratch(4096, 1);
+            scratch[0] += 1;
+            if (warmed_up) late_global_allocations += core::pool_stats().global_allocations - before.global_allocations;
+            warmed_up = true;
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }, threads);
+    }
+    CHECK(threads_seen.load() <= static_cast<int>(threads));
+    CHECK(late_global_allocations.load() == 0);
+}
+
+TEST(pooled_polynomial_arithmetic) {
+    int64 q = 1LL << 40;
+    Polynomial a(1024);
+    Polynomial b(1024, 0);
+    for (std::size_t i = 0; i < a.size(); ++i) a[i] = static_cast<int64>((i * 7919) % 1000);
+    b[1] = 1;
+
+    // Multiplying by x shifts negacyclically
+    Polynomial shifted = polynomial::negacyclic_multiply(a, b, q);
+    CHECK(shifted[0] == core::modq(-a[1023], q));
+    CHECK(shifted[5] == a[4]);
+    CHECK(polynomial::subtract(polynomial::add(a, b, q), b, q) == a);
+
+    // std::vector data converts through the iterator constructor
+    std::vector<int64> plain(a.begin(), a.end());
+    CHECK(Polynomial(plain.begin(), plain.end()) == a);
+
+    // A freed buffer is served again from the thread's cache
+    { Polynomial warm(4096, 0); }
+    core::PoolStats before = core::pool_stats();
+    { Polynomial again(4096, 0); }
+    CHECK(core::pool_stats().global_allocations == before.global_allocations);
+    CHECK(core::pool_stats().reused > before.reused);
+}
+
+TEST(operation_metrics) {
+    Parameters params(1024, 1LL << 40, 16, 3);
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    Polynomial m(params.n, 1);
+    const uint64 calls = 20;
+
+    core::reset_metrics();
+    for (uint64 i = 0; i < calls; ++i) schemes::encrypt_rlwe(m, sk, params);
+    core::MetricsSnapshot snapshot = core::metrics_snapshot();
+
+    // Compiled out, nothing is recorded
+    if (!core::metrics_enabled()) {
+        CHECK(snapshot.operations.empty());
+        return;
+    }
+
+    const core::OperationMetrics* encrypt = nullptr;
+    for (const core::OperationMetrics& op : snapshot.operations) {
+        if (op.name == "schemes::encrypt_rlwe") encrypt = &op;
+    }
+    REQUIRE(encrypt != nullptr);
+    CHECK(encrypt->calls == calls);
+    CHECK(encrypt->poly_multiplies == calls);
+    CHECK(encrypt->latency.count == calls);
+
+    // Percentiles are bucket upper bounds, so they bracket min and max
+    const core::LatencyHistogram& latency = encrypt->latency;
+    CHECK(latency.min_ns <= latency.percentile(0));
+    CHECK(latency.percentile(0) <= latency.percentile(50));
+    CHECK(latency.percentile(50) <= latency.percentile(90));
+    CHECK(latency.percentile(90) <= latency.percentile(99));
+    CHECK(latency.percentile(99) <= latency.percentile(100));
+    CHECK(latency.max_ns <= latency.percentile(100));
+
+    core::reset_metrics();
+    CHECK(core::metrics_snapshot().operations.empty());
+}
+
+TEST(chrome_trace_dump) {
+    core::start_tracing();
+    CHECK(core::tracing_active() == core::tracing_enabled());
+    core::set_trace_thread_name("test main");
+    {
+        TURINGED_TRACE_SCOPE("test.outer");
+        {
+            // Directly inside a scope of the same name: not recorded
+            TURINGED_TRACE_SCOPE("test.outer");
+            TURINGED_TRACE_SCOPE("test.inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    std::thread other([]() {
+        core::set_trace_thread_name("test \"other\"");
+        TURINGED_TRACE_SCOPE("test.other");
+    });
+    other.join();
+    core::stop_tracing();
+    { TURINGED_TRACE_SCOPE("test.after_stop"); }
+
+    std::stringstream dump;
+    core::write_chrome_trace(dump);
+    std::string text = dump.str();
+    JsonValue trace = JsonParser(text).parse();
+    CHECK(trace["otherData"]["dropped_events"].number == 0);
+
+    // Thread names come as metadata events; the rest are complete events
+    std::map<int, std::string> thread_names;
+    std::map<std::string, std::vector<const JsonValue*>> events;
+    for (const JsonValue& e : trace["traceEvents"].items) {
+        if (e["ph"].string == "M") {
+            CHECK(e["name"].string == "thread_name");
+            thread_names[static_cast<int>(e["tid"].number)] = e["args"]["name"].string;
+        } else {
+            CHECK(e["ph"].string == "X");
+            events[e["name"].string].push_back(&e);
+        }
+    }
+
+    if (!core::tracing_enabled()) {
+        CHECK(trace["traceEvents"].items.empty());
+        return;
+    }
+
+    REQUIRE(events["test.outer"].size() == 1);
+    REQUIRE(events["test.inner"].size() == 1);
+    REQUIRE(events["test.other"].size() == 1);
+    CHECK(events.count("test.after_stop") == 0);
+
+    // Each scope is one event whose span holds its children, on its thread
+    const JsonValue& outer = *events["test.outer"][0];
+    const JsonValue& inner = *events["test.inner"][0];
+    const JsonValue& other_event = *events["test.other"][0];
+    CHECK(thread_names[static_cast<int>(outer["tid"].number)] == "test main");
+    CHECK(inner["tid"].number == outer["tid"].number);
+    CHECK(thread_names[static_cast<int>(other_event["tid"].number)] == "test \"other\"");
+    CHECK(inner["dur"].number >= 1000.0);
+    // Times are printed in microseconds to the nanosecond
+    const double slack = 0.001;
+    CHECK(outer["ts"].number <= inner["ts"].number);
+    CHECK(inner["ts"].number + inner["dur"].number <= outer["ts"].number + outer["dur"].number + slack);
+    CHECK(other_event["ts"].number + slack >= outer["ts"].number + outer["dur"].number);
+}
@@ -0,0 +1,318 @@
+// Binary serialization, memory-mapped key files and the streaming pipeline
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+using namespace turinged;
+
+namespace {
+
+std::string serialized_rlwe(const schemes::RLWECiphertext& ct, const Parameters& params) {
+    std::stringstream out;
+    io::serialize(out, ct, params);
+    return out.str();
+}
+
+// A stream that cannot seek, like a pipe, so its size is unknown to readers
+struct PipeBuffer : std::stringbuf {
+    explicit PipeBuffer(const std::string& bytes) : std::stringbuf(bytes) {}
+    pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override { return pos_type(-1); }
+    pos_type seekpos(pos_type, std::ios_base::openmode) override { return pos_type(-1); }
+};
+
+// Rewrites the little-endian u64 at `offset`
+std::string with_u64(std::string bytes, std::size_t offset, uint64 value) {
+    for (int b = 0; b < 8; ++b) bytes[offset + b] = static_cast<char>((value >> (8 * b)) & 0xff);
+    return bytes;
+}
+
+}
+
+TEST(serialization_round_trip) {
+    Parameters params(1024, 1LL << 40, 16, 3);
+    Parameters lwe_params(128, 1LL << 40, 16, 3);
+    auto lwe_sk = keys::generate_lwe_secret_key(128);
+    auto rlwe_sk = keys::generate_rlwe_secret_key(params.n);
+    auto glwe_sk = keys::generate_glwe_secret_key(2, params.n);
+    Polynomial m(params.n, 0);
+    m[3] = 7;
+
+    auto lwe_ct = schemes::encrypt_lwe(5, lwe_sk, lwe_params);
+    auto rlwe_ct = schemes::encrypt_rlwe(m, rlwe_sk, params);
+    auto glwe_ct = schemes::encrypt_glwe(m, glwe_sk, params);
+    auto ggsw_ct = schemes::encrypt_ggsw(m, glwe_sk, params, 2, 256);
+    auto relin = keys::generate_rlwe_relin_key(rlwe_sk, params, 1LL << 10);
+    auto glwe_pk = keys::generate_glwe_public_key(glwe_sk, params);
+    auto rns_params = rns::create_rns_parameters(params.n, 16, 3, 50, 3);
+    auto rns_relin = keys::generate_rns_relin_key(rlwe_sk, rns_params);
+    keys::KeygenOptions options;
+    options.seed = 1;
+    auto bsk = keys::generate_bootstrapping_key(lwe_sk, glwe_sk, params, 1, 1LL << 10, options);
+    auto ksk = keys::generate_lwe_key_switch_key(keys::extract_lwe_secret_key(glwe_sk), lwe_sk, lwe_params, 1LL << 8, options);
+
+    // Objects are concatenated on one stream and read back in order
+    std::stringstream stream;
+    io::serialize(stream, lwe_ct, lwe_params);
+    io::serialize(stream, rlwe_ct, params);
+    io::serialize(stream, glwe_ct, params);
+    io::serialize(stream, ggsw_ct, params);
+    io::serialize(stream, relin, params);
+    io::serialize(stream, glwe_pk, params);
+    io::serialize(stream, glwe_sk, params);
+    io::serialize(stream, rns_relin, rns_params);
+    io::serialize(stream, bsk, params);
+    keys::write_bootstrapping_key(stream, lwe_sk, glwe_sk, params, 1, 1LL << 10, options);
+    io::serialize(stream, ksk, lwe_params);
+
+    io::Header header;
+    auto lwe_back = io::deserialize_lwe_ciphertext(stream, &header);
+    CHECK(lwe_back.a == lwe_ct.a && lwe_back.b == lwe_ct.b);
+    CHECK(header.n == 128 && header.q == lwe_params.q && header.coeff_bits == 40);
+
+    auto rlwe_back = io::deserialize_rlwe_ciphertext(stream);
+    CHECK(rlwe_back.a == rlwe_ct.a && rlwe_back.b == rlwe_ct.b);
+    auto glwe_back = io::deserialize_glwe_ciphertext(stream);
+    CHECK(glwe_back.b == glwe_ct.b && glwe_back.d_tilde == glwe_ct.d_tilde);
+    auto ggsw_back = io::deserialize_ggsw_ciphertext(stream);
+    CHECK(ggsw_back.glev_rows[2].levels[1].b == ggsw_ct.glev_rows[2].levels[1].b);
+
+    auto relin_back = io::deserialize_rlwe_key_switch_key(stream);
+    REQUIRE(relin_back.a.size() == relin.a.size());
+    for (std::size_t j = 0; j < relin.a.size(); ++j) {
+        CHECK(relin_back.a[j].residues == relin.a[j].residues);
+        CHECK(relin_back.b[j].residues == relin.b[j].residues);
+    }
+
+    CHECK(io::deserialize_glwe_public_key(stream).pk2 == glwe_pk.pk2);
+    CHECK(io::deserialize_glwe_secret_key(stream).s == glwe_sk.s);
+    auto rns_back = io::deserialize_rns_relin_key(stream);
+    CHECK(rns_back.keys[0].body[1].residues == rns_relin.keys[0].body[1].residues);
+
+    CHECK(io::deserialize_bootstrapping_key(stream).data == bsk.data);
+
+    // The streamed key shares the seeded masks but draws fresh noise
+    auto streamed = io::deserialize_bootstrapping_key(stream);
+    REQUIRE(streamed.data.size() == bsk.data.size() && streamed.transformed == bsk.transformed);
+    bool masks_match = true;
+    for (std::size_t i = 0; i < bsk.n_lwe; ++i) {
+        for (std::size_t row = 0; row <= bsk.k; ++row) {
+            for (int level = 0; level <= bsk.l; ++level) {
+                const uint64* mask = bsk.glwe(i, row, level);
+                masks_match = masks_match && std::equal(mask, mask + bsk.k * bsk.poly_words(), streamed.glwe(i, row, level));
+            }
+        }
+    }
+    CHECK(masks_match);
+    CHECK(io::deserialize_lwe_key_switch_key(stream).data == ksk.data);
+    CHECK(stream.peek() == std::char_traits<char>::eof());
+}
+
+TEST(serialization_detects_corruption) {
+    Parameters params(1024, 1LL << 40, 16, 3);
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    std::string bytes = serialized_rlwe(schemes::encrypt_rlwe(Polynomial(params.n, 1), sk, params), params);
+
+    // Every single-bit flip, in the header, body or checksum, is rejected
+    for (std::size_t pos : {std::size_t(0), std::size_t(5), std::size_t(12), std::size_t(100),
+                            bytes.size() / 2, bytes.size() - 1}) {
+        std::string corrupt = bytes;
+        corrupt[pos] ^= 0x10;
+        std::stringstream in(corrupt);
+        CHECK_THROWS(io::deserialize_rlwe_ciphertext(in));
+    }
+
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 9));
+    CHECK_THROWS(io::deserialize_rlwe_ciphertext(truncated));
+
+    std::stringstream wrong_type(bytes);
+    CHECK_THROWS(io::deserialize_lwe_ciphertext(wrong_type));
+
+    std::stringstream intact(bytes);
+    CHECK(schemes::decrypt_rlwe(io::deserialize_rlwe_ciphertext(intact), sk, params) == Polynomial(params.n, 1));
+}
+
+TEST(serialization_rejects_bad_lengths) {
+    Parameters params(1024, 1LL << 40, 16, 3);
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    std::string bytes = serialized_rlwe(schemes::encrypt_rlwe(Polynomial(params.n, 1), sk, params), params);
+
+    // The mask length follows the 41-byte header; lengths too large for the
+    // stream, or that disagree with the header's degree, fail before allocating
+    const std::size_t length_offset = 41;
+    for (uint64 length : {uint64(1) << 62, uint64(1) << 40, uint64(params.n / 2), uint64(params.n + 1)}) {
+        std::string corrupt = with_u64(bytes, length_offset, length);
+        std::stringstream in(corrupt);
+        CHECK_THROWS(io::deserialize_rlwe_ciphertext(in));
+        PipeBuffer pipe(corrupt);
+        std::istream piped(&pipe);
+        CHECK_THROWS(io::deserialize_rlwe_ciphertext(piped));
+    }
+
+    PipeBuffer intact(bytes);
+    std::istream piped(&intact);
+    CHECK(schemes::decrypt_rlwe(io::deserialize_rlwe_ciphertext(piped), sk, params) == Polynomial(params.n, 1));
+
+    // The same for a key whose size is the product of several shape fields
+    Parameters lwe_params(64, 1LL << 40, 16, 3);
+    auto lwe_sk = keys::generate_lwe_secret_key(64);
+    auto ksk = keys::generate_lwe_key_switch_key(lwe_sk, lwe_sk, lwe_params, 1LL << 10);
+    std::stringstream ksk_out;
+    io::serialize(ksk_out, ksk, lwe_params);
+    for (uint64 n_in : {uint64(1) << 40, uint64(1) << 60}) {
+        std::stringstream in(with_u64(ksk_out.str(), length_offset, n_in));
+        CHECK_THROWS(io::deserialize_lwe_key_switch_key(in));
+    }
+}
+
+TEST(serialization_lwe_dimension_is_its_own_field) {
+    // Extraction from a k = 2 GLWE ciphertext gives dimension 2n under a header of degree n
+    Parameters params(1024, 1LL << 40, 16, 3);
+    auto glwe_sk = keys::generate_glwe_secret_key(2, params.n);
+    auto lwe_sk = keys::extract_lwe_secret_key(glwe_sk);
+    Polynomial m(params.n, 0);
+    m[5] = 9;
+    auto extracted = operations::sample_extract(schemes::encrypt_glwe(m, glwe_sk, params), 5, params);
+    REQUIRE(extracted.a.size() == 2 * params.n);
+
+    std::stringstream stream;
+    io::serialize(stream, extracted, params);
+    io::Header header;
+    auto back = io::deserialize_lwe_ciphertext(stream, &header);
+    CHECK(header.n == params.n);
+    CHECK(back.a == extracted.a && back.b == extracted.b);
+    CHECK(schemes::decrypt_lwe(back, lwe_sk, params) == 9);
+
+    // Public keys under the extracted key round-trip the same way
+    auto pk = keys::generate_lwe_public_key(lwe_sk, params, 64);
+    std::stringstream pk_stream;
+    io::serialize(pk_stream, pk, params);
+    auto pk_back = io::deserialize_lwe_public_key(pk_stream);
+    CHECK(pk_back.k == 2 * params.n && pk_back.a == pk.a && pk_back.b == pk.b);
+    CHECK(schemes::decrypt_lwe(schemes::encrypt_lwe(3, pk_back, params), lwe_sk, params) == 3);
+
+    // The length is still checked against the stream
+    std::string bytes = stream.str();
+    for (uint64 length : {uint64(1) << 40, uint64(4 * params.n)}) {
+        std::stringstream in(with_u64(bytes, 41, length));
+        CHECK_THROWS(io::deserialize_lwe_ciphertext(in));
+    }
+}
+
+TEST(mapped_key_store) {
+    std::size_t n = 1024;
+    std::size_t n_lwe = 630;
+    Parameters params(n, 1LL << 32, 4, 2);
+    Parameters lwe_params(n_lwe, 1LL << 32, 4, 2);
+    auto glwe_sk = keys::generate_glwe_secret_key(1, n);
+    auto lwe_sk = keys::generate_lwe_secret_key(n_lwe);
+    auto extracted = keys::extract_lwe_secret_key(glwe_sk);
+    auto bsk = keys::generate_bootstrapping_key(lwe_sk, glwe_sk, params, 2, 1024);
+    auto ksk = keys::generate_lwe_key_switch_key(extracted, lwe_sk, lwe_params, 16);
+
+    const std::string bsk_path = "test_io_bsk.map";
+    const std::string ksk_path = "test_io_ksk.map";
+    io::write_mapped_key(bsk_path, bsk, params);
+    io::write_mapped_key(ksk_path, ksk, lwe_params);
+    {
+        io::KeyStore bsk_store(bsk_path);
+        io::KeyStore ksk_store(ksk_path);
+        CHECK(bsk_store.verify());
+        CHECK(ksk_store.verify());
+        CHECK(bsk_store.parameters().q == params.q);
+
+        auto bsk_view = bsk_store.bootstrapping_key();
+        CHECK(bsk_view.n_lwe == n_lwe && bsk_view.transformed == bsk.transformed);
+        CHECK(std::equal(bsk.data.begin(), bsk.data.end(), bsk_view.data));
+        CHECK_THROWS(ksk_store.bootstrapping_key());
+
+        auto ksk_view = ksk_store.lwe_key_switch_key();
+        for (int64 m = 0; m < 4; ++m) {
+            auto ct = schemes::encrypt_lwe(m, extracted, params);
+            CHECK(schemes::decrypt_lwe(operations::key_switch_lwe(ct, ksk_view, lwe_params), lwe_sk, lwe_params) == m);
+        }
+    }
+
+    // Each patch below keeps the mapped word count (the key switching key's
+    // n_in wraps around 2^64 in the product); the layouts are still rejected
+    auto read_file = [](const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    auto write_file = [](const std::string& path, const std::string& bytes) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    };
+    auto layout_field = [](std::string bytes, std::size_t field, uint64 value) {
+        return with_u64(std::move(bytes), (8 + field) * sizeof(uint64), value);
+    };
+    std::size_t small_n_lwe = 4;
+    io::write_mapped_key(bsk_path, keys::generate_bootstrapping_key(keys::generate_lwe_secret_key(small_n_lwe), glwe_sk, params, 2, 1024), params);
+    std::string bsk_bytes = read_file(bsk_path);
+    write_file(bsk_path, layout_field(layout_field(bsk_bytes, 0, 2 * small_n_lwe), 2, n / 2));
+    CHECK_THROWS(io::KeyStore(bsk_path).bootstrapping_key());
+    write_file(bsk_path, layout_field(bsk_bytes, 4, uint64(params.q)));
+    CHECK_THROWS(io::KeyStore(bsk_path).bootstrapping_key());
+
+    std::string ksk_bytes = read_file(ksk_path);
+    write_file(ksk_path, layout_field(ksk_bytes, 0, uint64(ksk.n_in) + (uint64(1) << 61)));
+    CHECK_THROWS(io::KeyStore(ksk_path).lwe_key_switch_key());
+    write_file(ksk_path, layout_field(ksk_bytes, 2, uint64(lwe_params.q)));
+    CHECK_THROWS(io::KeyStore(ksk_path).lwe_key_switch_key());
+    write_file(ksk_path, ksk_bytes);
+    CHECK(io::KeyStore(ksk_path).lwe_key_switch_key().n_in == ksk.n_in);
+    std::remove(bsk_path.c_str());
+    std::remove(ksk_path.c_str());
+}
+
+TEST(stream_pipeline_round_trip) {
+    Parameters params(1024, 1LL << 40, 257, 3);
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto pk = keys::generate_rlwe_public_key(sk, params);
+
+    std::vector<int> records(5000);
+    for (std::size_t i = 0; i < records.size(); ++i) records[i] = static_cast<int>((i * 131 + 7) % 256);
+
+    io::StreamOptions options;
+    options.num_threads = 3;
+    options.batch_size = 2;
+    std::stringstream stream;
+    auto encrypted = io::encrypt_stream(io::iterator_record_source(records.begin(), records.end()), stream, pk, params, options);
+    CHECK(encrypted.records == records.size());
+    CHECK(encrypted.ciphertexts == (records.size() + params.n - 1) / params.n);
+
+    std::vector<int64> decrypted;
+    auto sink = [&](const int64* values, std::size_t count) { decrypted.insert(decrypted.end(), values, values + count); };
+    auto stats = io::decrypt_stream(stream, sink, sk, params, options);
+    CHECK(stats.records == records.size());
+    CHECK(std::equal(records.begin(), records.end(), decrypted.begin(), decrypted.end()));
+
+    // With a slow writer the reader stays within 2 * queue_depth + num_threads
+    // batches of it
+    options.num_threads = 2;
+    options.batch_size = 1;
+    options.queue_depth = 1;
+    std::vector<int> long_input(40 * params.n, 1);
+    std::atomic<std::size_t> written(0);
+    std::size_t read = 0;
+    bool within_window = true;
+    auto source = io::iterator_record_source(long_input.begin(), long_input.end());
+    auto counted = [&](int64* values, std::size_t max) {
+        std::size_t got = source(values, max);
+        read += got;
+        within_window = within_window && (read + params.n - 1) / params.n <= written + 4;
+        return got;
+    };
+    options.progress = [&](const io::StreamStats& progress) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        written = progress.ciphertexts;
+    };
+    std::stringstream slow;
+    CHECK(io::encrypt_stream(counted, slow, sk, params, options).ciphertexts == 40);
+    CHECK(within_window);
+}
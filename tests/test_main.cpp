@@ -0,0 +1,49 @@
+#include "test_common.hpp"
+#include <chrono>
+#include <exception>
+#include <iostream>
+
+namespace turinged {
+namespace test {
+
+static std::size_t failures = 0;
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void report_failure(const char* file, int line, const std::string& what) {
+    ++failures;
+    std::cerr << file << ":" << line << ": " << what << " failed" << std::endl;
+}
+
+}
+}
+
+int main(int argc, char** argv) {
+    using namespace turinged::test;
+    std::string filter = argc > 1 ? argv[1] : "";
+
+    std::size_t run = 0;
+    std::size_t failed = 0;
+    for (const TestCase& test : registry()) {
+        if (std::string(test.name).find(filter) == std::string::npos) continue;
+        std::size_t before = failures;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            test.run();
+        } catch (const RequireFailed&) {
+        } catch (const std::exception& e) {
+            report_failure(test.name, 0, std::string("unexpected exception: ") + e.what());
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        bool ok = failures == before;
+        std::cout << (ok ? "[  OK  ] " : "[ FAIL ] ") << test.name << " (" << static_cast<long>(ms) << " ms)" << std::endl;
+        ++run;
+        if (!ok) ++failed;
+    }
+
+    std::cout << run - failed << "/" << run << " passed" << std::endl;
+    return failed == 0 && run > 0 ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+// Noise variance estimates carried by ciphertexts against measured noise
+
+#include "test_common.hpp"
+#include <functional>
+#include <random>
+
+using namespace turinged;
+
+namespace {
+
+// The coherent part of the noise is fixed by the key, so one key alone can
+// land several times either side of the estimate
+const int KEYS = 8;
+
+std::mt19937_64 message_rng(2024);
+
+Polynomial random_message(std::size_t n, int64 t) {
+    Polynomial m(n);
+    for (int64& c : m) c = static_cast<int64>(message_rng() % static_cast<uint64>(t));
+    return m;
+}
+
+struct Encrypted {
+    schemes::RLWECiphertext ct;
+    Polynomial message;
+};
+
+// One operation chain evaluated under a fresh key
+struct RLWEChain {
+    const Parameters& params;
+    keys::RLWESecretKey sk;
+    keys::RLWERelinKey rlk;
+
+    RLWEChain(const Parameters& params, int64 beta)
+        : params(params), sk(keys::generate_rlwe_secret_key(params.n)), rlk(keys::generate_rlwe_relin_key(sk, params, beta)) {}
+
+    Encrypted encrypt() {
+        Polynomial m = random_message(params.n, params.t);
+        return {schemes::encrypt_rlwe(m, sk, params), m};
+    }
+
+    Encrypted multiply(const Encrypted& x, const Encrypted& y) {
+        return {operations::multiply_rlwe(x.ct, y.ct, rlk, params), polynomial::negacyclic_multiply(x.message, y.message, params.t)};
+    }
+
+    Encrypted multiply_plain(const Encrypted& x) {
+        Polynomial p = random_message(params.n, params.t);
+        return {operations::multiply_plain_rlwe(x.ct, p, params), polynomial::negacyclic_multiply(x.message, p, params.t)};
+    }
+
+    Encrypted add(const Encrypted& x, const Encrypted& y) {
+        return {operations::add_rlwe(x.ct, y.ct, params), polynomial::add(x.message, y.message, params.t)};
+    }
+};
+
+// Measured error variance averaged over `keys` keys, over the estimate
+double measured_over_estimate(const Parameters& params, int64 beta, int keys,
+                              const std::function<Encrypted(RLWEChain&)>& chain) {
+    double measured = 0.0;
+    double estimate = 0.0;
+    for (int i = 0; i < keys; ++i) {
+        RLWEChain c(params, beta);
+        Encrypted result = chain(c);
+        measured += noise::measure_noise_rlwe(result.ct, result.message, c.sk, params).variance;
+        estimate += result.ct.noise_variance;
+        CHECK(result.ct.coherent_variance >= 0.0 && result.ct.coherent_variance <= result.ct.noise_variance);
+    }
+    return measured / estimate;
+}
+
+// The estimate is a mean over keys
+bool tracks(double ratio) {
+    return ratio > 1.0 / 8.0 && ratio < 4.0;
+}
+
+}
+
+TEST(noise_estimate_fresh_and_plaintext) {
+    Parameters params(2048, 1LL << 38, 16, 6);
+    CHECK(tracks(measured_over_estimate(params, 1LL << 13, 2, [](RLWEChain& c) { return c.encrypt(); })));
+    CHECK(tracks(measured_over_estimate(params, 1LL << 13, 2, [](RLWEChain& c) { return c.multiply_plain(c.encrypt()); })));
+
+    // With q mod t != 0 the carry of the plaintext product adds to the error
+    Parameters odd(1024, 1LL << 54, 17, 3);
+    CHECK(tracks(measured_over_estimate(odd, 1LL << 13, 2, [](RLWEChain& c) { return c.multiply_plain(c.encrypt()); })));
+}
+
+TEST(noise_estimate_products) {
+    // The set from the parameter selection regression: at q = 2^38 the
+    // relinearisation error dominates and most of it is coherent
+    Parameters params(2048, 1LL << 38, 16, 6);
+    const int64 beta = 1LL << 13;
+    CHECK(tracks(measured_over_estimate(params, beta, KEYS, [](RLWEChain& c) {
+        return c.multiply(c.encrypt(), c.encrypt());
+    })));
+
+    // A centered plaintext with even t has mean 1/2, which multiplies the
+    // coherent part far more than |p|^2
+    CHECK(tracks(measured_over_estimate(params, beta, KEYS, [](RLWEChain& c) {
+        return c.multiply_plain(c.multiply(c.encrypt(), c.encrypt()));
+    })));
+
+    // Branches relinearised with the same key add up coherently
+    CHECK(tracks(measured_over_estimate(params, beta, KEYS, [](RLWEChain& c) {
+        Encrypted sum = c.multiply_plain(c.multiply(c.encrypt(), c.encrypt()));
+        for (int branch = 1; branch < 4; ++branch) {
+            sum = c.add(sum, c.multiply_plain(c.multiply(c.encrypt(), c.encrypt())));
+        }
+        return sum;
+    })));
+
+    // Depth 2: the coherent error of each input meets the slowly varying part
+    // of the other input's phase, whose size varies from one ciphertext to the next
+    Parameters deep(1024, 1LL << 54, 16, 3);
+    CHECK(tracks(measured_over_estimate(deep, beta, 2 * KEYS, [](RLWEChain& c) {
+        return c.multiply(c.multiply(c.encrypt(), c.encrypt()), c.multiply(c.encrypt(), c.encrypt()));
+    })));
+
+    Parameters odd(1024, 1LL << 54, 17, 3);
+    CHECK(tracks(measured_over_estimate(odd, beta, KEYS, [](RLWEChain& c) {
+        return c.multiply_plain(c.multiply(c.encrypt(), c.encrypt()));
+    })));
+}
+
+TEST(noise_estimate_rotations) {
+    Parameters params(2048, 1LL << 38, 16, 6);
+    const int64 beta = 1LL << 13;
+    std::vector<uint64> elements = {operations::galois_element_for_rotation(1, params.n),
+                                    operations::galois_element_for_rotation(2, params.n)};
+
+    // The critical path of the selection regression for one branch
+    CHECK(tracks(measured_over_estimate(params, beta, KEYS, [&](RLWEChain& c) {
+        keys::RLWEGaloisKeys gk = keys::generate_rlwe_galois_keys(c.sk, params, beta, elements);
+        Encrypted x = c.multiply_plain(c.multiply(c.encrypt(), c.encrypt()));
+        for (uint64 g : elements) {
+            x.ct = operations::apply_galois_rlwe(x.ct, g, gk, params);
+            x.message = polynomial::automorphism(x.message, g, params.t);
+        }
+        return x;
+    })));
+}
+
+TEST(noise_estimate_glwe_accumulate) {
+    // GLWE key switching leaves the same coherent error; a plaintext dot
+    // product over switched ciphertexts adds it up
+    Parameters params(1024, 1LL << 40, 16, 3);
+    const int64 beta = 1LL << 10;
+    double measured = 0.0;
+    double estimate = 0.0;
+    for (int key = 0; key < KEYS; ++key) {
+        auto from = keys::generate_glwe_secret_key(2, params.n);
+        auto to = keys::generate_glwe_secret_key(2, params.n);
+        auto ksk = keys::generate_glwe_key_switch_key(from.s, to, params, beta);
+
+        std::vector<schemes::GLWECiphertext> cts;
+        std::vector<operations::PreparedPlaintext> plains;
+        Polynomial expected(params.n, 0);
+        for (int i = 0; i < 4; ++i) {
+            Polynomial m = random_message(params.n, params.t);
+            Polynomial p = random_message(params.n, params.t);
+            cts.push_back(operations::key_switch_glwe(schemes::encrypt_glwe(m, from, params), ksk, params));
+            plains.push_back(operations::prepare_plaintext(p, params));
+            expected = polynomial::add(expected, polynomial::negacyclic_multiply(m, p, params.t), params.t);
+        }
+        auto result = operations::multiply_plain_accumulate_glwe(cts, plains, params);
+        measured += noise::measure_noise_glwe(result, expected, to, params).variance;
+        estimate += result.noise_variance;
+    }
+    CHECK(tracks(measured / estimate));
+}
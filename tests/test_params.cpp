@@ -0,0 +1,96 @@
+// Parameter selection: selected sets decrypt their critical path
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <random>
+
+using namespace turinged;
+
+namespace {
+
+std::mt19937_64 message_rng(4242);
+
+Polynomial random_message(std::size_t n, int64 t) {
+    Polynomial m(n);
+    for (int64& c : m) c = static_cast<int64>(message_rng() % static_cast<uint64>(t));
+    return m;
+}
+
+}
+
+TEST(selected_parameters_meet_targets) {
+    params::Requirements req;
+    req.t = 16;
+    req.plaintext_multiplies = 1;
+    params::ParameterSet set = params::select_parameters(req);
+    const Parameters& params = set.params;
+    CHECK(set.security_bits >= req.security_bits);
+    CHECK(set.failure_probability <= req.failure_probability);
+    CHECK(set.beta == 0);
+
+    auto sk = keys::generate_glwe_secret_key(set.k, params.n);
+    Polynomial m(params.n, 0);
+    Polynomial p(params.n, 0);
+    for (std::size_t i = 0; i < params.n; ++i) m[i] = static_cast<int64>((i * 5 + 1) % 16);
+    p[0] = 3;
+    p[2] = 15;
+    auto ct = operations::multiply_plain_glwe(schemes::encrypt_glwe(m, sk, params), operations::prepare_plaintext(p, params), params);
+    CHECK(schemes::decrypt_glwe(ct, sk, params) == polynomial::negacyclic_multiply(m, p, params.t));
+
+    // Three products in sequence do not fit in n = 1024 at 128 bits
+    req.depth = 3;
+    req.max_n = 1024;
+    CHECK_THROWS(params::select_parameters(req));
+}
+
+TEST(selected_parameters_decrypt_critical_path) {
+    // This set once came out at n = 2048, q = 2^38 with a claimed failure
+    // probability of 2^-134, and about one key in 30 failed to decrypt
+    params::Requirements req;
+    req.t = 16;
+    req.depth = 1;
+    req.fan_in = 4;
+    req.plaintext_multiplies = 1;
+    req.rotations = 2;
+    params::ParameterSet set = params::select_parameters(req);
+    const Parameters& params = set.params;
+    REQUIRE(set.k == 1);
+    REQUIRE(set.failure_probability <= req.failure_probability);
+
+    std::vector<uint64> elements;
+    for (std::size_t r = 1; r <= req.rotations; ++r) {
+        elements.push_back(operations::galois_element_for_rotation(static_cast<int>(r), params.n));
+    }
+
+    const int keys = 24;
+    double worst = 0.0;
+    for (int key = 0; key < keys; ++key) {
+        auto sk = keys::generate_rlwe_secret_key(params.n);
+        auto rlk = keys::generate_rlwe_relin_key(sk, params, set.beta);
+        auto gk = keys::generate_rlwe_galois_keys(sk, params, set.beta, elements);
+
+        schemes::RLWECiphertext sum;
+        Polynomial expected(params.n, 0);
+        for (std::size_t branch = 0; branch < req.fan_in; ++branch) {
+            Polynomial m1 = random_message(params.n, params.t);
+            Polynomial m2 = random_message(params.n, params.t);
+            Polynomial p = random_message(params.n, params.t);
+            auto ct = operations::multiply_rlwe(schemes::encrypt_rlwe(m1, sk, params),
+                                                schemes::encrypt_rlwe(m2, sk, params), rlk, params);
+            ct = operations::multiply_plain_rlwe(ct, p, params);
+            Polynomial m = polynomial::negacyclic_multiply(polynomial::negacyclic_multiply(m1, m2, params.t), p, params.t);
+            for (uint64 g : elements) {
+                ct = operations::apply_galois_rlwe(ct, g, gk, params);
+                m = polynomial::automorphism(m, g, params.t);
+            }
+            sum = branch == 0 ? ct : operations::add_rlwe(sum, ct, params);
+            expected = polynomial::add(expected, m, params.t);
+        }
+
+        CHECK(schemes::decrypt_rlwe(sum, sk, params) == expected);
+        double measured = noise::measure_noise_rlwe(sum, expected, sk, params).variance;
+        worst = std::max(worst, measured / set.variance);
+    }
+    // The margin covers the worst key seen
+    CHECK(worst < req.variance_margin);
+}
@@ -0,0 +1,145 @@
+// RNS BFV over a leveled modulus chain and approximate CKKS arithmetic
+
+#include "test_common.hpp"
+#include <cmath>
+
+using namespace turinged;
+
+namespace {
+
+double max_error(const std::vector<std::complex<double>>& got, const std::vector<double>& expected) {
+    double err = 0;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        err = std::max(err, std::abs(got[i] - expected[i]));
+    }
+    return err;
+}
+
+}
+
+TEST(rns_bfv_multiplication_down_the_chain) {
+    std::size_t n = 2048;
+    int64 t = 65537;
+    auto params = rns::create_rns_parameters(n, t, 3, 55, 5);
+    auto sk = keys::generate_rlwe_secret_key(n);
+    auto rlk = keys::generate_rns_relin_key(sk, params);
+
+    Polynomial m1(n);
+    Polynomial m2(n, 0);
+    for (std::size_t i = 0; i < n; ++i) m1[i] = static_cast<int64>((i * 977) % t);
+    m2[0] = 3;
+    m2[5] = t - 1;
+    m2[100] = 12345;
+
+    auto c1 = schemes::encrypt_rlwe_rns(m1, sk, params);
+    auto c2 = schemes::encrypt_rlwe_rns(m2, sk, params);
+    CHECK(c1.level() == params.top_level());
+    CHECK(schemes::decrypt_rlwe_rns(c1, sk, params) == m1);
+
+    auto dropped = operations::mod_switch_to_level_rlwe_rns(c1, 0, params);
+    CHECK(dropped.level() == 0);
+    CHECK(schemes::decrypt_rlwe_rns(dropped, sk, params) == m1);
+    auto mixed = operations::add_rlwe_rns(dropped, c2, params);
+    CHECK(mixed.level() == 0);
+    CHECK(schemes::decrypt_rlwe_rns(mixed, sk, params) == polynomial::add(m1, m2, t));
+
+    auto ct = c1;
+    Polynomial expected = m1;
+    for (std::size_t depth = 1; depth <= params.top_level(); ++depth) {
+        ct = operations::multiply_rlwe_rns(ct, c2, rlk, params);
+        expected = polynomial::negacyclic_multiply(expected, m2, t);
+        CHECK(ct.level() == params.top_level() - depth);
+        CHECK(schemes::decrypt_rlwe_rns(ct, sk, params) == expected);
+    }
+    CHECK_THROWS(operations::multiply_rlwe_rns(ct, c2, rlk, params));
+}
+
+TEST(rns_glwe_multiplication) {
+    std::size_t n = 512;
+    int64 t = 257;
+    auto params = rns::create_rns_parameters(n, t, 3, 50, 3);
+    auto sk = keys::generate_glwe_secret_key(2, n);
+    auto rlk = keys::generate_rns_relin_key(sk, params);
+
+    Polynomial a(n);
+    Polynomial b(n, 0);
+    for (std::size_t i = 0; i < n; ++i) a[i] = static_cast<int64>(i % t);
+    b[1] = 2;
+    b[3] = 5;
+    auto ca = schemes::encrypt_glwe_rns(a, sk, params);
+    auto cb = schemes::encrypt_glwe_rns(b, sk, params);
+    CHECK(schemes::decrypt_glwe_rns(ca, sk, params) == a);
+
+    auto product = operations::multiply_glwe_rns(ca, cb, rlk, params);
+    Polynomial expected = polynomial::negacyclic_multiply(a, b, t);
+    CHECK(schemes::decrypt_glwe_rns(product, sk, params) == expected);
+
+    product = operations::multiply_glwe_rns(product, cb, rlk, params);
+    expected = polynomial::negacyclic_multiply(expected, b, t);
+    CHECK(schemes::decrypt_glwe_rns(product, sk, params) == expected);
+}
+
+TEST(ckks_add_multiply_rescale) {
+    std::size_t n = 4096;
+    double scale = std::pow(2.0, 40);
+    auto encoder = encoding::create_ckks_encoder(n);
+    auto params = rns::create_ckks_parameters(n, 3, 40, 4);
+    auto sk = keys::generate_rlwe_secret_key(n);
+    auto rlk = keys::generate_rns_relin_key(sk, params);
+
+    std::vector<double> x(n / 2);
+    std::vector<double> y(n / 2);
+    std::vector<double> sum(n / 2);
+    std::vector<double> product(n / 2);
+    for (std::size_t i = 0; i < n / 2; ++i) {
+        x[i] = std::sin(static_cast<double>(i) * 0.01);
+        y[i] = 2 * std::cos(static_cast<double>(i) * 0.03);
+        sum[i] = x[i] + y[i];
+        product[i] = x[i] * y[i];
+    }
+
+    auto cx = schemes::encrypt_ckks(encoding::encode_ckks(x, scale, encoder), sk, params);
+    auto cy = schemes::encrypt_ckks(encoding::encode_ckks(y, scale, encoder), sk, params);
+    auto decode = [&](const schemes::CKKSCiphertext& ct) {
+        return encoding::decode_ckks(schemes::decrypt_ckks(ct, sk, params), ct.scale, encoder);
+    };
+
+    CHECK(max_error(decode(cx), x) < 1e-6);
+    CHECK(max_error(decode(operations::add_ckks(cx, cy, params)), sum) < 1e-6);
+
+    auto cp = operations::multiply_ckks(cx, cy, rlk, params);
+    CHECK(cp.level() == params.top_level() - 1);
+    CHECK(max_error(decode(cp), product) < 1e-5);
+
+    auto dropped = operations::mod_drop_ckks(cx, 1, params);
+    CHECK(dropped.level() == 1);
+    CHECK(max_error(decode(dropped), x) < 1e-6);
+}
+
+TEST(rns_encryption_from_many_threads) {
+    // Each thread draws from its own generator
+    std::size_t n = 1024;
+    auto params = rns::create_rns_parameters(n, 257, 3, 50, 2);
+    auto ckks_params = rns::create_ckks_parameters(n, 3, 40, 2);
+    auto encoder = encoding::create_ckks_encoder(n);
+    auto sk = keys::generate_rlwe_secret_key(n);
+
+    std::vector<Polynomial> messages(16, Polynomial(n, 0));
+    for (std::size_t i = 0; i < messages.size(); ++i) messages[i][i] = static_cast<int64>(i + 1);
+    std::vector<double> values(n / 2, 0.25);
+    auto plain = encoding::encode_ckks(values, std::pow(2.0, 40), encoder);
+
+    std::vector<schemes::RNSRLWECiphertext> cts(messages.size());
+    std::vector<schemes::CKKSCiphertext> ckks(messages.size());
+    core::parallel_for(messages.size(), [&](std::size_t i) {
+        cts[i] = schemes::encrypt_rlwe_rns(messages[i], sk, params);
+        ckks[i] = schemes::encrypt_ckks(plain, sk, ckks_params);
+    }, 4);
+
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        CHECK(schemes::decrypt_rlwe_rns(cts[i], sk, params) == messages[i]);
+        auto decoded = encoding::decode_ckks(schemes::decrypt_ckks(ckks[i], sk, ckks_params), ckks[i].scale, encoder);
+        CHECK(max_error(decoded, values) < 1e-6);
+    }
+    CHECK(cts[0].a.residues != cts[1].a.residues);
+}
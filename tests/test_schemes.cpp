@@ -0,0 +1,424 @@
+// LWE, RLWE and GLWE encryption, key switching key generation, the linear
+// and BFV operations, slot batching, rotations and LWE-to-ring packing
+
+#include "test_common.hpp"
+#include <algorithm>
+#include <sstream>
+
+using namespace turinged;
+
+namespace {
+
+Polynomial sample_message(std::size_t n, int64 t, std::size_t stride) {
+    Polynomial m(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        m[i] = static_cast<int64>((i * stride + 3) % static_cast<std::size_t>(t));
+    }
+    return m;
+}
+
+std::vector<int64> sample_slots(std::size_t n, int64 t) {
+    std::vector<int64> slots(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        slots[i] = static_cast<int64>((i * 31 + 7) % static_cast<std::size_t>(t));
+    }
+    return slots;
+}
+
+// Both batch rows rotated left by steps (|steps| < n/2)
+std::vector<int64> rotated(const std::vector<int64>& slots, int steps) {
+    std::size_t half = slots.size() / 2;
+    std::vector<int64> out(slots.size());
+    for (std::size_t row = 0; row < 2; ++row) {
+        for (std::size_t i = 0; i < half; ++i) {
+            std::size_t from = (i + static_cast<std::size_t>(steps + static_cast<int>(half))) % half;
+            out[row * half + i] = slots[row * half + from];
+        }
+    }
+    return out;
+}
+
+}
+
+TEST(lwe_round_trip_and_linear_operations) {
+    Parameters params(0, 1LL << 32, 16, 8);
+    auto sk = keys::generate_lwe_secret_key(512);
+    auto pk = keys::generate_lwe_public_key(sk, params, 1024);
+
+    for (int64 m = 0; m < params.t; ++m) {
+        CHECK(schemes::decrypt_lwe(schemes::encrypt_lwe(m, sk, params), sk, params) == m);
+        CHECK(schemes::decrypt_lwe(schemes::encrypt_lwe(m, pk, params), sk, params) == m);
+    }
+
+    auto a = schemes::encrypt_lwe(5, sk, params);
+    auto b = schemes::encrypt_lwe(13, sk, params);
+    CHECK(schemes::decrypt_lwe(operations::add_lwe(a, b, params), sk, params) == 2);
+    CHECK(schemes::decrypt_lwe(operations::subtract_lwe(a, b, params), sk, params) == 8);
+    CHECK(schemes::decrypt_lwe(operations::scalar_multiply_lwe(a, 3, params), sk, params) == 15);
+    CHECK(schemes::decrypt_lwe(operations::add_plain_lwe(a, 4, params), sk, params) == 9);
+    CHECK(schemes::decrypt_lwe(operations::add_lwe(a, schemes::trivial_lwe(7, params), params), sk, params) == 12);
+
+    auto batch = schemes::encrypt_lwe_batch({1, 2, 3, 4}, pk, params, 2);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        CHECK(schemes::decrypt_lwe(batch[i], sk, params) == static_cast<int64>(i + 1));
+    }
+}
+
+TEST(rlwe_and_glwe_round_trip) {
+    Parameters params(512, 1LL << 40, 16, 8);
+    Polynomial m = sample_message(params.n, params.t, 5);
+
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto pk = keys::generate_rlwe_public_key(sk, params);
+    CHECK(schemes::decrypt_rlwe(schemes::encrypt_rlwe(m, sk, params), sk, params) == m);
+    CHECK(schemes::decrypt_rlwe(schemes::encrypt_rlwe(m, pk, params), sk, params) == m);
+
+    auto gsk = keys::generate_glwe_secret_key(2, params.n);
+    auto gpk = keys::generate_glwe_public_key(gsk, params);
+    CHECK(schemes::decrypt_glwe(schemes::encrypt_glwe(m, gsk, params), gsk, params) == m);
+    CHECK(schemes::decrypt_glwe(schemes::encrypt_glwe(m, gpk, params), gsk, params) == m);
+
+    auto seeded = schemes::encrypt_glwe_seeded(m, gsk, params, 42);
+    CHECK(schemes::decrypt_glwe(schemes::expand_seeded_glwe(seeded, 2, params), gsk, params) == m);
+
+    auto ggsw = schemes::encrypt_ggsw(m, gsk, params, 2, 1LL << 8);
+    CHECK(schemes::decrypt_ggsw(ggsw, gsk, params, 2, 1LL << 8) == m);
+}
+
+TEST(seeded_glev_and_ggsw) {
+    Parameters params(512, 1LL << 40, 16, 8);
+    Polynomial m = sample_message(params.n, params.t, 5);
+    const int l = 2;
+    const int64 beta = 1LL << 8;
+    auto gsk = keys::generate_glwe_secret_key(2, params.n);
+    auto prepared = schemes::prepare_glwe_secret_key(gsk, params);
+
+    // Every level decrypts; the same seed gives the same masks whatever the noise seed
+    auto glev = schemes::expand_seeded_glev(schemes::encrypt_glev_seeded(m, prepared, params, l, beta, 7, 100), 2, params);
+    auto glev_again = schemes::expand_seeded_glev(schemes::encrypt_glev_seeded(m, prepared, params, l, beta, 7, 101), 2, params);
+    auto glev_other = schemes::expand_seeded_glev(schemes::encrypt_glev_seeded(m, prepared, params, l, beta, 8, 100), 2, params);
+    for (int j = 0; j <= l; ++j) {
+        CHECK(schemes::decrypt_glev_level(glev, gsk, params, j, beta) == m);
+        CHECK(schemes::decrypt_glev_level(glev_again, gsk, params, j, beta) == m);
+        CHECK(glev.levels[j].d_tilde == glev_again.levels[j].d_tilde);
+        CHECK(glev.levels[j].b != glev_again.levels[j].b);
+        CHECK(glev.levels[j].d_tilde != glev_other.levels[j].d_tilde);
+    }
+
+    auto seeded = schemes::encrypt_ggsw_seeded(m, prepared, params, l, beta, 11, 200);
+    auto ggsw = schemes::expand_seeded_ggsw(seeded, params);
+    auto ggsw_again = schemes::expand_seeded_ggsw(schemes::encrypt_ggsw_seeded(m, prepared, params, l, beta, 11, 201), params);
+    for (int j = 0; j <= l; ++j) {
+        CHECK(schemes::decrypt_ggsw(ggsw, gsk, params, j, beta) == m);
+    }
+    bool masks_match = true;
+    for (std::size_t row = 0; row <= gsk.s.size(); ++row) {
+        for (int j = 0; j <= l; ++j) {
+            masks_match = masks_match && ggsw.glev_rows[row].levels[j].d_tilde == ggsw_again.glev_rows[row].levels[j].d_tilde;
+        }
+    }
+    CHECK(masks_match);
+
+    // The view overload writes the same ciphertext as expanding the seeded one
+    std::size_t k = gsk.s.size();
+    std::vector<int64> words(schemes::GGSWCiphertextView::words(k, params.n, l));
+    schemes::GGSWCiphertextView out(words.data(), k, params.n, l, params.q);
+    schemes::encrypt_ggsw_seeded(polynomial::view(m, params.q), prepared, params, beta, 11, 200, out);
+    bool same = true;
+    for (std::size_t row = 0; row <= k; ++row) {
+        for (int j = 0; j <= l; ++j) {
+            const schemes::GLWECiphertext& expected = ggsw.glev_rows[row].levels[j];
+            schemes::GLWECiphertextView level = out.row(row).level(j);
+            same = same && std::equal(expected.b.begin(), expected.b.end(), level.body);
+            for (std::size_t c = 0; c < k; ++c) {
+                same = same && std::equal(expected.d_tilde[c].begin(), expected.d_tilde[c].end(), level.mask + c * params.n);
+            }
+        }
+    }
+    CHECK(same);
+}
+
+TEST(plaintext_products) {
+    Parameters params(512, 1LL << 40, 16, 8);
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    Polynomial m = sample_message(params.n, params.t, 3);
+    Polynomial plain(params.n, 0);
+    plain[0] = 3;
+    plain[7] = 15;
+
+    auto ct = schemes::encrypt_rlwe(m, sk, params);
+    Polynomial expected = polynomial::negacyclic_multiply(m, plain, params.t);
+    CHECK(schemes::decrypt_rlwe(operations::multiply_plain_rlwe(ct, plain, params), sk, params) == expected);
+
+    auto prepared = operations::prepare_plaintext(plain, params);
+    auto sum = operations::multiply_plain_accumulate_rlwe({ct, ct}, {prepared, prepared}, params);
+    CHECK(schemes::decrypt_rlwe(sum, sk, params) == polynomial::add(expected, expected, params.t));
+}
+
+TEST(modulus_switching) {
+    Parameters params(1024, 1LL << 50, 16, 8);
+    int64 q_new = 1LL << 30;
+    Parameters switched = operations::switched_parameters(params, q_new);
+    Polynomial m = sample_message(params.n, params.t, 7);
+
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto ct = operations::modulus_switch_rlwe(schemes::encrypt_rlwe(m, sk, params), params, q_new);
+    CHECK(schemes::decrypt_rlwe(ct, sk, switched) == m);
+
+    Parameters lwe_params(0, params.q, params.t, 8);
+    auto lwe_sk = keys::generate_lwe_secret_key(256);
+    auto lwe_ct = operations::modulus_switch_lwe(schemes::encrypt_lwe(11, lwe_sk, lwe_params), lwe_params, q_new);
+    CHECK(schemes::decrypt_lwe(lwe_ct, lwe_sk, operations::switched_parameters(lwe_params, q_new)) == 11);
+
+    // The batch matches switching one ciphertext at a time
+    std::vector<schemes::LWECiphertext> batch;
+    for (int64 message = 0; message < lwe_params.t; ++message) batch.push_back(schemes::encrypt_lwe(message, lwe_sk, lwe_params));
+    auto switched_batch = operations::modulus_switch_lwe_batch(batch, lwe_params, q_new, 3);
+    CHECK(switched_batch.size() == batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        auto single = operations::modulus_switch_lwe(batch[i], lwe_params, q_new);
+        CHECK(switched_batch[i].a == single.a && switched_batch[i].b == single.b);
+        CHECK(schemes::decrypt_lwe(switched_batch[i], lwe_sk, operations::switched_parameters(lwe_params, q_new)) == static_cast<int64>(i));
+    }
+}
+
+TEST(key_switching) {
+    Parameters params(1024, 1LL << 52, 257, 3);
+    Polynomial m = sample_message(params.n, params.t, 7);
+    auto from = keys::generate_rlwe_secret_key(params.n);
+    auto to = keys::generate_rlwe_secret_key(params.n);
+    auto ksk = keys::generate_rlwe_key_switch_key(from.s, to, params, 1LL << 15);
+    auto ct = operations::key_switch_rlwe(schemes::encrypt_rlwe(m, from, params), ksk, params);
+    CHECK(schemes::decrypt_rlwe(ct, to, params) == m);
+
+    Parameters lwe_params(0, 1LL << 32, 16, 2);
+    auto lwe_from = keys::generate_lwe_secret_key(600);
+    auto lwe_to = keys::generate_lwe_secret_key(500);
+    auto lwe_ksk = keys::generate_lwe_key_switch_key(lwe_from, lwe_to, lwe_params, 1LL << 4);
+    for (int64 message = 0; message < lwe_params.t; ++message) {
+        auto switched = operations::key_switch_lwe(schemes::encrypt_lwe(message, lwe_from, lwe_params), lwe_ksk, lwe_params);
+        CHECK(schemes::decrypt_lwe(switched, lwe_to, lwe_params) == message);
+    }
+}
+
+TEST(key_switch_key_generation_pipeline) {
+    Parameters params(0, 1LL << 32, 16, 2);
+    auto from = keys::generate_lwe_secret_key(600);
+    auto to = keys::generate_lwe_secret_key(500);
+
+    // Chunks of 64 rows, each reported once it is done
+    std::vector<keys::KeygenProgress> reports;
+    keys::KeygenOptions options;
+    options.num_threads = 3;
+    options.chunk_size = 64;
+    options.seed = 42;
+    options.progress = [&](const keys::KeygenProgress& p) { reports.push_back(p); };
+    auto ksk = keys::generate_lwe_key_switch_key(from, to, params, 1LL << 4, options);
+    REQUIRE(reports.size() == (from.s.size() + 63) / 64);
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+        CHECK(reports[i].total == from.s.size());
+        CHECK(reports[i].completed == std::min((i + 1) * 64, from.s.size()));
+        CHECK(reports[i].elapsed_seconds >= (i == 0 ? 0.0 : reports[i - 1].elapsed_seconds));
+    }
+
+    // The masks depend only on the seed, not on the threads or the chunking;
+    // the streamed key shares them
+    options.num_threads = 1;
+    options.chunk_size = 7;
+    options.progress = nullptr;
+    auto serial = keys::generate_lwe_key_switch_key(from, to, params, 1LL << 4, options);
+    std::stringstream stream;
+    keys::write_lwe_key_switch_key(stream, from, to, params, 1LL << 4, options);
+    auto streamed = io::deserialize_lwe_key_switch_key(stream);
+    REQUIRE(serial.data.size() == ksk.data.size() && streamed.data.size() == ksk.data.size());
+    bool masks_match = true;
+    for (std::size_t i = 0; i < ksk.n_in; ++i) {
+        for (int j = 0; j < ksk.levels; ++j) {
+            masks_match = masks_match && std::equal(ksk.entry(i, j), ksk.entry(i, j) + ksk.n_out, serial.entry(i, j)) &&
+                          std::equal(ksk.entry(i, j), ksk.entry(i, j) + ksk.n_out, streamed.entry(i, j));
+        }
+    }
+    CHECK(masks_match);
+
+    for (const keys::LWEKeySwitchKey* key : {&ksk, &serial, &streamed}) {
+        for (int64 message : {0, 5, 15}) {
+            auto switched = operations::key_switch_lwe(schemes::encrypt_lwe(message, from, params), *key, params);
+            CHECK(schemes::decrypt_lwe(switched, to, params) == message);
+        }
+    }
+}
+
+TEST(bfv_multiplication) {
+    // Depth 2 keeps about 12 bits of budget at the largest q the exact tensor allows
+    Parameters params(1024, 1LL << 54, 17, 3);
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto rlk = keys::generate_rlwe_relin_key(sk, params, 1LL << 15);
+
+    Polynomial m1 = sample_message(params.n, params.t, 7);
+    Polynomial m2(params.n, 0);
+    m2[0] = 2;
+    m2[3] = 5;
+    auto c1 = schemes::encrypt_rlwe(m1, sk, params);
+    auto c2 = schemes::encrypt_rlwe(m2, sk, params);
+
+    Polynomial expected = polynomial::negacyclic_multiply(m1, m2, params.t);
+    auto product = operations::multiply_rlwe(c1, c2, rlk, params);
+    CHECK(schemes::decrypt_rlwe(product, sk, params) == expected);
+
+    expected = polynomial::negacyclic_multiply(expected, m1, params.t);
+    CHECK(schemes::decrypt_rlwe(operations::multiply_rlwe(product, c1, rlk, params), sk, params) == expected);
+}
+
+TEST(batch_encoding) {
+    Parameters params(1024, 1LL << 54, 12289, 3);
+    auto encoder = encoding::create_batch_encoder(params);
+    std::vector<int64> x = sample_slots(params.n, params.t);
+    std::vector<int64> y(params.n);
+    for (std::size_t i = 0; i < params.n; ++i) y[i] = static_cast<int64>((i * i + 5) % 12289);
+    CHECK(encoding::decode_batch(encoding::encode_batch(x, encoder), encoder) == x);
+
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto rlk = keys::generate_rlwe_relin_key(sk, params, 1LL << 18);
+    auto cx = schemes::encrypt_rlwe(encoding::encode_batch(x, encoder), sk, params);
+    auto cy = schemes::encrypt_rlwe(encoding::encode_batch(y, encoder), sk, params);
+
+    auto product = encoding::decode_batch(schemes::decrypt_rlwe(operations::multiply_rlwe(cx, cy, rlk, params), sk, params), encoder);
+    auto sum = encoding::decode_batch(schemes::decrypt_rlwe(operations::add_rlwe(cx, cy, params), sk, params), encoder);
+    for (std::size_t i = 0; i < params.n; ++i) {
+        CHECK(product[i] == x[i] * y[i] % params.t);
+        CHECK(sum[i] == (x[i] + y[i]) % params.t);
+    }
+}
+
+TEST(slot_rotations_with_exact_keys) {
+    Parameters params(1024, 1LL << 54, 12289, 3);
+    std::size_t half = params.n / 2;
+    auto encoder = encoding::create_batch_encoder(params);
+    std::vector<int64> x = sample_slots(params.n, params.t);
+
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    std::vector<uint64> elements = operations::power_of_two_galois_elements(params.n);
+    elements.push_back(operations::galois_element_for_rotation(3, params.n));
+    elements.push_back(operations::galois_element_for_rotation(-1, params.n));
+    auto gk = keys::generate_rlwe_galois_keys(sk, params, 1LL << 18, elements);
+    auto ct = schemes::encrypt_rlwe(encoding::encode_batch(x, encoder), sk, params);
+
+    auto decode = [&](const schemes::RLWECiphertext& c) {
+        return encoding::decode_batch(schemes::decrypt_rlwe(c, sk, params), encoder);
+    };
+
+    CHECK(decode(operations::rotate_rows_rlwe(ct, 3, gk, params)) == rotated(x, 3));
+    CHECK(decode(operations::rotate_rows_rlwe(ct, -1, gk, params)) == rotated(x, -1));
+
+    std::vector<int64> swapped(x.begin() + half, x.end());
+    swapped.insert(swapped.end(), x.begin(), x.begin() + half);
+    CHECK(decode(operations::swap_rows_rlwe(ct, gk, params)) == swapped);
+
+    std::vector<int> steps = {1, 2, 4, 3, -1};
+    auto hoisted = operations::rotate_rows_hoisted(ct, steps, gk, params);
+    REQUIRE(hoisted.size() == steps.size());
+    for (std::size_t i = 0; i < steps.size(); ++i) {
+        CHECK(decode(hoisted[i]) == rotated(x, steps[i]));
+    }
+
+    int64 total = 0;
+    for (int64 v : x) total = (total + v) % params.t;
+    auto sums = decode(operations::sum_slots_rlwe(ct, gk, params));
+    CHECK(sums == std::vector<int64>(params.n, total));
+}
+
+TEST(slot_rotations_with_power_of_two_keys) {
+    Parameters params(1024, 1LL << 54, 12289, 3);
+    auto encoder = encoding::create_batch_encoder(params);
+    std::vector<int64> x = sample_slots(params.n, params.t);
+
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto gk = keys::generate_rlwe_galois_keys(sk, params, 1LL << 18, operations::power_of_two_galois_elements(params.n));
+    auto ct = schemes::encrypt_rlwe(encoding::encode_batch(x, encoder), sk, params);
+    auto decode = [&](const schemes::RLWECiphertext& c) {
+        return encoding::decode_batch(schemes::decrypt_rlwe(c, sk, params), encoder);
+    };
+
+    // Missing exact keys are made up from the power-of-two rotations
+    for (int steps : {3, -1, 5, 300, -255, 511}) {
+        CHECK(decode(operations::rotate_rows_rlwe(ct, steps, gk, params)) == rotated(x, steps));
+    }
+
+    std::vector<int> steps = {4, 3, -1};
+    auto hoisted = operations::rotate_rows_hoisted(ct, steps, gk, params);
+    REQUIRE(hoisted.size() == steps.size());
+    for (std::size_t i = 0; i < steps.size(); ++i) {
+        CHECK(decode(hoisted[i]) == rotated(x, steps[i]));
+    }
+
+    keys::RLWEGaloisKeys swap_only = keys::generate_rlwe_galois_keys(
+        sk, params, 1LL << 18, {operations::galois_element_for_row_swap(params.n)});
+    CHECK_THROWS(operations::rotate_rows_rlwe(ct, 1, swap_only, params));
+}
+
+TEST(trivial_rlwe_operands) {
+    Parameters params(1024, 1LL << 54, 12289, 3);
+    auto encoder = encoding::create_batch_encoder(params);
+    std::vector<int64> x = sample_slots(params.n, params.t);
+    std::vector<int64> y(params.n);
+    for (std::size_t i = 0; i < params.n; ++i) y[i] = static_cast<int64>((i * i + 5) % 12289);
+
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto rlk = keys::generate_rlwe_relin_key(sk, params, 1LL << 18);
+    auto gk = keys::generate_rlwe_galois_keys(sk, params, 1LL << 18, operations::power_of_two_galois_elements(params.n));
+    auto ct = schemes::encrypt_rlwe(encoding::encode_batch(x, encoder), sk, params);
+    auto trivial = schemes::trivial_rlwe(encoding::encode_batch(y, encoder), params);
+    auto decode = [&](const schemes::RLWECiphertext& c) {
+        return encoding::decode_batch(schemes::decrypt_rlwe(c, sk, params), encoder);
+    };
+
+    // Products with a trivial operand, on either side, or both
+    std::vector<int64> xy(params.n), yy(params.n);
+    for (std::size_t i = 0; i < params.n; ++i) {
+        xy[i] = x[i] * y[i] % params.t;
+        yy[i] = y[i] * y[i] % params.t;
+    }
+    CHECK(decode(operations::multiply_rlwe(ct, trivial, rlk, params)) == xy);
+    CHECK(decode(operations::multiply_rlwe(trivial, ct, rlk, params)) == xy);
+    CHECK(decode(operations::relinearize_rlwe(operations::tensor_rlwe(trivial, ct, params), rlk, params)) == xy);
+    auto squared = operations::multiply_rlwe(trivial, trivial, rlk, params);
+    CHECK(squared.is_trivial());
+    CHECK(decode(squared) == yy);
+
+    // Rotations of a trivial ciphertext permute the body and stay trivial
+    auto rotated_trivial = operations::rotate_rows_rlwe(trivial, 3, gk, params);
+    CHECK(rotated_trivial.is_trivial());
+    CHECK(decode(rotated_trivial) == rotated(y, 3));
+    CHECK(decode(operations::key_switch_rlwe(trivial, gk.keys.begin()->second, params)) == y);
+
+    std::vector<int> steps = {1, 4, 3, -1};
+    auto hoisted = operations::rotate_rows_hoisted(trivial, steps, gk, params);
+    REQUIRE(hoisted.size() == steps.size());
+    for (std::size_t i = 0; i < steps.size(); ++i) {
+        CHECK(hoisted[i].is_trivial());
+        CHECK(decode(hoisted[i]) == rotated(y, steps[i]));
+    }
+}
+
+TEST(lwe_to_ring_packing) {
+    Parameters params(1024, (1LL << 50) - 27, 16, 3);
+    auto sk = keys::generate_rlwe_secret_key(params.n);
+    auto lwe_sk = keys::extract_lwe_secret_key(sk);
+    auto gk = keys::generate_rlwe_galois_keys(sk, params, 1LL << 10, operations::packing_galois_elements(params.n));
+
+    for (std::size_t count : {std::size_t(1), std::size_t(5), std::size_t(64)}) {
+        std::vector<schemes::LWECiphertext> cts;
+        for (std::size_t j = 0; j < count; ++j) {
+            cts.push_back(schemes::encrypt_lwe(static_cast<int64>(j % 16), lwe_sk, params));
+        }
+        Polynomial m = schemes::decrypt_rlwe(operations::pack_lwe_rlwe(cts, gk, params, 2), sk, params);
+
+        std::size_t slots = 1;
+        while (slots < count) slots *= 2;
+        std::size_t stride = params.n / slots;
+        for (std::size_t i = 0; i < params.n; ++i) {
+            bool packed = i % stride == 0 && i / stride < count;
+            CHECK(m[i] == (packed ? static_cast<int64>((i / stride) % 16) : 0));
+        }
+    }
+}
@@ -0,0 +1,194 @@
+// Picks the fastest parameter set meeting a security level and a decryption
+// failure target for a circuit (see params/params.hpp).
+//
+// Costs are measured on this machine by timing the library's operations at
+// each candidate (n, k) whose modelled cost is within --within times the best
+// modelled cost (0 measures all); the rest, and every candidate with --model,
+// are priced by the transform-count model. The table lists the cheapest
+// accepted set of every (n, k), fastest first, marking measured costs "m" and
+// modelled ones "e".
+//
+//   turinged_params [--security 128] [--t 16] [--failure-bits 40] [--margin 16] [--public-key]
+//                   [--depth 1] [--fan-in 4] [--plain 1] [--rotations 2]
+//                   [--mix enc,dec,add,plain,mul,rot] [--min-n 256] [--max-n 32768]
+//                   [--max-k 4] [--model] [--within 4] [--min-time 0.02]
+
+#include "turinged/turinged.hpp"
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace turinged;
+
+namespace {
+
+struct Options {
+    params::Requirements req;
+    bool model = false;
+    double within = 4.0;
+    double min_time = 0.02;
+};
+
+double parse_number(const std::string& flag, const std::string& text) {
+    std::size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != text.size() || value < 0.0) {
+        throw std::runtime_error("Bad value '" + text + "' for " + flag);
+    }
+    return value;
+}
+
+std::size_t parse_count(const std::string& flag, const std::string& text) {
+    double value = parse_number(flag, text);
+    if (value != static_cast<double>(static_cast<std::size_t>(value))) {
+        throw std::runtime_error("Bad value '" + text + "' for " + flag);
+    }
+    return static_cast<std::size_t>(value);
+}
+
+params::OperationMix parse_mix(const std::string& text) {
+    std::vector<double> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) values.push_back(parse_number("--mix", item));
+    if (values.size() != 6) {
+        throw std::runtime_error("--mix takes six counts: enc,dec,add,plain,mul,rot");
+    }
+
+    params::OperationMix mix;
+    mix.encryptions = values[0];
+    mix.decryptions = values[1];
+    mix.additions = values[2];
+    mix.plaintext_multiplies = values[3];
+    mix.multiplies = values[4];
+    mix.rotations = values[5];
+    return mix;
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    params::Requirements& req = options.req;
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--public-key") {
+            req.public_key = true;
+            continue;
+        }
+        if (flag == "--model") {
+            options.model = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::runtime_error("Missing value for " + flag);
+        }
+        std::string value = argv[++i];
+
+        if (flag == "--security") req.security_bits = static_cast<int>(parse_count(flag, value));
+        else if (flag == "--t") req.t = static_cast<int64>(parse_count(flag, value));
+        else if (flag == "--failure-bits") req.failure_probability = std::exp2(-parse_number(flag, value));
+        else if (flag == "--margin") req.variance_margin = parse_number(flag, value);
+        else if (flag == "--depth") req.depth = static_cast<int>(parse_count(flag, value));
+        else if (flag == "--fan-in") req.fan_in = parse_count(flag, value);
+        else if (flag == "--plain") req.plaintext_multiplies = parse_count(flag, value);
+        else if (flag == "--rotations") req.rotations = parse_count(flag, value);
+        else if (flag == "--mix") req.mix = parse_mix(value);
+        else if (flag == "--min-n") req.min_n = parse_count(flag, value);
+        else if (flag == "--max-n") req.max_n = parse_count(flag, value);
+        else if (flag == "--max-k") req.max_k = parse_count(flag, value);
+        else if (flag == "--within") options.within = parse_number(flag, value);
+        else if (flag == "--min-time") options.min_time = parse_number(flag, value);
+        else throw std::runtime_error("Unknown option " + flag);
+    }
+
+    if (req.t < 2) {
+        throw std::runtime_error("--t must be at least 2");
+    }
+    if (req.fan_in == 0) {
+        throw std::runtime_error("--fan-in must be at least 1");
+    }
+    if (!(req.variance_margin >= 1.0)) {
+        throw std::runtime_error("--margin must be at least 1");
+    }
+    return options;
+}
+
+void print_set(std::ostream& out, const params::ParameterSet& set, bool measured) {
+    out << std::setw(7) << set.params.n
+        << std::setw(3) << set.k
+        << std::setw(8) << static_cast<int>(std::log2(static_cast<double>(set.params.q)))
+        << std::setw(10) << set.params.noise_bound
+        << std::setw(7) << (set.beta > 0 ? std::to_string(static_cast<int>(std::log2(static_cast<double>(set.beta)))) : "-")
+        << std::setw(4) << set.levels
+        << std::setw(10) << std::fixed << std::setprecision(1) << set.security_bits
+        << std::setw(12) << std::setprecision(1) << std::log2(set.failure_probability)
+        << std::setw(14) << std::setprecision(3) << set.cost * 1e3
+        << std::setw(3) << (measured ? "m" : "e")
+        << std::defaultfloat << std::endl;
+}
+
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options = parse_options(argc, argv);
+
+        using Key = std::pair<std::size_t, std::size_t>;
+        std::vector<params::ParameterSet> sets = params::feasible_parameters(options.req);
+        if (sets.empty()) {
+            std::cerr << "turinged_params: no parameter set meets the security and failure probability targets"
+                      << std::endl;
+            return 1;
+        }
+
+        // Sets come back fastest first, so the model's best is the front
+        std::set<Key> to_measure;
+        if (!options.model) {
+            for (const params::ParameterSet& set : sets) {
+                if (options.within <= 0.0 || set.cost <= options.within * sets.front().cost) {
+                    to_measure.insert(Key(set.params.n, set.k));
+                }
+            }
+
+            std::map<Key, params::OperationCosts> measured;
+            params::CostFunction costs = [&](std::size_t n, std::size_t k) {
+                if (!to_measure.count(Key(n, k))) return params::model_operation_costs(n, k);
+                auto it = measured.find(Key(n, k));
+                if (it == measured.end()) {
+                    std::cerr << "measuring n=" << n << " k=" << k << "..." << std::endl;
+                    it = measured.emplace(Key(n, k), params::measure_operation_costs(n, k, options.min_time)).first;
+                }
+                return it->second;
+            };
+            sets = params::feasible_parameters(options.req, costs);
+        }
+
+        params::OperationMix mix = params::operation_mix(options.req);
+        std::cout << "security " << options.req.security_bits << " bits, t=" << options.req.t
+                  << ", failure <= 2^" << std::log2(options.req.failure_probability)
+                  << ", mix: " << mix.encryptions << " enc, " << mix.decryptions << " dec, "
+                  << mix.additions << " add, " << mix.plaintext_multiplies << " plain, "
+                  << mix.multiplies << " mul, " << mix.rotations << " rot"
+                  << std::endl;
+        std::cout << std::setw(7) << "n" << std::setw(3) << "k" << std::setw(8) << "log q"
+                  << std::setw(10) << "noise" << std::setw(7) << "log b" << std::setw(4) << "l"
+                  << std::setw(10) << "security" << std::setw(12) << "log2 fail" << std::setw(14) << "ms/eval"
+                  << std::endl;
+        for (const params::ParameterSet& set : sets) {
+            print_set(std::cout, set, to_measure.count(Key(set.params.n, set.k)) > 0);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "turinged_params: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}